@@ -7,6 +7,7 @@
 #include <regex>
 #include <utility>
 
+#include "flutter/fml/async_file_io.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
@@ -69,7 +70,25 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     return mappings;
   }
 
+  // Matching files are opened while visiting the directory and then read in
+  // batches so that loading many small assets does not cost a blocking
+  // system call per asset. A batch is read as soon as it is full so that only
+  // a bounded number of files are open at once.
   std::regex asset_regex(asset_pattern);
+  std::vector<fml::UniqueFD> files;
+  std::vector<std::string> filenames;
+  auto read_files = [&]() {
+    auto contents = fml::AsyncFileIO::GetShared().ReadFiles(files);
+    for (size_t i = 0; i < contents.size(); i++) {
+      if (contents[i]) {
+        mappings.push_back(std::move(contents[i]));
+      } else {
+        FML_LOG(ERROR) << "Mapping " << filenames[i] << " failed";
+      }
+    }
+    files.clear();
+    filenames.clear();
+  };
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     TRACE_EVENT0("flutter", "DirectoryAssetBundle::GetAsMappings FileVisitor");
@@ -84,12 +103,10 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
         return true;
       }
 
-      auto mapping = std::make_unique<fml::FileMapping>(fd);
-
-      if (mapping && mapping->IsValid()) {
-        mappings.push_back(std::move(mapping));
-      } else {
-        FML_LOG(ERROR) << "Mapping " << filename << " failed";
+      files.push_back(std::move(fd));
+      filenames.push_back(filename);
+      if (files.size() == fml::AsyncFileIO::kMaxOpenFilesPerBatch) {
+        read_files();
       }
     }
     return true;
@@ -106,6 +123,7 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     }
     fml::VisitFiles(subdir_fd, visitor);
   }
+  read_files();
 
   return mappings;
 }
@@ -12,6 +12,7 @@
 #include <string_view>
 #include <utility>
 
+#include "flutter/fml/async_file_io.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/hex_codec.h"
@@ -223,13 +224,33 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
-    SkSLCache cache = LoadFile(directory, filename, true);
-    if (cache.key != nullptr && cache.value != nullptr) {
-      result.push_back(cache);
-    } else {
-      FML_LOG(ERROR) << "Failed to load: " << filename;
+  // The cache files are opened while visiting the directory and then read in
+  // batches of a bounded number of open files.
+  std::vector<fml::UniqueFD> files;
+  std::vector<std::string> filenames;
+  auto read_files = [&result, &files, &filenames]() {
+    auto contents = fml::AsyncFileIO::GetShared().ReadFiles(files);
+    for (size_t i = 0; i < contents.size(); i++) {
+      SkSLCache cache;
+      if (contents[i]) {
+        cache = ParseCacheObject(*contents[i], filenames[i], true);
+      }
+      if (cache.key != nullptr && cache.value != nullptr) {
+        result.push_back(cache);
+      } else {
+        FML_LOG(ERROR) << "Failed to load: " << filenames[i];
+      }
+    }
+    files.clear();
+    filenames.clear();
+  };
+  fml::FileVisitor visitor = [&files, &filenames, &read_files](
+                                 const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    files.push_back(fml::OpenFileReadOnly(directory, filename.c_str()));
+    filenames.push_back(filename);
+    if (files.size() == fml::AsyncFileIO::kMaxOpenFilesPerBatch) {
+      read_files();
     }
     return true;
   };
@@ -246,6 +267,7 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
       fml::VisitFiles(fresh_dir, visitor);
     }
   }
+  read_files();
 
   std::unique_ptr<fml::Mapping> mapping = nullptr;
   if (asset_manager_ != nullptr) {
@@ -298,33 +320,39 @@ PersistentCache::SkSLCache PersistentCache::LoadFile(
     const fml::UniqueFD& dir,
     const std::string& file_name,
     bool need_key) {
-  SkSLCache result;
   auto file = fml::OpenFileReadOnly(dir, file_name.c_str());
   if (!file.is_valid()) {
-    return result;
+    return {};
   }
-  auto mapping = std::make_unique<fml::FileMapping>(file);
-  if (mapping->GetSize() < sizeof(CacheObjectHeader)) {
+  return ParseCacheObject(fml::FileMapping(file), file_name, need_key);
+}
+
+PersistentCache::SkSLCache PersistentCache::ParseCacheObject(
+    const fml::Mapping& mapping,
+    const std::string& file_name,
+    bool need_key) {
+  SkSLCache result;
+  if (mapping.GetSize() < sizeof(CacheObjectHeader)) {
     return result;
   }
   const CacheObjectHeader* header =
-      reinterpret_cast<const CacheObjectHeader*>(mapping->GetMapping());
+      reinterpret_cast<const CacheObjectHeader*>(mapping.GetMapping());
   if (header->signature != CacheObjectHeader::kSignature ||
       header->version != CacheObjectHeader::kVersion1) {
     FML_LOG(INFO) << "Persistent cache header is corrupt: " << file_name;
     return result;
   }
-  if (mapping->GetSize() < sizeof(CacheObjectHeader) + header->key_size) {
+  if (mapping.GetSize() < sizeof(CacheObjectHeader) + header->key_size) {
     FML_LOG(INFO) << "Persistent cache size is corrupt: " << file_name;
     return result;
   }
   if (need_key) {
     result.key = SkData::MakeWithCopy(
-        mapping->GetMapping() + sizeof(CacheObjectHeader), header->key_size);
+        mapping.GetMapping() + sizeof(CacheObjectHeader), header->key_size);
   }
   size_t value_offset = sizeof(CacheObjectHeader) + header->key_size;
-  result.value = SkData::MakeWithCopy(mapping->GetMapping() + value_offset,
-                                      mapping->GetSize() - value_offset);
+  result.value = SkData::MakeWithCopy(mapping.GetMapping() + value_offset,
+                                      mapping.GetSize() - value_offset);
   return result;
 }
 
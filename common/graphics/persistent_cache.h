@@ -165,6 +165,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
                             const std::string& file_name,
                             bool need_key);
 
+  static SkSLCache ParseCacheObject(const fml::Mapping& mapping,
+                                    const std::string& file_name,
+                                    bool need_key);
+
   bool IsValid() const;
 
   explicit PersistentCache(bool read_only = false);
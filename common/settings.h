@@ -158,6 +158,13 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // Record trace events into the in-process `fml::tracing::TraceRecorder`.
+  // The recorded events can be dumped on demand with the
+  // `_flutter.dumpTraceRingBuffer` service extension.
+  bool trace_to_ring_buffer = false;
+  // If not empty, the directory the trace ring buffer is dumped into when a
+  // janky frame is rasterized.
+  std::string trace_ring_buffer_dump_path;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -236,6 +243,11 @@ struct Settings {
   // platforms.
   bool merged_platform_ui_thread = true;
 
+  // If true, the engine applies its own thread priority and CPU affinity
+  // policy to the threads it creates, such as the Dart VM workers. Set by
+  // embedders that do not configure thread priorities themselves.
+  bool use_engine_thread_policy = false;
+
   // Log a warning during shell initialization if Impeller is not enabled.
   bool warn_on_impeller_opt_out = false;
 
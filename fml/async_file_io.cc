@@ -0,0 +1,213 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_io.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+#if FML_OS_LINUX
+#include "flutter/fml/platform/linux/async_file_io_uring.h"
+#endif
+
+namespace fml {
+
+namespace {
+
+class AsyncFileIOThreadPool final : public AsyncFileIO {
+ public:
+  explicit AsyncFileIOThreadPool(size_t worker_count)
+      : loop_(
+            ConcurrentMessageLoop::Create(std::max<size_t>(worker_count, 1))),
+        task_runner_(loop_->GetTaskRunner()) {}
+
+  ~AsyncFileIOThreadPool() override = default;
+
+  // |AsyncFileIO|
+  Backend GetBackend() const override { return Backend::kThreadPool; }
+
+  // |AsyncFileIO|
+  void Submit(std::vector<Operation> operations) override {
+    for (auto& operation : operations) {
+      task_runner_->PostTask([operation = std::move(operation)]() {
+        const int64_t result = internal::PerformFileOperation(operation);
+        if (operation.on_complete) {
+          operation.on_complete(result);
+        }
+      });
+    }
+  }
+
+ private:
+  std::shared_ptr<ConcurrentMessageLoop> loop_;
+  std::shared_ptr<ConcurrentTaskRunner> task_runner_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileIOThreadPool);
+};
+
+}  // namespace
+
+AsyncFileIO::Operation AsyncFileIO::Operation::Read(
+    const UniqueFD& file,
+    uint8_t* buffer,
+    size_t length,
+    int64_t offset,
+    CompletionCallback on_complete) {
+  Operation operation;
+  operation.type = Type::kRead;
+  operation.file = file.get();
+  operation.buffer = buffer;
+  operation.length = length;
+  operation.offset = offset;
+  operation.on_complete = std::move(on_complete);
+  return operation;
+}
+
+AsyncFileIO::Operation AsyncFileIO::Operation::Write(
+    const UniqueFD& file,
+    const uint8_t* buffer,
+    size_t length,
+    int64_t offset,
+    CompletionCallback on_complete) {
+  Operation operation;
+  operation.type = Type::kWrite;
+  operation.file = file.get();
+  // The buffer is only read from.
+  operation.buffer = const_cast<uint8_t*>(buffer);
+  operation.length = length;
+  operation.offset = offset;
+  operation.on_complete = std::move(on_complete);
+  return operation;
+}
+
+AsyncFileIO::Operation AsyncFileIO::Operation::Fsync(
+    const UniqueFD& file,
+    CompletionCallback on_complete) {
+  Operation operation;
+  operation.type = Type::kFsync;
+  operation.file = file.get();
+  operation.on_complete = std::move(on_complete);
+  return operation;
+}
+
+AsyncFileIO::AsyncFileIO() = default;
+
+AsyncFileIO::~AsyncFileIO() = default;
+
+std::unique_ptr<AsyncFileIO> AsyncFileIO::Create(size_t queue_depth) {
+#if FML_OS_LINUX
+  if (auto io_uring = AsyncFileIOUring::Create(queue_depth)) {
+    return io_uring;
+  }
+#endif  // FML_OS_LINUX
+  return CreateWithThreadPool();
+}
+
+std::unique_ptr<AsyncFileIO> AsyncFileIO::CreateWithThreadPool(
+    size_t worker_count) {
+  return std::make_unique<AsyncFileIOThreadPool>(worker_count);
+}
+
+AsyncFileIO& AsyncFileIO::GetShared() {
+  static AsyncFileIO* shared = Create().release();
+  return *shared;
+}
+
+std::vector<std::unique_ptr<Mapping>> AsyncFileIO::ReadFiles(
+    const std::vector<UniqueFD>& files) {
+  TRACE_EVENT0("flutter", "AsyncFileIO::ReadFiles");
+
+  struct FileRead {
+    std::vector<uint8_t> data;
+    std::unique_ptr<FileMapping> file_mapping;
+    size_t filled = 0;
+    bool done = false;
+    bool failed = false;
+  };
+
+  std::vector<FileRead> reads(files.size());
+  for (size_t i = 0; i < files.size(); i++) {
+    auto& read = reads[i];
+    const int64_t size =
+        files[i].is_valid() ? internal::GetFileSize(files[i].get()) : -1;
+    if (size < 0) {
+      read.failed = true;
+      continue;
+    }
+    // Large files are mapped so that they are paged in on demand and do not
+    // take up heap memory.
+    if (static_cast<uint64_t>(size) >= kMinMappedFileSize) {
+      read.file_mapping = std::make_unique<FileMapping>(files[i]);
+      read.failed = !read.file_mapping->IsValid();
+      read.done = true;
+      continue;
+    }
+    read.data.resize(size);
+    read.done = size == 0;
+  }
+
+  // Reads may complete short (for instance if the file was truncated after it
+  // was sized), in which case the remainder is requested in a further batch
+  // until the end of the file is reached.
+  while (true) {
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < reads.size(); i++) {
+      auto& read = reads[i];
+      if (!read.done && !read.failed && read.filled == read.data.size()) {
+        read.done = true;
+      }
+      if (!read.done && !read.failed) {
+        pending.push_back(i);
+      }
+    }
+    if (pending.empty()) {
+      break;
+    }
+
+    CountDownLatch latch(pending.size());
+    std::vector<Operation> operations;
+    operations.reserve(pending.size());
+    for (const auto i : pending) {
+      auto& read = reads[i];
+      operations.emplace_back(Operation::Read(
+          files[i], read.data.data() + read.filled,
+          read.data.size() - read.filled, read.filled,
+          [&read, &latch](int64_t result) {
+            if (result < 0) {
+              read.failed = true;
+            } else if (result == 0) {
+              read.data.resize(read.filled);
+              read.done = true;
+            } else {
+              read.filled += result;
+            }
+            latch.CountDown();
+          }));
+    }
+    Submit(std::move(operations));
+    latch.Wait();
+  }
+
+  std::vector<std::unique_ptr<Mapping>> mappings;
+  mappings.reserve(reads.size());
+  for (auto& read : reads) {
+    if (read.failed) {
+      mappings.emplace_back(nullptr);
+    } else if (read.file_mapping) {
+      mappings.emplace_back(std::move(read.file_mapping));
+    } else {
+      mappings.emplace_back(
+          std::make_unique<DataMapping>(std::move(read.data)));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace fml
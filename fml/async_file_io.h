@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ASYNC_FILE_IO_H_
+#define FLUTTER_FML_ASYNC_FILE_IO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Asynchronous positional file I/O.
+///
+///             Operations are submitted in batches and complete out of order
+///             on an implementation defined thread. On Linux, operations are
+///             submitted to the kernel via an io_uring so that a batch of reads
+///             costs a single system call and does not occupy a thread per
+///             outstanding operation. Elsewhere (and on kernels without
+///             io_uring support) the operations are performed synchronously
+///             on a small pool of worker threads.
+///
+///             The descriptors and buffers referenced by an operation must
+///             remain valid until its completion callback has been invoked.
+///
+class AsyncFileIO {
+ public:
+  static constexpr size_t kDefaultQueueDepth = 128;
+  static constexpr size_t kDefaultWorkerCount = 2;
+  /// The number of files callers of `ReadFiles` should keep open at once.
+  /// Larger sets of files are read in several batches of at most this many
+  /// so that loading them does not exhaust the descriptor limit.
+  static constexpr size_t kMaxOpenFilesPerBatch = 64;
+  /// Files at least this large are memory mapped by `ReadFiles` instead of
+  /// being copied to the heap.
+  static constexpr size_t kMinMappedFileSize = 64 * 1024;
+
+  enum class Backend {
+    kIOUring,
+    kThreadPool,
+  };
+
+  //----------------------------------------------------------------------------
+  /// The number of bytes transferred on success (zero for `kFsync`), or a
+  /// negative value on failure. On POSIX platforms, failures are reported as
+  /// the negated `errno`.
+  ///
+  using CompletionCallback = std::function<void(int64_t result)>;
+
+  struct Operation {
+    enum class Type {
+      kRead,
+      kWrite,
+      kFsync,
+    };
+
+    Type type = Type::kRead;
+    UniqueFD::element_type file = UniqueFD::traits_type::InvalidValue();
+    uint8_t* buffer = nullptr;
+    size_t length = 0;
+    int64_t offset = 0;
+    CompletionCallback on_complete;
+
+    static Operation Read(const UniqueFD& file,
+                          uint8_t* buffer,
+                          size_t length,
+                          int64_t offset,
+                          CompletionCallback on_complete);
+
+    static Operation Write(const UniqueFD& file,
+                           const uint8_t* buffer,
+                           size_t length,
+                           int64_t offset,
+                           CompletionCallback on_complete);
+
+    static Operation Fsync(const UniqueFD& file,
+                           CompletionCallback on_complete);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the most efficient implementation available on this
+  ///             platform and kernel.
+  ///
+  static std::unique_ptr<AsyncFileIO> Create(
+      size_t queue_depth = kDefaultQueueDepth);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an implementation that performs operations on a pool
+  ///             of worker threads. Available on all platforms.
+  ///
+  static std::unique_ptr<AsyncFileIO> CreateWithThreadPool(
+      size_t worker_count = kDefaultWorkerCount);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A lazily created process wide instance shared by the engine
+  ///             subsystems that load many files at once.
+  ///
+  static AsyncFileIO& GetShared();
+
+  virtual ~AsyncFileIO();
+
+  virtual Backend GetBackend() const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits a batch of operations. Operations within a batch may
+  ///             be performed concurrently and in any order. Callbacks may be
+  ///             invoked before this call returns.
+  ///
+  virtual void Submit(std::vector<Operation> operations) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the entire contents of each of the given files, issuing
+  ///             the reads as a batch and blocking until all of them are
+  ///             complete. Files of at least `kMinMappedFileSize` bytes are
+  ///             memory mapped instead of read.
+  ///
+  /// @return     A mapping per file, in order. The mapping of a file that could
+  ///             not be read is null.
+  ///
+  std::vector<std::unique_ptr<Mapping>> ReadFiles(
+      const std::vector<UniqueFD>& files);
+
+ protected:
+  AsyncFileIO();
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+namespace internal {
+
+// Synchronous implementations of the operations used by the thread pool
+// backend. Provided by the platform specific file implementation.
+int64_t PerformFileOperation(const AsyncFileIO::Operation& operation);
+
+// Returns the size of the file or a negative value on failure.
+int64_t GetFileSize(UniqueFD::element_type file);
+
+}  // namespace internal
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ASYNC_FILE_IO_H_
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_io.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// A directory of small files resembling the assets of an app (icons, shaders,
+// JSON), shared by all benchmarks with the same file count.
+class AssetDirectory {
+ public:
+  explicit AssetDirectory(size_t count) {
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<size_t> size(256, 8192);
+    for (size_t i = 0; i < count; i++) {
+      names_.push_back("asset_" + std::to_string(i));
+      std::vector<uint8_t> data(size(generator), static_cast<uint8_t>(i));
+      WriteAtomically(directory_.fd(), names_.back().c_str(),
+                      DataMapping(std::move(data)));
+    }
+  }
+
+  static AssetDirectory& ForCount(size_t count) {
+    static auto* directories =
+        new std::map<size_t, std::unique_ptr<AssetDirectory>>();
+    auto& directory = (*directories)[count];
+    if (!directory) {
+      directory = std::make_unique<AssetDirectory>(count);
+    }
+    return *directory;
+  }
+
+  size_t GetCount() const { return names_.size(); }
+
+  // Opens the files in [begin, end).
+  std::vector<UniqueFD> Open(size_t begin, size_t end) {
+    std::vector<UniqueFD> files;
+    files.reserve(end - begin);
+    for (size_t i = begin; i < end; i++) {
+      files.emplace_back(OpenFileReadOnly(directory_.fd(), names_[i].c_str()));
+    }
+    return files;
+  }
+
+ private:
+  ScopedTemporaryDirectory directory_;
+  std::vector<std::string> names_;
+};
+
+// Touches every page of the mapping as a consumer of the asset would.
+uint64_t Consume(const Mapping& mapping) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < mapping.GetSize(); i += 4096) {
+    sum += mapping.GetMapping()[i];
+  }
+  return sum;
+}
+
+void LoadWithAsyncFileIO(benchmark::State& state, AsyncFileIO& io) {
+  auto& assets = AssetDirectory::ForCount(state.range(0));
+  while (state.KeepRunning()) {
+    uint64_t sum = 0;
+    // Open the files in batches, as the engine does, to stay below the
+    // descriptor limit.
+    for (size_t begin = 0; begin < assets.GetCount();
+         begin += AsyncFileIO::kMaxOpenFilesPerBatch) {
+      const size_t end = std::min(
+          begin + AsyncFileIO::kMaxOpenFilesPerBatch, assets.GetCount());
+      for (const auto& mapping : io.ReadFiles(assets.Open(begin, end))) {
+        if (!mapping) {
+          state.SkipWithError("Could not read an asset.");
+          return;
+        }
+        sum += Consume(*mapping);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+static void BM_LoadAssets_FileMapping(benchmark::State& state) {
+  auto& assets = AssetDirectory::ForCount(state.range(0));
+  while (state.KeepRunning()) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < assets.GetCount(); i++) {
+      FileMapping mapping(assets.Open(i, i + 1).front());
+      if (!mapping.IsValid()) {
+        state.SkipWithError("Could not map an asset.");
+        return;
+      }
+      sum += Consume(mapping);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LoadAssets_AsyncThreadPool(benchmark::State& state) {
+  auto io = AsyncFileIO::CreateWithThreadPool();
+  LoadWithAsyncFileIO(state, *io);
+}
+
+static void BM_LoadAssets_AsyncDefault(benchmark::State& state) {
+  auto io = AsyncFileIO::Create();
+  state.SetLabel(io->GetBackend() == AsyncFileIO::Backend::kIOUring
+                     ? "io_uring"
+                     : "thread_pool");
+  LoadWithAsyncFileIO(state, *io);
+}
+
+BENCHMARK(BM_LoadAssets_FileMapping)->Range(256, 4096);
+BENCHMARK(BM_LoadAssets_AsyncThreadPool)->Range(256, 4096);
+BENCHMARK(BM_LoadAssets_AsyncDefault)->Range(256, 4096);
+
+}  // namespace benchmarking
+}  // namespace fml
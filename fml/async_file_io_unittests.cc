@@ -0,0 +1,244 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_io.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "gtest/gtest.h"
+
+#if FML_OS_LINUX
+#include "flutter/fml/platform/linux/async_file_io_uring.h"
+#endif  // FML_OS_LINUX
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+enum class BackendKind {
+  kThreadPool,
+  kPlatformDefault,
+};
+
+bool WriteFile(const UniqueFD& directory,
+               const std::string& name,
+               const std::string& contents) {
+  return WriteAtomically(directory, name.c_str(), DataMapping(contents));
+}
+
+std::string ToString(const Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+}  // namespace
+
+class AsyncFileIOTest : public ::testing::TestWithParam<BackendKind> {
+ public:
+  std::unique_ptr<AsyncFileIO> CreateFileIO(
+      size_t queue_depth = AsyncFileIO::kDefaultQueueDepth) {
+    switch (GetParam()) {
+      case BackendKind::kThreadPool:
+        return AsyncFileIO::CreateWithThreadPool();
+      case BackendKind::kPlatformDefault:
+        return AsyncFileIO::Create(queue_depth);
+    }
+    return nullptr;
+  }
+};
+
+TEST_P(AsyncFileIOTest, ReadsFiles) {
+  ScopedTemporaryDirectory temp_dir;
+  const std::string large(AsyncFileIO::kMinMappedFileSize, 'x');
+  ASSERT_TRUE(WriteFile(temp_dir.fd(), "a", "hello"));
+  ASSERT_TRUE(OpenFile(temp_dir.fd(), "b", true, FilePermission::kReadWrite)
+                  .is_valid());
+  ASSERT_TRUE(WriteFile(temp_dir.fd(), "c", large));
+
+  std::vector<UniqueFD> files;
+  files.emplace_back(OpenFileReadOnly(temp_dir.fd(), "a"));
+  files.emplace_back(OpenFileReadOnly(temp_dir.fd(), "b"));
+  files.emplace_back(OpenFileReadOnly(temp_dir.fd(), "c"));
+  files.emplace_back(OpenFileReadOnly(temp_dir.fd(), "does_not_exist"));
+
+  auto io = CreateFileIO();
+  auto mappings = io->ReadFiles(files);
+  ASSERT_EQ(mappings.size(), 4u);
+  ASSERT_NE(mappings[0], nullptr);
+  EXPECT_EQ(ToString(*mappings[0]), "hello");
+  EXPECT_FALSE(mappings[0]->IsDontNeedSafe());
+  ASSERT_NE(mappings[1], nullptr);
+  EXPECT_EQ(mappings[1]->GetSize(), 0u);
+  ASSERT_NE(mappings[2], nullptr);
+  EXPECT_EQ(ToString(*mappings[2]), large);
+  // Large files are memory mapped rather than copied to the heap.
+  EXPECT_TRUE(mappings[2]->IsDontNeedSafe());
+  EXPECT_EQ(mappings[3], nullptr);
+}
+
+TEST_P(AsyncFileIOTest, ReadsMoreFilesThanQueueDepth) {
+  ScopedTemporaryDirectory temp_dir;
+  constexpr size_t kFileCount = 100;
+  std::vector<UniqueFD> files;
+  for (size_t i = 0; i < kFileCount; i++) {
+    const auto name = std::to_string(i);
+    ASSERT_TRUE(WriteFile(temp_dir.fd(), name, name));
+    files.emplace_back(OpenFileReadOnly(temp_dir.fd(), name.c_str()));
+  }
+
+  auto io = CreateFileIO(4);
+  auto mappings = io->ReadFiles(files);
+  ASSERT_EQ(mappings.size(), kFileCount);
+  for (size_t i = 0; i < kFileCount; i++) {
+    ASSERT_NE(mappings[i], nullptr);
+    EXPECT_EQ(ToString(*mappings[i]), std::to_string(i));
+  }
+}
+
+TEST_P(AsyncFileIOTest, WritesSyncsAndReads) {
+  ScopedTemporaryDirectory temp_dir;
+  auto file = OpenFile(temp_dir.fd(), "file", true,
+                       FilePermission::kReadWrite);
+  ASSERT_TRUE(file.is_valid());
+
+  auto io = CreateFileIO();
+  const std::string contents = "0123456789";
+  int64_t write_results[2] = {};
+  {
+    CountDownLatch latch(2);
+    std::vector<AsyncFileIO::Operation> operations;
+    operations.emplace_back(AsyncFileIO::Operation::Write(
+        file, reinterpret_cast<const uint8_t*>(contents.data()), 5, 0,
+        [&](int64_t result) {
+          write_results[0] = result;
+          latch.CountDown();
+        }));
+    operations.emplace_back(AsyncFileIO::Operation::Write(
+        file, reinterpret_cast<const uint8_t*>(contents.data()) + 5, 5, 5,
+        [&](int64_t result) {
+          write_results[1] = result;
+          latch.CountDown();
+        }));
+    io->Submit(std::move(operations));
+    latch.Wait();
+  }
+  EXPECT_EQ(write_results[0], 5);
+  EXPECT_EQ(write_results[1], 5);
+
+  int64_t fsync_result = -1;
+  {
+    CountDownLatch latch(1);
+    std::vector<AsyncFileIO::Operation> operations;
+    operations.emplace_back(
+        AsyncFileIO::Operation::Fsync(file, [&](int64_t result) {
+          fsync_result = result;
+          latch.CountDown();
+        }));
+    io->Submit(std::move(operations));
+    latch.Wait();
+  }
+  EXPECT_EQ(fsync_result, 0);
+
+  uint8_t buffer[16] = {};
+  int64_t read_result = -1;
+  {
+    CountDownLatch latch(1);
+    std::vector<AsyncFileIO::Operation> operations;
+    operations.emplace_back(AsyncFileIO::Operation::Read(
+        file, buffer, sizeof(buffer), 2, [&](int64_t result) {
+          read_result = result;
+          latch.CountDown();
+        }));
+    io->Submit(std::move(operations));
+    latch.Wait();
+  }
+  ASSERT_EQ(read_result, 8);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(buffer), 8),
+            "23456789");
+}
+
+TEST_P(AsyncFileIOTest, ReportsErrors) {
+  ScopedTemporaryDirectory temp_dir;
+  // Reading from a directory fails.
+  auto io = CreateFileIO();
+  uint8_t buffer[16];
+  int64_t read_result = 0;
+  CountDownLatch latch(1);
+  std::vector<AsyncFileIO::Operation> operations;
+  operations.emplace_back(AsyncFileIO::Operation::Read(
+      temp_dir.fd(), buffer, sizeof(buffer), 0, [&](int64_t result) {
+        read_result = result;
+        latch.CountDown();
+      }));
+  io->Submit(std::move(operations));
+  latch.Wait();
+  EXPECT_LT(read_result, 0);
+}
+
+TEST_P(AsyncFileIOTest, SubmitsFromCompletionCallbacks) {
+  ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(WriteFile(temp_dir.fd(), "file", "0123456789"));
+  auto file = OpenFileReadOnly(temp_dir.fd(), "file");
+  ASSERT_TRUE(file.is_valid());
+
+  // Each completed read submits two more until |kReadCount| reads were
+  // submitted, which fills up the small queue from within the callbacks.
+  constexpr size_t kReadCount = 64;
+  auto io = CreateFileIO(2);
+  std::vector<uint8_t> buffers(kReadCount);
+  std::vector<int64_t> results(kReadCount, -1);
+  std::atomic_size_t submitted = 0;
+  CountDownLatch latch(kReadCount);
+  std::function<std::vector<AsyncFileIO::Operation>(size_t)> make_reads =
+      [&](size_t count) {
+        std::vector<AsyncFileIO::Operation> operations;
+        for (size_t i = 0; i < count; i++) {
+          const size_t index = submitted++;
+          if (index >= kReadCount) {
+            break;
+          }
+          operations.emplace_back(AsyncFileIO::Operation::Read(
+              file, &buffers[index], 1, index % 10,
+              [&, index](int64_t result) {
+                results[index] = result;
+                io->Submit(make_reads(2));
+                latch.CountDown();
+              }));
+        }
+        return operations;
+      };
+  io->Submit(make_reads(4));
+  latch.Wait();
+
+  for (size_t i = 0; i < kReadCount; i++) {
+    ASSERT_EQ(results[i], 1);
+    EXPECT_EQ(buffers[i], '0' + i % 10);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AsyncFileIOBackends,
+                         AsyncFileIOTest,
+                         ::testing::Values(BackendKind::kThreadPool,
+                                           BackendKind::kPlatformDefault));
+
+#if FML_OS_LINUX
+TEST(AsyncFileIOUringTest, IsPreferredWhenAvailable) {
+  const bool available = AsyncFileIOUring::Create(8) != nullptr;
+  auto io = AsyncFileIO::Create();
+  ASSERT_NE(io, nullptr);
+  EXPECT_EQ(io->GetBackend() == AsyncFileIO::Backend::kIOUring, available);
+}
+#endif  // FML_OS_LINUX
+
+}  // namespace testing
+}  // namespace fml
@@ -42,7 +42,7 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(fml::UniqueClosure task) {
   if (!task) {
     return;
   }
@@ -59,7 +59,7 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  tasks_.push(task);
+  tasks_.push(std::move(task));
 
   // Unlock the mutex before notifying the condition variable because that mutex
   // has to be acquired on the other thread anyway. Waiting in this scope till
@@ -78,11 +78,11 @@ void ConcurrentMessageLoop::WorkerMain() {
 
     // Shutdown cannot be read with the task mutex unlocked.
     bool shutdown_now = shutdown_;
-    fml::closure task;
+    fml::UniqueClosure task;
     std::vector<fml::closure> thread_tasks;
 
     if (!tasks_.empty()) {
-      task = tasks_.front();
+      task = std::move(tasks_.front());
       tasks_.pop();
     }
 
@@ -112,7 +112,7 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
-void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
+void ConcurrentMessageLoop::ExecuteTask(const fml::UniqueClosure& task) {
   task();
 }
 
@@ -153,13 +153,13 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
-void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+void ConcurrentTaskRunner::PostTask(fml::UniqueClosure task) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(std::move(task));
     return;
   }
 
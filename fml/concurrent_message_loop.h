@@ -13,6 +13,7 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
@@ -38,7 +39,7 @@ class ConcurrentMessageLoop
 
  protected:
   explicit ConcurrentMessageLoop(size_t worker_count);
-  virtual void ExecuteTask(const fml::closure& task);
+  virtual void ExecuteTask(const fml::UniqueClosure& task);
 
  private:
   friend ConcurrentTaskRunner;
@@ -47,14 +48,14 @@ class ConcurrentMessageLoop
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
+  std::queue<fml::UniqueClosure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
 
   void WorkerMain();
 
-  void PostTask(const fml::closure& task);
+  void PostTask(fml::UniqueClosure task);
 
   bool HasThreadTasksLocked() const;
 
@@ -69,7 +70,7 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::UniqueClosure task) override;
 
  private:
   friend ConcurrentMessageLoop;
@@ -11,6 +11,8 @@
 
 #ifdef FML_OS_ANDROID
 #include "flutter/fml/platform/android/cpu_affinity.h"
+#elif defined(FML_OS_LINUX)
+#include "flutter/fml/platform/linux/cpu_affinity.h"
 #endif  // FML_OS_ANDROID
 
 namespace fml {
@@ -26,6 +28,8 @@ std::optional<size_t> EfficiencyCoreCount() {
 bool RequestAffinity(CpuAffinity affinity) {
 #ifdef FML_OS_ANDROID
   return AndroidRequestAffinity(affinity);
+#elif defined(FML_OS_LINUX)
+  return LinuxRequestAffinity(affinity);
 #else
   return true;
 #endif
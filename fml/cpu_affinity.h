@@ -42,7 +42,7 @@ std::optional<size_t> EfficiencyCoreCount();
 /// @brief Request the given affinity for the current thread.
 ///
 ///        Returns true if successfull, or if it was a no-op. This function is
-///        only supported on Android devices.
+///        only supported on Android and Linux devices.
 ///
 ///        Affinity requests are based on documented CPU speed. This speed data
 ///        is parsed from cpuinfo_max_freq files, see also:
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_point.h"
+
+#if FML_OS_LINUX
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+#endif  // FML_OS_LINUX
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// Keeps every CPU busy with threads of the given priority while alive.
+class BackgroundLoad {
+ public:
+  BackgroundLoad(const Thread::ThreadConfigSetter& setter,
+                 Thread::ThreadPriority priority) {
+    const size_t count = std::max(std::thread::hardware_concurrency(), 1u);
+    for (size_t i = 0; i < count; i++) {
+      threads_.emplace_back([this, setter, priority]() {
+        setter(Thread::ThreadConfig("load", priority));
+        uint64_t value = 1;
+        while (!done_.load(std::memory_order_relaxed)) {
+          value = value * 6364136223846793005u + 1442695040888963407u;
+        }
+        benchmark::DoNotOptimize(value);
+      });
+    }
+  }
+
+  ~BackgroundLoad() {
+    done_ = true;
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+ private:
+  std::atomic_bool done_ = false;
+  std::vector<std::thread> threads_;
+};
+
+// A fixed amount of work standing in for rasterizing a frame.
+uint64_t RenderFrame() {
+  uint64_t value = 1;
+  for (size_t i = 0; i < 200000; i++) {
+    value = value * 6364136223846793005u + 1442695040888963407u;
+  }
+  return value;
+}
+
+// Measures the time to render frames on a raster thread while the device is
+// busy with background work. Reports the standard deviation and the 99th
+// percentile of the frame times in microseconds.
+void MeasureFrameTimesUnderLoad(benchmark::State& state,
+                                const Thread::ThreadConfigSetter& setter) {
+  BackgroundLoad load(setter, Thread::ThreadPriority::kBackground);
+  Thread raster(setter, Thread::ThreadConfig(
+                            "raster", Thread::ThreadPriority::kRaster));
+
+  std::vector<double> frame_times;
+  for (auto _ : state) {
+    AutoResetWaitableEvent latch;
+    TimeDelta frame_time;
+    raster.GetTaskRunner()->PostTask([&latch, &frame_time]() {
+      const auto start = TimePoint::Now();
+      benchmark::DoNotOptimize(RenderFrame());
+      frame_time = TimePoint::Now() - start;
+      latch.Signal();
+    });
+    latch.Wait();
+    state.SetIterationTime(frame_time.ToSecondsF());
+    frame_times.push_back(frame_time.ToMicrosecondsF());
+  }
+
+  if (frame_times.empty()) {
+    return;
+  }
+  double mean = 0;
+  for (const auto time : frame_times) {
+    mean += time;
+  }
+  mean /= frame_times.size();
+  double variance = 0;
+  for (const auto time : frame_times) {
+    variance += (time - mean) * (time - mean);
+  }
+  variance /= frame_times.size();
+  std::sort(frame_times.begin(), frame_times.end());
+  state.counters["StdDevUs"] = std::sqrt(variance);
+  state.counters["P99Us"] = frame_times[frame_times.size() * 99 / 100];
+}
+
+}  // namespace
+
+static void BM_FrameTimeUnderLoad_NameOnly(benchmark::State& state) {
+  MeasureFrameTimesUnderLoad(state, Thread::SetCurrentThreadName);
+}
+
+static void BM_FrameTimeUnderLoad_PlatformPriority(benchmark::State& state) {
+#if FML_OS_LINUX
+  MeasureFrameTimesUnderLoad(state, LinuxThreadConfigSetter);
+#else
+  state.SkipWithError("No platform thread config setter.");
+#endif  // FML_OS_LINUX
+}
+
+BENCHMARK(BM_FrameTimeUnderLoad_NameOnly)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameTimeUnderLoad_PlatformPriority)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
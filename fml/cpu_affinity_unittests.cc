@@ -4,11 +4,22 @@
 
 #include "cpu_affinity.h"
 
+#include "fml/build_config.h"
 #include "fml/file.h"
 #include "fml/mapping.h"
 #include "gtest/gtest.h"
 #include "logging.h"
 
+#if FML_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+
+#include <string>
+#include <vector>
+
+#include "fml/platform/linux/cpu_affinity.h"
+#endif  // FML_OS_LINUX
+
 namespace fml {
 namespace testing {
 
@@ -94,5 +105,178 @@ TEST(CpuAffinity, MissingFileParsing) {
   ASSERT_FALSE(result.has_value());
 }
 
+#if FML_OS_LINUX
+namespace {
+
+CpuTopologyEntry Cpu(size_t index,
+                     size_t core,
+                     size_t cache_domain,
+                     int64_t speed) {
+  return {.index = index,
+          .core = core,
+          .cache_domain = cache_domain,
+          .speed = speed};
+}
+
+bool WriteSysfsFile(const fml::UniqueFD& base_dir,
+                    const std::string& path,
+                    const std::string& contents) {
+  auto slash = path.rfind('/');
+  std::vector<std::string> components;
+  size_t start = 0;
+  while (start < slash) {
+    auto end = path.find('/', start);
+    components.push_back(path.substr(start, end - start));
+    start = end + 1;
+  }
+  auto dir = fml::CreateDirectory(base_dir, components,
+                                  fml::FilePermission::kReadWrite);
+  return dir.is_valid() &&
+         fml::WriteAtomically(dir, path.substr(slash + 1).c_str(),
+                              fml::DataMapping(contents + "\n"));
+}
+
+}  // namespace
+
+TEST(CpuAffinity, ParseCpuList) {
+  EXPECT_EQ(ParseCpuList("0"), std::vector<size_t>({0}));
+  EXPECT_EQ(ParseCpuList("0-3"), std::vector<size_t>({0, 1, 2, 3}));
+  EXPECT_EQ(ParseCpuList("0,4\n"), std::vector<size_t>({0, 4}));
+  EXPECT_EQ(ParseCpuList("0-1,8-9"), std::vector<size_t>({0, 1, 8, 9}));
+  EXPECT_TRUE(ParseCpuList("").empty());
+  EXPECT_TRUE(ParseCpuList("a").empty());
+  EXPECT_TRUE(ParseCpuList("3-1").empty());
+  EXPECT_TRUE(ParseCpuList("0;1").empty());
+}
+
+TEST(CpuAffinity, TopologyUsesOneThreadOfEachCore) {
+  // Four cores with two threads each, sharing one cache.
+  CpuTopology topology({Cpu(0, 0, 0, 1), Cpu(1, 1, 0, 1), Cpu(2, 2, 0, 1),
+                        Cpu(3, 3, 0, 1), Cpu(4, 0, 0, 1), Cpu(5, 1, 0, 1),
+                        Cpu(6, 2, 0, 1), Cpu(7, 3, 0, 1)});
+
+  EXPECT_EQ(topology.GetFrameIndices(), std::vector<size_t>({0, 1, 2, 3}));
+  // Every other CPU shares a core with the frame threads.
+  EXPECT_TRUE(topology.GetBackgroundIndices().empty());
+}
+
+TEST(CpuAffinity, TopologyPrefersFastestCacheDomain) {
+  // Two clusters of two cores, with the faster cluster second.
+  CpuTopology topology({Cpu(0, 0, 0, 1), Cpu(1, 1, 0, 1), Cpu(2, 2, 2, 2),
+                        Cpu(3, 3, 2, 2)});
+
+  EXPECT_EQ(topology.GetFrameIndices(), std::vector<size_t>({2, 3}));
+  EXPECT_EQ(topology.GetBackgroundIndices(), std::vector<size_t>({0, 1}));
+}
+
+TEST(CpuAffinity, TopologyPrefersLargestOfEqualCacheDomains) {
+  CpuTopology topology({Cpu(0, 0, 0, 1), Cpu(1, 1, 0, 1), Cpu(2, 2, 2, 1),
+                        Cpu(3, 3, 2, 1), Cpu(4, 4, 2, 1)});
+
+  EXPECT_EQ(topology.GetFrameIndices(), std::vector<size_t>({2, 3, 4}));
+  EXPECT_EQ(topology.GetBackgroundIndices(), std::vector<size_t>({0, 1}));
+}
+
+TEST(CpuAffinity, TopologyLeavesEfficiencyCoresToBackgroundThreads) {
+  // Four efficiency and four other cores sharing one cache.
+  CpuTopology topology({Cpu(0, 0, 0, 1), Cpu(1, 1, 0, 1), Cpu(2, 2, 0, 1),
+                        Cpu(3, 3, 0, 1), Cpu(4, 4, 0, 2), Cpu(5, 5, 0, 2),
+                        Cpu(6, 6, 0, 2), Cpu(7, 7, 0, 3)});
+
+  EXPECT_EQ(topology.GetFrameIndices(), std::vector<size_t>({4, 5, 6, 7}));
+  EXPECT_EQ(topology.GetBackgroundIndices(),
+            std::vector<size_t>({0, 1, 2, 3}));
+}
+
+TEST(CpuAffinity, TopologyWithoutEnoughCoresHasNoPreference) {
+  // A single core with two threads.
+  CpuTopology smt({Cpu(0, 0, 0, 1), Cpu(1, 0, 0, 1)});
+  EXPECT_TRUE(smt.GetFrameIndices().empty());
+  EXPECT_TRUE(smt.GetBackgroundIndices().empty());
+
+  // A single fast core.
+  CpuTopology big_little({Cpu(0, 0, 0, 1), Cpu(1, 1, 0, 1), Cpu(2, 2, 0, 2)});
+  EXPECT_TRUE(big_little.GetFrameIndices().empty());
+  EXPECT_TRUE(big_little.GetBackgroundIndices().empty());
+
+  CpuTopology empty({});
+  EXPECT_TRUE(empty.GetFrameIndices().empty());
+  EXPECT_TRUE(empty.GetBackgroundIndices().empty());
+}
+
+TEST(CpuAffinity, TopologyReadsSysfs) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+
+  // Two cache domains of two cores with two threads each, where the second
+  // domain is faster.
+  for (size_t cpu = 0; cpu < 8; cpu++) {
+    const std::string path = "cpu" + std::to_string(cpu);
+    const size_t core = cpu % 4;
+    const bool fast = core >= 2;
+    const std::string siblings =
+        std::to_string(core) + "," + std::to_string(core + 4);
+    const std::string cache = fast ? "2-3,6-7" : "0-1,4-5";
+    ASSERT_TRUE(WriteSysfsFile(base_dir.fd(),
+                               path + "/cpufreq/cpuinfo_max_freq",
+                               fast ? "2000000" : "1000000"));
+    ASSERT_TRUE(WriteSysfsFile(
+        base_dir.fd(), path + "/topology/thread_siblings_list", siblings));
+    ASSERT_TRUE(
+        WriteSysfsFile(base_dir.fd(), path + "/cache/index0/level", "1"));
+    ASSERT_TRUE(WriteSysfsFile(
+        base_dir.fd(), path + "/cache/index0/shared_cpu_list", siblings));
+    ASSERT_TRUE(
+        WriteSysfsFile(base_dir.fd(), path + "/cache/index1/level", "3"));
+    ASSERT_TRUE(WriteSysfsFile(
+        base_dir.fd(), path + "/cache/index1/shared_cpu_list", cache));
+  }
+
+  auto topology =
+      CpuTopology::Read(base_dir.path(), {0, 1, 2, 3, 4, 5, 6, 7});
+  EXPECT_EQ(topology.GetFrameIndices(), std::vector<size_t>({2, 3}));
+  EXPECT_EQ(topology.GetBackgroundIndices(),
+            std::vector<size_t>({0, 1, 4, 5}));
+
+  // Without topology, each CPU is a core of its own sharing one cache.
+  auto flat = CpuTopology::Read(base_dir.path() + "/missing", {0, 1});
+  EXPECT_EQ(flat.GetFrameIndices(), std::vector<size_t>({0, 1}));
+  EXPECT_TRUE(flat.GetBackgroundIndices().empty());
+}
+
+TEST(CpuAffinity, LinuxBackgroundPriorityIsReversible) {
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(affinity), &affinity), 0);
+  const int niceness = ::getpriority(PRIO_PROCESS, 0);
+  const int policy = sched_getscheduler(0);
+
+  LinuxSetCurrentThreadPriority(Thread::ThreadPriority::kBackground);
+
+  // Background threads are batch scheduled, and everything can be undone
+  // without privileges.
+  EXPECT_EQ(sched_getscheduler(0), SCHED_BATCH);
+  sched_param param = {};
+  EXPECT_EQ(sched_setscheduler(0, policy, &param), 0);
+  EXPECT_EQ(::setpriority(PRIO_PROCESS, 0, niceness), 0);
+  EXPECT_EQ(sched_setaffinity(0, sizeof(affinity), &affinity), 0);
+}
+
+TEST(CpuAffinity, LinuxFramePriorityUndoesBackgroundPolicy) {
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(affinity), &affinity), 0);
+  const int niceness = ::getpriority(PRIO_PROCESS, 0);
+
+  // A thread created by a background thread inherits its policy.
+  LinuxSetCurrentThreadPriority(Thread::ThreadPriority::kBackground);
+  LinuxSetCurrentThreadPriority(Thread::ThreadPriority::kRaster);
+  EXPECT_EQ(sched_getscheduler(0), SCHED_OTHER);
+
+  ::setpriority(PRIO_PROCESS, 0, niceness);
+  sched_setaffinity(0, sizeof(affinity), &affinity);
+}
+#endif  // FML_OS_LINUX
+
 }  // namespace testing
 }  // namespace fml
@@ -5,26 +5,34 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
+#include <deque>
+#include <functional>
 #include <queue>
 
-#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::UniqueClosure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::UniqueClosure& GetTask() const;
+
+  /// Moves the closure out of this task, leaving it empty.
+  fml::UniqueClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
@@ -34,14 +42,24 @@ class DelayedTask {
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::UniqueClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTask);
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A min-heap of `DelayedTask`s ordered by target time and then by
+/// registration order. Since tasks are move-only, the top task is removed via
+/// `TakeTop` rather than being copied out before a `pop`.
+class DelayedTaskQueue
+    : public std::priority_queue<DelayedTask,
+                                 std::deque<DelayedTask>,
+                                 std::greater<DelayedTask>> {
+ public:
+  /// Removes the top task from the heap and returns it.
+  DelayedTask TakeTop();
+};
 
 }  // namespace fml
 
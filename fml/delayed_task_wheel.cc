@@ -0,0 +1,274 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/delayed_task_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+int HighestSetBit(uint64_t value) {
+  FML_DCHECK(value != 0);
+  return 63 - std::countl_zero(value);
+}
+
+int LowestSetBit(uint64_t value) {
+  FML_DCHECK(value != 0);
+  return std::countr_zero(value);
+}
+
+}  // namespace
+
+DelayedTaskWheel::DelayedTaskWheel() = default;
+
+DelayedTaskWheel::~DelayedTaskWheel() = default;
+
+uint64_t DelayedTaskWheel::TickForTime(fml::TimePoint time) {
+  // Flip the sign bit so that the ordering of signed nanosecond values is
+  // preserved in the unsigned domain.
+  const uint64_t nanos =
+      static_cast<uint64_t>(time.ToEpochDelta().ToNanoseconds()) ^
+      (uint64_t{1} << 63);
+  return nanos >> kTickShift;
+}
+
+void DelayedTaskWheel::Push(DelayedTask task) {
+  size_++;
+  if (!use_wheel_) {
+    due_.push(std::move(task));
+    if (size_ > kMaxHeapSize) {
+      StartUsingWheel();
+    }
+    return;
+  }
+
+  const bool is_early = TickForTime(task.GetTargetTime()) < current_tick_;
+  Insert(std::move(task));
+  if (is_early) {
+    early_push_count_++;
+    MaybeMoveAnchorBack();
+  }
+}
+
+size_t DelayedTaskWheel::ChangedLevel(uint64_t a, uint64_t b) {
+  FML_DCHECK(a != b);
+  return std::min<size_t>(HighestSetBit(a ^ b) / kSlotBits, kLevels);
+}
+
+void DelayedTaskWheel::StartUsingWheel() {
+  FML_DCHECK(!use_wheel_ && !due_.empty());
+  std::vector<DelayedTask> tasks;
+  tasks.reserve(due_.size());
+  while (!due_.empty()) {
+    tasks.push_back(due_.TakeTop());
+  }
+  // The tasks were taken in order, anchor the wheel on the earliest one.
+  current_tick_ = TickForTime(tasks.front().GetTargetTime());
+  early_push_count_ = 0;
+  use_wheel_ = true;
+  for (auto& task : tasks) {
+    Insert(std::move(task));
+  }
+}
+
+void DelayedTaskWheel::StopUsingWheel() {
+  FML_DCHECK(use_wheel_);
+  std::vector<DelayedTask> tasks;
+  TakeLevels(kLevels, tasks);
+  for (auto& task : overflow_) {
+    tasks.push_back(std::move(task));
+  }
+  overflow_.clear();
+  for (auto& task : tasks) {
+    due_.push(std::move(task));
+  }
+  use_wheel_ = false;
+}
+
+void DelayedTaskWheel::TakeLevels(size_t level_count,
+                                  std::vector<DelayedTask>& tasks) {
+  for (size_t level = 0; level < level_count; level++) {
+    auto& wheel_level = levels_[level];
+    while (wheel_level.occupied != 0) {
+      const size_t slot = LowestSetBit(wheel_level.occupied);
+      for (auto& task : wheel_level.slots[slot]) {
+        tasks.push_back(std::move(task));
+      }
+      wheel_level.slots[slot].clear();
+      wheel_level.occupied &= ~(uint64_t{1} << slot);
+    }
+    wheel_level.count = 0;
+  }
+}
+
+void DelayedTaskWheel::MaybeMoveAnchorBack() {
+  const uint64_t tick = TickForTime(due_.top().GetTargetTime());
+  if (tick >= current_tick_) {
+    return;
+  }
+  const size_t changed_level = ChangedLevel(tick, current_tick_);
+  size_t moved_count = due_.size();
+  for (size_t level = 0; level < changed_level; level++) {
+    moved_count += levels_[level].count;
+  }
+  // The early tasks themselves are among the moved ones, so each of them
+  // pays for moving at most one other task.
+  if (early_push_count_ * 2 < moved_count) {
+    return;
+  }
+  MoveAnchorBack(tick, changed_level);
+}
+
+void DelayedTaskWheel::MoveAnchorBack(uint64_t tick, size_t changed_level) {
+  FML_DCHECK(tick < current_tick_);
+  // A task in a level at or above the highest group of slot bits in which the
+  // anchors differ shares all bits above its level with both anchors, so its
+  // slot stays the same. Tasks in lower levels and due tasks may now be after
+  // the anchor and have to be placed again. Tasks in the overflow list stay
+  // out of range of the wheel.
+  std::vector<DelayedTask> tasks;
+  TakeLevels(changed_level, tasks);
+  while (!due_.empty()) {
+    tasks.push_back(due_.TakeTop());
+  }
+  current_tick_ = tick;
+  early_push_count_ = 0;
+  for (auto& task : tasks) {
+    Insert(std::move(task));
+  }
+}
+
+void DelayedTaskWheel::Insert(DelayedTask task) {
+  const uint64_t tick = TickForTime(task.GetTargetTime());
+  if (tick <= current_tick_) {
+    due_.push(std::move(task));
+    return;
+  }
+
+  // The level is determined by the most significant group of slot bits in
+  // which the task tick differs from the current tick.
+  const size_t level = ChangedLevel(tick, current_tick_);
+  if (level >= kLevels) {
+    overflow_.emplace_back(std::move(task));
+    return;
+  }
+
+  const size_t slot = (tick >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+  levels_[level].slots[slot].emplace_back(std::move(task));
+  levels_[level].occupied |= uint64_t{1} << slot;
+  levels_[level].count++;
+}
+
+const DelayedTask& DelayedTaskWheel::Top() const {
+  FML_DCHECK(!due_.empty());
+  return due_.top();
+}
+
+DelayedTask DelayedTaskWheel::TakeTop() {
+  FML_DCHECK(!due_.empty());
+  DelayedTask task = due_.TakeTop();
+  size_--;
+  if (!use_wheel_) {
+    return task;
+  }
+  if (size_ <= kMinWheelSize) {
+    StopUsingWheel();
+  } else if (due_.empty()) {
+    AdvanceToNextTick();
+  }
+  return task;
+}
+
+void DelayedTaskWheel::AdvanceToNextTick() {
+  while (due_.empty()) {
+    bool found = false;
+    for (size_t level = 0; level < kLevels; level++) {
+      auto& wheel_level = levels_[level];
+      if (wheel_level.occupied == 0) {
+        continue;
+      }
+
+      // All occupied slots in a level are after the current tick. Move the
+      // current tick to the start of the earliest one and redistribute its
+      // tasks into the finer levels below (or into the due heap).
+      const size_t slot = LowestSetBit(wheel_level.occupied);
+      const size_t shift = level * kSlotBits;
+      const size_t level_end = shift + kSlotBits;
+      const uint64_t upper =
+          level_end >= 64 ? 0 : (current_tick_ >> level_end) << level_end;
+      current_tick_ = upper | (static_cast<uint64_t>(slot) << shift);
+      early_push_count_ = 0;
+
+      Slot tasks;
+      std::swap(tasks, wheel_level.slots[slot]);
+      wheel_level.occupied &= ~(uint64_t{1} << slot);
+      wheel_level.count -= tasks.size();
+      for (auto& task : tasks) {
+        Insert(std::move(task));
+      }
+      found = true;
+      break;
+    }
+
+    if (found) {
+      continue;
+    }
+
+    // The wheel is exhausted, all remaining tasks are in the overflow list.
+    FML_DCHECK(!overflow_.empty());
+    uint64_t earliest = std::numeric_limits<uint64_t>::max();
+    for (const auto& task : overflow_) {
+      earliest = std::min(earliest, TickForTime(task.GetTargetTime()));
+    }
+    current_tick_ = earliest;
+    early_push_count_ = 0;
+    std::vector<DelayedTask> tasks;
+    std::swap(tasks, overflow_);
+    for (auto& task : tasks) {
+      Insert(std::move(task));
+    }
+  }
+}
+
+size_t DelayedTaskWheel::Size() const {
+  return size_;
+}
+
+bool DelayedTaskWheel::IsEmpty() const {
+  return size_ == 0;
+}
+
+size_t DelayedTaskWheel::GetDueTaskCountForTest() const {
+  return due_.size();
+}
+
+bool DelayedTaskWheel::IsUsingWheelForTest() const {
+  return use_wheel_;
+}
+
+void DelayedTaskWheel::Clear() {
+  due_ = {};
+  for (auto& level : levels_) {
+    for (auto& slot : level.slots) {
+      slot.clear();
+    }
+    level.occupied = 0;
+    level.count = 0;
+  }
+  overflow_.clear();
+  early_push_count_ = 0;
+  size_ = 0;
+  use_wheel_ = false;
+}
+
+}  // namespace fml
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_DELAYED_TASK_WHEEL_H_
+#define FLUTTER_FML_DELAYED_TASK_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/delayed_task.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A hierarchical timer wheel of `DelayedTask`s.
+///
+///             This is a drop-in replacement for the `DelayedTaskQueue` heap
+///             used by `TaskSource`. Tasks are bucketed by their target time
+///             into ticks of `kTickDuration`. Tasks that are due in the
+///             current tick (or are already overdue) are kept in a small heap
+///             so that they are handed out in exactly the same order as the
+///             `DelayedTaskQueue` would: by target time and then by
+///             registration order. Tasks in the future are appended to a slot
+///             of the wheel in O(1) and only sorted once their tick comes up.
+///
+///             The wheel has `kLevels` levels of `kSlotsPerLevel` slots each.
+///             Each level covers `kSlotsPerLevel` times the range of the one
+///             below it. Tasks further in the future than the outermost level
+///             can represent are kept in an overflow list.
+///
+///             Slots are placed relative to the tick of the earliest task. A
+///             task that is earlier than that tick, such as one posted to run
+///             right away while timers are pending, is pushed onto the heap of
+///             due tasks. Once enough such tasks were pushed to pay for it,
+///             the anchor is moved back to the earliest task so that later
+///             tasks go into the wheel again instead of piling up in the heap.
+///             Pushing a task therefore takes constant time for future tasks
+///             and logarithmic time in the number of due tasks otherwise.
+///
+///             The heap is faster than the wheel for few tasks. Up to
+///             `kMaxHeapSize` tasks are only kept in the heap. The wheel is
+///             used once there are more, until the number of tasks drops to
+///             `kMinWheelSize`.
+///
+class DelayedTaskWheel {
+ public:
+  /// The number of bits of a nanosecond target time that are ignored when
+  /// placing a task in the wheel. A tick is 2^20 nanoseconds (~1.05ms).
+  static constexpr int kTickShift = 20;
+  static constexpr int kSlotBits = 6;
+  static constexpr size_t kSlotsPerLevel = 1u << kSlotBits;
+  static constexpr size_t kLevels = 4;
+  /// The crossover measured by delayed_task_wheel_benchmark.
+  static constexpr size_t kMaxHeapSize = 512;
+  static constexpr size_t kMinWheelSize = kMaxHeapSize / 4;
+
+  DelayedTaskWheel();
+
+  ~DelayedTaskWheel();
+
+  /// Adds a task to the wheel.
+  void Push(DelayedTask task);
+
+  /// Returns the task with the earliest target time (and the lowest
+  /// registration order among tasks with the same time). The wheel must not be
+  /// empty.
+  const DelayedTask& Top() const;
+
+  /// Removes the task returned by `Top` from the wheel and returns it.
+  DelayedTask TakeTop();
+
+  size_t Size() const;
+
+  bool IsEmpty() const;
+
+  /// Drops all pending tasks.
+  void Clear();
+
+  /// The number of tasks in the heap of due tasks.
+  size_t GetDueTaskCountForTest() const;
+
+  bool IsUsingWheelForTest() const;
+
+ private:
+  using Slot = std::vector<DelayedTask>;
+
+  struct Level {
+    std::array<Slot, kSlotsPerLevel> slots;
+    // Bit N is set iff |slots[N]| is non-empty.
+    uint64_t occupied = 0;
+    // The number of tasks in all slots.
+    size_t count = 0;
+  };
+
+  // Tasks whose tick is at or before |current_tick_|, or all tasks while the
+  // wheel is not in use. Whenever the wheel is not empty, this heap is not
+  // empty either, so its top is the top of the wheel.
+  DelayedTaskQueue due_;
+  std::array<Level, kLevels> levels_;
+  std::vector<DelayedTask> overflow_;
+  uint64_t current_tick_ = 0;
+  // The number of tasks pushed before |current_tick_| since it was last set.
+  size_t early_push_count_ = 0;
+  size_t size_ = 0;
+  bool use_wheel_ = false;
+
+  static uint64_t TickForTime(fml::TimePoint time);
+
+  // Places a task relative to |current_tick_|, which must not be after the
+  // tick of the earliest task.
+  void Insert(DelayedTask task);
+
+  // Moves |current_tick_| back to the tick of the earliest due task once
+  // enough tasks were pushed before it to amortize the cost of re-placing the
+  // tasks that depend on the anchor.
+  void MaybeMoveAnchorBack();
+
+  // Moves |current_tick_| back to |tick| and re-places the tasks whose slots
+  // depend on the part of the anchor that changed.
+  void MoveAnchorBack(uint64_t tick, size_t changed_level);
+
+  // The level of the most significant group of slot bits in which the ticks
+  // differ, or |kLevels| if they differ above the outermost level.
+  static size_t ChangedLevel(uint64_t a, uint64_t b);
+
+  // Moves all tasks from the heap into the wheel.
+  void StartUsingWheel();
+
+  // Moves all tasks from the wheel into the heap.
+  void StopUsingWheel();
+
+  // Removes all tasks from the wheel levels below |level_count| and appends
+  // them to |tasks|.
+  void TakeLevels(size_t level_count, std::vector<DelayedTask>& tasks);
+
+  // Moves the tasks of the earliest occupied tick in the wheel into |due_|.
+  void AdvanceToNextTick();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTaskWheel);
+};
+
+static_assert(DelayedTaskWheel::kSlotsPerLevel <= 64,
+              "Slot occupancy is tracked in a 64-bit mask.");
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_DELAYED_TASK_WHEEL_H_
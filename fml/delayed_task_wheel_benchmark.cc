@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/delayed_task_wheel.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/delayed_task.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// Target times resembling the timers an app schedules: a burst of animation
+// ticks within the next frames, debouncers within a few seconds and a tail of
+// long lived timeouts.
+std::vector<fml::TimePoint> GenerateTargetTimes(size_t count) {
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int64_t> frame_ms(0, 50);
+  std::uniform_int_distribution<int64_t> debounce_ms(0, 5000);
+  std::uniform_int_distribution<int64_t> timeout_ms(0, 600000);
+  const auto now = fml::TimePoint::Now();
+  std::vector<fml::TimePoint> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    int64_t ms = 0;
+    switch (i % 4) {
+      case 0:
+      case 1:
+        ms = frame_ms(generator);
+        break;
+      case 2:
+        ms = debounce_ms(generator);
+        break;
+      default:
+        ms = timeout_ms(generator);
+        break;
+    }
+    times.push_back(now + fml::TimeDelta::FromMilliseconds(ms));
+  }
+  return times;
+}
+
+DelayedTask MakeTask(size_t order, fml::TimePoint time) {
+  return DelayedTask(order, [] {}, time, TaskSourceGrade::kUnspecified);
+}
+
+// Adapts the wheel to the interface of |DelayedTaskQueue|.
+class DelayedTaskWheelQueue {
+ public:
+  void push(DelayedTask task) { wheel_.Push(std::move(task)); }
+
+  DelayedTask TakeTop() { return wheel_.TakeTop(); }
+
+ private:
+  DelayedTaskWheel wheel_;
+};
+
+// Posts tasks that are due right away while timers are pending, as
+// `PostTask` does. The timers are all at least a frame away, so every posted
+// task is earlier than all of them.
+template <class Queue>
+void PostDueTasks(benchmark::State& state, Queue& queue) {
+  const auto times = GenerateTargetTimes(state.range(0));
+  for (size_t i = 0; i < times.size(); i++) {
+    queue.push(MakeTask(i, times[i] + fml::TimeDelta::FromMilliseconds(16)));
+  }
+  const auto now = fml::TimePoint::Now();
+  size_t order = times.size();
+  while (state.KeepRunning()) {
+    queue.push(MakeTask(order++, now));
+    benchmark::DoNotOptimize(queue.TakeTop());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void BM_DelayedTaskQueue_Insert(benchmark::State& state) {
+  const auto times = GenerateTargetTimes(state.range(0));
+  while (state.KeepRunning()) {
+    DelayedTaskQueue queue;
+    for (size_t i = 0; i < times.size(); i++) {
+      queue.push(MakeTask(i, times[i]));
+    }
+    benchmark::DoNotOptimize(queue.top());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+static void BM_DelayedTaskWheel_Insert(benchmark::State& state) {
+  const auto times = GenerateTargetTimes(state.range(0));
+  while (state.KeepRunning()) {
+    DelayedTaskWheel wheel;
+    for (size_t i = 0; i < times.size(); i++) {
+      wheel.Push(MakeTask(i, times[i]));
+    }
+    benchmark::DoNotOptimize(wheel.Top());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+static void BM_DelayedTaskQueue_InsertAndDrain(benchmark::State& state) {
+  const auto times = GenerateTargetTimes(state.range(0));
+  while (state.KeepRunning()) {
+    DelayedTaskQueue queue;
+    for (size_t i = 0; i < times.size(); i++) {
+      queue.push(MakeTask(i, times[i]));
+    }
+    while (!queue.empty()) {
+      benchmark::DoNotOptimize(queue.TakeTop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+static void BM_DelayedTaskWheel_InsertAndDrain(benchmark::State& state) {
+  const auto times = GenerateTargetTimes(state.range(0));
+  while (state.KeepRunning()) {
+    DelayedTaskWheel wheel;
+    for (size_t i = 0; i < times.size(); i++) {
+      wheel.Push(MakeTask(i, times[i]));
+    }
+    while (!wheel.IsEmpty()) {
+      benchmark::DoNotOptimize(wheel.TakeTop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+static void BM_DelayedTaskQueue_PostDueTasks(benchmark::State& state) {
+  DelayedTaskQueue queue;
+  PostDueTasks(state, queue);
+}
+
+static void BM_DelayedTaskWheel_PostDueTasks(benchmark::State& state) {
+  DelayedTaskWheelQueue queue;
+  PostDueTasks(state, queue);
+}
+
+BENCHMARK(BM_DelayedTaskQueue_Insert)->Range(64, 64 << 10);
+BENCHMARK(BM_DelayedTaskWheel_Insert)->Range(64, 64 << 10);
+BENCHMARK(BM_DelayedTaskQueue_InsertAndDrain)->Range(64, 64 << 10);
+BENCHMARK(BM_DelayedTaskWheel_InsertAndDrain)->Range(64, 64 << 10);
+BENCHMARK(BM_DelayedTaskQueue_PostDueTasks)->Range(64, 64 << 10);
+BENCHMARK(BM_DelayedTaskWheel_PostDueTasks)->Range(64, 64 << 10);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,216 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/delayed_task_wheel.h"
+
+#include <random>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+DelayedTask MakeTask(size_t order, fml::TimePoint time, size_t* ran_order) {
+  return DelayedTask(
+      order, [order, ran_order]() { *ran_order = order; }, time,
+      TaskSourceGrade::kUnspecified);
+}
+
+// Runs every task in the wheel and returns their registration order.
+std::vector<size_t> DrainWheel(DelayedTaskWheel& wheel, size_t* ran_order) {
+  std::vector<size_t> orders;
+  while (!wheel.IsEmpty()) {
+    wheel.TakeTop().GetTask()();
+    orders.push_back(*ran_order);
+  }
+  return orders;
+}
+
+}  // namespace
+
+TEST(DelayedTaskWheelTest, StartsEmpty) {
+  DelayedTaskWheel wheel;
+  EXPECT_TRUE(wheel.IsEmpty());
+  EXPECT_EQ(wheel.Size(), 0u);
+}
+
+TEST(DelayedTaskWheelTest, SameTimeTasksAreOrderedByRegistration) {
+  DelayedTaskWheel wheel;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  for (size_t i = 0; i < 10; i++) {
+    wheel.Push(MakeTask(i, now + fml::TimeDelta::FromSeconds(1), &ran_order));
+  }
+  EXPECT_EQ(wheel.Size(), 10u);
+  auto orders = DrainWheel(wheel, &ran_order);
+  EXPECT_EQ(orders, (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(DelayedTaskWheelTest, TasksWithinATickAreOrderedByTime) {
+  DelayedTaskWheel wheel;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  wheel.Push(
+      MakeTask(0, now + fml::TimeDelta::FromMicroseconds(30), &ran_order));
+  wheel.Push(
+      MakeTask(1, now + fml::TimeDelta::FromMicroseconds(10), &ran_order));
+  wheel.Push(
+      MakeTask(2, now + fml::TimeDelta::FromMicroseconds(20), &ran_order));
+  auto orders = DrainWheel(wheel, &ran_order);
+  EXPECT_EQ(orders, (std::vector<size_t>{1, 2, 0}));
+}
+
+TEST(DelayedTaskWheelTest, HandlesOverdueAndFarFutureTasks) {
+  DelayedTaskWheel wheel;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  wheel.Push(MakeTask(0, now, &ran_order));
+  wheel.Push(MakeTask(1, fml::TimePoint::Max(), &ran_order));
+  wheel.Push(
+      MakeTask(2, now + fml::TimeDelta::FromSeconds(100000), &ran_order));
+  wheel.Push(MakeTask(3, now - fml::TimeDelta::FromSeconds(1), &ran_order));
+  wheel.Push(MakeTask(4, fml::TimePoint::Min(), &ran_order));
+  wheel.Push(
+      MakeTask(5, now + fml::TimeDelta::FromMilliseconds(16), &ran_order));
+  auto orders = DrainWheel(wheel, &ran_order);
+  EXPECT_EQ(orders, (std::vector<size_t>{4, 3, 0, 5, 2, 1}));
+}
+
+TEST(DelayedTaskWheelTest, ClearDropsAllTasks) {
+  DelayedTaskWheel wheel;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  wheel.Push(MakeTask(0, now, &ran_order));
+  wheel.Push(MakeTask(1, now + fml::TimeDelta::FromSeconds(1), &ran_order));
+  wheel.Push(
+      MakeTask(2, now + fml::TimeDelta::FromSeconds(100000), &ran_order));
+  wheel.Clear();
+  EXPECT_TRUE(wheel.IsEmpty());
+  wheel.Push(MakeTask(3, now + fml::TimeDelta::FromSeconds(2), &ran_order));
+  auto orders = DrainWheel(wheel, &ran_order);
+  EXPECT_EQ(orders, (std::vector<size_t>{3}));
+}
+
+TEST(DelayedTaskWheelTest, UsesTheHeapForFewTasks) {
+  DelayedTaskWheel wheel;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  for (size_t i = 0; i < DelayedTaskWheel::kMaxHeapSize; i++) {
+    wheel.Push(MakeTask(i, now + fml::TimeDelta::FromMilliseconds(i * 2),
+                        &ran_order));
+  }
+  EXPECT_FALSE(wheel.IsUsingWheelForTest());
+
+  wheel.Push(MakeTask(DelayedTaskWheel::kMaxHeapSize, now, &ran_order));
+  EXPECT_TRUE(wheel.IsUsingWheelForTest());
+
+  while (wheel.Size() > DelayedTaskWheel::kMinWheelSize) {
+    wheel.TakeTop();
+  }
+  EXPECT_FALSE(wheel.IsUsingWheelForTest());
+}
+
+TEST(DelayedTaskWheelTest, EarlierTasksMoveTheAnchorBack) {
+  DelayedTaskWheel wheel;
+  DelayedTaskQueue heap;
+  size_t ran_order = 0;
+  const auto now = fml::TimePoint::Now();
+  auto push = [&](size_t order, fml::TimePoint time) {
+    wheel.Push(MakeTask(order, time, &ran_order));
+    heap.push(MakeTask(order, time, &ran_order));
+  };
+
+  // A far future timer anchors the wheel once it is in use.
+  const size_t anchored_count = DelayedTaskWheel::kMaxHeapSize + 1;
+  for (size_t i = 0; i < anchored_count; i++) {
+    push(i, now + fml::TimeDelta::FromSeconds(3600));
+  }
+  ASSERT_TRUE(wheel.IsUsingWheelForTest());
+  ASSERT_EQ(wheel.GetDueTaskCountForTest(), anchored_count);
+
+  // Nearer timers, each in its own tick and registered latest first, are
+  // pushed onto the heap of due tasks until the anchor moves back to them.
+  const size_t count = anchored_count * 3;
+  for (size_t i = anchored_count; i < count; i++) {
+    push(i, now + fml::TimeDelta::FromMilliseconds((count - i) * 2));
+    EXPECT_LE(wheel.GetDueTaskCountForTest(), 2 * anchored_count);
+  }
+  EXPECT_LT(wheel.GetDueTaskCountForTest(), anchored_count);
+
+  // Timers after the anchor go into the wheel.
+  const size_t due_count = wheel.GetDueTaskCountForTest();
+  for (size_t i = count; i < count + 100; i++) {
+    push(i, now + fml::TimeDelta::FromSeconds(i));
+    EXPECT_EQ(wheel.GetDueTaskCountForTest(), due_count);
+  }
+
+  std::vector<size_t> wheel_orders;
+  std::vector<size_t> heap_orders;
+  while (!heap.empty()) {
+    ASSERT_EQ(wheel.Top().GetTargetTime(), heap.top().GetTargetTime());
+    wheel.TakeTop().GetTask()();
+    wheel_orders.push_back(ran_order);
+    heap.TakeTop().GetTask()();
+    heap_orders.push_back(ran_order);
+  }
+  EXPECT_TRUE(wheel.IsEmpty());
+  EXPECT_EQ(wheel_orders, heap_orders);
+}
+
+TEST(DelayedTaskWheelTest, MatchesHeapOrderingForRandomTimers) {
+  DelayedTaskWheel wheel;
+  DelayedTaskQueue heap;
+  std::mt19937 generator(42);
+  // Mix of timers within a frame, within a few seconds, and far out.
+  std::uniform_int_distribution<int64_t> delays[] = {
+      std::uniform_int_distribution<int64_t>(0, 16'000'000),
+      std::uniform_int_distribution<int64_t>(0, 5'000'000'000),
+      std::uniform_int_distribution<int64_t>(0, 100'000'000'000'000),
+  };
+  const auto now = fml::TimePoint::Now();
+  size_t ran_order = 0;
+  size_t order = 0;
+  std::vector<size_t> wheel_orders;
+  std::vector<size_t> heap_orders;
+  for (int round = 0; round < 50; round++) {
+    // Interleave registrations and pops so that tasks get registered relative
+    // to different positions of the wheel.
+    for (int i = 0; i < 200; i++) {
+      auto& delay = delays[generator() % 3];
+      // Quantize some of the times so that ties are exercised.
+      int64_t nanos = delay(generator);
+      if (i % 4 == 0) {
+        nanos -= nanos % 1'000'000;
+      }
+      const auto time = now + fml::TimeDelta::FromNanoseconds(nanos);
+      wheel.Push(MakeTask(order, time, &ran_order));
+      heap.push(MakeTask(order, time, &ran_order));
+      order++;
+    }
+    for (int i = 0; i < 150; i++) {
+      ASSERT_EQ(wheel.Top().GetTargetTime(), heap.top().GetTargetTime());
+      wheel.TakeTop().GetTask()();
+      wheel_orders.push_back(ran_order);
+      heap.TakeTop().GetTask()();
+      heap_orders.push_back(ran_order);
+    }
+    ASSERT_EQ(wheel.Size(), heap.size());
+  }
+  while (!heap.empty()) {
+    wheel.TakeTop().GetTask()();
+    wheel_orders.push_back(ran_order);
+    heap.TakeTop().GetTask()();
+    heap_orders.push_back(ran_order);
+  }
+  EXPECT_TRUE(wheel.IsEmpty());
+  EXPECT_EQ(wheel_orders, heap_orders);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FUNCTION_REF_H_
+#define FLUTTER_FML_FUNCTION_REF_H_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace fml {
+
+template <typename Signature>
+class FunctionRef;
+
+//------------------------------------------------------------------------------
+/// @brief      A non-owning reference to a callable.
+///
+///             Unlike a `std::function`, a `FunctionRef` never allocates,
+///             regardless of the size of the captures of the callable. It is
+///             meant for callbacks that are invoked before the function they
+///             are passed to returns. The referenced callable must outlive the
+///             `FunctionRef`, so it must not be stored.
+///
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+ public:
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, FunctionRef> &&
+                std::is_object_v<std::remove_reference_t<Callable>> &&
+                std::is_invocable_r_v<R, Callable&, Args...>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  FunctionRef(Callable&& callable)
+      : callable_(const_cast<void*>(
+            static_cast<const void*>(std::addressof(callable)))),
+        invoke_(&Invoke<std::remove_reference_t<Callable>>) {}
+
+  FunctionRef(const FunctionRef& other) = default;
+
+  FunctionRef& operator=(const FunctionRef& other) = default;
+
+  R operator()(Args... args) const {
+    return invoke_(callable_, std::forward<Args>(args)...);
+  }
+
+ private:
+  void* callable_;
+  R (*invoke_)(void*, Args...);
+
+  template <typename Callable>
+  static R Invoke(void* callable, Args... args) {
+    return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FUNCTION_REF_H_
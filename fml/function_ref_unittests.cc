@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/function_ref.h"
+
+#include <functional>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+int Apply(FunctionRef<int(int)> function, int value) {
+  return function(value);
+}
+}  // namespace
+
+TEST(FunctionRefTest, InvokesLambdaWithLargeCaptures) {
+  int a = 1, b = 2, c = 3, d = 4, e = 5;
+  EXPECT_EQ(Apply([&](int value) { return value + a + b + c + d + e; }, 10),
+            25);
+}
+
+TEST(FunctionRefTest, ReferencesTheCallable) {
+  int count = 0;
+  auto increment = [&count](int value) {
+    count += value;
+    return count;
+  };
+  FunctionRef<int(int)> function = increment;
+  function(2);
+  function(3);
+  EXPECT_EQ(count, 5);
+
+  FunctionRef<int(int)> copy = function;
+  EXPECT_EQ(copy(1), 6);
+}
+
+TEST(FunctionRefTest, ForwardsArgumentsAndConvertsResults) {
+  std::function<std::string(const std::string&)> twice =
+      [](const std::string& value) { return value + value; };
+  FunctionRef<std::string(const std::string&)> function = twice;
+  EXPECT_EQ(function("ab"), "abab");
+
+  // A callable returning a convertible type.
+  auto make_short = []() -> short { return 7; };
+  FunctionRef<long()> widened = make_short;
+  EXPECT_EQ(widened(), 7);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -53,7 +53,7 @@ MessageLoopImpl::~MessageLoopImpl() {
   task_queue_->Dispose(queue_id_);
 }
 
-void MessageLoopImpl::PostTask(const fml::closure& task,
+void MessageLoopImpl::PostTask(fml::UniqueClosure task,
                                fml::TimePoint target_time) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
@@ -61,7 +61,7 @@ void MessageLoopImpl::PostTask(const fml::closure& task,
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, std::move(task), target_time);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -117,13 +117,19 @@ void MessageLoopImpl::DoTerminate() {
 
 void MessageLoopImpl::FlushTasks(FlushType type) {
   const auto now = fml::TimePoint::Now();
-  fml::closure invocation;
+  fml::UniqueClosure invocation;
   do {
     invocation = task_queue_->GetNextTaskToRun(queue_id_, now);
     if (!invocation) {
       break;
     }
-    invocation();
+    if (task_queue_->IsStatsEnabled()) {
+      const auto start = fml::TimePoint::Now();
+      invocation();
+      task_queue_->RecordTaskRun(fml::TimePoint::Now() - start);
+    } else {
+      invocation();
+    }
     std::vector<fml::closure> observers =
         task_queue_->GetObserversToNotify(queue_id_);
     for (const auto& observer : observers) {
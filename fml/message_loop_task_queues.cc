@@ -13,6 +13,7 @@
 
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/trace_event.h"
 
 namespace fml {
 
@@ -26,6 +27,14 @@ class TaskSourceGradeHolder {
  public:
   TaskSourceGrade task_source_grade;
 
+  // The following describe the task last returned by |GetNextTaskToRun| on
+  // this thread. |stats| is only set while task statistics are enabled and is
+  // cleared once the task has been recorded.
+  std::shared_ptr<SynchronizedTaskQueueStats> stats;
+  TaskQueueId task_queue_id = kUnmerged;
+  fml::TimeDelta latency;
+  size_t queue_depth = 0;
+
   explicit TaskSourceGradeHolder(TaskSourceGrade task_source_grade_arg)
       : task_source_grade(task_source_grade_arg) {}
 };
@@ -39,6 +48,7 @@ TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
   wakeable = NULL;
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
+  stats = std::make_shared<SynchronizedTaskQueueStats>();
 }
 
 MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
@@ -90,14 +100,14 @@ TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
 
 void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
-    const fml::closure& task,
+    fml::UniqueClosure task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
   std::lock_guard guard(queue_mutex_);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
   queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+      {order, std::move(task), target_time, task_source_grade});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
@@ -114,8 +124,9 @@ bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
   return HasPendingTasksUnlocked(queue_id);
 }
 
-fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
-                                                     fml::TimePoint from_time) {
+fml::UniqueClosure MessageLoopTaskQueues::GetNextTaskToRun(
+    TaskQueueId queue_id,
+    fml::TimePoint from_time) {
   std::lock_guard guard(queue_mutex_);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
@@ -131,11 +142,76 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
-  tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
-  return invocation;
+  const auto& entry = queue_entries_.at(top.task_queue_id);
+  const auto& task_source = entry->task_source;
+  if (!tls_task_source_grade) {
+    tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+  }
+  TaskSourceGradeHolder* holder = tls_task_source_grade.get();
+  holder->task_source_grade = task_source_grade;
+  if (stats_enabled_.load(std::memory_order_relaxed)) {
+    holder->stats = entry->stats;
+    holder->task_queue_id = top.task_queue_id;
+    holder->latency = fml::TimePoint::Now() - top.task.GetTargetTime();
+    holder->queue_depth = task_source->GetNumPendingTasks();
+  } else if (holder->stats) {
+    holder->stats = nullptr;
+  }
+  return task_source->PopTask(task_source_grade);
+}
+
+void MessageLoopTaskQueues::SetStatsEnabled(bool enabled) {
+  stats_enabled_ = enabled;
+}
+
+bool MessageLoopTaskQueues::IsStatsEnabled() const {
+  return stats_enabled_;
+}
+
+void MessageLoopTaskQueues::RecordTaskRun(fml::TimeDelta duration) {
+  if (!stats_enabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  TaskSourceGradeHolder* holder = tls_task_source_grade.get();
+  if (holder == nullptr || !holder->stats) {
+    return;
+  }
+  // Moving the stats out of the holder clears them, so each task is recorded
+  // at most once.
+  const std::shared_ptr<SynchronizedTaskQueueStats> stats =
+      std::move(holder->stats);
+  {
+    std::lock_guard guard(stats->mutex);
+    stats->stats.RecordTask(holder->task_source_grade, holder->latency,
+                            duration, holder->queue_depth);
+  }
+  FML_TRACE_COUNTER("flutter", "TaskQueueStats",
+                    static_cast<int64_t>(holder->task_queue_id),  //
+                    "QueueDepth", holder->queue_depth,            //
+                    "LatencyMicros", holder->latency.ToMicroseconds(),
+                    "DurationMicros", duration.ToMicroseconds());
+  holder->task_queue_id = kUnmerged;
+  holder->latency = {};
+  holder->queue_depth = 0;
+}
+
+std::map<TaskQueueId, TaskQueueStats> MessageLoopTaskQueues::GetStats() const {
+  std::lock_guard guard(queue_mutex_);
+  std::map<TaskQueueId, TaskQueueStats> stats;
+  for (const auto& entry : queue_entries_) {
+    std::lock_guard stats_guard(entry.second->stats->mutex);
+    stats.emplace(entry.first, entry.second->stats->stats);
+  }
+  return stats;
+}
+
+void MessageLoopTaskQueues::ResetStats() {
+  std::lock_guard guard(queue_mutex_);
+  for (auto& entry : queue_entries_) {
+    std::lock_guard stats_guard(entry.second->stats->mutex);
+    entry.second->stats->stats = {};
+  }
 }
 
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -16,13 +17,22 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/task_queue_id.h"
+#include "flutter/fml/task_queue_stats.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/unique_closure.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
 
 static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 
+/// The statistics of a task queue together with the mutex that guards them, so
+/// that recording a task does not take the mutex of all task queues.
+struct SynchronizedTaskQueueStats {
+  std::mutex mutex;
+  TaskQueueStats stats;
+};
+
 /// A collection of tasks and observers associated with one TaskQueue.
 ///
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
@@ -35,6 +45,10 @@ class TaskQueueEntry {
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
 
+  /// Timing statistics of tasks run from this queue. Only collected while
+  /// \p MessageLoopTaskQueues::SetStatsEnabled is on.
+  std::shared_ptr<SynchronizedTaskQueueStats> stats;
+
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
   /// empty, this TaskQueue does not own any other TaskQueues.
   std::set<TaskQueueId> owner_of;
@@ -77,19 +91,40 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::UniqueClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
   static TaskSourceGrade GetCurrentTaskSourceGrade();
 
+  // Statistics methods.
+
+  /// Enables or disables collection of per queue task statistics. Collection
+  /// is off by default and costs one acquisition of the statistics lock of the
+  /// queue per task when enabled.
+  void SetStatsEnabled(bool enabled);
+
+  bool IsStatsEnabled() const;
+
+  /// Records the run duration of the task most recently returned by
+  /// \p GetNextTaskToRun on the calling thread along with how long it waited
+  /// and the depth of its queue. Also emits the values as trace counters.
+  void RecordTaskRun(fml::TimeDelta duration);
+
+  /// Returns a snapshot of the statistics of all live task queues.
+  std::map<TaskQueueId, TaskQueueStats> GetStats() const;
+
+  /// Clears the statistics of all task queues.
+  void ResetStats();
+
   // Observers methods.
 
   void AddTaskObserver(TaskQueueId queue_id,
@@ -158,6 +193,8 @@ class MessageLoopTaskQueues {
 
   std::atomic_int order_;
 
+  std::atomic_bool stats_enabled_ = false;
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(MessageLoopTaskQueues);
 };
 
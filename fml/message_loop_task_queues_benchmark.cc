@@ -44,7 +44,7 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
+          fml::UniqueClosure invocation =
               task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
           if (!invocation) {
             break;
@@ -103,7 +103,8 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -143,7 +144,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -186,7 +188,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -205,7 +208,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -215,14 +219,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -440,5 +446,77 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, RecordsTaskStatsWhenEnabled) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto now = ChronoTicksSinceEpoch();
+
+  // Nothing is recorded while disabled.
+  task_queue->RegisterTask(queue_id, [] {}, now);
+  task_queue->GetNextTaskToRun(queue_id, now)();
+  task_queue->RecordTaskRun(fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(task_queue->GetStats()
+                .at(queue_id)
+                .GetGradeStats(TaskSourceGrade::kUnspecified)
+                .duration_us.GetCount(),
+            0u);
+
+  task_queue->SetStatsEnabled(true);
+  task_queue->RegisterTask(queue_id, [] {}, now,
+                           TaskSourceGrade::kUserInteraction);
+  task_queue->RegisterTask(queue_id, [] {}, now,
+                           TaskSourceGrade::kUserInteraction);
+  task_queue->GetNextTaskToRun(queue_id, ChronoTicksSinceEpoch())();
+  task_queue->RecordTaskRun(fml::TimeDelta::FromMilliseconds(3));
+  task_queue->SetStatsEnabled(false);
+
+  const auto stats = task_queue->GetStats().at(queue_id).GetGradeStats(
+      TaskSourceGrade::kUserInteraction);
+  EXPECT_EQ(stats.duration_us.GetCount(), 1u);
+  EXPECT_EQ(stats.duration_us.GetMax(), 3000u);
+  EXPECT_EQ(stats.latency_us.GetCount(), 1u);
+  // Both tasks were pending when the first one was picked.
+  EXPECT_EQ(stats.queue_depth.GetMax(), 2u);
+
+  task_queue->ResetStats();
+  EXPECT_EQ(task_queue->GetStats()
+                .at(queue_id)
+                .GetGradeStats(TaskSourceGrade::kUserInteraction)
+                .duration_us.GetCount(),
+            0u);
+  task_queue->Dispose(queue_id);
+}
+
+TEST(MessageLoopTaskQueue, RecordsEachTaskOnce) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto now = ChronoTicksSinceEpoch();
+  auto duration_count = [&]() {
+    return task_queue->GetStats()
+        .at(queue_id)
+        .GetGradeStats(TaskSourceGrade::kUnspecified)
+        .duration_us.GetCount();
+  };
+
+  task_queue->SetStatsEnabled(true);
+  task_queue->RegisterTask(queue_id, [] {}, now);
+  task_queue->GetNextTaskToRun(queue_id, now)();
+  task_queue->RecordTaskRun(fml::TimeDelta::FromMilliseconds(1));
+  task_queue->RecordTaskRun(fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(duration_count(), 1u);
+
+  // A task picked while collection was off is not recorded when it is turned
+  // on before the task finishes.
+  task_queue->SetStatsEnabled(false);
+  task_queue->RegisterTask(queue_id, [] {}, now);
+  task_queue->GetNextTaskToRun(queue_id, now)();
+  task_queue->SetStatsEnabled(true);
+  task_queue->RecordTaskRun(fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(duration_count(), 1u);
+
+  task_queue->SetStatsEnabled(false);
+  task_queue->Dispose(queue_id);
+}
+
 }  // namespace testing
 }  // namespace fml
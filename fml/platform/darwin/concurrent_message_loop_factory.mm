@@ -12,7 +12,7 @@ class ConcurrentMessageLoopDarwin : public ConcurrentMessageLoop {
  protected:
   explicit ConcurrentMessageLoopDarwin(size_t worker_count) : ConcurrentMessageLoop(worker_count) {}
 
-  void ExecuteTask(const fml::closure& task) override {
+  void ExecuteTask(const fml::UniqueClosure& task) override {
     @autoreleasepool {
       task();
     }
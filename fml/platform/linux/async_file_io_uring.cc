@@ -0,0 +1,408 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/async_file_io_uring.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/thread.h"
+
+// clang-format off
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+// clang-format on
+
+#include <linux/io_uring.h>
+
+#define FML_IO_URING_AVAILABLE 1
+
+#else
+
+#define FML_IO_URING_AVAILABLE 0
+
+#endif
+
+namespace fml {
+
+#if FML_IO_URING_AVAILABLE
+
+namespace {
+
+// The length field of a submission is 32 bits wide. Longer transfers complete
+// short and must be continued by the caller.
+constexpr size_t kMaxTransferLength = 1u << 30;
+
+// The longest the completion thread sleeps between failed waits.
+constexpr std::chrono::milliseconds kMaxWaitBackoff(64);
+
+int IOUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IOUringEnter(int fd,
+                 unsigned to_submit,
+                 unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+T* RingPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+void UnmapRing(void* sq_ring,
+               size_t sq_ring_size,
+               void* cq_ring,
+               size_t cq_ring_size,
+               void* sqes,
+               size_t sqes_size) {
+  if (sqes != nullptr) {
+    ::munmap(sqes, sqes_size);
+  }
+  if (cq_ring != nullptr && cq_ring != sq_ring) {
+    ::munmap(cq_ring, cq_ring_size);
+  }
+  if (sq_ring != nullptr) {
+    ::munmap(sq_ring, sq_ring_size);
+  }
+}
+
+void* MapRegion(int fd, size_t size, off_t offset) {
+  void* region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, offset);
+  return region == MAP_FAILED ? nullptr : region;
+}
+
+}  // namespace
+
+std::unique_ptr<AsyncFileIOUring> AsyncFileIOUring::Create(
+    size_t queue_depth) {
+  io_uring_params params = {};
+  const int fd = IOUringSetup(
+      static_cast<unsigned>(std::clamp<size_t>(queue_depth, 1, 4096)),
+      &params);
+  if (fd < 0) {
+    // The kernel is too old, io_uring is disabled via sysctl, or the process
+    // is sandboxed.
+    FML_DLOG(INFO) << "io_uring is not available: " << strerror(errno);
+    return nullptr;
+  }
+  UniqueFD ring_fd(fd);
+
+  // IORING_OP_READ and IORING_OP_WRITE were added in the same kernel release
+  // (5.6) as this feature flag. There is no cheaper way to check for them.
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+    FML_DLOG(INFO) << "io_uring does not support IORING_OP_READ.";
+    return nullptr;
+  }
+
+  Ring ring;
+  ring.sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring.cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  ring.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    ring.sq_ring_size = ring.cq_ring_size =
+        std::max(ring.sq_ring_size, ring.cq_ring_size);
+  }
+
+  ring.sq_ring = MapRegion(fd, ring.sq_ring_size, IORING_OFF_SQ_RING);
+  ring.cq_ring = single_mmap
+                     ? ring.sq_ring
+                     : MapRegion(fd, ring.cq_ring_size, IORING_OFF_CQ_RING);
+  ring.sqes = static_cast<io_uring_sqe*>(
+      MapRegion(fd, ring.sqes_size, IORING_OFF_SQES));
+  if (ring.sq_ring == nullptr || ring.cq_ring == nullptr ||
+      ring.sqes == nullptr) {
+    FML_LOG(ERROR) << "Could not map the io_uring: " << strerror(errno);
+    UnmapRing(ring.sq_ring, ring.sq_ring_size, ring.cq_ring, ring.cq_ring_size,
+              ring.sqes, ring.sqes_size);
+    return nullptr;
+  }
+
+  ring.sq_head = RingPointer<unsigned>(ring.sq_ring, params.sq_off.head);
+  ring.sq_tail = RingPointer<unsigned>(ring.sq_ring, params.sq_off.tail);
+  ring.sq_mask = RingPointer<unsigned>(ring.sq_ring, params.sq_off.ring_mask);
+  ring.sq_array = RingPointer<unsigned>(ring.sq_ring, params.sq_off.array);
+  ring.sq_entries = params.sq_entries;
+
+  ring.cq_head = RingPointer<unsigned>(ring.cq_ring, params.cq_off.head);
+  ring.cq_tail = RingPointer<unsigned>(ring.cq_ring, params.cq_off.tail);
+  ring.cq_mask = RingPointer<unsigned>(ring.cq_ring, params.cq_off.ring_mask);
+  ring.cqes = RingPointer<io_uring_cqe>(ring.cq_ring, params.cq_off.cqes);
+  ring.cq_entries = params.cq_entries;
+
+  UniqueFD wake_fd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (!wake_fd.is_valid()) {
+    FML_LOG(ERROR) << "Could not create an eventfd: " << strerror(errno);
+    UnmapRing(ring.sq_ring, ring.sq_ring_size, ring.cq_ring, ring.cq_ring_size,
+              ring.sqes, ring.sqes_size);
+    return nullptr;
+  }
+
+  return std::unique_ptr<AsyncFileIOUring>(
+      new AsyncFileIOUring(std::move(ring_fd), ring, std::move(wake_fd)));
+}
+
+AsyncFileIOUring::AsyncFileIOUring(UniqueFD ring_fd,
+                                   Ring ring,
+                                   UniqueFD wake_fd)
+    : ring_fd_(std::move(ring_fd)), ring_(ring), wake_fd_(std::move(wake_fd)) {
+  completion_thread_ = std::thread([this]() { CompletionMain(); });
+}
+
+AsyncFileIOUring::~AsyncFileIOUring() {
+  terminating_ = true;
+  WakeUpCompletionThread();
+  completion_thread_.join();
+  UnmapRing(ring_.sq_ring, ring_.sq_ring_size, ring_.cq_ring,
+            ring_.cq_ring_size, ring_.sqes, ring_.sqes_size);
+}
+
+AsyncFileIO::Backend AsyncFileIOUring::GetBackend() const {
+  return Backend::kIOUring;
+}
+
+void AsyncFileIOUring::Submit(std::vector<Operation> operations) {
+  const bool on_completion_thread =
+      std::this_thread::get_id() == completion_thread_.get_id();
+  std::unique_lock lock(submission_mutex_);
+  for (auto& operation : operations) {
+    // Ownership of the operation is passed to the completion thread.
+    auto pending = std::make_unique<Operation>(std::move(operation));
+    // The completion thread can't wait for room in the ring, it is the thread
+    // that makes room.
+    if (on_completion_thread &&
+        (in_flight_ >= ring_.cq_entries || !deferred_.empty())) {
+      deferred_.push_back(std::move(pending));
+      continue;
+    }
+    PushLocked(lock, pending.release());
+  }
+  FlushLocked();
+}
+
+void AsyncFileIOUring::PushLocked(std::unique_lock<std::mutex>& lock,
+                                  Operation* operation) {
+  if (in_flight_ >= ring_.cq_entries) {
+    FlushLocked();
+    completion_cv_.wait(lock,
+                        [&]() { return in_flight_ < ring_.cq_entries; });
+  }
+  in_flight_++;
+
+  // Only this (locked) producer advances the tail. The kernel advances the
+  // head as it consumes entries during |FlushLocked|.
+  const unsigned tail = *ring_.sq_tail;
+  if (tail - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE) ==
+      ring_.sq_entries) {
+    FlushLocked();
+  }
+
+  const unsigned index = *ring_.sq_tail & *ring_.sq_mask;
+  io_uring_sqe* sqe = &ring_.sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = reinterpret_cast<uint64_t>(operation);
+  sqe->fd = operation->file;
+  switch (operation->type) {
+    case Operation::Type::kRead:
+    case Operation::Type::kWrite:
+      sqe->opcode = operation->type == Operation::Type::kRead
+                        ? IORING_OP_READ
+                        : IORING_OP_WRITE;
+      sqe->addr = reinterpret_cast<uint64_t>(operation->buffer);
+      sqe->len = static_cast<uint32_t>(
+          std::min(operation->length, kMaxTransferLength));
+      sqe->off = static_cast<uint64_t>(operation->offset);
+      break;
+    case Operation::Type::kFsync:
+      sqe->opcode = IORING_OP_FSYNC;
+      break;
+  }
+  ring_.sq_array[index] = index;
+  __atomic_store_n(ring_.sq_tail, *ring_.sq_tail + 1, __ATOMIC_RELEASE);
+  unflushed_++;
+}
+
+void AsyncFileIOUring::FlushLocked() {
+  while (unflushed_ > 0) {
+    const int submitted = IOUringEnter(ring_fd_.get(), unflushed_, 0, 0);
+    if (submitted < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        continue;
+      }
+      FML_LOG(ERROR) << "Could not submit to the io_uring: "
+                     << strerror(errno);
+      FailUnflushedLocked(errno);
+      return;
+    }
+    unflushed_ -= std::min<unsigned>(submitted, unflushed_);
+  }
+}
+
+void AsyncFileIOUring::FailUnflushedLocked(int error) {
+  // The kernel only consumes entries during |FlushLocked|, so the unflushed
+  // ones at the end of the queue can be taken back.
+  const unsigned tail = *ring_.sq_tail - unflushed_;
+  for (unsigned entry = tail; entry != *ring_.sq_tail; entry++) {
+    const io_uring_sqe& sqe = ring_.sqes[entry & *ring_.sq_mask];
+    failed_.emplace_back(reinterpret_cast<Operation*>(sqe.user_data),
+                         -static_cast<int64_t>(error));
+  }
+  __atomic_store_n(ring_.sq_tail, tail, __ATOMIC_RELEASE);
+  in_flight_ -= unflushed_;
+  unflushed_ = 0;
+  completion_cv_.notify_all();
+  WakeUpCompletionThread();
+}
+
+void AsyncFileIOUring::WakeUpCompletionThread() {
+  const uint64_t value = 1;
+  // The write only fails if the counter would overflow, in which case the
+  // thread is woken up anyway.
+  [[maybe_unused]] auto result = ::write(wake_fd_.get(), &value, sizeof(value));
+}
+
+void AsyncFileIOUring::WaitForCompletions() {
+  // The io_uring file descriptor is readable while the completion queue is
+  // not empty.
+  pollfd fds[] = {
+      {.fd = ring_fd_.get(), .events = POLLIN, .revents = 0},
+      {.fd = wake_fd_.get(), .events = POLLIN, .revents = 0},
+  };
+  std::chrono::milliseconds backoff(0);
+  while (::poll(fds, 2, -1) < 0) {
+    if (errno == EINTR) {
+      continue;
+    }
+    // Back off so that a persistent failure neither spins this thread nor
+    // floods the log.
+    if (backoff.count() == 0) {
+      FML_LOG(ERROR) << "Could not wait for io_uring completions: "
+                     << strerror(errno);
+    }
+    backoff = std::clamp(backoff * 2, std::chrono::milliseconds(1),
+                         kMaxWaitBackoff);
+    std::this_thread::sleep_for(backoff);
+    if (terminating_) {
+      return;
+    }
+  }
+  if (fds[1].revents & POLLIN) {
+    uint64_t value = 0;
+    [[maybe_unused]] auto result =
+        ::read(wake_fd_.get(), &value, sizeof(value));
+  }
+}
+
+void AsyncFileIOUring::CompletionMain() {
+  Thread::SetCurrentThreadName(Thread::ThreadConfig("io.flutter.io_uring"));
+  bool wait = true;
+  while (true) {
+    if (wait) {
+      WaitForCompletions();
+    }
+
+    // This thread is the only consumer of the completion queue.
+    unsigned head = *ring_.cq_head;
+    const unsigned tail = __atomic_load_n(ring_.cq_tail, __ATOMIC_ACQUIRE);
+    size_t completed = 0;
+    for (; head != tail; head++) {
+      const io_uring_cqe& cqe = ring_.cqes[head & *ring_.cq_mask];
+      std::unique_ptr<Operation> operation(
+          reinterpret_cast<Operation*>(cqe.user_data));
+      const int64_t result = cqe.res;
+      // Release the entry to the kernel before running the callback.
+      __atomic_store_n(ring_.cq_head, head + 1, __ATOMIC_RELEASE);
+      if (operation->on_complete) {
+        operation->on_complete(result);
+      }
+      completed++;
+    }
+
+    std::vector<std::pair<std::unique_ptr<Operation>, int64_t>> failed;
+    bool done = false;
+    {
+      std::unique_lock lock(submission_mutex_);
+      in_flight_ -= completed;
+      if (completed > 0) {
+        completion_cv_.notify_all();
+      }
+      while (!deferred_.empty() && in_flight_ < ring_.cq_entries) {
+        PushLocked(lock, deferred_.front().release());
+        deferred_.pop_front();
+      }
+      FlushLocked();
+      std::swap(failed, failed_);
+      done = terminating_ && in_flight_ == 0 && deferred_.empty() &&
+             failed.empty();
+    }
+    if (done) {
+      return;
+    }
+
+    for (auto& [operation, error] : failed) {
+      if (operation->on_complete) {
+        operation->on_complete(error);
+      }
+    }
+    // The callbacks of failed operations may have deferred more operations.
+    wait = failed.empty();
+  }
+}
+
+#else  // FML_IO_URING_AVAILABLE
+
+std::unique_ptr<AsyncFileIOUring> AsyncFileIOUring::Create(
+    size_t queue_depth) {
+  return nullptr;
+}
+
+AsyncFileIOUring::AsyncFileIOUring(UniqueFD ring_fd,
+                                   Ring ring,
+                                   UniqueFD wake_fd) {}
+
+AsyncFileIOUring::~AsyncFileIOUring() = default;
+
+AsyncFileIO::Backend AsyncFileIOUring::GetBackend() const {
+  return Backend::kIOUring;
+}
+
+void AsyncFileIOUring::Submit(std::vector<Operation> operations) {
+  FML_UNREACHABLE();
+}
+
+void AsyncFileIOUring::PushLocked(std::unique_lock<std::mutex>& lock,
+                                  Operation* operation) {}
+
+void AsyncFileIOUring::FlushLocked() {}
+
+void AsyncFileIOUring::FailUnflushedLocked(int error) {}
+
+void AsyncFileIOUring::WakeUpCompletionThread() {}
+
+void AsyncFileIOUring::WaitForCompletions() {}
+
+void AsyncFileIOUring::CompletionMain() {}
+
+#endif  // FML_IO_URING_AVAILABLE
+
+}  // namespace fml
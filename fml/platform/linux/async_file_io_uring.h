@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_ASYNC_FILE_IO_URING_H_
+#define FLUTTER_FML_PLATFORM_LINUX_ASYNC_FILE_IO_URING_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/async_file_io.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      An `AsyncFileIO` that submits operations to the kernel via an
+///             io_uring.
+///
+///             Submissions from any thread are serialized onto the submission
+///             queue and flushed with one `io_uring_enter` call per batch. A
+///             dedicated thread waits for completions and invokes the
+///             completion callbacks. The number of operations in flight is
+///             limited to the capacity of the completion queue so that
+///             completions are never dropped. Operations submitted from a
+///             completion callback while the queue is full are deferred until
+///             the callback returns instead of waiting for a completion that
+///             only the calling thread could reap.
+///
+///             The completion thread polls the ring and an eventfd, so that it
+///             can be woken up even if the kernel refuses new submissions.
+///             Operations the kernel refuses complete with the error.
+///
+///             The ring is set up with raw system calls so that no additional
+///             library is needed.
+///
+class AsyncFileIOUring final : public AsyncFileIO {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an io_uring with room for `queue_depth` submissions.
+  ///
+  /// @return     The io_uring or null if the kernel does not support io_uring
+  ///             (or the required operations) or the process is not allowed
+  ///             to use it.
+  ///
+  static std::unique_ptr<AsyncFileIOUring> Create(size_t queue_depth);
+
+  ~AsyncFileIOUring() override;
+
+  // |AsyncFileIO|
+  Backend GetBackend() const override;
+
+  // |AsyncFileIO|
+  void Submit(std::vector<Operation> operations) override;
+
+ private:
+  struct Ring {
+    void* sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    void* cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_mask = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_entries = 0;
+
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned* cq_mask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cq_entries = 0;
+  };
+
+  UniqueFD ring_fd_;
+  Ring ring_;
+  // An eventfd that wakes up the completion thread.
+  UniqueFD wake_fd_;
+
+  // Guards the submission queue and the members below.
+  std::mutex submission_mutex_;
+  std::condition_variable completion_cv_;
+  size_t in_flight_ = 0;
+  // SQEs added to the submission queue but not yet passed to the kernel.
+  unsigned unflushed_ = 0;
+  // Operations submitted from the completion thread while the ring was full.
+  std::deque<std::unique_ptr<Operation>> deferred_;
+  // Operations the kernel refused, with the error to complete them with.
+  std::vector<std::pair<std::unique_ptr<Operation>, int64_t>> failed_;
+
+  std::atomic_bool terminating_ = false;
+  std::thread completion_thread_;
+
+  AsyncFileIOUring(UniqueFD ring_fd, Ring ring, UniqueFD wake_fd);
+
+  // Must be called with |submission_mutex_| held. Takes ownership of the
+  // operation.
+  void PushLocked(std::unique_lock<std::mutex>& lock, Operation* operation);
+
+  // Must be called with |submission_mutex_| held.
+  void FlushLocked();
+
+  // Removes the unflushed SQEs from the submission queue and hands their
+  // operations to the completion thread to fail with |error|. Must be called
+  // with |submission_mutex_| held.
+  void FailUnflushedLocked(int error);
+
+  void WakeUpCompletionThread();
+
+  // Blocks until there are completions to reap or the thread is woken up.
+  void WaitForCompletions();
+
+  void CompletionMain();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileIOUring);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_ASYNC_FILE_IO_URING_H_
@@ -0,0 +1,333 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+constexpr const char* kCpuPath = "/sys/devices/system/cpu";
+
+/// The CPUSpeedTracker and CpuTopology are initialized once the first time
+/// they are needed.
+std::once_flag gCPUTrackerFlag;
+CPUSpeedTracker* gCPUTracker;
+CpuTopology* gCPUTopology;
+
+// Only the CPUs in the affinity mask of the main thread (whose ID is the
+// process ID) are considered. The mask of the current thread may already have
+// been narrowed by an earlier request.
+void InitCPUInfo() {
+  std::vector<size_t> cpus;
+  std::vector<CpuIndexAndSpeed> cpu_speeds;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(getpid(), sizeof(set), &set) == 0) {
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (!CPU_ISSET(cpu, &set)) {
+        continue;
+      }
+      cpus.push_back(cpu);
+      auto speed = ReadIntFromFile(std::string(kCpuPath) + "/cpu" +
+                                   std::to_string(cpu) +
+                                   "/cpufreq/cpuinfo_max_freq");
+      if (speed.has_value()) {
+        cpu_speeds.push_back({.index = cpu, .speed = speed.value()});
+      }
+    }
+  }
+  gCPUTracker = new CPUSpeedTracker(cpu_speeds);
+  gCPUTopology = new CpuTopology(CpuTopology::Read(kCpuPath, cpus));
+}
+
+bool SetUpCPUTracker() {
+  std::call_once(gCPUTrackerFlag, InitCPUInfo);
+  return gCPUTracker != nullptr && gCPUTracker->IsValid();
+}
+
+const CpuTopology& GetCPUTopology() {
+  std::call_once(gCPUTrackerFlag, InitCPUInfo);
+  return *gCPUTopology;
+}
+
+std::string ReadFileToString(const std::string& path) {
+  std::ifstream file;
+  file.open(path.c_str());
+  std::string contents;
+  std::getline(file, contents);
+  return contents;
+}
+
+// Prefers the given CPUs for the calling thread. An empty set means no
+// preference, in which case the affinity is left alone.
+void PreferCPUs(const std::vector<size_t>& cpus) {
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto index : cpus) {
+    CPU_SET(index, &set);
+  }
+  sched_setaffinity(0, sizeof(set), &set);
+}
+
+// Like with |sched_setaffinity|, a pid of 0 refers to the calling thread.
+bool SetCurrentThreadPolicy(int policy) {
+  sched_param param = {};
+  return ::sched_setscheduler(0, policy, &param) == 0;
+}
+
+// Whether the calling thread may return to the default niceness after it has
+// been raised. Without CAP_SYS_NICE, this requires an RLIMIT_NICE of at least
+// 20 (which allows a niceness of 0).
+bool CanRestoreDefaultNiceness() {
+  rlimit limit = {};
+  if (::getrlimit(RLIMIT_NICE, &limit) != 0) {
+    return false;
+  }
+  return limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= 20;
+}
+
+// Like with |sched_setaffinity|, a pid of 0 refers to the calling thread.
+bool SetCurrentThreadNiceness(int niceness) {
+  return ::setpriority(PRIO_PROCESS, 0, niceness) == 0;
+}
+
+}  // namespace
+
+std::vector<size_t> ParseCpuList(const std::string& list) {
+  std::vector<size_t> cpus;
+  const char* cursor = list.c_str();
+  while (*cursor != '\0') {
+    char* end = nullptr;
+    const unsigned long first = std::strtoul(cursor, &end, 10);
+    if (end == cursor) {
+      // Not a number, the list is malformed.
+      return {};
+    }
+    unsigned long last = first;
+    cursor = end;
+    if (*cursor == '-') {
+      cursor++;
+      last = std::strtoul(cursor, &end, 10);
+      if (end == cursor || last < first || last >= CPU_SETSIZE) {
+        return {};
+      }
+      cursor = end;
+    }
+    for (unsigned long cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+    if (*cursor == ',') {
+      cursor++;
+    } else if (*cursor != '\0' && *cursor != '\n') {
+      return {};
+    } else {
+      break;
+    }
+  }
+  return cpus;
+}
+
+CpuTopology::CpuTopology(std::vector<CpuTopologyEntry> entries) {
+  if (entries.empty()) {
+    return;
+  }
+  int64_t min_speed = entries.front().speed;
+  int64_t max_speed = entries.front().speed;
+  for (const auto& entry : entries) {
+    min_speed = std::min(min_speed, entry.speed);
+    max_speed = std::max(max_speed, entry.speed);
+  }
+  // On heterogeneous systems, the slowest CPUs are the efficiency cores.
+  auto is_frame_capable = [&](const CpuTopologyEntry& entry) {
+    return min_speed == max_speed || entry.speed > min_speed;
+  };
+
+  struct CacheDomain {
+    int64_t speed = 0;
+    std::set<size_t> cores;
+  };
+  std::map<size_t, CacheDomain> domains;
+  for (const auto& entry : entries) {
+    auto& domain = domains[entry.cache_domain];
+    domain.speed = std::max(domain.speed, entry.speed);
+    if (is_frame_capable(entry)) {
+      domain.cores.insert(entry.core);
+    }
+  }
+
+  // The frame threads share the fastest cache domain, preferring the one with
+  // the most physical cores. Ties go to the lowest domain.
+  auto frame_domain = domains.begin();
+  for (auto it = domains.begin(); it != domains.end(); ++it) {
+    if (it->second.speed > frame_domain->second.speed ||
+        (it->second.speed == frame_domain->second.speed &&
+         it->second.cores.size() > frame_domain->second.cores.size())) {
+      frame_domain = it;
+    }
+  }
+  const std::set<size_t>& frame_cores = frame_domain->second.cores;
+  if (frame_cores.size() < kMinFrameCores) {
+    return;
+  }
+
+  // One logical CPU of each physical core, so that the frame threads do not
+  // compete for the same core with SMT.
+  std::set<size_t> used_cores;
+  for (const auto& entry : entries) {
+    if (entry.cache_domain == frame_domain->first && is_frame_capable(entry) &&
+        used_cores.insert(entry.core).second) {
+      frame_.push_back(entry.index);
+    }
+  }
+  // Everything that does not share a physical core with the frame threads.
+  for (const auto& entry : entries) {
+    if (frame_cores.count(entry.core) == 0) {
+      background_.push_back(entry.index);
+    }
+  }
+  std::sort(frame_.begin(), frame_.end());
+  std::sort(background_.begin(), background_.end());
+}
+
+CpuTopology CpuTopology::Read(const std::string& cpu_path,
+                              const std::vector<size_t>& cpus) {
+  std::vector<CpuTopologyEntry> entries;
+  for (const auto cpu : cpus) {
+    const std::string path = cpu_path + "/cpu" + std::to_string(cpu);
+    const auto speed = ReadIntFromFile(path + "/cpufreq/cpuinfo_max_freq");
+    CpuTopologyEntry entry = {
+        .index = cpu,
+        .core = cpu,
+        .cache_domain = 0,
+        .speed = speed.value_or(0),
+    };
+
+    auto siblings = ParseCpuList(
+        ReadFileToString(path + "/topology/thread_siblings_list"));
+    if (!siblings.empty()) {
+      entry.core = siblings.front();
+    }
+
+    auto cluster =
+        ParseCpuList(ReadFileToString(path + "/topology/cluster_cpus_list"));
+    if (!cluster.empty()) {
+      entry.cache_domain = cluster.front();
+    }
+
+    // The cache with the highest level is the last level cache.
+    int64_t last_level = 0;
+    for (size_t i = 0;; i++) {
+      const std::string cache = path + "/cache/index" + std::to_string(i);
+      auto level = ReadIntFromFile(cache + "/level");
+      if (!level.has_value()) {
+        break;
+      }
+      if (level.value() <= last_level) {
+        continue;
+      }
+      auto shared = ParseCpuList(ReadFileToString(cache + "/shared_cpu_list"));
+      if (!shared.empty()) {
+        last_level = level.value();
+        entry.cache_domain = shared.front();
+      }
+    }
+    entries.push_back(entry);
+  }
+  return CpuTopology(std::move(entries));
+}
+
+const std::vector<size_t>& CpuTopology::GetFrameIndices() const {
+  return frame_;
+}
+
+const std::vector<size_t>& CpuTopology::GetBackgroundIndices() const {
+  return background_;
+}
+
+bool LinuxRequestAffinity(CpuAffinity affinity) {
+  if (!SetUpCPUTracker()) {
+    return true;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto index : gCPUTracker->GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void LinuxSetCurrentThreadPriority(Thread::ThreadPriority priority) {
+  switch (priority) {
+    case Thread::ThreadPriority::kBackground: {
+      PreferCPUs(GetCPUTopology().GetBackgroundIndices());
+      // SCHED_BATCH keeps the niceness but tells the scheduler that the
+      // thread is not latency sensitive. Unlike SCHED_IDLE, it can be undone
+      // without privileges.
+      if (!SetCurrentThreadPolicy(SCHED_BATCH)) {
+        FML_DLOG(WARNING) << "Failed to set background thread policy: "
+                          << strerror(errno);
+      }
+      // An unprivileged process cannot undo a raised niceness, which would
+      // stick to any work that later runs on this thread.
+      if (CanRestoreDefaultNiceness() && !SetCurrentThreadNiceness(10)) {
+        FML_LOG(ERROR) << "Failed to set background thread priority: "
+                       << strerror(errno);
+      }
+      break;
+    }
+    case Thread::ThreadPriority::kDisplay: {
+      PreferCPUs(GetCPUTopology().GetFrameIndices());
+      // Threads inherit the policy of the thread that created them.
+      SetCurrentThreadPolicy(SCHED_OTHER);
+      if (!SetCurrentThreadNiceness(-1)) {
+        FML_DLOG(WARNING) << "Failed to set UI thread priority: "
+                          << strerror(errno);
+      }
+      break;
+    }
+    case Thread::ThreadPriority::kRaster: {
+      PreferCPUs(GetCPUTopology().GetFrameIndices());
+      SetCurrentThreadPolicy(SCHED_OTHER);
+      // Match the Android embedder. Unprivileged processes may not raise
+      // their priority at all, in which case the raster thread stays at the
+      // default.
+      if (!SetCurrentThreadNiceness(-5) && !SetCurrentThreadNiceness(-2)) {
+        FML_DLOG(WARNING) << "Failed to set raster thread priority: "
+                          << strerror(errno);
+      }
+      break;
+    }
+    case Thread::ThreadPriority::kNormal:
+      break;
+  }
+}
+
+void LinuxThreadConfigSetter(const Thread::ThreadConfig& config) {
+  Thread::SetCurrentThreadName(config);
+  LinuxSetCurrentThreadPriority(config.priority);
+}
+
+}  // namespace fml
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
+#define FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/cpu_affinity.h"
+#include "flutter/fml/thread.h"
+
+namespace fml {
+
+/// @brief Linux specific implementation of RequestAffinity.
+bool LinuxRequestAffinity(CpuAffinity affinity);
+
+/// @brief The placement of a logical CPU in the processor topology.
+struct CpuTopologyEntry {
+  // The index of the given CPU.
+  size_t index;
+  // The lowest index of the logical CPUs that share a physical core with this
+  // one (SMT siblings).
+  size_t core;
+  // The lowest index of the logical CPUs that share the last level cache (or,
+  // if that is unknown, the cluster) with this one.
+  size_t cache_domain;
+  // CPU speed in kHZ, or 0 if unknown.
+  int64_t speed;
+};
+
+/// @brief The sets of CPUs that the engine threads prefer based on the
+///        processor topology.
+///
+///        The UI and raster threads share a set of "frame" CPUs: one logical
+///        CPU of each physical core that is not an efficiency core in the
+///        fastest cache domain. The threads hand frames to each other, so
+///        they benefit from sharing a cache, and as no two of the CPUs are
+///        SMT siblings, the scheduler places the two threads on separate
+///        physical cores whenever it can.
+///
+///        Background threads prefer the CPUs outside of the physical cores of
+///        the frame CPUs, if there are any, such as the efficiency cores or
+///        the cores of another cache domain.
+///
+///        These are preferences shared by all threads of a kind and by all
+///        engines. No thread is pinned to a core of its own.
+///
+/// @note  This is visible for testing.
+class CpuTopology {
+ public:
+  /// The minimum number of physical cores in the frame set, so that the UI
+  /// and raster threads do not have to share one.
+  static constexpr size_t kMinFrameCores = 2;
+
+  explicit CpuTopology(std::vector<CpuTopologyEntry> entries);
+
+  /// @brief Reads the topology of the given logical CPUs from sysfs.
+  ///
+  ///        `cpu_path` is usually /sys/devices/system/cpu. CPUs for which the
+  ///        topology is not exposed are treated as separate physical cores
+  ///        sharing a cache.
+  static CpuTopology Read(const std::string& cpu_path,
+                          const std::vector<size_t>& cpus);
+
+  /// @brief The CPUs preferred by the UI and raster threads, or an empty set
+  ///        if there is no preference.
+  const std::vector<size_t>& GetFrameIndices() const;
+
+  /// @brief The CPUs preferred by background threads, or an empty set if
+  ///        there is no preference.
+  const std::vector<size_t>& GetBackgroundIndices() const;
+
+ private:
+  std::vector<size_t> frame_;
+  std::vector<size_t> background_;
+};
+
+/// @brief Parses a sysfs CPU list such as "0-3,8,10-11".
+///
+/// @note  Visible for testing.
+std::vector<size_t> ParseCpuList(const std::string& list);
+
+/// @brief Applies the scheduling policy, niceness and CPU affinity for the
+///        given priority to the current thread.
+///
+///        - The UI and raster threads prefer the frame CPUs of the
+///          `CpuTopology` under SCHED_OTHER. They are given the niceness the
+///          Android embedder uses, which requires CAP_SYS_NICE or a
+///          sufficient RLIMIT_NICE.
+///        - Background threads prefer the background CPUs of the
+///          `CpuTopology` under SCHED_BATCH. Their niceness is only lowered
+///          if the process could raise it again, which unprivileged
+///          processes usually cannot. Switching back from SCHED_BATCH does
+///          not require privileges.
+///        - Other threads are left alone.
+void LinuxSetCurrentThreadPriority(Thread::ThreadPriority priority);
+
+/// @brief A ThreadConfigSetter that names the thread and applies
+///        LinuxSetCurrentThreadPriority.
+void LinuxThreadConfigSetter(const Thread::ThreadConfig& config);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_CPU_AFFINITY_H_
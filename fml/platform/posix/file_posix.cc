@@ -14,6 +14,7 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/async_file_io.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
@@ -265,4 +266,34 @@ bool VisitFiles(const fml::UniqueFD& directory, const FileVisitor& visitor) {
   return true;
 }
 
+namespace internal {
+
+int64_t PerformFileOperation(const AsyncFileIO::Operation& operation) {
+  ssize_t result = 0;
+  switch (operation.type) {
+    case AsyncFileIO::Operation::Type::kRead:
+      result = FML_HANDLE_EINTR(::pread(operation.file, operation.buffer,
+                                        operation.length, operation.offset));
+      break;
+    case AsyncFileIO::Operation::Type::kWrite:
+      result = FML_HANDLE_EINTR(::pwrite(operation.file, operation.buffer,
+                                         operation.length, operation.offset));
+      break;
+    case AsyncFileIO::Operation::Type::kFsync:
+      result = FML_HANDLE_EINTR(::fsync(operation.file));
+      break;
+  }
+  return result < 0 ? -errno : result;
+}
+
+int64_t GetFileSize(int file) {
+  struct stat stat_buffer = {};
+  if (::fstat(file, &stat_buffer) != 0) {
+    return -errno;
+  }
+  return stat_buffer.st_size;
+}
+
+}  // namespace internal
+
 }  // namespace fml
@@ -17,6 +17,7 @@
 #include <optional>
 #include <sstream>
 
+#include "flutter/fml/async_file_io.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/platform/win/errors_win.h"
@@ -436,4 +437,41 @@ bool VisitFiles(const fml::UniqueFD& directory, const FileVisitor& visitor) {
   return true;
 }
 
+namespace internal {
+
+int64_t PerformFileOperation(const AsyncFileIO::Operation& operation) {
+  if (operation.type == AsyncFileIO::Operation::Type::kFsync) {
+    return ::FlushFileBuffers(operation.file) ? 0 : -1;
+  }
+
+  OVERLAPPED overlapped = {};
+  overlapped.Offset = static_cast<DWORD>(operation.offset & 0xffffffff);
+  overlapped.OffsetHigh = static_cast<DWORD>(operation.offset >> 32);
+  const DWORD length =
+      static_cast<DWORD>(std::min<size_t>(operation.length, MAXDWORD));
+  DWORD transferred = 0;
+  BOOL success = FALSE;
+  if (operation.type == AsyncFileIO::Operation::Type::kRead) {
+    success = ::ReadFile(operation.file, operation.buffer, length,
+                         &transferred, &overlapped);
+    if (!success && ::GetLastError() == ERROR_HANDLE_EOF) {
+      return 0;
+    }
+  } else {
+    success = ::WriteFile(operation.file, operation.buffer, length,
+                          &transferred, &overlapped);
+  }
+  return success ? static_cast<int64_t>(transferred) : -1;
+}
+
+int64_t GetFileSize(HANDLE file) {
+  LARGE_INTEGER size;
+  if (!::GetFileSizeEx(file, &size)) {
+    return -1;
+  }
+  return size.QuadPart;
+}
+
+}  // namespace internal
+
 }  // namespace fml
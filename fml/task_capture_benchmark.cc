@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This benchmark replaces the global allocation functions to count the heap
+// allocations made by each task. It is built as its own executable so that
+// the other benchmarks keep the default allocator.
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/closure.h"
+#include "flutter/fml/message_loop_task_queues.h"
+
+namespace {
+
+// The number of heap allocations made on this thread while a
+// |CountAllocations| is alive.
+thread_local size_t* allocation_counter = nullptr;
+
+class CountAllocations {
+ public:
+  explicit CountAllocations(size_t& counter) { allocation_counter = &counter; }
+
+  ~CountAllocations() { allocation_counter = nullptr; }
+};
+
+void* CountedAllocate(size_t size) {
+  if (allocation_counter) {
+    (*allocation_counter)++;
+  }
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  // The engine is built without exceptions, so |std::bad_alloc| can't be
+  // thrown. Running out of memory in a benchmark is fatal anyway.
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+void* CountedAllocateAligned(size_t size, std::align_val_t alignment) {
+  if (allocation_counter) {
+    (*allocation_counter)++;
+  }
+  const auto align = static_cast<size_t>(alignment);
+  // |std::aligned_alloc| requires the size to be a multiple of the alignment.
+  const size_t aligned_size = (std::max<size_t>(size, 1) + align - 1) &
+                              ~(align - 1);
+  void* pointer = std::aligned_alloc(align, aligned_size);
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+  return CountedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer,
+                     size_t size,
+                     std::align_val_t alignment) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer,
+                       size_t size,
+                       std::align_val_t alignment) noexcept {
+  std::free(pointer);
+}
+
+namespace fml {
+namespace benchmarking {
+
+// Measures the cost of posting and running tasks whose captures resemble the
+// ones engine tasks typically carry (a few pointers and reference counted
+// objects). The |AllocationsPerTask| counter reports the heap allocations
+// made while creating, registering and running a task. Tasks created as an
+// |fml::closure| show the cost of the previous task type.
+template <class Closure>
+static void BM_RegisterAndRunTasksWithCaptures(
+    benchmark::State& state) {  // NOLINT
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queue->CreateTaskQueue();
+  const int num_tasks = state.range(0);
+  auto shared = std::make_shared<int>(0);
+  size_t allocations = 0;
+  while (state.KeepRunning()) {
+    const auto now = fml::TimePoint::Now();
+    CountAllocations count_allocations(allocations);
+    for (int i = 0; i < num_tasks; i++) {
+      Closure task = [shared, i, task_queue, queue_id]() { *shared += i; };
+      task_queue->RegisterTask(queue_id, std::move(task), now);
+    }
+    for (;;) {
+      fml::UniqueClosure invocation =
+          task_queue->GetNextTaskToRun(queue_id, now);
+      if (!invocation) {
+        break;
+      }
+      invocation();
+    }
+  }
+  state.counters["AllocationsPerTask"] =
+      benchmark::Counter(static_cast<double>(allocations) /
+                             std::max<int64_t>(state.iterations(), 1) /
+                             num_tasks);
+  task_queue->Dispose(queue_id);
+}
+
+BENCHMARK_TEMPLATE(BM_RegisterAndRunTasksWithCaptures, fml::UniqueClosure)
+    ->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_RegisterAndRunTasksWithCaptures, fml::closure)
+    ->Range(8, 1024);
+
+}  // namespace benchmarking
+}  // namespace fml
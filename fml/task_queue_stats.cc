@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_queue_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+size_t Log2Histogram::BucketForValue(uint64_t value) {
+  size_t bucket = 0;
+  while (value != 0 && bucket < kBucketCount - 1) {
+    value >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void Log2Histogram::AddSample(uint64_t value) {
+  buckets_[BucketForValue(value)]++;
+  count_++;
+  sum_ += value;
+  max_ = std::max(max_, value);
+}
+
+uint64_t Log2Histogram::GetPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto target = static_cast<uint64_t>(
+      std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * count_));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i];
+    if (seen >= target && buckets_[i] > 0) {
+      if (i == kBucketCount - 1) {
+        return max_;
+      }
+      return std::min<uint64_t>(uint64_t{1} << i, max_);
+    }
+  }
+  return max_;
+}
+
+static size_t IndexForGrade(TaskSourceGrade grade) {
+  switch (grade) {
+    case TaskSourceGrade::kUserInteraction:
+      return 0;
+    case TaskSourceGrade::kDartEventLoop:
+      return 1;
+    case TaskSourceGrade::kUnspecified:
+      return 2;
+  }
+  FML_UNREACHABLE();
+}
+
+void TaskQueueStats::RecordTask(TaskSourceGrade grade,
+                                fml::TimeDelta latency,
+                                fml::TimeDelta duration,
+                                size_t queue_depth) {
+  auto& stats = grades_[IndexForGrade(grade)];
+  stats.latency_us.AddSample(std::max<int64_t>(latency.ToMicroseconds(), 0));
+  stats.duration_us.AddSample(std::max<int64_t>(duration.ToMicroseconds(), 0));
+  stats.queue_depth.AddSample(queue_depth);
+}
+
+const TaskGradeStats& TaskQueueStats::GetGradeStats(
+    TaskSourceGrade grade) const {
+  return grades_[IndexForGrade(grade)];
+}
+
+const char* TaskQueueStats::GetGradeName(TaskSourceGrade grade) {
+  switch (grade) {
+    case TaskSourceGrade::kUserInteraction:
+      return "userInteraction";
+    case TaskSourceGrade::kDartEventLoop:
+      return "dartEventLoop";
+    case TaskSourceGrade::kUnspecified:
+      return "unspecified";
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace fml
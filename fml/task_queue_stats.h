@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_QUEUE_STATS_H_
+#define FLUTTER_FML_TASK_QUEUE_STATS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/task_source_grade.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A fixed-size histogram with power-of-two bucket boundaries.
+///
+///             Bucket 0 counts samples of value 0. Bucket `i` (for `i > 0`)
+///             counts samples in `[2^(i-1), 2^i)`. The last bucket is open
+///             ended. Recording a sample never allocates.
+///
+class Log2Histogram {
+ public:
+  static constexpr size_t kBucketCount = 24;
+
+  void AddSample(uint64_t value);
+
+  uint64_t GetCount() const { return count_; }
+
+  uint64_t GetSum() const { return sum_; }
+
+  uint64_t GetMax() const { return max_; }
+
+  const std::array<uint64_t, kBucketCount>& GetBuckets() const {
+    return buckets_;
+  }
+
+  /// Returns the exclusive upper bound of the bucket containing the given
+  /// percentile (in `[0, 100]`), clamped to the largest recorded sample.
+  /// Returns 0 if no samples have been recorded.
+  uint64_t GetPercentile(double percentile) const;
+
+  static size_t BucketForValue(uint64_t value);
+
+ private:
+  std::array<uint64_t, kBucketCount> buckets_ = {};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The histograms collected for tasks of one `TaskSourceGrade` in
+///             one task queue.
+///
+struct TaskGradeStats {
+  /// Time between a task becoming runnable (its target time) and it starting
+  /// to run, in microseconds. High values indicate starvation.
+  Log2Histogram latency_us;
+  /// Time spent running the task, in microseconds. High values indicate slow
+  /// tasks.
+  Log2Histogram duration_us;
+  /// The number of tasks pending in the queue when the task was picked.
+  Log2Histogram queue_depth;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Task timing statistics for a single task queue, broken down by
+///             `TaskSourceGrade`.
+///
+class TaskQueueStats {
+ public:
+  static constexpr size_t kGradeCount = 3;
+
+  void RecordTask(TaskSourceGrade grade,
+                  fml::TimeDelta latency,
+                  fml::TimeDelta duration,
+                  size_t queue_depth);
+
+  const TaskGradeStats& GetGradeStats(TaskSourceGrade grade) const;
+
+  static const char* GetGradeName(TaskSourceGrade grade);
+
+ private:
+  std::array<TaskGradeStats, kGradeCount> grades_;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_QUEUE_STATS_H_
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_queue_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskQueueStatsTest, HistogramBuckets) {
+  EXPECT_EQ(Log2Histogram::BucketForValue(0), 0u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(1), 1u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(2), 2u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(3), 2u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(4), 3u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(1000), 10u);
+  EXPECT_EQ(Log2Histogram::BucketForValue(UINT64_MAX),
+            Log2Histogram::kBucketCount - 1);
+}
+
+TEST(TaskQueueStatsTest, HistogramAccumulatesSamples) {
+  Log2Histogram histogram;
+  EXPECT_EQ(histogram.GetPercentile(50), 0u);
+  for (uint64_t i = 0; i < 100; i++) {
+    histogram.AddSample(i < 90 ? 10 : 1000);
+  }
+  EXPECT_EQ(histogram.GetCount(), 100u);
+  EXPECT_EQ(histogram.GetSum(), 90u * 10u + 10u * 1000u);
+  EXPECT_EQ(histogram.GetMax(), 1000u);
+  EXPECT_EQ(histogram.GetBuckets()[4], 90u);
+  EXPECT_EQ(histogram.GetBuckets()[10], 10u);
+  // Percentiles report the upper bound of the bucket.
+  EXPECT_EQ(histogram.GetPercentile(50), 16u);
+  EXPECT_EQ(histogram.GetPercentile(90), 16u);
+  EXPECT_EQ(histogram.GetPercentile(99), 1000u);
+}
+
+TEST(TaskQueueStatsTest, RecordsPerGrade) {
+  TaskQueueStats stats;
+  stats.RecordTask(TaskSourceGrade::kUserInteraction,
+                   fml::TimeDelta::FromMilliseconds(2),
+                   fml::TimeDelta::FromMicroseconds(100), 3);
+  stats.RecordTask(TaskSourceGrade::kDartEventLoop,
+                   fml::TimeDelta::FromMicroseconds(-5),
+                   fml::TimeDelta::FromMicroseconds(7), 0);
+
+  const auto& user = stats.GetGradeStats(TaskSourceGrade::kUserInteraction);
+  EXPECT_EQ(user.latency_us.GetCount(), 1u);
+  EXPECT_EQ(user.latency_us.GetMax(), 2000u);
+  EXPECT_EQ(user.duration_us.GetMax(), 100u);
+  EXPECT_EQ(user.queue_depth.GetMax(), 3u);
+
+  const auto& dart = stats.GetGradeStats(TaskSourceGrade::kDartEventLoop);
+  EXPECT_EQ(dart.latency_us.GetCount(), 1u);
+  // Tasks that ran before their target time are clamped to zero latency.
+  EXPECT_EQ(dart.latency_us.GetMax(), 0u);
+
+  EXPECT_EQ(stats.GetGradeStats(TaskSourceGrade::kUnspecified)
+                .latency_us.GetCount(),
+            0u);
+}
+
+}  // namespace testing
+}  // namespace fml
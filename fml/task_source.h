@@ -6,6 +6,7 @@
 #define FLUTTER_FML_TASK_SOURCE_H_
 
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/delayed_task_wheel.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
 
@@ -18,7 +19,9 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. Each heap is backed by a `DelayedTaskWheel` so that registering a task
+ * for the future is constant time regardless of how many timers are pending.
+ * A task that is already due only costs a heap push over the due tasks.
  *
  * Registering Tasks
  * -----------------
@@ -49,10 +52,11 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and returns the
+  /// closure of the popped task.
+  fml::UniqueClosure PopTask(TaskSourceGrade grade);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -73,8 +77,8 @@ class TaskSource {
 
  private:
   const fml::TaskQueueId task_queue_id_;
-  fml::DelayedTaskQueue primary_task_queue_;
-  fml::DelayedTaskQueue secondary_task_queue_;
+  fml::DelayedTaskWheel primary_task_queue_;
+  fml::DelayedTaskWheel secondary_task_queue_;
   int secondary_pause_requests_ = 0;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
@@ -13,6 +13,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_recorder.h"
 
 #if defined(FML_OS_WIN)
 #include <windows.h>
@@ -105,6 +106,7 @@ void SetThreadName(const std::string& name) {
   if (name == "") {
     return;
   }
+  tracing::TraceRecorder::GetInstance().SetCurrentThreadName(name);
 #if defined(FML_OS_MACOSX)
   pthread_setname_np(name.c_str());
 #elif defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
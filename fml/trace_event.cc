@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
@@ -27,6 +28,11 @@ AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
+// Events stamped with a negative `timestamp0` happened now. The timeline
+// handler gets the time from the timeline micros source, the recorder from its
+// own clock, so that every event it holds uses the same clock.
+constexpr int64_t kNow = -1;
+
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
@@ -38,9 +44,20 @@ inline void FlutterTimelineEvent(const char* label,
                                  const char** argument_values) {
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
-  if (handler && gAllowlist.Query(label)) {
-    handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
-            type, argument_count, argument_names, argument_values);
+  const bool recording = TraceRecorder::IsInstanceRecording();
+  if ((!handler && !recording) || !gAllowlist.Query(label)) {
+    return;
+  }
+  if (handler) {
+    handler(label,
+            timestamp0 >= 0 ? timestamp0 : gTimelineMicrosSource.load()(),
+            timestamp1_or_async_id, flow_id_count, flow_ids, type,
+            argument_count, argument_names, argument_values);
+  }
+  if (recording) {
+    TraceRecorder::GetInstance().Record(
+        label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
+        type, argument_count, argument_names, argument_values);
   }
 }
 }  // namespace
@@ -110,15 +127,15 @@ void TraceTimelineEvent(TraceArg category_group,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {
-  TraceTimelineEvent(category_group,                  // group
-                     name,                            // name
-                     gTimelineMicrosSource.load()(),  // timestamp_micros
-                     identifier,                      // identifier
-                     flow_id_count,                   // flow_id_count
-                     flow_ids,                        // flow_ids
-                     type,                            // type
-                     c_names,                         // names
-                     values                           // values
+  TraceTimelineEvent(category_group,  // group
+                     name,            // name
+                     kNow,            // timestamp_micros
+                     identifier,      // identifier
+                     flow_id_count,   // flow_id_count
+                     flow_ids,        // flow_ids
+                     type,            // type
+                     c_names,         // names
+                     values           // values
   );
 }
 
@@ -126,8 +143,8 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -146,8 +163,8 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -168,8 +185,8 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -181,8 +198,8 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,                     // label
+                       kNow,                     // timestamp0
                        0,                        // timestamp1_or_async_id
                        0,                        // flow_id_count
                        nullptr,                  // flow_ids
@@ -198,8 +215,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceIDArg id,
                            size_t flow_id_count,
                            const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -213,8 +230,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,                           // label
+                       kNow,                           // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -234,8 +251,8 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -253,8 +270,8 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,                           // label
+                       kNow,                           // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -269,8 +286,8 @@ void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -289,8 +306,8 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -311,8 +328,8 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,           // label
+                       kNow,           // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -326,8 +343,8 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,     // label
+                       kNow,     // timestamp0
                        id,       // timestamp1_or_async_id
                        0,        // flow_id_count
                        nullptr,  // flow_ids
@@ -341,8 +358,8 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,                           // label
+                       kNow,                           // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -354,8 +371,8 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(name,                          // label
+                       kNow,                          // timestamp0
                        id,                            // timestamp1_or_async_id
                        0,                             // flow_id_count
                        nullptr,                       // flow_ids
@@ -0,0 +1,845 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string_view>
+#include <tuple>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// The fixed-size serialized form of an event in a ring buffer slot. Strings
+// are stored inline and truncated to fit.
+struct EventPayload {
+  int64_t timestamp0;
+  int64_t timestamp1_or_id;
+  int64_t flow_ids[TraceRecorder::kMaxFlowIds];
+  int32_t type;
+  uint16_t flow_id_count;
+  uint16_t argument_count;
+  char label[TraceRecorder::kMaxLabelLength + 1];
+  // |argument_count| pairs of null terminated names and values.
+  char arguments[144];
+};
+
+constexpr size_t kPayloadWords = sizeof(EventPayload) / sizeof(uint64_t);
+
+static_assert(std::is_trivially_copyable_v<EventPayload>);
+static_assert(sizeof(EventPayload) % sizeof(uint64_t) == 0);
+
+// A ring buffer slot guarded by a sequence lock. The payload is stored as
+// relaxed atomic words so that a reader racing with the owning thread sees a
+// torn (and then discarded) event rather than a data race.
+struct Slot {
+  // 2 * index + 1 while the event at |index| is being written, 2 * index + 2
+  // once it has been written.
+  std::atomic<uint64_t> sequence = 0;
+  std::atomic<uint64_t> words[kPayloadWords] = {};
+};
+
+static_assert(sizeof(Slot) == TraceRecorder::kSlotSize);
+
+// There is no portable process identifier in FML. All threads are reported as
+// belonging to the same synthetic process.
+constexpr int64_t kProcessId = 1;
+
+std::atomic<uint64_t> gLastRecorderId;
+
+// Mirrors the recording state of |TraceRecorder::GetInstance| so that trace
+// events can check it without initializing the instance.
+std::atomic_bool gInstanceRecording;
+
+size_t CopyTruncated(char* destination, size_t capacity, const char* source) {
+  FML_DCHECK(capacity > 0);
+  if (source == nullptr) {
+    destination[0] = '\0';
+    return 1;
+  }
+  const size_t length = strnlen(source, capacity - 1);
+  memcpy(destination, source, length);
+  destination[length] = '\0';
+  return length + 1;
+}
+
+}  // namespace
+
+struct TraceRecorder::ThreadBuffer {
+  explicit ThreadBuffer(size_t p_capacity)
+      : capacity(std::max<size_t>(p_capacity, 1)),
+        slots(std::make_unique<Slot[]>(capacity)) {}
+
+  const size_t capacity;
+  const std::unique_ptr<Slot[]> slots;
+  // The index of the next event to write. Only advanced by the owning thread.
+  std::atomic<uint64_t> head = 0;
+  // Events before this index have been cleared.
+  std::atomic<uint64_t> start = 0;
+  // Whether a live thread currently owns this buffer.
+  std::atomic_bool in_use = true;
+  // Guarded by the |buffers_mutex_| of the recorder.
+  int64_t thread_id = 0;
+  std::string thread_name;
+
+  void Write(const EventPayload& payload) {
+    uint64_t words[kPayloadWords];
+    memcpy(words, &payload, sizeof(words));
+
+    const uint64_t index = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % capacity];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kPayloadWords; i++) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    head.store(index + 1, std::memory_order_release);
+  }
+
+  bool Read(uint64_t index, EventPayload* payload) const {
+    const Slot& slot = slots[index % capacity];
+    const uint64_t expected = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+      return false;
+    }
+    uint64_t words[kPayloadWords];
+    for (size_t i = 0; i < kPayloadWords; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+      return false;
+    }
+    memcpy(payload, words, sizeof(words));
+    return true;
+  }
+};
+
+namespace {
+
+// Trivially destructible so that it may still be consulted by trace events
+// emitted from the destructors of other thread locals.
+struct CurrentThreadState {
+  uint64_t recorder_id = 0;
+  void* buffer = nullptr;
+  bool exited = false;
+  char thread_name[TraceRecorder::kMaxLabelLength + 1] = {};
+};
+
+thread_local CurrentThreadState tls_state;
+
+// Hands the ring buffer of the thread back to the recorder when the thread
+// exits so that it can be reused by another thread.
+struct ThreadExitObserver {
+  std::shared_ptr<void> buffer;
+  std::atomic_bool* in_use = nullptr;
+
+  void Release() {
+    if (in_use) {
+      in_use->store(false, std::memory_order_release);
+    }
+    in_use = nullptr;
+    buffer.reset();
+  }
+
+  ~ThreadExitObserver() {
+    Release();
+    tls_state.buffer = nullptr;
+    tls_state.exited = true;
+  }
+};
+
+thread_local ThreadExitObserver tls_exit_observer;
+
+}  // namespace
+
+TraceRecorder& TraceRecorder::GetInstance() {
+  static TraceRecorder* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+TraceRecorder::TraceRecorder() : recorder_id_(++gLastRecorderId) {}
+
+TraceRecorder::~TraceRecorder() = default;
+
+bool TraceRecorder::IsInstanceRecording() {
+  return gInstanceRecording.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::Start(size_t events_per_thread) {
+  events_per_thread_ = events_per_thread;
+  recording_ = true;
+  if (this == &GetInstance()) {
+    gInstanceRecording = true;
+  }
+}
+
+void TraceRecorder::Stop() {
+  recording_ = false;
+  if (this == &GetInstance()) {
+    gInstanceRecording = false;
+  }
+}
+
+void TraceRecorder::Clear() {
+  std::scoped_lock lock(buffers_mutex_);
+  for (const auto& buffer : buffers_) {
+    buffer->start.store(buffer->head.load(std::memory_order_acquire),
+                        std::memory_order_release);
+  }
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::GetCurrentThreadBuffer() {
+  auto& state = tls_state;
+  if (state.recorder_id == recorder_id_ && state.buffer != nullptr) {
+    return static_cast<ThreadBuffer*>(state.buffer);
+  }
+  if (state.exited) {
+    return nullptr;
+  }
+
+  auto& observer = tls_exit_observer;
+  observer.Release();
+
+  std::scoped_lock lock(buffers_mutex_);
+  std::shared_ptr<ThreadBuffer> buffer;
+  // Reuse the buffer of a thread that has exited so that short lived threads
+  // do not grow memory use without bound. Its events are cleared so that
+  // they are not attributed to the new thread.
+  for (const auto& candidate : buffers_) {
+    bool in_use = false;
+    if (candidate->in_use.compare_exchange_strong(in_use, true,
+                                                  std::memory_order_acquire)) {
+      buffer = candidate;
+      buffer->start.store(buffer->head.load(std::memory_order_relaxed),
+                          std::memory_order_release);
+      break;
+    }
+  }
+  if (!buffer) {
+    buffer = std::make_shared<ThreadBuffer>(events_per_thread_.load());
+    buffers_.push_back(buffer);
+  }
+  buffer->thread_id = static_cast<int64_t>(++last_thread_id_);
+  buffer->thread_name = state.thread_name;
+
+  observer.buffer = buffer;
+  observer.in_use = &buffer->in_use;
+  state.recorder_id = recorder_id_;
+  state.buffer = buffer.get();
+  return buffer.get();
+}
+
+void TraceRecorder::SetCurrentThreadName(const std::string& name) {
+  auto& state = tls_state;
+  CopyTruncated(state.thread_name, sizeof(state.thread_name), name.c_str());
+  if (state.recorder_id == recorder_id_ && state.buffer != nullptr) {
+    std::scoped_lock lock(buffers_mutex_);
+    static_cast<ThreadBuffer*>(state.buffer)->thread_name = state.thread_name;
+  }
+}
+
+void TraceRecorder::Record(const char* label,
+                           int64_t timestamp0,
+                           int64_t timestamp1_or_async_id,
+                           intptr_t flow_id_count,
+                           const int64_t* flow_ids,
+                           Dart_Timeline_Event_Type type,
+                           intptr_t argument_count,
+                           const char** argument_names,
+                           const char** argument_values) {
+  if (!IsRecording()) {
+    return;
+  }
+  ThreadBuffer* buffer = GetCurrentThreadBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+
+  EventPayload payload = {};
+  payload.timestamp0 =
+      timestamp0 >= 0
+          ? timestamp0
+          : fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  payload.timestamp1_or_id = timestamp1_or_async_id;
+  payload.type = static_cast<int32_t>(type);
+  payload.flow_id_count = static_cast<uint16_t>(
+      std::clamp<intptr_t>(flow_id_count, 0, kMaxFlowIds));
+  for (size_t i = 0; i < payload.flow_id_count; i++) {
+    payload.flow_ids[i] = flow_ids[i];
+  }
+  CopyTruncated(payload.label, sizeof(payload.label), label);
+
+  size_t offset = 0;
+  for (intptr_t i = 0; i < argument_count; i++) {
+    // Each argument needs at least the two terminators.
+    const size_t remaining = sizeof(payload.arguments) - offset;
+    if (remaining < 2) {
+      break;
+    }
+    // Leave at least one byte for the value.
+    offset += CopyTruncated(payload.arguments + offset, remaining - 1,
+                            argument_names[i]);
+    offset += CopyTruncated(payload.arguments + offset,
+                            sizeof(payload.arguments) - offset,
+                            argument_values[i]);
+    payload.argument_count++;
+  }
+
+  buffer->Write(payload);
+}
+
+std::vector<TraceRecorder::ThreadEvents> TraceRecorder::Snapshot() const {
+  std::vector<ThreadEvents> result;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffers = buffers_;
+    for (const auto& buffer : buffers) {
+      ThreadEvents thread;
+      thread.thread_id = buffer->thread_id;
+      thread.thread_name = buffer->thread_name;
+      result.emplace_back(std::move(thread));
+    }
+  }
+
+  for (size_t i = 0; i < buffers.size(); i++) {
+    const ThreadBuffer& buffer = *buffers[i];
+    ThreadEvents& thread = result[i];
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    uint64_t first = buffer.start.load(std::memory_order_acquire);
+    if (head > buffer.capacity) {
+      first = std::max<uint64_t>(first, head - buffer.capacity);
+    }
+    thread.events.reserve(head > first ? head - first : 0);
+
+    EventPayload payload;
+    for (uint64_t index = first; index < head; index++) {
+      if (!buffer.Read(index, &payload)) {
+        continue;
+      }
+      Event event;
+      event.type = static_cast<Dart_Timeline_Event_Type>(payload.type);
+      event.label = payload.label;
+      event.timestamp_micros = payload.timestamp0;
+      event.timestamp1_or_id = payload.timestamp1_or_id;
+      event.flow_ids.assign(payload.flow_ids,
+                            payload.flow_ids + payload.flow_id_count);
+      const char* cursor = payload.arguments;
+      const char* end = payload.arguments + sizeof(payload.arguments);
+      for (size_t arg = 0; arg < payload.argument_count && cursor < end;
+           arg++) {
+        std::string name = cursor;
+        cursor += name.size() + 1;
+        std::string value = cursor < end ? cursor : "";
+        cursor += value.size() + 1;
+        event.arguments.emplace_back(std::move(name), std::move(value));
+      }
+      thread.events.emplace_back(std::move(event));
+    }
+  }
+
+  result.erase(std::remove_if(result.begin(), result.end(),
+                              [](const ThreadEvents& thread) {
+                                return thread.events.empty();
+                              }),
+               result.end());
+  return result;
+}
+
+bool TraceRecorder::WriteToFile(const fml::UniqueFD& directory,
+                                const char* file_name,
+                                Format format) const {
+  auto mapping = Serialize(Snapshot(), format);
+  return fml::WriteAtomically(directory, file_name, *mapping);
+}
+
+std::unique_ptr<fml::Mapping> TraceRecorder::Serialize(
+    const std::vector<ThreadEvents>& threads,
+    Format format) {
+  std::string data;
+  switch (format) {
+    case Format::kChromeJSON:
+      data = SerializeChromeJSON(threads);
+      break;
+    case Format::kPerfettoProto:
+      data = SerializePerfettoProto(threads);
+      break;
+  }
+  return std::make_unique<fml::DataMapping>(data);
+}
+
+//------------------------------------------------------------------------------
+// Chrome JSON
+//------------------------------------------------------------------------------
+
+namespace {
+
+void AppendJSONString(std::string& out, std::string_view value) {
+  out.push_back('"');
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out.append(escaped);
+        } else {
+          out.push_back(c);
+        }
+        break;
+    }
+  }
+  out.push_back('"');
+}
+
+void AppendHexID(std::string& out, int64_t id) {
+  char hex[24];
+  snprintf(hex, sizeof(hex), "\"0x%" PRIx64 "\"", static_cast<uint64_t>(id));
+  out.append(hex);
+}
+
+bool IsNumber(const std::string& value) {
+  if (value.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  strtod(value.c_str(), &end);
+  return end == value.c_str() + value.size();
+}
+
+void AppendJSONArguments(std::string& out,
+                         const TraceRecorder::Event& event,
+                         bool numeric) {
+  out.append(",\"args\":{");
+  for (size_t i = 0; i < event.arguments.size(); i++) {
+    const auto& [name, value] = event.arguments[i];
+    if (i > 0) {
+      out.push_back(',');
+    }
+    AppendJSONString(out, name);
+    out.push_back(':');
+    if (numeric && IsNumber(value)) {
+      out.append(value);
+    } else {
+      AppendJSONString(out, value);
+    }
+  }
+  out.push_back('}');
+}
+
+const char* ChromePhaseForType(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+std::string TraceRecorder::SerializeChromeJSON(
+    const std::vector<ThreadEvents>& threads) {
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first_event = true;
+  auto begin_event = [&]() {
+    if (!first_event) {
+      out.push_back(',');
+    }
+    first_event = false;
+    out.push_back('\n');
+  };
+  const std::string pid = std::to_string(kProcessId);
+
+  for (const auto& thread : threads) {
+    const std::string tid = std::to_string(thread.thread_id);
+    if (!thread.thread_name.empty()) {
+      begin_event();
+      out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid +
+                 ",\"tid\":" + tid + ",\"args\":{\"name\":");
+      AppendJSONString(out, thread.thread_name);
+      out.append("}}");
+    }
+
+    for (const auto& event : thread.events) {
+      const char* phase = ChromePhaseForType(event.type);
+      if (phase == nullptr) {
+        continue;
+      }
+      begin_event();
+      out.append("{\"name\":");
+      AppendJSONString(out, event.label);
+      out.append(",\"cat\":\"flutter\",\"ph\":\"");
+      out.append(phase);
+      out.append("\",\"pid\":" + pid + ",\"tid\":" + tid +
+                 ",\"ts\":" + std::to_string(event.timestamp_micros));
+      switch (event.type) {
+        case Dart_Timeline_Event_Duration:
+          out.append(",\"dur\":" +
+                     std::to_string(std::max<int64_t>(
+                         event.timestamp1_or_id - event.timestamp_micros, 0)));
+          break;
+        case Dart_Timeline_Event_Instant:
+          out.append(",\"s\":\"t\"");
+          break;
+        case Dart_Timeline_Event_Async_Begin:
+        case Dart_Timeline_Event_Async_End:
+        case Dart_Timeline_Event_Async_Instant:
+        case Dart_Timeline_Event_Flow_Begin:
+        case Dart_Timeline_Event_Flow_Step:
+        case Dart_Timeline_Event_Flow_End:
+          out.append(",\"id\":");
+          AppendHexID(out, event.timestamp1_or_id);
+          if (event.type == Dart_Timeline_Event_Flow_End) {
+            out.append(",\"bp\":\"e\"");
+          }
+          break;
+        default:
+          break;
+      }
+      if (!event.flow_ids.empty()) {
+        out.append(",\"bind_id\":");
+        AppendHexID(out, event.flow_ids.front());
+        out.append(",\"flow_in\":true,\"flow_out\":true");
+      }
+      if (!event.arguments.empty()) {
+        AppendJSONArguments(out, event,
+                            event.type == Dart_Timeline_Event_Counter);
+      }
+      out.push_back('}');
+    }
+  }
+  out.append("\n]}\n");
+  return out;
+}
+
+//------------------------------------------------------------------------------
+// Perfetto protobuf
+//------------------------------------------------------------------------------
+
+namespace {
+
+// A minimal protobuf wire format encoder for the handful of messages in
+// perfetto/protos/perfetto/trace/trace.proto used below.
+class ProtoWriter {
+ public:
+  void WriteVarint(uint32_t field, uint64_t value) {
+    WriteTag(field, 0);
+    AppendVarint(value);
+  }
+
+  void WriteFixed64(uint32_t field, uint64_t value) {
+    WriteTag(field, 1);
+    for (size_t i = 0; i < 8; i++) {
+      data_.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+  }
+
+  void WriteBytes(uint32_t field, std::string_view value) {
+    WriteTag(field, 2);
+    AppendVarint(value.size());
+    data_.append(value);
+  }
+
+  void WriteMessage(uint32_t field, const ProtoWriter& message) {
+    WriteBytes(field, message.data_);
+  }
+
+  const std::string& GetData() const { return data_; }
+
+ private:
+  std::string data_;
+
+  void WriteTag(uint32_t field, uint32_t wire_type) {
+    AppendVarint((static_cast<uint64_t>(field) << 3) | wire_type);
+  }
+
+  void AppendVarint(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+};
+
+// Field numbers from the Perfetto trace protos.
+namespace proto {
+constexpr uint32_t kTracePacket = 1;  // Trace.packet
+
+constexpr uint32_t kPacketTimestamp = 8;
+constexpr uint32_t kPacketSequenceId = 10;
+constexpr uint32_t kPacketTrackEvent = 11;
+constexpr uint32_t kPacketTrackDescriptor = 60;
+
+constexpr uint32_t kTrackUuid = 1;
+constexpr uint32_t kTrackName = 2;
+constexpr uint32_t kTrackProcess = 3;
+constexpr uint32_t kTrackThread = 4;
+constexpr uint32_t kTrackParentUuid = 5;
+constexpr uint32_t kTrackCounter = 8;
+
+constexpr uint32_t kProcessPid = 1;
+
+constexpr uint32_t kThreadPid = 1;
+constexpr uint32_t kThreadTid = 2;
+constexpr uint32_t kThreadName = 5;
+
+constexpr uint32_t kEventDebugAnnotations = 4;
+constexpr uint32_t kEventType = 9;
+constexpr uint32_t kEventTrackUuid = 11;
+constexpr uint32_t kEventCategories = 22;
+constexpr uint32_t kEventName = 23;
+constexpr uint32_t kEventCounterValue = 30;
+constexpr uint32_t kEventFlowIds = 47;
+constexpr uint32_t kEventTerminatingFlowIds = 48;
+
+constexpr uint32_t kAnnotationStringValue = 6;
+constexpr uint32_t kAnnotationName = 10;
+
+constexpr uint64_t kTypeSliceBegin = 1;
+constexpr uint64_t kTypeSliceEnd = 2;
+constexpr uint64_t kTypeInstant = 3;
+constexpr uint64_t kTypeCounter = 4;
+}  // namespace proto
+
+constexpr uint32_t kSequenceId = 1;
+constexpr uint64_t kProcessTrackUuid = 1;
+constexpr uint64_t kThreadTrackUuidBase = uint64_t{1} << 32;
+constexpr uint64_t kDerivedTrackUuidBase = uint64_t{2} << 32;
+
+class PerfettoTraceWriter {
+ public:
+  PerfettoTraceWriter() {
+    ProtoWriter process;
+    process.WriteVarint(proto::kProcessPid, kProcessId);
+    ProtoWriter track;
+    track.WriteVarint(proto::kTrackUuid, kProcessTrackUuid);
+    track.WriteMessage(proto::kTrackProcess, process);
+    WriteTrackDescriptor(track);
+  }
+
+  uint64_t AddThreadTrack(const TraceRecorder::ThreadEvents& thread) {
+    const uint64_t uuid = kThreadTrackUuidBase + thread.thread_id;
+    ProtoWriter descriptor;
+    descriptor.WriteVarint(proto::kThreadPid, kProcessId);
+    descriptor.WriteVarint(proto::kThreadTid, thread.thread_id);
+    if (!thread.thread_name.empty()) {
+      descriptor.WriteBytes(proto::kThreadName, thread.thread_name);
+    }
+    ProtoWriter track;
+    track.WriteVarint(proto::kTrackUuid, uuid);
+    track.WriteVarint(proto::kTrackParentUuid, kProcessTrackUuid);
+    track.WriteMessage(proto::kTrackThread, descriptor);
+    WriteTrackDescriptor(track);
+    return uuid;
+  }
+
+  // Returns the track for async events with the given name and identifier.
+  uint64_t GetAsyncTrack(const std::string& name, int64_t id) {
+    auto key = std::make_tuple(false, name, id);
+    auto found = derived_tracks_.find(key);
+    if (found != derived_tracks_.end()) {
+      return found->second;
+    }
+    const uint64_t uuid = kDerivedTrackUuidBase + derived_tracks_.size();
+    derived_tracks_[key] = uuid;
+    ProtoWriter track;
+    track.WriteVarint(proto::kTrackUuid, uuid);
+    track.WriteVarint(proto::kTrackParentUuid, kProcessTrackUuid);
+    track.WriteBytes(proto::kTrackName, name);
+    WriteTrackDescriptor(track);
+    return uuid;
+  }
+
+  // Returns the track for values of counter |name| of counter event |label|.
+  uint64_t GetCounterTrack(const std::string& label, const std::string& name) {
+    auto key = std::make_tuple(true, label + " " + name, 0);
+    auto found = derived_tracks_.find(key);
+    if (found != derived_tracks_.end()) {
+      return found->second;
+    }
+    const uint64_t uuid = kDerivedTrackUuidBase + derived_tracks_.size();
+    derived_tracks_[key] = uuid;
+    ProtoWriter track;
+    track.WriteVarint(proto::kTrackUuid, uuid);
+    track.WriteVarint(proto::kTrackParentUuid, kProcessTrackUuid);
+    track.WriteBytes(proto::kTrackName, std::get<1>(key));
+    track.WriteMessage(proto::kTrackCounter, ProtoWriter{});
+    WriteTrackDescriptor(track);
+    return uuid;
+  }
+
+  void WriteTrackEvent(int64_t timestamp_micros, const ProtoWriter& event) {
+    ProtoWriter packet;
+    packet.WriteVarint(proto::kPacketTimestamp,
+                       static_cast<uint64_t>(timestamp_micros) * 1000);
+    packet.WriteVarint(proto::kPacketSequenceId, kSequenceId);
+    packet.WriteMessage(proto::kPacketTrackEvent, event);
+    trace_.WriteMessage(proto::kTracePacket, packet);
+  }
+
+  const std::string& GetData() const { return trace_.GetData(); }
+
+ private:
+  ProtoWriter trace_;
+  std::map<std::tuple<bool, std::string, int64_t>, uint64_t> derived_tracks_;
+
+  void WriteTrackDescriptor(const ProtoWriter& track) {
+    ProtoWriter packet;
+    packet.WriteVarint(proto::kPacketSequenceId, kSequenceId);
+    packet.WriteMessage(proto::kPacketTrackDescriptor, track);
+    trace_.WriteMessage(proto::kTracePacket, packet);
+  }
+};
+
+ProtoWriter MakeTrackEvent(uint64_t type,
+                           uint64_t track_uuid,
+                           const TraceRecorder::Event* event) {
+  ProtoWriter writer;
+  writer.WriteVarint(proto::kEventType, type);
+  writer.WriteVarint(proto::kEventTrackUuid, track_uuid);
+  if (event == nullptr) {
+    return writer;
+  }
+  writer.WriteBytes(proto::kEventCategories, "flutter");
+  writer.WriteBytes(proto::kEventName, event->label);
+  for (const auto& [name, value] : event->arguments) {
+    ProtoWriter annotation;
+    annotation.WriteBytes(proto::kAnnotationName, name);
+    annotation.WriteBytes(proto::kAnnotationStringValue, value);
+    writer.WriteMessage(proto::kEventDebugAnnotations, annotation);
+  }
+  for (const auto flow_id : event->flow_ids) {
+    writer.WriteFixed64(proto::kEventFlowIds, flow_id);
+  }
+  return writer;
+}
+
+}  // namespace
+
+std::string TraceRecorder::SerializePerfettoProto(
+    const std::vector<ThreadEvents>& threads) {
+  PerfettoTraceWriter writer;
+  for (const auto& thread : threads) {
+    const uint64_t thread_track = writer.AddThreadTrack(thread);
+    for (const auto& event : thread.events) {
+      const int64_t ts = event.timestamp_micros;
+      switch (event.type) {
+        case Dart_Timeline_Event_Begin:
+          writer.WriteTrackEvent(
+              ts, MakeTrackEvent(proto::kTypeSliceBegin, thread_track, &event));
+          break;
+        case Dart_Timeline_Event_End:
+          writer.WriteTrackEvent(
+              ts, MakeTrackEvent(proto::kTypeSliceEnd, thread_track, nullptr));
+          break;
+        case Dart_Timeline_Event_Instant:
+          writer.WriteTrackEvent(
+              ts, MakeTrackEvent(proto::kTypeInstant, thread_track, &event));
+          break;
+        case Dart_Timeline_Event_Duration:
+          writer.WriteTrackEvent(
+              ts, MakeTrackEvent(proto::kTypeSliceBegin, thread_track, &event));
+          writer.WriteTrackEvent(
+              std::max(event.timestamp1_or_id, ts),
+              MakeTrackEvent(proto::kTypeSliceEnd, thread_track, nullptr));
+          break;
+        case Dart_Timeline_Event_Async_Begin:
+        case Dart_Timeline_Event_Async_End:
+        case Dart_Timeline_Event_Async_Instant: {
+          const uint64_t track =
+              writer.GetAsyncTrack(event.label, event.timestamp1_or_id);
+          if (event.type == Dart_Timeline_Event_Async_End) {
+            writer.WriteTrackEvent(
+                ts, MakeTrackEvent(proto::kTypeSliceEnd, track, nullptr));
+          } else {
+            const uint64_t type = event.type == Dart_Timeline_Event_Async_Begin
+                                      ? proto::kTypeSliceBegin
+                                      : proto::kTypeInstant;
+            writer.WriteTrackEvent(ts, MakeTrackEvent(type, track, &event));
+          }
+          break;
+        }
+        case Dart_Timeline_Event_Counter:
+          for (const auto& [name, value] : event.arguments) {
+            ProtoWriter counter = MakeTrackEvent(
+                proto::kTypeCounter, writer.GetCounterTrack(event.label, name),
+                nullptr);
+            counter.WriteVarint(
+                proto::kEventCounterValue,
+                static_cast<uint64_t>(strtoll(value.c_str(), nullptr, 10)));
+            writer.WriteTrackEvent(ts, counter);
+          }
+          break;
+        case Dart_Timeline_Event_Flow_Begin:
+        case Dart_Timeline_Event_Flow_Step:
+        case Dart_Timeline_Event_Flow_End: {
+          ProtoWriter flow =
+              MakeTrackEvent(proto::kTypeInstant, thread_track, &event);
+          flow.WriteFixed64(event.type == Dart_Timeline_Event_Flow_End
+                                ? proto::kEventTerminatingFlowIds
+                                : proto::kEventFlowIds,
+                            event.timestamp1_or_id);
+          writer.WriteTrackEvent(ts, flow);
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+  return writer.GetData();
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,193 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      An in-process flight recorder for engine trace events.
+///
+///             While recording, every trace event that passes the trace
+///             allowlist is copied into a fixed-size ring buffer owned by the
+///             thread that emitted it. This works independently of the Dart
+///             timeline handler, so traces are available in processes where
+///             no Dart VM (and no timeline handler) is present. Trace events
+///             are only emitted in builds with `FLUTTER_TIMELINE_ENABLED`,
+///             which excludes release builds on most platforms.
+///
+///             Recording an event never takes a lock and never allocates once
+///             the calling thread has its buffer: the event is serialized
+///             into the next slot of the ring, and the oldest event is
+///             overwritten when the ring is full. Memory use is bounded by
+///             `kSlotSize` bytes per event times the number of events per
+///             thread times the number of threads that have emitted events.
+///             Labels and arguments that do not fit in a slot are truncated.
+///
+///             The recorded events can be snapshotted at any time from any
+///             thread (for instance when jank is detected) and exported in the
+///             Chrome JSON trace format or the Perfetto protobuf trace format.
+///
+class TraceRecorder {
+ public:
+  static constexpr size_t kDefaultEventsPerThread = 4096;
+  static constexpr size_t kSlotSize = 256;
+  static constexpr size_t kMaxLabelLength = 63;
+  static constexpr size_t kMaxFlowIds = 2;
+
+  enum class Format {
+    /// The Chrome JSON trace event format. Can be loaded into
+    /// `chrome://tracing` and `ui.perfetto.dev`.
+    kChromeJSON,
+    /// The Perfetto protobuf trace format. Can be loaded into
+    /// `ui.perfetto.dev` and processed by `trace_processor`.
+    kPerfettoProto,
+  };
+
+  struct Event {
+    Dart_Timeline_Event_Type type = Dart_Timeline_Event_Begin;
+    std::string label;
+    int64_t timestamp_micros = 0;
+    /// The end timestamp for `Dart_Timeline_Event_Duration` events and the
+    /// async or flow identifier for async and flow events.
+    int64_t timestamp1_or_id = 0;
+    std::vector<int64_t> flow_ids;
+    std::vector<std::pair<std::string, std::string>> arguments;
+  };
+
+  struct ThreadEvents {
+    /// A small identifier assigned by the recorder in the order in which
+    /// threads first emitted an event. Stable for the life of the recorder.
+    int64_t thread_id = 0;
+    std::string thread_name;
+    /// The recorded events of the thread, oldest first.
+    std::vector<Event> events;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The process-wide recorder that `FlutterTimelineEvent` feeds.
+  ///
+  static TraceRecorder& GetInstance();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the instance returned by `GetInstance` is recording.
+  ///             Cheap enough to be checked on every trace event.
+  ///
+  static bool IsInstanceRecording();
+
+  TraceRecorder();
+
+  ~TraceRecorder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts copying events into per-thread ring buffers.
+  ///
+  /// @param[in]  events_per_thread  The capacity of ring buffers allocated
+  ///                                after this call. Buffers of threads that
+  ///                                already recorded events keep their size.
+  ///
+  void Start(size_t events_per_thread = kDefaultEventsPerThread);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording. Events recorded so far remain available
+  ///             to `Snapshot` until `Clear` is called.
+  ///
+  void Stop();
+
+  bool IsRecording() const {
+    return recording_.load(std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discards all events recorded so far. Safe to call while other
+  ///             threads are recording.
+  ///
+  void Clear();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an event on the ring buffer of the calling thread. The
+  ///             arguments are the same as those of a Dart timeline event
+  ///             handler. A negative `timestamp0` is replaced by the current
+  ///             time of `fml::TimePoint`, the clock used for all events
+  ///             emitted by the trace macros.
+  ///
+  void Record(const char* label,
+              int64_t timestamp0,
+              int64_t timestamp1_or_async_id,
+              intptr_t flow_id_count,
+              const int64_t* flow_ids,
+              Dart_Timeline_Event_Type type,
+              intptr_t argument_count,
+              const char** argument_names,
+              const char** argument_values);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the name reported for the calling thread in exported
+  ///             traces.
+  ///
+  void SetCurrentThreadName(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies out the events currently held in all ring buffers.
+  ///             Events being overwritten concurrently are skipped.
+  ///
+  std::vector<ThreadEvents> Snapshot() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Snapshots the recorded events and writes them to a file in
+  ///             the given directory.
+  ///
+  /// @return     Whether the file was written successfully.
+  ///
+  bool WriteToFile(const fml::UniqueFD& directory,
+                   const char* file_name,
+                   Format format) const;
+
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const std::vector<ThreadEvents>& threads,
+      Format format);
+
+  static std::string SerializeChromeJSON(
+      const std::vector<ThreadEvents>& threads);
+
+  static std::string SerializePerfettoProto(
+      const std::vector<ThreadEvents>& threads);
+
+ private:
+  struct ThreadBuffer;
+
+  const uint64_t recorder_id_;
+  std::atomic_bool recording_ = false;
+  std::atomic_size_t events_per_thread_ = kDefaultEventsPerThread;
+  mutable std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  uint64_t last_thread_id_ = 0;
+
+  // Returns the ring buffer of the calling thread, allocating one if
+  // necessary. Returns null on threads that are exiting.
+  ThreadBuffer* GetCurrentThreadBuffer();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,314 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+void RecordEvent(TraceRecorder& recorder,
+                 const char* label,
+                 Dart_Timeline_Event_Type type = Dart_Timeline_Event_Begin,
+                 int64_t timestamp = 1,
+                 const char* arg_name = nullptr,
+                 const char* arg_value = nullptr) {
+  const char* names[] = {arg_name};
+  const char* values[] = {arg_value};
+  recorder.Record(label, timestamp, 0, 0, nullptr, type, arg_name ? 1 : 0,
+                  names, values);
+}
+
+}  // namespace
+
+TEST(TraceRecorderTest, RecordsEvents) {
+  TraceRecorder recorder;
+  recorder.Start();
+  const int64_t flow_ids[] = {7, 8, 9};
+  const char* names[] = {"frame", "layers"};
+  const char* values[] = {"42", "3"};
+  recorder.Record("Begin", 100, 0, 3, flow_ids, Dart_Timeline_Event_Begin, 2,
+                  names, values);
+  RecordEvent(recorder, "Begin", Dart_Timeline_Event_End, 200);
+
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 2u);
+  const auto& begin = threads[0].events[0];
+  EXPECT_EQ(begin.type, Dart_Timeline_Event_Begin);
+  EXPECT_EQ(begin.label, "Begin");
+  EXPECT_EQ(begin.timestamp_micros, 100);
+  ASSERT_EQ(begin.flow_ids.size(), TraceRecorder::kMaxFlowIds);
+  EXPECT_EQ(begin.flow_ids[0], 7);
+  EXPECT_EQ(begin.flow_ids[1], 8);
+  ASSERT_EQ(begin.arguments.size(), 2u);
+  EXPECT_EQ(begin.arguments[0].first, "frame");
+  EXPECT_EQ(begin.arguments[0].second, "42");
+  EXPECT_EQ(begin.arguments[1].first, "layers");
+  EXPECT_EQ(begin.arguments[1].second, "3");
+  EXPECT_EQ(threads[0].events[1].type, Dart_Timeline_Event_End);
+  EXPECT_EQ(threads[0].events[1].timestamp_micros, 200);
+}
+
+TEST(TraceRecorderTest, FillsInMissingTimestamps) {
+  TraceRecorder recorder;
+  recorder.Start();
+  RecordEvent(recorder, "NoVM", Dart_Timeline_Event_Instant, -1);
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 1u);
+  EXPECT_GT(threads[0].events[0].timestamp_micros, 0);
+}
+
+TEST(TraceRecorderTest, OverwritesOldestEventsWhenFull) {
+  TraceRecorder recorder;
+  recorder.Start(4);
+  for (int i = 0; i < 10; i++) {
+    RecordEvent(recorder, std::to_string(i).c_str());
+  }
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 4u);
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_EQ(threads[0].events[i].label, std::to_string(i + 6));
+  }
+}
+
+TEST(TraceRecorderTest, TruncatesLongStrings) {
+  TraceRecorder recorder;
+  recorder.Start();
+  const std::string long_label(500, 'l');
+  const std::string long_value(500, 'v');
+  RecordEvent(recorder, long_label.c_str(), Dart_Timeline_Event_Instant, 1,
+              "name", long_value.c_str());
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 1u);
+  const auto& event = threads[0].events[0];
+  EXPECT_EQ(event.label, long_label.substr(0, TraceRecorder::kMaxLabelLength));
+  ASSERT_EQ(event.arguments.size(), 1u);
+  EXPECT_EQ(event.arguments[0].first, "name");
+  EXPECT_FALSE(event.arguments[0].second.empty());
+  EXPECT_LT(event.arguments[0].second.size(), long_value.size());
+}
+
+TEST(TraceRecorderTest, StopAndClear) {
+  TraceRecorder recorder;
+  RecordEvent(recorder, "BeforeStart");
+  EXPECT_TRUE(recorder.Snapshot().empty());
+
+  recorder.Start();
+  RecordEvent(recorder, "WhileRecording");
+  recorder.Stop();
+  RecordEvent(recorder, "AfterStop");
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 1u);
+  EXPECT_EQ(threads[0].events[0].label, "WhileRecording");
+
+  recorder.Clear();
+  EXPECT_TRUE(recorder.Snapshot().empty());
+}
+
+TEST(TraceRecorderTest, RecordsPerThreadWithNames) {
+  TraceRecorder recorder;
+  recorder.Start();
+  RecordEvent(recorder, "OnMain");
+  std::thread thread([&recorder]() {
+    recorder.SetCurrentThreadName("worker");
+    RecordEvent(recorder, "OnWorker");
+  });
+  thread.join();
+
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 2u);
+  EXPECT_NE(threads[0].thread_id, threads[1].thread_id);
+  const auto& worker =
+      threads[0].thread_name == "worker" ? threads[0] : threads[1];
+  const auto& main = &worker == &threads[0] ? threads[1] : threads[0];
+  EXPECT_EQ(worker.thread_name, "worker");
+  ASSERT_EQ(worker.events.size(), 1u);
+  EXPECT_EQ(worker.events[0].label, "OnWorker");
+  ASSERT_EQ(main.events.size(), 1u);
+  EXPECT_EQ(main.events[0].label, "OnMain");
+}
+
+TEST(TraceRecorderTest, ReusesBuffersOfExitedThreads) {
+  TraceRecorder recorder;
+  recorder.Start();
+  for (int i = 0; i < 8; i++) {
+    std::thread thread([&recorder, i]() {
+      RecordEvent(recorder, std::to_string(i).c_str());
+    });
+    thread.join();
+  }
+  auto threads = recorder.Snapshot();
+  ASSERT_EQ(threads.size(), 1u);
+  ASSERT_EQ(threads[0].events.size(), 1u);
+  EXPECT_EQ(threads[0].events[0].label, "7");
+}
+
+TEST(TraceRecorderTest, SnapshotWhileRecordingSeesConsistentEvents) {
+  TraceRecorder recorder;
+  recorder.Start(16);
+  std::atomic_bool done = false;
+  std::thread writer([&]() {
+    for (int i = 0; !done; i++) {
+      const std::string value = std::to_string(i);
+      RecordEvent(recorder, value.c_str(), Dart_Timeline_Event_Instant, i,
+                  "value", value.c_str());
+    }
+  });
+  for (int i = 0; i < 200; i++) {
+    for (const auto& thread : recorder.Snapshot()) {
+      for (const auto& event : thread.events) {
+        ASSERT_EQ(event.arguments.size(), 1u);
+        ASSERT_EQ(event.label, event.arguments[0].second);
+        ASSERT_EQ(std::to_string(event.timestamp_micros), event.label);
+      }
+    }
+  }
+  done = true;
+  writer.join();
+}
+
+TEST(TraceRecorderTest, SerializesChromeJSON) {
+  TraceRecorder::Event begin;
+  begin.type = Dart_Timeline_Event_Begin;
+  begin.label = "Quote\"d";
+  begin.timestamp_micros = 10;
+  begin.arguments = {{"key", "value"}};
+  TraceRecorder::Event counter;
+  counter.type = Dart_Timeline_Event_Counter;
+  counter.label = "Memory";
+  counter.timestamp_micros = 11;
+  counter.arguments = {{"bytes", "1024"}};
+  TraceRecorder::Event async;
+  async.type = Dart_Timeline_Event_Async_Begin;
+  async.label = "Async";
+  async.timestamp_micros = 12;
+  async.timestamp1_or_id = 255;
+  TraceRecorder::ThreadEvents thread;
+  thread.thread_id = 3;
+  thread.thread_name = "raster";
+  thread.events = {begin, counter, async};
+
+  const auto json = TraceRecorder::SerializeChromeJSON({thread});
+  EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                      "\"tid\":3,\"args\":{\"name\":\"raster\"}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Quote\\\"d\",\"cat\":\"flutter\",\"ph\":"
+                      "\"B\",\"pid\":1,\"tid\":3,\"ts\":10,\"args\":{\"key\":"
+                      "\"value\"}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"C\",\"pid\":1,\"tid\":3,\"ts\":11,\"args\":{"
+                      "\"bytes\":1024}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"b\",\"pid\":1,\"tid\":3,\"ts\":12,\"id\":"
+                      "\"0xff\""),
+            std::string::npos);
+}
+
+TEST(TraceRecorderTest, SerializesPerfettoProto) {
+  TraceRecorder::Event begin;
+  begin.type = Dart_Timeline_Event_Begin;
+  begin.label = "Rasterize";
+  begin.timestamp_micros = 10;
+  TraceRecorder::Event end;
+  end.type = Dart_Timeline_Event_End;
+  end.timestamp_micros = 20;
+  TraceRecorder::ThreadEvents thread;
+  thread.thread_id = 1;
+  thread.thread_name = "raster";
+  thread.events = {begin, end};
+
+  const auto proto = TraceRecorder::SerializePerfettoProto({thread});
+  ASSERT_FALSE(proto.empty());
+  // Every top level field is a length delimited Trace.packet.
+  size_t offset = 0;
+  size_t packets = 0;
+  while (offset < proto.size()) {
+    ASSERT_EQ(static_cast<uint8_t>(proto[offset++]), 0x0a);
+    uint64_t length = 0;
+    int shift = 0;
+    uint8_t byte = 0;
+    do {
+      ASSERT_LT(offset, proto.size());
+      byte = static_cast<uint8_t>(proto[offset++]);
+      length |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    offset += length;
+    packets++;
+  }
+  EXPECT_EQ(offset, proto.size());
+  // The process and thread descriptors followed by the two slice events.
+  EXPECT_EQ(packets, 4u);
+  EXPECT_NE(proto.find("Rasterize"), std::string::npos);
+  EXPECT_NE(proto.find("raster"), std::string::npos);
+}
+
+#if FLUTTER_TIMELINE_ENABLED
+TEST(TraceRecorderTest, RecordsTraceEventsWithoutTimelineHandler) {
+  ASSERT_FALSE(TraceHasTimelineEventHandler());
+  auto& recorder = TraceRecorder::GetInstance();
+  recorder.Start();
+  { TRACE_EVENT0("flutter", "TraceRecorderTest"); }
+  recorder.Stop();
+
+  bool found = false;
+  for (const auto& thread : recorder.Snapshot()) {
+    for (const auto& event : thread.events) {
+      found |= event.label == "TraceRecorderTest";
+    }
+  }
+  recorder.Clear();
+  EXPECT_TRUE(found);
+}
+
+TEST(TraceRecorderTest, RecordsTraceEventsWithOneClock) {
+  // A timeline micros source on another clock must not leak into the
+  // recorded events.
+  TraceSetTimelineMicrosSource([]() -> int64_t { return 1; });
+  auto& recorder = TraceRecorder::GetInstance();
+  ASSERT_FALSE(TraceRecorder::IsInstanceRecording());
+  recorder.Start();
+  ASSERT_TRUE(TraceRecorder::IsInstanceRecording());
+  const int64_t before = fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  { TRACE_EVENT0("flutter", "TraceRecorderClockTest"); }
+  const int64_t after = fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  recorder.Stop();
+  EXPECT_FALSE(TraceRecorder::IsInstanceRecording());
+  TraceSetTimelineMicrosSource([]() -> int64_t { return -1; });
+
+  size_t count = 0;
+  for (const auto& thread : recorder.Snapshot()) {
+    for (const auto& event : thread.events) {
+      if (event.label == "TraceRecorderClockTest") {
+        count++;
+        EXPECT_GE(event.timestamp_micros, before);
+        EXPECT_LE(event.timestamp_micros, after);
+      }
+    }
+  }
+  recorder.Clear();
+  // The begin and end events.
+  EXPECT_EQ(count, 2u);
+}
+#endif  // FLUTTER_TIMELINE_ENABLED
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
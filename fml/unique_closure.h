@@ -0,0 +1,200 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_UNIQUE_CLOSURE_H_
+#define FLUTTER_FML_UNIQUE_CLOSURE_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only `void()` callable with inline storage for small
+///             captures.
+///
+///             Unlike `fml::closure` (a `std::function`), this type does not
+///             require the wrapped callable to be copyable. Lambdas that
+///             capture move-only values (`std::unique_ptr`, promises, etc.)
+///             may be posted to task runners directly without wrapping them in
+///             `fml::MakeCopyable`.
+///
+///             Callables that fit within `kInlineStorageSize` bytes are stored
+///             inline and relocated via their move constructor. Larger captures
+///             fall back to a single heap allocation that is transferred (not
+///             copied) as the closure moves through the task queues.
+///
+///             An `fml::closure` converts implicitly into a `UniqueClosure`.
+///             Empty `std::function`s and null function pointers produce an
+///             empty `UniqueClosure`.
+///
+class UniqueClosure {
+ public:
+  //----------------------------------------------------------------------------
+  /// The number of bytes of capture that can be held without allocating. This
+  /// is large enough for an `fml::closure` or a lambda capturing a handful of
+  /// pointers or `RefPtr`s, which covers the vast majority of engine tasks.
+  ///
+  static constexpr size_t kInlineStorageSize = 6 * sizeof(void*);
+
+  UniqueClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename Decayed = std::decay_t<Callable>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Decayed, UniqueClosure> &&
+                std::is_invocable_r_v<void, Decayed&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(Callable&& callable) {
+    if (IsNullCallable(callable)) {
+      return;
+    }
+    Emplace<Decayed>(std::forward<Callable>(callable));
+  }
+
+  UniqueClosure(UniqueClosure&& other) noexcept { MoveFrom(other); }
+
+  UniqueClosure& operator=(UniqueClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueClosure() { Reset(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes the wrapped callable. The closure must not be empty.
+  ///
+  void operator()() const { ops_->invoke(const_cast<Storage*>(&storage_)); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  bool operator==(std::nullptr_t) const { return ops_ == nullptr; }
+
+  bool operator!=(std::nullptr_t) const { return ops_ != nullptr; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the wrapped callable (if any) leaving the closure
+  ///             empty.
+  ///
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether the wrapped callable is held in the inline storage
+  ///             as opposed to a separate heap allocation. Empty closures are
+  ///             not considered inline.
+  ///
+  bool IsInline() const { return ops_ != nullptr && ops_->is_inline; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a callable of type `T` will be held inline.
+  ///
+  template <typename T>
+  static constexpr bool FitsInline() {
+    return sizeof(T) <= kInlineStorageSize &&
+           alignof(T) <= alignof(std::max_align_t);
+  }
+
+ private:
+  using Storage =
+      std::aligned_storage_t<kInlineStorageSize, alignof(std::max_align_t)>;
+
+  struct Ops {
+    void (*invoke)(Storage* storage);
+    // Move constructs into |to| and destroys the source in |from|.
+    void (*relocate)(Storage* from, Storage* to);
+    void (*destroy)(Storage* storage);
+    bool is_inline;
+  };
+
+  template <typename T>
+  struct InlineOps {
+    static T* Get(Storage* storage) {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+    static void Invoke(Storage* storage) { (*Get(storage))(); }
+    static void Relocate(Storage* from, Storage* to) {
+      ::new (to) T(std::move(*Get(from)));
+      Get(from)->~T();
+    }
+    static void Destroy(Storage* storage) { Get(storage)->~T(); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy, true};
+  };
+
+  template <typename T>
+  struct HeapOps {
+    static T*& Get(Storage* storage) {
+      return *std::launder(reinterpret_cast<T**>(storage));
+    }
+    static void Invoke(Storage* storage) { (*Get(storage))(); }
+    static void Relocate(Storage* from, Storage* to) {
+      ::new (to) T*(Get(from));
+    }
+    static void Destroy(Storage* storage) { delete Get(storage); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy, false};
+  };
+
+  const Ops* ops_ = nullptr;
+  Storage storage_;
+
+  template <typename T, typename Callable>
+  void Emplace(Callable&& callable) {
+    if constexpr (FitsInline<T>()) {
+      ::new (&storage_) T(std::forward<Callable>(callable));
+      ops_ = &InlineOps<T>::kOps;
+    } else {
+      ::new (&storage_) T*(new T(std::forward<Callable>(callable)));
+      ops_ = &HeapOps<T>::kOps;
+    }
+  }
+
+  void MoveFrom(UniqueClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(&other.storage_, &storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  template <typename T>
+  static bool IsNullCallable(const std::function<T>& function) {
+    return !function;
+  }
+
+  template <typename T>
+  static bool IsNullCallable(T* function_pointer) {
+    return function_pointer == nullptr;
+  }
+
+  template <typename T>
+  static bool IsNullCallable(const T&) {
+    return false;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UniqueClosure);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_UNIQUE_CLOSURE_H_
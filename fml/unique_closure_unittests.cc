@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/unique_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+class RefCountedDummy : public fml::RefCountedThreadSafe<RefCountedDummy> {};
+}  // namespace
+
+TEST(UniqueClosureTest, DefaultConstructedIsEmpty) {
+  UniqueClosure closure;
+  EXPECT_FALSE(closure);
+  EXPECT_EQ(closure, nullptr);
+  EXPECT_FALSE(closure.IsInline());
+}
+
+TEST(UniqueClosureTest, CanInvokeLambda) {
+  int count = 0;
+  UniqueClosure closure = [&count]() { count++; };
+  ASSERT_TRUE(closure);
+  closure();
+  closure();
+  EXPECT_EQ(count, 2);
+}
+
+TEST(UniqueClosureTest, AcceptsMoveOnlyCaptures) {
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  UniqueClosure closure = [value = std::move(value), &result]() {
+    result = *value;
+  };
+  closure();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(UniqueClosureTest, EmptyStdFunctionProducesEmptyClosure) {
+  fml::closure empty;
+  UniqueClosure closure = empty;
+  EXPECT_FALSE(closure);
+
+  void (*null_function)() = nullptr;
+  UniqueClosure closure2 = null_function;
+  EXPECT_FALSE(closure2);
+}
+
+TEST(UniqueClosureTest, StdFunctionIsStoredInline) {
+  int count = 0;
+  fml::closure function = [&count]() { count++; };
+  UniqueClosure closure = function;
+  EXPECT_TRUE(closure.IsInline());
+  closure();
+  EXPECT_EQ(count, 1);
+}
+
+TEST(UniqueClosureTest, TypicalCapturesAreStoredInline) {
+  auto ref = fml::MakeRefCounted<RefCountedDummy>();
+  auto unique = std::make_unique<int>(1);
+  int* raw = unique.get();
+  UniqueClosure closure = [ref, unique = std::move(unique), raw, this]() {};
+  EXPECT_TRUE(closure.IsInline());
+}
+
+TEST(UniqueClosureTest, LargeCapturesAreStoredOnHeap) {
+  std::array<char, UniqueClosure::kInlineStorageSize + 1> large = {};
+  large[0] = 'a';
+  char result = 0;
+  UniqueClosure closure = [large, &result]() { result = large[0]; };
+  EXPECT_FALSE(closure.IsInline());
+  UniqueClosure moved = std::move(closure);
+  EXPECT_FALSE(closure);
+  moved();
+  EXPECT_EQ(result, 'a');
+}
+
+TEST(UniqueClosureTest, MoveTransfersOwnership) {
+  auto ref = fml::MakeRefCounted<RefCountedDummy>();
+  {
+    UniqueClosure closure = [ref]() {};
+    EXPECT_FALSE(ref->HasOneRef());
+    UniqueClosure moved(std::move(closure));
+    EXPECT_FALSE(closure);
+    EXPECT_TRUE(moved);
+    EXPECT_FALSE(ref->HasOneRef());
+
+    UniqueClosure assigned;
+    assigned = std::move(moved);
+    EXPECT_FALSE(moved);
+    EXPECT_TRUE(assigned);
+    EXPECT_FALSE(ref->HasOneRef());
+  }
+  EXPECT_TRUE(ref->HasOneRef());
+}
+
+TEST(UniqueClosureTest, ResetDestroysCaptures) {
+  auto ref = fml::MakeRefCounted<RefCountedDummy>();
+  UniqueClosure closure = [ref]() {};
+  EXPECT_FALSE(ref->HasOneRef());
+  closure.Reset();
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(ref->HasOneRef());
+
+  closure = [ref]() {};
+  EXPECT_FALSE(ref->HasOneRef());
+  closure = nullptr;
+  EXPECT_TRUE(ref->HasOneRef());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "impeller/aiks/aiks_context.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/typographer_context.h"
@@ -64,6 +65,7 @@ bool AiksPlayground::OpenPlaygroundHere(
         impeller_dispatcher.FinishRecording();
         renderer.GetContentContext().GetTransientsBuffer().Reset();
         renderer.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
+        renderer.GetContentContext().GetFrameArena().Reset();
         return true;
       });
 }
@@ -12,6 +12,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/aiks/color_source.h"
 #include "impeller/aiks/image_filter.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/color_source_contents.h"
@@ -23,6 +24,7 @@
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
+#include "impeller/entity/draw_batcher.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/save_layer_utils.h"
 #include "impeller/geometry/color.h"
@@ -34,10 +36,11 @@ namespace impeller {
 namespace {
 
 static std::shared_ptr<Contents> CreateContentsForGeometryWithFilters(
+    FrameArena& arena,
     const Paint& paint,
     std::shared_ptr<Geometry> geometry) {
   std::shared_ptr<ColorSourceContents> contents =
-      paint.color_source.GetContents(paint);
+      paint.color_source.GetContents(paint, &arena);
 
   // Attempt to apply the color filter on the CPU first.
   // Note: This is not just an optimization; some color sources rely on
@@ -118,26 +121,30 @@ static std::optional<ImageData> GetImageColorSourceData(
 }
 
 static std::shared_ptr<Contents> CreatePathContentsWithFilters(
+    FrameArena& arena,
     const Paint& paint,
     const Path& path) {
   std::shared_ptr<Geometry> geometry;
   switch (paint.style) {
     case Paint::Style::kFill:
-      geometry = Geometry::MakeFillPath(path);
+      geometry = Geometry::MakeFillPath(path, std::nullopt, &arena);
       break;
     case Paint::Style::kStroke:
-      geometry =
-          Geometry::MakeStrokePath(path, paint.stroke_width, paint.stroke_miter,
-                                   paint.stroke_cap, paint.stroke_join);
+      geometry = Geometry::MakeStrokePath(
+          path, paint.stroke_width, paint.stroke_miter, paint.stroke_cap,
+          paint.stroke_join, &arena);
       break;
   }
 
-  return CreateContentsForGeometryWithFilters(paint, std::move(geometry));
+  return CreateContentsForGeometryWithFilters(arena, paint,
+                                              std::move(geometry));
 }
 
 static std::shared_ptr<Contents> CreateCoverContentsWithFilters(
+    FrameArena& arena,
     const Paint& paint) {
-  return CreateContentsForGeometryWithFilters(paint, Geometry::MakeCover());
+  return CreateContentsForGeometryWithFilters(arena, paint,
+                                              Geometry::MakeCover(&arena));
 }
 
 static void SetClipScissor(std::optional<Rect> clip_coverage,
@@ -467,7 +474,8 @@ void Canvas::DrawPath(const Path& path, const Paint& paint) {
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(CreatePathContentsWithFilters(paint, path));
+  entity.SetContents(
+      CreatePathContentsWithFilters(renderer_.GetFrameArena(), paint, path));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -476,7 +484,8 @@ void Canvas::DrawPaint(const Paint& paint) {
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(CreateCoverContentsWithFilters(paint));
+  entity.SetContents(
+      CreateCoverContentsWithFilters(renderer_.GetFrameArena(), paint));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -554,8 +563,10 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
     Save(1u);
   }
 
-  auto draw_blurred_rrect = [this, &rect, &corner_radii, &rrect_paint]() {
-    auto contents = std::make_shared<SolidRRectBlurContents>();
+  FrameArena& arena = renderer_.GetFrameArena();
+  auto draw_blurred_rrect = [this, &arena, &rect, &corner_radii,
+                             &rrect_paint]() {
+    auto contents = arena.MakeShared<SolidRRectBlurContents>();
 
     contents->SetColor(rrect_paint.color);
     contents->SetSigma(rrect_paint.mask_blur_descriptor->sigma);
@@ -584,7 +595,8 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
       entity.SetTransform(GetCurrentTransform());
       entity.SetBlendMode(rrect_paint.blend_mode);
       entity.SetContents(CreateContentsForGeometryWithFilters(
-          rrect_paint, Geometry::MakeRoundRect(rect, corner_radii)));
+          arena, rrect_paint,
+          Geometry::MakeRoundRect(rect, corner_radii, &arena)));
       AddRenderEntityToCurrentPass(entity, true);
       break;
     }
@@ -606,11 +618,14 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
 }
 
 void Canvas::DrawLine(const Point& p0, const Point& p1, const Paint& paint) {
+  FrameArena& arena = renderer_.GetFrameArena();
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(CreateContentsForGeometryWithFilters(
-      paint, Geometry::MakeLine(p0, p1, paint.stroke_width, paint.stroke_cap)));
+      arena, paint,
+      Geometry::MakeLine(p0, p1, paint.stroke_width, paint.stroke_cap,
+                         &arena)));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -625,11 +640,12 @@ void Canvas::DrawRect(const Rect& rect, const Paint& paint) {
     return;
   }
 
+  FrameArena& arena = renderer_.GetFrameArena();
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(
-      CreateContentsForGeometryWithFilters(paint, Geometry::MakeRect(rect)));
+  entity.SetContents(CreateContentsForGeometryWithFilters(
+      arena, paint, Geometry::MakeRect(rect, &arena)));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -656,11 +672,12 @@ void Canvas::DrawOval(const Rect& rect, const Paint& paint) {
     return;
   }
 
+  FrameArena& arena = renderer_.GetFrameArena();
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(
-      CreateContentsForGeometryWithFilters(paint, Geometry::MakeOval(rect)));
+  entity.SetContents(CreateContentsForGeometryWithFilters(
+      arena, paint, Geometry::MakeOval(rect, &arena)));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -673,11 +690,12 @@ void Canvas::DrawRRect(const Rect& rect,
   }
 
   if (paint.style == Paint::Style::kFill) {
+    FrameArena& arena = renderer_.GetFrameArena();
     Entity entity;
     entity.SetTransform(GetCurrentTransform());
     entity.SetBlendMode(paint.blend_mode);
     entity.SetContents(CreateContentsForGeometryWithFilters(
-        paint, Geometry::MakeRoundRect(rect, corner_radii)));
+        arena, paint, Geometry::MakeRoundRect(rect, corner_radii, &arena)));
 
     AddRenderEntityToCurrentPass(entity);
     return;
@@ -701,43 +719,47 @@ void Canvas::DrawCircle(const Point& center,
     return;
   }
 
+  FrameArena& arena = renderer_.GetFrameArena();
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
-  auto geometry =
-      paint.style == Paint::Style::kStroke
-          ? Geometry::MakeStrokedCircle(center, radius, paint.stroke_width)
-          : Geometry::MakeCircle(center, radius);
+  auto geometry = paint.style == Paint::Style::kStroke
+                      ? Geometry::MakeStrokedCircle(center, radius,
+                                                    paint.stroke_width, &arena)
+                      : Geometry::MakeCircle(center, radius, &arena);
   entity.SetContents(
-      CreateContentsForGeometryWithFilters(paint, std::move(geometry)));
+      CreateContentsForGeometryWithFilters(arena, paint, std::move(geometry)));
 
   AddRenderEntityToCurrentPass(entity);
 }
 
 void Canvas::ClipPath(const Path& path, Entity::ClipOperation clip_op) {
-  ClipGeometry(Geometry::MakeFillPath(path), clip_op);
+  ClipGeometry(
+      Geometry::MakeFillPath(path, std::nullopt, &renderer_.GetFrameArena()),
+      clip_op);
 }
 
 void Canvas::ClipRect(const Rect& rect, Entity::ClipOperation clip_op) {
-  auto geometry = Geometry::MakeRect(rect);
+  auto geometry = Geometry::MakeRect(rect, &renderer_.GetFrameArena());
   ClipGeometry(geometry, clip_op);
 }
 
 void Canvas::ClipOval(const Rect& bounds, Entity::ClipOperation clip_op) {
-  auto geometry = Geometry::MakeOval(bounds);
+  auto geometry = Geometry::MakeOval(bounds, &renderer_.GetFrameArena());
   ClipGeometry(geometry, clip_op);
 }
 
 void Canvas::ClipRRect(const Rect& rect,
                        const Size& corner_radii,
                        Entity::ClipOperation clip_op) {
-  auto geometry = Geometry::MakeRoundRect(rect, corner_radii);
+  auto geometry = Geometry::MakeRoundRect(rect, corner_radii,
+                                          &renderer_.GetFrameArena());
   ClipGeometry(geometry, clip_op);
 }
 
 void Canvas::ClipGeometry(const std::shared_ptr<Geometry>& geometry,
                           Entity::ClipOperation clip_op) {
-  auto contents = std::make_shared<ClipContents>();
+  auto contents = renderer_.GetFrameArena().MakeShared<ClipContents>();
   contents->SetGeometry(geometry);
   contents->SetClipOperation(clip_op);
 
@@ -756,7 +778,8 @@ void Canvas::RestoreClip() {
   entity.SetTransform(GetCurrentTransform());
   // This path is empty because ClipRestoreContents just generates a quad that
   // takes up the full render target.
-  auto clip_restore = std::make_shared<ClipRestoreContents>();
+  auto clip_restore =
+      renderer_.GetFrameArena().MakeShared<ClipRestoreContents>();
   clip_restore->SetRestoreHeight(GetClipHeight());
   entity.SetContents(std::move(clip_restore));
 
@@ -771,13 +794,15 @@ void Canvas::DrawPoints(std::vector<Point> points,
     return;
   }
 
+  FrameArena& arena = renderer_.GetFrameArena();
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(CreateContentsForGeometryWithFilters(
-      paint,
+      arena, paint,
       Geometry::MakePointField(std::move(points), radius,
-                               /*round=*/point_style == PointStyle::kRound)));
+                               /*round=*/point_style == PointStyle::kRound,
+                               &arena)));
 
   AddRenderEntityToCurrentPass(entity);
 }
@@ -869,7 +894,8 @@ void Canvas::DrawVertices(const std::shared_ptr<VerticesGeometry>& vertices,
 
   // If there are no vertex colors.
   if (UseColorSourceContents(vertices, paint)) {
-    entity.SetContents(CreateContentsForGeometryWithFilters(paint, vertices));
+    entity.SetContents(CreateContentsForGeometryWithFilters(
+        renderer_.GetFrameArena(), paint, vertices));
     AddRenderEntityToCurrentPass(entity);
     return;
   }
@@ -1126,6 +1152,9 @@ void Canvas::SaveLayer(const Paint& paint,
     return SkipUntilMatchingRestore(total_content_depth);
   }
 
+  // Pending draws belong to the parent pass, which may be ended below.
+  draw_batcher_.Flush(renderer_);
+
   // Backdrop filter state, ignored if there is no BDF.
   std::shared_ptr<FilterContents> backdrop_filter_contents;
   Point local_position = {0, 0};
@@ -1238,6 +1267,7 @@ bool Canvas::Restore() {
           Entity::RenderingMode::kSubpassAppendSnapshotTransform ||
       transform_stack_.back().rendering_mode ==
           Entity::RenderingMode::kSubpassPrependSnapshotTransform) {
+    draw_batcher_.Flush(renderer_);
     auto lazy_render_pass = std::move(render_passes_.back());
     render_passes_.pop_back();
     // Force the render pass to be constructed if it never was.
@@ -1331,13 +1361,15 @@ bool Canvas::Restore() {
   transform_stack_.pop_back();
 
   if (num_clips > 0) {
+    draw_batcher_.Flush(renderer_);
     Entity entity;
     entity.SetTransform(
         Matrix::MakeTranslation(Vector3(-GetGlobalPassPosition())) *
         GetCurrentTransform());
     // This path is empty because ClipRestoreContents just generates a quad that
     // takes up the full render target.
-    auto clip_restore = std::make_shared<ClipRestoreContents>();
+    auto clip_restore =
+        renderer_.GetFrameArena().MakeShared<ClipRestoreContents>();
     clip_restore->SetRestoreHeight(GetClipHeight());
     entity.SetContents(std::move(clip_restore));
 
@@ -1388,7 +1420,7 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
   entity.SetClipDepth(GetClipHeight());
   entity.SetBlendMode(paint.blend_mode);
 
-  auto text_contents = std::make_shared<TextContents>();
+  auto text_contents = renderer_.GetFrameArena().MakeShared<TextContents>();
   text_contents->SetTextFrame(text_frame);
   text_contents->SetForceTextColor(paint.mask_blur_descriptor.has_value());
   text_contents->SetScale(GetCurrentTransform().GetMaxBasisLengthXY());
@@ -1468,6 +1500,7 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
     if (renderer_.GetDeviceCapabilities().SupportsFramebufferFetch()) {
       ApplyFramebufferBlend(entity);
     } else {
+      draw_batcher_.Flush(renderer_);
       // End the active pass and flush the buffer before rendering "advanced"
       // blends. Advanced blends work by binding the current render target
       // texture as an input ("destination"), blending with a second texture
@@ -1513,6 +1546,11 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
     return;
   }
 
+  // Runs of solid color fills are merged into a single draw.
+  if (draw_batcher_.Add(renderer_, entity, *result.pass)) {
+    return;
+  }
+  draw_batcher_.Flush(renderer_);
   entity.Render(renderer_, *result.pass);
 }
 
@@ -1520,6 +1558,7 @@ void Canvas::AddClipEntityToCurrentPass(Entity& entity) {
   if (IsSkipping()) {
     return;
   }
+  draw_batcher_.Flush(renderer_);
 
   auto transform = entity.GetTransform();
   entity.SetTransform(
@@ -1634,6 +1673,7 @@ bool Canvas::BlitToOnscreen() {
 }
 
 void Canvas::EndReplay() {
+  draw_batcher_.Flush(renderer_);
   FML_DCHECK(render_passes_.size() == 1u);
   render_passes_.back().inline_pass_context->GetRenderPass(0);
   render_passes_.back().inline_pass_context->EndPass();
@@ -15,6 +15,7 @@
 #include "impeller/aiks/paint.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/atlas_contents.h"
+#include "impeller/entity/draw_batcher.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass_clip_stack.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -246,6 +247,7 @@ class Canvas {
   std::optional<Rect> initial_cull_rect_;
   std::vector<LazyRenderingConfig> render_passes_;
   std::vector<SaveLayerState> save_layer_state_;
+  DrawBatcher draw_batcher_;
 
   uint64_t current_depth_ = 0u;
 
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "impeller/aiks/paint.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
@@ -28,13 +29,15 @@ namespace impeller {
 namespace {
 
 struct CreateContentsVisitor {
-  explicit CreateContentsVisitor(const Paint& p_paint) : paint(p_paint) {}
+  CreateContentsVisitor(const Paint& p_paint, FrameArena* p_arena)
+      : paint(p_paint), arena(p_arena) {}
 
   const Paint& paint;
+  FrameArena* arena;
 
   std::shared_ptr<ColorSourceContents> operator()(
       const LinearGradientData& data) {
-    auto contents = std::make_shared<LinearGradientContents>();
+    auto contents = MakeSharedInArena<LinearGradientContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetColors(data.colors);
     contents->SetStops(data.stops);
@@ -52,7 +55,7 @@ struct CreateContentsVisitor {
 
   std::shared_ptr<ColorSourceContents> operator()(
       const RadialGradientData& data) {
-    auto contents = std::make_shared<RadialGradientContents>();
+    auto contents = MakeSharedInArena<RadialGradientContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetColors(data.colors);
     contents->SetStops(data.stops);
@@ -72,7 +75,7 @@ struct CreateContentsVisitor {
   std::shared_ptr<ColorSourceContents> operator()(
       const ConicalGradientData& data) {
     std::shared_ptr<ConicalGradientContents> contents =
-        std::make_shared<ConicalGradientContents>();
+        MakeSharedInArena<ConicalGradientContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetColors(data.colors);
     contents->SetStops(data.stops);
@@ -92,7 +95,7 @@ struct CreateContentsVisitor {
 
   std::shared_ptr<ColorSourceContents> operator()(
       const SweepGradientData& data) {
-    auto contents = std::make_shared<SweepGradientContents>();
+    auto contents = MakeSharedInArena<SweepGradientContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetCenterAndAngles(data.center, data.start_angle, data.end_angle);
     contents->SetColors(data.colors);
@@ -104,7 +107,7 @@ struct CreateContentsVisitor {
   }
 
   std::shared_ptr<ColorSourceContents> operator()(const ImageData& data) {
-    auto contents = std::make_shared<TiledTextureContents>();
+    auto contents = MakeSharedInArena<TiledTextureContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetTexture(data.texture);
     contents->SetTileModes(data.x_tile_mode, data.y_tile_mode);
@@ -124,7 +127,7 @@ struct CreateContentsVisitor {
 
   std::shared_ptr<ColorSourceContents> operator()(
       const RuntimeEffectData& data) {
-    auto contents = std::make_shared<RuntimeEffectContents>();
+    auto contents = MakeSharedInArena<RuntimeEffectContents>(arena);
     contents->SetOpacityFactor(paint.color.alpha);
     contents->SetRuntimeStage(data.runtime_stage);
     contents->SetUniformData(data.uniform_data);
@@ -133,7 +136,7 @@ struct CreateContentsVisitor {
   }
 
   std::shared_ptr<ColorSourceContents> operator()(const std::monostate& data) {
-    auto contents = std::make_shared<SolidColorContents>();
+    auto contents = MakeSharedInArena<SolidColorContents>(arena);
     contents->SetColor(paint.color);
     return contents;
   }
@@ -237,8 +240,9 @@ ColorSource::Type ColorSource::GetType() const {
 }
 
 std::shared_ptr<ColorSourceContents> ColorSource::GetContents(
-    const Paint& paint) const {
-  return std::visit(CreateContentsVisitor{paint}, color_source_data_);
+    const Paint& paint,
+    FrameArena* arena) const {
+  return std::visit(CreateContentsVisitor{paint, arena}, color_source_data_);
 }
 
 const ColorSourceData& ColorSource::GetData() const {
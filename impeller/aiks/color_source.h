@@ -19,6 +19,7 @@
 
 namespace impeller {
 
+class FrameArena;
 struct Paint;
 
 struct LinearGradientData {
@@ -144,7 +145,11 @@ class ColorSource {
 
   Type GetType() const;
 
-  std::shared_ptr<ColorSourceContents> GetContents(const Paint& paint) const;
+  /// @brief Creates the contents of the color source, allocated from the
+  ///        given frame arena if there is one.
+  std::shared_ptr<ColorSourceContents> GetContents(
+      const Paint& paint,
+      FrameArena* arena = nullptr) const;
 
   const ColorSourceData& GetData() const;
 
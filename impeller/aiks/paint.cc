@@ -28,8 +28,9 @@ constexpr ColorMatrix kColorInversion = {
 // clang-format on
 
 std::shared_ptr<Contents> Paint::CreateContentsForGeometry(
-    const std::shared_ptr<Geometry>& geometry) const {
-  auto contents = color_source.GetContents(*this);
+    const std::shared_ptr<Geometry>& geometry,
+    FrameArena* arena) const {
+  auto contents = color_source.GetContents(*this, arena);
 
   // Attempt to apply the color filter on the CPU first.
   // Note: This is not just an optimization; some color sources rely on
@@ -102,7 +102,8 @@ struct Paint {
       const Matrix& effect_transform = Matrix()) const;
 
   std::shared_ptr<Contents> CreateContentsForGeometry(
-      const std::shared_ptr<Geometry>& geometry) const;
+      const std::shared_ptr<Geometry>& geometry,
+      FrameArena* arena = nullptr) const;
 
   /// @brief   Whether this paint has a color filter that can apply opacity
   bool HasColorFilter() const;
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/frame_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+struct FrameArena::Block {
+  /// The allocations alive in the block, plus one while an arena holds it.
+  std::atomic<size_t> references = 1u;
+  size_t capacity = 0u;
+  size_t offset = 0u;
+
+  uint8_t* GetData() { return reinterpret_cast<uint8_t*>(this + 1); }
+};
+
+// Each allocation is preceded by a pointer to its block so that it can be
+// returned without knowing the arena it came from.
+static constexpr size_t kHeaderSize = sizeof(void*);
+
+static size_t GetMaxBlockUsage(size_t size, size_t alignment) {
+  return kHeaderSize + alignment + size;
+}
+
+FrameArena::FrameArena(size_t block_size) : block_size_(block_size) {}
+
+FrameArena::~FrameArena() {
+  for (Block* block : blocks_) {
+    ReleaseBlock(block);
+  }
+  for (Block* block : oversized_blocks_) {
+    ReleaseBlock(block);
+  }
+}
+
+FrameArena::Block* FrameArena::CreateBlock(size_t capacity) {
+  void* memory = std::malloc(sizeof(Block) + capacity);
+  FML_CHECK(memory != nullptr) << "Could not allocate a frame arena block.";
+  Block* block = new (memory) Block();
+  block->capacity = capacity;
+  return block;
+}
+
+void FrameArena::ReleaseBlock(Block* block) {
+  if (block->references.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+    block->~Block();
+    std::free(block);
+  }
+}
+
+void* FrameArena::AllocateFromBlock(Block* block,
+                                    size_t size,
+                                    size_t alignment) {
+  uintptr_t data = reinterpret_cast<uintptr_t>(block->GetData());
+  uintptr_t address = data + block->offset + kHeaderSize;
+  address = (address + alignment - 1u) & ~(alignment - 1u);
+  if (address + size > data + block->capacity) {
+    return nullptr;
+  }
+  block->offset = address + size - data;
+  block->references.fetch_add(1u, std::memory_order_relaxed);
+  *reinterpret_cast<Block**>(address - kHeaderSize) = block;
+  return reinterpret_cast<void*>(address);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+  alignment = std::max(alignment, alignof(Block*));
+  allocation_count_++;
+
+  size_t max_usage = GetMaxBlockUsage(size, alignment);
+  if (max_usage > block_size_) {
+    Block* block = CreateBlock(max_usage);
+    oversized_blocks_.push_back(block);
+    return AllocateFromBlock(block, size, alignment);
+  }
+
+  while (current_block_ < blocks_.size()) {
+    void* allocation =
+        AllocateFromBlock(blocks_[current_block_], size, alignment);
+    if (allocation != nullptr) {
+      return allocation;
+    }
+    current_block_++;
+  }
+  blocks_.push_back(CreateBlock(block_size_));
+  return AllocateFromBlock(blocks_.back(), size, alignment);
+}
+
+void FrameArena::Deallocate(void* allocation) {
+  if (allocation == nullptr) {
+    return;
+  }
+  uintptr_t address = reinterpret_cast<uintptr_t>(allocation);
+  ReleaseBlock(*reinterpret_cast<Block**>(address - kHeaderSize));
+}
+
+void FrameArena::Reset() {
+  // Only the arena adds references to its blocks, so a block the arena holds
+  // the only reference to cannot gain new ones and can safely be rewound.
+  auto kept = std::remove_if(blocks_.begin(), blocks_.end(), [](Block* block) {
+    if (block->references.load(std::memory_order_acquire) == 1u) {
+      block->offset = 0u;
+      return false;
+    }
+    ReleaseBlock(block);
+    return true;
+  });
+  blocks_.erase(kept, blocks_.end());
+
+  for (Block* block : oversized_blocks_) {
+    ReleaseBlock(block);
+  }
+  oversized_blocks_.clear();
+
+  current_block_ = 0u;
+  allocation_count_ = 0u;
+}
+
+size_t FrameArena::GetBlockCount() const {
+  return blocks_.size() + oversized_blocks_.size();
+}
+
+size_t FrameArena::GetAllocationCount() const {
+  return allocation_count_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_BASE_FRAME_ARENA_H_
+#define FLUTTER_IMPELLER_BASE_FRAME_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A bump allocator for objects that usually live no longer than
+///             the frame they were recorded in.
+///
+///             Memory is handed out from large blocks that are reused from
+///             frame to frame, so recording a frame of entities does not call
+///             into the system allocator once the arena has warmed up.
+///
+///             Every allocation remembers its block and every block counts the
+///             allocations still alive in it. An object that escapes the frame
+///             (for example contents retained by a cached layer) keeps its
+///             block alive after |Reset| or after the arena is destroyed, and
+///             the block is freed when the last such object is deallocated.
+///
+///             Allocation and |Reset| must happen on one thread at a time.
+///             Deallocation may happen on any thread.
+///
+class FrameArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64u * 1024u;
+
+  explicit FrameArena(size_t block_size = kDefaultBlockSize);
+
+  ~FrameArena();
+
+  FrameArena(const FrameArena&) = delete;
+
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates memory for an object of the given size and
+  ///             alignment. Allocations larger than the block size are given a
+  ///             block of their own.
+  ///
+  ///             Running out of memory is fatal, like with operator new.
+  ///
+  void* Allocate(size_t size, size_t alignment);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns an allocation made by any arena. The memory is reused
+  ///             once every allocation in its block has been returned and the
+  ///             arena has been reset.
+  ///
+  static void Deallocate(void* allocation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the frame. Blocks whose allocations have all been
+  ///             returned are rewound for the next frame, while blocks still
+  ///             holding escaped objects are handed over to those objects.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a shared object whose control block and storage are
+  ///             allocated from this arena.
+  ///
+  template <class T, class... Args>
+  std::shared_ptr<T> MakeShared(Args&&... args);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of blocks the arena currently holds, including
+  ///             blocks for oversized allocations.
+  ///
+  size_t GetBlockCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of allocations made since the last |Reset|.
+  ///
+  size_t GetAllocationCount() const;
+
+ private:
+  struct Block;
+
+  const size_t block_size_;
+  std::vector<Block*> blocks_;
+  std::vector<Block*> oversized_blocks_;
+  size_t current_block_ = 0u;
+  size_t allocation_count_ = 0u;
+
+  static Block* CreateBlock(size_t capacity);
+
+  static void ReleaseBlock(Block* block);
+
+  static void* AllocateFromBlock(Block* block, size_t size, size_t alignment);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A standard library allocator that allocates from a
+///             |FrameArena|.
+///
+template <class T>
+class FrameArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit FrameArenaAllocator(FrameArena* arena) : arena_(arena) {}
+
+  template <class U>
+  FrameArenaAllocator(  // NOLINT(google-explicit-constructor)
+      const FrameArenaAllocator<U>& other)
+      : arena_(other.GetArena()) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  void deallocate(T* allocation, size_t count) {
+    FrameArena::Deallocate(allocation);
+  }
+
+  FrameArena* GetArena() const { return arena_; }
+
+  template <class U>
+  bool operator==(const FrameArenaAllocator<U>& other) const {
+    return arena_ == other.GetArena();
+  }
+
+ private:
+  FrameArena* arena_;
+};
+
+template <class T, class... Args>
+std::shared_ptr<T> FrameArena::MakeShared(Args&&... args) {
+  return std::allocate_shared<T>(FrameArenaAllocator<T>(this),
+                                 std::forward<Args>(args)...);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a shared object in the arena if there is one, and on
+///             the heap otherwise.
+///
+template <class T, class... Args>
+std::shared_ptr<T> MakeSharedInArena(FrameArena* arena, Args&&... args) {
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return arena->MakeShared<T>(std::forward<Args>(args)...);
+}
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_BASE_FRAME_ARENA_H_
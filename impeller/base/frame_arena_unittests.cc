@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/base/frame_arena.h"
+
+namespace impeller::testing {
+
+namespace {
+
+struct DestructionCounter {
+  explicit DestructionCounter(int* p_count) : count(p_count) {}
+
+  ~DestructionCounter() { (*count)++; }
+
+  int* count;
+};
+
+}  // namespace
+
+TEST(FrameArenaTest, AllocationsAreAligned) {
+  FrameArena arena;
+  for (size_t alignment : {1u, 2u, 4u, 8u, 16u, 64u}) {
+    void* allocation = arena.Allocate(3u, alignment);
+    ASSERT_NE(allocation, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation) % alignment, 0u);
+    FrameArena::Deallocate(allocation);
+  }
+  EXPECT_EQ(arena.GetAllocationCount(), 6u);
+}
+
+TEST(FrameArenaTest, SharedObjectsAreDestroyed) {
+  FrameArena arena;
+  int destroyed = 0;
+  {
+    auto object = arena.MakeShared<DestructionCounter>(&destroyed);
+    EXPECT_EQ(destroyed, 0);
+  }
+  EXPECT_EQ(destroyed, 1);
+}
+
+TEST(FrameArenaTest, ResetReusesBlocks) {
+  FrameArena arena(1024u);
+  for (int frame = 0; frame < 10; frame++) {
+    std::vector<std::shared_ptr<int>> objects;
+    for (int i = 0; i < 100; i++) {
+      objects.push_back(arena.MakeShared<int>(i));
+    }
+    objects.clear();
+    arena.Reset();
+    EXPECT_EQ(arena.GetAllocationCount(), 0u);
+  }
+  size_t block_count = arena.GetBlockCount();
+  EXPECT_GT(block_count, 1u);
+
+  std::vector<std::shared_ptr<int>> objects;
+  for (int i = 0; i < 100; i++) {
+    objects.push_back(arena.MakeShared<int>(i));
+  }
+  EXPECT_EQ(arena.GetBlockCount(), block_count);
+}
+
+TEST(FrameArenaTest, EscapedObjectsOutliveResetAndArena) {
+  std::shared_ptr<int> escaped;
+  {
+    FrameArena arena(1024u);
+    escaped = arena.MakeShared<int>(42);
+    auto transient = arena.MakeShared<int>(7);
+    arena.Reset();
+
+    // The block with the escaped object is no longer the arena's to reuse.
+    EXPECT_EQ(arena.GetBlockCount(), 0u);
+    auto next_frame = arena.MakeShared<int>(0);
+    EXPECT_NE(next_frame.get(), escaped.get());
+    EXPECT_EQ(*transient, 7);
+  }
+  EXPECT_EQ(*escaped, 42);
+}
+
+TEST(FrameArenaTest, OversizedAllocationsGetTheirOwnBlock) {
+  FrameArena arena(1024u);
+  auto small = arena.MakeShared<int>(1);
+  EXPECT_EQ(arena.GetBlockCount(), 1u);
+
+  auto large = arena.MakeShared<std::array<uint8_t, 4096>>();
+  EXPECT_EQ(arena.GetBlockCount(), 2u);
+
+  small.reset();
+  large.reset();
+  arena.Reset();
+  EXPECT_EQ(arena.GetBlockCount(), 1u);
+}
+
+TEST(FrameArenaTest, AllocatorWorksWithContainers) {
+  FrameArena arena;
+  std::vector<int, FrameArenaAllocator<int>> values{
+      FrameArenaAllocator<int>(&arena)};
+  for (int i = 0; i < 1000; i++) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(values[999], 999);
+  EXPECT_GT(arena.GetAllocationCount(), 1u);
+}
+
+TEST(FrameArenaTest, ObjectsMayBeReleasedOnOtherThreads) {
+  FrameArena arena(1024u);
+  std::vector<std::shared_ptr<int>> objects;
+  for (int i = 0; i < 1000; i++) {
+    objects.push_back(arena.MakeShared<int>(i));
+  }
+  std::thread thread([objects = std::move(objects)]() mutable {
+    objects.clear();
+  });
+  arena.Reset();
+  thread.join();
+
+  auto object = arena.MakeShared<int>(1);
+  EXPECT_EQ(*object, 1);
+}
+
+TEST(FrameArenaTest, MakeSharedInArenaFallsBackToTheHeap) {
+  auto object = MakeSharedInArena<int>(nullptr, 3);
+  EXPECT_EQ(*object, 3);
+
+  FrameArena arena;
+  auto arena_object = MakeSharedInArena<int>(&arena, 4);
+  EXPECT_EQ(*arena_object, 4);
+  EXPECT_EQ(arena.GetAllocationCount(), 1u);
+}
+
+}  // namespace impeller::testing
@@ -87,6 +87,7 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
     {{stage_input.type.columns}}u,      // number of columns
     {{stage_input.offset}}u,            // offset for interleaved layout
     {{stage_input.relaxed_precision}},  // relaxed precision
+    false,                              // normalized
   };
 {% endfor %}
 
@@ -140,6 +141,7 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
     {{stage_output.type.columns}}u,      // number of columns
     {{stage_output.offset}}u,            // offset for interleaved layout
     {{stage_output.relaxed_precision}},  // relaxed precision
+    false,                               // normalized
   };
 {% endfor %}
   static constexpr std::array<const ShaderStageIOSlot*, {{length(stage_outputs)}}> kAllShaderStageOutputs = {
@@ -4,9 +4,11 @@
 
 #include "impeller/core/host_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
@@ -17,6 +19,21 @@
 namespace impeller {
 
 constexpr size_t kAllocatorBlockSize = 1024000;  // 1024 Kb.
+constexpr size_t kMaxAllocatorBlockSize = 8u * kAllocatorBlockSize;
+
+namespace {
+
+/// The smallest block size that fits the usage of a frame, up to the maximum
+/// block size.
+size_t GetBlockSizeForUsage(size_t usage) {
+  size_t block_size = kAllocatorBlockSize;
+  while (block_size < usage && block_size < kMaxAllocatorBlockSize) {
+    block_size *= 2u;
+  }
+  return block_size;
+}
+
+}  // namespace
 
 std::shared_ptr<HostBuffer> HostBuffer::Create(
     const std::shared_ptr<Allocator>& allocator) {
@@ -24,12 +41,9 @@ std::shared_ptr<HostBuffer> HostBuffer::Create(
 }
 
 HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator)
-    : allocator_(allocator) {
-  DeviceBufferDescriptor desc;
-  desc.size = kAllocatorBlockSize;
-  desc.storage_mode = StorageMode::kHostVisible;
+    : allocator_(allocator), block_size_(kAllocatorBlockSize) {
   for (auto i = 0u; i < kHostBufferArenaSize; i++) {
-    std::shared_ptr<DeviceBuffer> device_buffer = allocator->CreateBuffer(desc);
+    std::shared_ptr<DeviceBuffer> device_buffer = CreateBlock(block_size_);
     FML_CHECK(device_buffer) << "Failed to allocate device buffer.";
     device_buffers_[i].push_back(device_buffer);
   }
@@ -69,27 +83,120 @@ BufferView HostBuffer::Emplace(size_t length,
   return BufferView{std::move(device_buffer), range};
 }
 
+BufferView HostBuffer::EmplaceUpTo(size_t length_hint,
+                                   size_t align,
+                                   EmplaceUpToProc cb) {
+  // If the data is expected to be bigger than the block size, create a one-off
+  // device buffer and write to that.
+  if (length_hint > block_size_) {
+    return EmplaceLargeUpTo(length_hint, cb);
+  }
+
+  size_t padding = 0;
+  if (align > 0 && offset_ % align) {
+    padding = align - (offset_ % align);
+  }
+  if (offset_ + padding + length_hint > GetCurrentBlockSize()) {
+    if (!MaybeCreateNewBuffer()) {
+      return {};
+    }
+  } else {
+    offset_ += padding;
+  }
+
+  // The callback gets the rest of the block so that data which is a little
+  // longer than the hint is still written in a single pass.
+  size_t room = GetCurrentBlockSize() - offset_;
+  size_t length = cb(GetCurrentBuffer()->OnGetContents() + offset_, room);
+  if (length > room) {
+    if (length > block_size_) {
+      return EmplaceLargeUpTo(length, cb);
+    }
+    if (!MaybeCreateNewBuffer()) {
+      return {};
+    }
+    room = GetCurrentBlockSize();
+    length = cb(GetCurrentBuffer()->OnGetContents(), room);
+    if (length > room) {
+      VALIDATION_LOG << "Emplaced data did not fit in the room it asked for.";
+      return {};
+    }
+  }
+
+  const std::shared_ptr<DeviceBuffer>& current_buffer = GetCurrentBuffer();
+  Range output_range(offset_, length);
+  current_buffer->Flush(output_range);
+
+  offset_ += length;
+  frame_stats_.used_bytes += length;
+  return BufferView{current_buffer, output_range};
+}
+
+BufferView HostBuffer::EmplaceLargeUpTo(size_t length_hint,
+                                        EmplaceUpToProc cb) {
+  std::shared_ptr<DeviceBuffer> device_buffer =
+      CreateLargeAllocation(length_hint);
+  if (!device_buffer) {
+    return {};
+  }
+  size_t length = cb(device_buffer->OnGetContents(), length_hint);
+  if (length > length_hint) {
+    // The hint was too low. The exact length is known now, so this only
+    // happens once.
+    device_buffer = CreateLargeAllocation(length);
+    if (!device_buffer) {
+      return {};
+    }
+    const size_t room = length;
+    length = cb(device_buffer->OnGetContents(), room);
+    if (length > room) {
+      VALIDATION_LOG << "Emplaced data did not fit in the room it asked for.";
+      return {};
+    }
+  }
+  device_buffer->Flush(Range{0, length});
+  return BufferView{std::move(device_buffer), Range{0, length}};
+}
+
 HostBuffer::TestStateQuery HostBuffer::GetStateForTest() {
   return HostBuffer::TestStateQuery{
       .current_frame = frame_index_,
       .current_buffer = current_buffer_,
       .total_buffer_count = device_buffers_[frame_index_].size(),
+      .block_size = block_size_,
   };
 }
 
+const HostBuffer::FrameStats& HostBuffer::GetLastFrameStats() const {
+  return last_frame_stats_;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateBlock(size_t size) const {
+  DeviceBufferDescriptor desc;
+  desc.size = size;
+  desc.storage_mode = StorageMode::kHostVisible;
+  return allocator_->CreateBuffer(desc);
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateLargeAllocation(
+    size_t length) {
+  frame_stats_.large_allocation_count++;
+  frame_stats_.large_allocation_bytes += length;
+  return CreateBlock(length);
+}
+
 bool HostBuffer::MaybeCreateNewBuffer() {
-  current_buffer_++;
-  if (current_buffer_ >= device_buffers_[frame_index_].size()) {
-    DeviceBufferDescriptor desc;
-    desc.size = kAllocatorBlockSize;
-    desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+  if (current_buffer_ + 1 >= device_buffers_[frame_index_].size()) {
+    std::shared_ptr<DeviceBuffer> buffer = CreateBlock(block_size_);
     if (!buffer) {
-      VALIDATION_LOG << "Failed to allocate host buffer of size " << desc.size;
+      VALIDATION_LOG << "Failed to allocate host buffer of size "
+                     << block_size_;
       return false;
     }
     device_buffers_[frame_index_].push_back(std::move(buffer));
   }
+  frame_stats_.consumed_bytes += offset_;
+  current_buffer_++;
   offset_ = 0;
   return true;
 }
@@ -104,12 +211,8 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
 
   // If the requested allocation is bigger than the block size, create a one-off
   // device buffer and write to that.
-  if (length > kAllocatorBlockSize) {
-    DeviceBufferDescriptor desc;
-    desc.size = length;
-    desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> device_buffer =
-        allocator_->CreateBuffer(desc);
+  if (length > block_size_) {
+    std::shared_ptr<DeviceBuffer> device_buffer = CreateLargeAllocation(length);
     if (!device_buffer) {
       return {};
     }
@@ -124,7 +227,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
   if (align > 0 && offset_ % align) {
     padding = align - (offset_ % align);
   }
-  if (offset_ + padding + length > kAllocatorBlockSize) {
+  if (offset_ + padding + length > GetCurrentBlockSize()) {
     if (!MaybeCreateNewBuffer()) {
       return {};
     }
@@ -139,6 +242,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
   current_buffer->Flush(output_range);
 
   offset_ += length;
+  frame_stats_.used_bytes += length;
   return std::make_tuple(output_range, current_buffer);
 }
 
@@ -147,12 +251,8 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     size_t length) {
   // If the requested allocation is bigger than the block size, create a one-off
   // device buffer and write to that.
-  if (length > kAllocatorBlockSize) {
-    DeviceBufferDescriptor desc;
-    desc.size = length;
-    desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> device_buffer =
-        allocator_->CreateBuffer(desc);
+  if (length > block_size_) {
+    std::shared_ptr<DeviceBuffer> device_buffer = CreateLargeAllocation(length);
     if (!device_buffer) {
       return {};
     }
@@ -166,7 +266,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
   }
 
   auto old_length = GetLength();
-  if (old_length + length > kAllocatorBlockSize) {
+  if (old_length + length > GetCurrentBlockSize()) {
     if (!MaybeCreateNewBuffer()) {
       return {};
     }
@@ -180,6 +280,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     current_buffer->Flush(Range{old_length, length});
   }
   offset_ += length;
+  frame_stats_.used_bytes += length;
   return std::make_tuple(Range{old_length, length}, current_buffer);
 }
 
@@ -191,7 +292,7 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length, size_t align) {
 
   {
     auto padding = align - (GetLength() % align);
-    if (offset_ + padding < kAllocatorBlockSize) {
+    if (offset_ + padding < GetCurrentBlockSize()) {
       offset_ += padding;
     } else if (!MaybeCreateNewBuffer()) {
       return {};
@@ -205,7 +306,75 @@ const std::shared_ptr<DeviceBuffer>& HostBuffer::GetCurrentBuffer() const {
   return device_buffers_[frame_index_][current_buffer_];
 }
 
+size_t HostBuffer::GetCurrentBlockSize() const {
+  return GetCurrentBuffer()->GetDeviceBufferDescriptor().size;
+}
+
+void HostBuffer::RecordFrameUsage() {
+  frame_stats_.block_size = block_size_;
+  frame_stats_.block_count = current_buffer_ + 1;
+  for (size_t i = 0; i <= current_buffer_; i++) {
+    frame_stats_.reserved_bytes +=
+        device_buffers_[frame_index_][i]->GetDeviceBufferDescriptor().size;
+  }
+  frame_stats_.consumed_bytes += offset_;
+  last_frame_stats_ = frame_stats_;
+  frame_stats_ = {};
+
+  FML_TRACE_COUNTER("impeller", "HostBuffer",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "UsedBytes", last_frame_stats_.used_bytes,
+                    "ConsumedBytes", last_frame_stats_.consumed_bytes,
+                    "ReservedBytes", last_frame_stats_.reserved_bytes,
+                    "LargeAllocationBytes",
+                    last_frame_stats_.large_allocation_bytes);
+
+  usage_history_[usage_history_count_ % kHostBufferUsageHistorySize] =
+      last_frame_stats_.consumed_bytes;
+  usage_history_count_++;
+
+  // Grow the blocks when none of the recent frames fit in a single block.
+  if (usage_history_count_ >= kHostBufferArenaSize) {
+    size_t min_usage = last_frame_stats_.consumed_bytes;
+    for (size_t i = usage_history_count_ - kHostBufferArenaSize;
+         i < usage_history_count_; i++) {
+      min_usage = std::min(
+          min_usage, usage_history_[i % kHostBufferUsageHistorySize]);
+    }
+    if (min_usage > block_size_) {
+      block_size_ = GetBlockSizeForUsage(min_usage);
+    }
+  }
+
+  // Shrink them once every frame of the history fits in smaller blocks.
+  if (usage_history_count_ >= kHostBufferUsageHistorySize) {
+    size_t max_usage =
+        *std::max_element(usage_history_.begin(), usage_history_.end());
+    block_size_ = std::min(block_size_, GetBlockSizeForUsage(max_usage));
+  }
+}
+
+void HostBuffer::TrimBlocks() {
+  std::vector<std::shared_ptr<DeviceBuffer>>& blocks =
+      device_buffers_[frame_index_];
+  auto has_other_size = [&](const std::shared_ptr<DeviceBuffer>& block) {
+    return block->GetDeviceBufferDescriptor().size != block_size_;
+  };
+  // There must always be a current block. If a block of the new size cannot
+  // be allocated, keep using the old one.
+  if (has_other_size(blocks.front())) {
+    if (std::shared_ptr<DeviceBuffer> block = CreateBlock(block_size_)) {
+      blocks.front() = std::move(block);
+    }
+  }
+  blocks.erase(
+      std::remove_if(blocks.begin() + 1, blocks.end(), has_other_size),
+      blocks.end());
+}
+
 void HostBuffer::Reset() {
+  RecordFrameUsage();
+
   // When resetting the host buffer state at the end of the frame, check if
   // there are any unused buffers and remove them.
   while (device_buffers_[frame_index_].size() > current_buffer_ + 1) {
@@ -215,6 +384,7 @@ void HostBuffer::Reset() {
   offset_ = 0u;
   current_buffer_ = 0u;
   frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+  TrimBlocks();
 }
 
 }  // namespace impeller
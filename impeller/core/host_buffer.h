@@ -10,8 +10,10 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
+#include "flutter/fml/function_ref.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/platform.h"
@@ -21,12 +23,39 @@ namespace impeller {
 /// Approximately the same size as the max frames in flight.
 static const constexpr size_t kHostBufferArenaSize = 4u;
 
-/// The host buffer class manages one more 1024 Kb blocks of device buffer
-/// allocations.
+/// The number of frames whose usage is considered when shrinking the blocks
+/// of a host buffer.
+static const constexpr size_t kHostBufferUsageHistorySize =
+    2u * kHostBufferArenaSize;
+
+/// The host buffer class manages one more blocks of device buffer allocations.
+/// Blocks start at 1024 Kb and grow when every recent frame needed more than
+/// one block. They shrink again once a number of frames would have fit in a
+/// smaller block. Allocations larger than a block get a buffer of their own.
 ///
 /// These are reset per-frame.
 class HostBuffer {
  public:
+  /// The usage of a host buffer in a single frame.
+  struct FrameStats {
+    /// The size of the blocks allocated in the frame.
+    size_t block_size = 0u;
+    /// The number of blocks written to.
+    size_t block_count = 0u;
+    /// The total size of the blocks written to.
+    size_t reserved_bytes = 0u;
+    /// The bytes of the blocks taken up by data, alignment padding and the
+    /// unused ends of blocks that were filled up.
+    size_t consumed_bytes = 0u;
+    /// The bytes of data emplaced into blocks. The difference to the consumed
+    /// bytes is lost to fragmentation.
+    size_t used_bytes = 0u;
+    /// The number of allocations that were too large for a block.
+    size_t large_allocation_count = 0u;
+    /// The total size of the allocations that were too large for a block.
+    size_t large_allocation_bytes = 0u;
+  };
+
   static std::shared_ptr<HostBuffer> Create(
       const std::shared_ptr<Allocator>& allocator);
 
@@ -120,16 +149,49 @@ class HostBuffer {
   ///
   BufferView Emplace(size_t length, size_t align, const EmplaceProc& cb);
 
+  /// Writes data into a buffer with room for the given number of bytes and
+  /// returns the length of the data. When that is more than the room, the
+  /// written bytes are discarded and the callback is invoked again with room
+  /// for at least the returned length.
+  using EmplaceUpToProc =
+      fml::FunctionRef<size_t(uint8_t* buffer, size_t room)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Emplaces data whose exact length is expensive to compute ahead
+  ///             of time directly onto the managed buffer.
+  ///
+  ///             The callback is given at least length_hint bytes of room, and
+  ///             usually the rest of the current block. Only the bytes it
+  ///             reports as written are used, the rest of the room is available
+  ///             to the next emplacement. The callback is only invoked a second
+  ///             time when the data does not fit in the room it was given.
+  ///
+  /// @param[in]  length_hint   The expected length of the data in bytes.
+  /// @param[in]  cb            A callback that will be passed a ptr to the
+  ///                           underlying host buffer and the room available
+  ///                           at it.
+  ///
+  /// @return     The buffer view of the written bytes.
+  ///
+  BufferView EmplaceUpTo(size_t length_hint,
+                         size_t align,
+                         EmplaceUpToProc cb);
+
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
   ///        reused.
   void Reset();
 
+  //----------------------------------------------------------------------------
+  /// @brief Retrieve the usage of the frame that was last reset.
+  const FrameStats& GetLastFrameStats() const;
+
   /// Test only internal state.
   struct TestStateQuery {
     size_t current_frame;
     size_t current_buffer;
     size_t total_buffer_count;
+    size_t block_size;
   };
 
   /// @brief Retrieve internal buffer state for test expectations.
@@ -155,6 +217,23 @@ class HostBuffer {
 
   const std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() const;
 
+  size_t GetCurrentBlockSize() const;
+
+  std::shared_ptr<DeviceBuffer> CreateBlock(size_t size) const;
+
+  /// Allocate a buffer of its own for data that does not fit in a block.
+  std::shared_ptr<DeviceBuffer> CreateLargeAllocation(size_t length);
+
+  BufferView EmplaceLargeUpTo(size_t length_hint, EmplaceUpToProc cb);
+
+  /// Record the usage of the frame being reset and update the size of new
+  /// blocks.
+  void RecordFrameUsage();
+
+  /// Release the blocks of the current arena that do not have the size of new
+  /// blocks.
+  void TrimBlocks();
+
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
   explicit HostBuffer(const std::shared_ptr<Allocator>& allocator);
@@ -169,6 +248,11 @@ class HostBuffer {
   size_t current_buffer_ = 0u;
   size_t offset_ = 0u;
   size_t frame_index_ = 0u;
+  size_t block_size_;
+  FrameStats frame_stats_;
+  FrameStats last_frame_stats_;
+  std::array<size_t, kHostBufferUsageHistorySize> usage_history_ = {};
+  size_t usage_history_count_ = 0u;
   std::string label_;
 };
 
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/point_packer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace impeller {
+
+static constexpr Scalar kPackedMax =
+    static_cast<Scalar>(std::numeric_limits<uint16_t>::max());
+
+// Rounding moves a packed coordinate by at most half a step.
+static constexpr Scalar kMaxRoundingError = 0.5f / kPackedMax;
+
+static uint16_t PackComponent(Scalar value) {
+  return static_cast<uint16_t>(
+      std::clamp(std::round(value), 0.0f, kPackedMax));
+}
+
+PointPacker::PointPacker(const Rect& bounds)
+    : origin_(bounds.GetPositive().GetOrigin()),
+      size_(bounds.GetPositive().GetSize()),
+      scale_(size_.width > 0 ? kPackedMax / size_.width : 0.0f,
+             size_.height > 0 ? kPackedMax / size_.height : 0.0f) {}
+
+bool PointPacker::CanPackPositions(const Rect& bounds,
+                                   const Matrix& transform) {
+  if (!bounds.IsFinite() || transform.HasPerspective()) {
+    return false;
+  }
+  Scalar extent = std::max(bounds.GetWidth(), bounds.GetHeight()) *
+                  transform.GetMaxBasisLengthXY();
+  return std::isfinite(extent) && extent * kMaxRoundingError <= kMaxDeviceError;
+}
+
+bool PointPacker::CanPackTextureCoords(const Rect& coords,
+                                       const ISize& texture_size) {
+  if (!Rect::MakeSize(Size(1, 1)).Contains(coords)) {
+    return false;
+  }
+  Scalar extent = std::max(texture_size.width, texture_size.height);
+  return extent * kMaxRoundingError <= kMaxTexelError;
+}
+
+PackedPoint PointPacker::Pack(Point point) const {
+  return PackedPoint{
+      .x = PackComponent((point.x - origin_.x) * scale_.x),
+      .y = PackComponent((point.y - origin_.y) * scale_.y),
+  };
+}
+
+Point PointPacker::Unpack(PackedPoint point) const {
+  return Point(origin_.x + point.x / kPackedMax * size_.width,
+               origin_.y + point.y / kPackedMax * size_.height);
+}
+
+Matrix PointPacker::GetUnpackTransform() const {
+  return Matrix::MakeTranslation({origin_.x, origin_.y, 0}) *
+         Matrix::MakeScale({size_.width, size_.height, 1});
+}
+
+BufferView PointPacker::Emplace(HostBuffer& host_buffer,
+                                const Point* points,
+                                size_t count) const {
+  return host_buffer.Emplace(
+      sizeof(PackedPoint) * count, alignof(PackedPoint),
+      [this, points, count](uint8_t* buffer) {
+        auto packed = reinterpret_cast<PackedPoint*>(buffer);
+        for (size_t i = 0; i < count; i++) {
+          packed[i] = Pack(points[i]);
+        }
+      });
+}
+
+}  // namespace impeller
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_CORE_POINT_PACKER_H_
+#define FLUTTER_IMPELLER_CORE_POINT_PACKER_H_
+
+#include <cstdint>
+
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+/// @brief A point stored as two 16-bit unsigned normalized components. This
+///        is the vertex format of inputs read through a descriptor made by
+///        |VertexDescriptor::CreatePackedDescriptor|.
+struct PackedPoint {
+  uint16_t x = 0u;
+  uint16_t y = 0u;
+
+  constexpr bool operator==(const PackedPoint& other) const {
+    return x == other.x && y == other.y;
+  }
+};
+
+static_assert(sizeof(PackedPoint) == 2 * sizeof(uint16_t));
+
+//------------------------------------------------------------------------------
+/// @brief      Packs points within a rectangle into |PackedPoint|s, which take
+///             half the space of 32-bit float points.
+///
+///             A packed point is the position of the point in the rectangle,
+///             rounded to 1/65535th of its size. The GPU reads it as a float
+///             in [0, 1], which |GetUnpackTransform| maps back to the
+///             rectangle.
+///
+class PointPacker {
+ public:
+  /// The most a packed position may be moved by rounding, in device pixels.
+  static constexpr Scalar kMaxDeviceError = 1.0f / 32.0f;
+
+  /// The most a packed texture coordinate may be moved by rounding, in texels.
+  static constexpr Scalar kMaxTexelError = 1.0f / 256.0f;
+
+  explicit PointPacker(const Rect& bounds);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether positions within the bounds can be packed for a draw
+  ///             with the given transform without moving any of them by more
+  ///             than |kMaxDeviceError|.
+  ///
+  static bool CanPackPositions(const Rect& bounds, const Matrix& transform);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether texture coordinates within the given rectangle of
+  ///             normalized texture coordinates can be packed without moving
+  ///             any of them by more than |kMaxTexelError| texels. Texture
+  ///             coordinates are packed relative to the unit rectangle, so they
+  ///             need no unpacking.
+  ///
+  static bool CanPackTextureCoords(const Rect& coords,
+                                   const ISize& texture_size);
+
+  PackedPoint Pack(Point point) const;
+
+  Point Unpack(PackedPoint point) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The transform that maps the unpacked [0, 1] coordinates read
+  ///             by the GPU back to the coordinate space of the bounds.
+  ///
+  Matrix GetUnpackTransform() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs the points directly into the host buffer.
+  ///
+  BufferView Emplace(HostBuffer& host_buffer,
+                     const Point* points,
+                     size_t count) const;
+
+ private:
+  Point origin_;
+  Size size_;
+  Point scale_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_CORE_POINT_PACKER_H_
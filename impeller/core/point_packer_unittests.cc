@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cmath>
+#include <limits>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/point_packer.h"
+#include "impeller/geometry/constants.h"
+#include "impeller/geometry/geometry_asserts.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PointPackerTest, PacksCornersOfBoundsExactly) {
+  Rect bounds = Rect::MakeLTRB(-10.5, 3.25, 1000.75, 2000);
+  PointPacker packer(bounds);
+
+  EXPECT_EQ(packer.Pack(bounds.GetLeftTop()), (PackedPoint{0u, 0u}));
+  EXPECT_EQ(packer.Pack(bounds.GetRightBottom()),
+            (PackedPoint{65535u, 65535u}));
+  EXPECT_EQ(packer.Pack(bounds.GetRightTop()), (PackedPoint{65535u, 0u}));
+  EXPECT_EQ(packer.Unpack(PackedPoint{0u, 0u}), bounds.GetLeftTop());
+  EXPECT_POINT_NEAR(packer.Unpack(PackedPoint{65535u, 65535u}),
+                    bounds.GetRightBottom());
+}
+
+TEST(PointPackerTest, UnpackTransformMapsUnitSquareToBounds) {
+  Rect bounds = Rect::MakeLTRB(20, -40, 100, 60);
+  PointPacker packer(bounds);
+  Matrix unpack = packer.GetUnpackTransform();
+
+  EXPECT_POINT_NEAR(unpack * Point(0, 0), bounds.GetLeftTop());
+  EXPECT_POINT_NEAR(unpack * Point(1, 1), bounds.GetRightBottom());
+  EXPECT_POINT_NEAR(unpack * Point(0.5, 0.25), Point(60, -15));
+}
+
+TEST(PointPackerTest, PacksWithinHalfAStep) {
+  Rect bounds = Rect::MakeLTRB(0, 0, 655.35, 65.535);
+  PointPacker packer(bounds);
+
+  for (int i = 0; i <= 1000; i++) {
+    Point point(i * 0.65535f, (1000 - i) * 0.065535f);
+    Point unpacked = packer.Unpack(packer.Pack(point));
+    EXPECT_LE(std::abs(unpacked.x - point.x), 0.005f + kEhCloseEnough);
+    EXPECT_LE(std::abs(unpacked.y - point.y), 0.0005f + kEhCloseEnough);
+  }
+}
+
+TEST(PointPackerTest, DegenerateBoundsPackToTheOrigin) {
+  PointPacker packer(Rect::MakeLTRB(5, 10, 5, 20));
+
+  EXPECT_EQ(packer.Pack(Point(5, 10)), (PackedPoint{0u, 0u}));
+  EXPECT_EQ(packer.Pack(Point(5, 20)), (PackedPoint{0u, 65535u}));
+  EXPECT_EQ(packer.Unpack(PackedPoint{0u, 65535u}), Point(5, 20));
+}
+
+TEST(PointPackerTest, CanPackPositionsDependsOnDeviceExtent) {
+  Rect bounds = Rect::MakeXYWH(0, 0, 1000, 500);
+
+  EXPECT_TRUE(PointPacker::CanPackPositions(bounds, {}));
+  EXPECT_TRUE(
+      PointPacker::CanPackPositions(bounds, Matrix::MakeScale({4, 4, 1})));
+  EXPECT_FALSE(
+      PointPacker::CanPackPositions(bounds, Matrix::MakeScale({5, 1, 1})));
+  EXPECT_FALSE(
+      PointPacker::CanPackPositions(bounds, Matrix::MakePerspective(
+                                                Radians(1), 1, 1, 100)));
+  EXPECT_FALSE(PointPacker::CanPackPositions(
+      Rect::MakeLTRB(0, 0, std::numeric_limits<Scalar>::infinity(), 1), {}));
+}
+
+TEST(PointPackerTest, CanPackTextureCoordsOfSmallTextures) {
+  Rect coords = Rect::MakeLTRB(0.25, 0, 1, 0.5);
+
+  EXPECT_TRUE(PointPacker::CanPackTextureCoords(coords, ISize(256, 256)));
+  EXPECT_FALSE(PointPacker::CanPackTextureCoords(coords, ISize(256, 1024)));
+  EXPECT_FALSE(PointPacker::CanPackTextureCoords(
+      Rect::MakeLTRB(-0.5, 0, 1, 1), ISize(16, 16)));
+  EXPECT_FALSE(PointPacker::CanPackTextureCoords(Rect::MakeLTRB(0, 0, 1, 2),
+                                                 ISize(16, 16)));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -120,23 +120,30 @@ struct ShaderStageIOSlot {
   size_t columns;
   size_t offset;
   bool relaxed_precision;
+  /// @brief Whether integer components are read as normalized floating point
+  ///        values in the range [0, 1] (or [-1, 1] when signed). Reflected
+  ///        inputs are never normalized, this is only set for inputs whose
+  ///        vertex format is repacked at runtime.
+  bool normalized = false;
 
   constexpr size_t GetHash() const {
     return fml::HashCombine(name, location, set, binding, type, bit_width,
-                            vec_size, columns, offset, relaxed_precision);
+                            vec_size, columns, offset, relaxed_precision,
+                            normalized);
   }
 
   constexpr bool operator==(const ShaderStageIOSlot& other) const {
-    return name == other.name &&                         //
-           location == other.location &&                 //
-           set == other.set &&                           //
-           binding == other.binding &&                   //
-           type == other.type &&                         //
-           bit_width == other.bit_width &&               //
-           vec_size == other.vec_size &&                 //
-           columns == other.columns &&                   //
-           offset == other.offset &&                     //
-           relaxed_precision == other.relaxed_precision  //
+    return name == other.name &&                            //
+           location == other.location &&                    //
+           set == other.set &&                              //
+           binding == other.binding &&                      //
+           type == other.type &&                            //
+           bit_width == other.bit_width &&                  //
+           vec_size == other.vec_size &&                    //
+           columns == other.columns &&                      //
+           offset == other.offset &&                        //
+           relaxed_precision == other.relaxed_precision &&  //
+           normalized == other.normalized                   //
         ;
   }
 };
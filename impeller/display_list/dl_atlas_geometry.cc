@@ -86,8 +86,11 @@ VertexBuffer DlAtlasGeometry::CreateSimpleVertexBuffer(
           flutter::DlRect sample_rect = tex_[i];
           Matrix matrix = skia_conversions::ToRSXForm(xform_[i]);
           auto points = sample_rect.GetPoints();
-          auto transformed_points = Rect::MakeSize(sample_rect.GetSize())
-                                        .GetTransformedPoints(matrix);
+          auto transformed_points =
+              Rect::MakeSize(sample_rect.GetSize()).GetPoints();
+          matrix.TransformPoints(transformed_points.data(),
+                                 transformed_points.data(),
+                                 transformed_points.size());
           for (size_t j = 0; j < 6; j++) {
             data[offset].position = transformed_points[indices[j]];
             data[offset].texture_coords = points[indices[j]] / texture_size;
@@ -121,8 +124,11 @@ VertexBuffer DlAtlasGeometry::CreateBlendVertexBuffer(
           flutter::DlRect sample_rect = tex_[i];
           Matrix matrix = skia_conversions::ToRSXForm(xform_[i]);
           auto points = sample_rect.GetPoints();
-          auto transformed_points = Rect::MakeSize(sample_rect.GetSize())
-                                        .GetTransformedPoints(matrix);
+          auto transformed_points =
+              Rect::MakeSize(sample_rect.GetSize()).GetPoints();
+          matrix.TransformPoints(transformed_points.data(),
+                                 transformed_points.data(),
+                                 transformed_points.size());
           for (size_t j = 0; j < 6; j++) {
             data[offset].vertices = transformed_points[indices[j]];
             data[offset].texture_coords = points[indices[j]] / texture_size;
@@ -14,6 +14,7 @@
 #include "flutter/fml/logging.h"
 #include "impeller/aiks/aiks_context.h"
 #include "impeller/aiks/color_filter.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/core/formats.h"
 #include "impeller/display_list/dl_atlas_geometry.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
@@ -25,6 +26,7 @@
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
@@ -1465,6 +1467,43 @@ void TextFrameDispatcher::drawTextFrame(
   );
 }
 
+void TextFrameDispatcher::drawPath(const DlPath& path) {
+  if (!renderer_.GetTessellationCache().IsPrefetching()) {
+    return;
+  }
+
+  // Paths that are drawn as rects, rrects or ovals are not tessellated, see
+  // DlDispatcherBase::SimplifyOrDrawPath.
+  DlRect rect;
+  bool closed;
+  SkRRect rrect;
+  if ((path.IsRect(&rect, &closed) && closed) ||
+      (path.IsSkRRect(&rrect) && rrect.isSimple()) || path.IsOval(&rect)) {
+    return;
+  }
+
+  const Path& impeller_path = path.GetPath();
+  auto bounds = impeller_path.GetTransformedBoundingBox(matrix_);
+  if (!bounds.has_value() ||
+      !bounds->IntersectsWithRect(cull_rect_state_.back())) {
+    return;
+  }
+
+  std::shared_ptr<Geometry> geometry;
+  switch (paint_.style) {
+    case Paint::Style::kFill:
+      geometry = Geometry::MakeFillPath(impeller_path, std::nullopt,
+                                        &renderer_.GetFrameArena());
+      break;
+    case Paint::Style::kStroke:
+      geometry = Geometry::MakeStrokePath(
+          impeller_path, paint_.stroke_width, paint_.stroke_miter,
+          paint_.stroke_cap, paint_.stroke_join, &renderer_.GetFrameArena());
+      break;
+  }
+  geometry->PrefetchPositionBuffer(renderer_, matrix_);
+}
+
 const Rect TextFrameDispatcher::GetCurrentLocalCullingBounds() const {
   auto cull_rect = cull_rect_state_.back();
   if (!cull_rect.IsEmpty() && !cull_rect.IsMaximum()) {
@@ -1610,6 +1649,8 @@ std::shared_ptr<Texture> DisplayListToTexture(
     context.GetContentContext().GetTransientsBuffer().Reset();
   }
   context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
+  context.GetContentContext().GetTessellationCache().DiscardPrefetches();
+  context.GetContentContext().GetFrameArena().Reset();
 
   return target.GetRenderTargetTexture();
 }
@@ -1637,6 +1678,8 @@ bool RenderToOnscreen(ContentContext& context,
     context.GetTransientsBuffer().Reset();
   }
   context.GetLazyGlyphAtlas()->ResetTextFrames();
+  context.GetTessellationCache().DiscardPrefetches();
+  context.GetFrameArena().Reset();
 
   return true;
 }
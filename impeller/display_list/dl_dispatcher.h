@@ -284,7 +284,8 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   Canvas& GetCanvas() override;
 };
 
-/// Performs a first pass over the display list to collect all text frames.
+/// Performs a first pass over the display list to collect all text frames and
+/// to start tessellating paths on the workers of the tessellation cache.
 class TextFrameDispatcher : public flutter::IgnoreAttributeDispatchHelper,
                             public flutter::IgnoreClipDispatchHelper,
                             public flutter::IgnoreDrawDispatchHelper {
@@ -329,6 +330,8 @@ class TextFrameDispatcher : public flutter::IgnoreAttributeDispatchHelper,
                      DlScalar x,
                      DlScalar y) override;
 
+  void drawPath(const DlPath& path) override;
+
   void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
                        DlScalar opacity) override;
 
@@ -6,6 +6,7 @@
 
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/aiks_context.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
@@ -59,6 +60,7 @@ bool DlPlayground::OpenPlaygroundHere(DisplayListPlaygroundCallback callback) {
         impeller_dispatcher.FinishRecording();
         context.GetContentContext().GetTransientsBuffer().Reset();
         context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
+        context.GetContentContext().GetFrameArena().Reset();
         return true;
       });
 }
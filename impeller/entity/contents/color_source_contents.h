@@ -120,6 +120,16 @@ class ColorSourceContents : public Contents {
     return geom.GetPositionBuffer(renderer, entity, pass);
   }
 
+  /// @brief A |CreateGeometryCallback| for contents whose vertex shader only
+  ///        transforms the positions, which may then be packed.
+  static GeometryResult PackedCreateGeometryCallback(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      const Geometry& geom) {
+    return geom.GetPackedPositionBuffer(renderer, entity, pass);
+  }
+
   /// @brief Whether the entity should be treated as non-opaque due to stroke
   ///        geometry requiring alpha for coverage.
   bool AppliesAlphaForStrokeCoverage(const Matrix& transform) const;
@@ -210,6 +220,7 @@ class ColorSourceContents : public Contents {
     }
     pass.SetVertexBuffer(std::move(geometry_result.vertex_buffer));
     options.primitive_type = geometry_result.type;
+    options.packed_vertices = geometry_result.packed_vertices;
 
     // Enable depth writing for all opaque entities in order to allow
     // reordering. Opaque entities are coerced to source blending by
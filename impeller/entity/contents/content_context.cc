@@ -7,7 +7,9 @@
 #include <memory>
 #include <utility>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "fml/trace_event.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
@@ -20,6 +22,8 @@
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/texture_mipmap.h"
+#include "impeller/renderer/vertex_descriptor.h"
+#include "impeller/tessellator/tessellation_cache.h"
 #include "impeller/tessellator/tessellator.h"
 #include "impeller/typographer/typographer_context.h"
 
@@ -219,6 +223,11 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPrimitiveType(primitive_type);
 
   desc.SetPolygonMode(wireframe ? PolygonMode::kLine : PolygonMode::kFill);
+
+  if (packed_vertices && desc.GetVertexDescriptor()) {
+    desc.SetVertexDescriptor(
+        desc.GetVertexDescriptor()->CreatePackedDescriptor());
+  }
 }
 
 template <typename PipelineT>
@@ -246,14 +255,20 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
-      render_target_cache_(render_target_allocator == nullptr
-                               ? std::make_shared<RenderTargetCache>(
-                                     context_->GetResourceAllocator())
-                               : std::move(render_target_allocator)),
+      tessellation_cache_(std::make_unique<TessellationCache>()),
+      frame_arena_(std::make_unique<FrameArena>()),
+      render_target_cache_(
+          render_target_allocator == nullptr
+              ? std::make_shared<RenderTargetCache>(
+                    context_->GetResourceAllocator(),
+                    RenderTargetCache::kDefaultMaxRetainedBytes)
+              : std::move(render_target_allocator)),
       host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  tessellation_cache_->SetWorkerTaskRunner(
+      context_->GetConcurrentWorkerTaskRunner());
 
   {
     TextureDescriptor desc;
@@ -302,6 +317,18 @@ ContentContext::ContentContext(
     texture_pipelines_.CreateDefault(*context_, options);
     fast_gradient_pipelines_.CreateDefault(*context_, options);
 
+    // Rects and convex paths are usually filled with packed vertices. Create
+    // the variants used by translucent and opaque fills of the onscreen pass
+    // up front instead of on their first draw.
+    auto options_packed = options_trianglestrip;
+    options_packed.depth_compare = CompareFunction::kGreater;
+    options_packed.packed_vertices = true;
+    solid_fill_pipelines_.CreateVariant(*context_, options_packed);
+    texture_pipelines_.CreateVariant(*context_, options_packed);
+    options_packed.blend_mode = BlendMode::kSource;
+    options_packed.depth_write_enabled = true;
+    solid_fill_pipelines_.CreateVariant(*context_, options_packed);
+
     if (context_->GetCapabilities()->SupportsSSBO()) {
       linear_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
       radial_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
@@ -547,6 +574,14 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+TessellationCache& ContentContext::GetTessellationCache() const {
+  return *tessellation_cache_;
+}
+
+FrameArena& ContentContext::GetFrameArena() const {
+  return *frame_arena_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
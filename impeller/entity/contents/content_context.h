@@ -314,6 +314,10 @@ struct ContentContextOptions {
   bool depth_write_enabled = false;
   bool wireframe = false;
   bool is_for_rrect_blur_clear = false;
+  /// Whether the two component float vertex inputs are read from
+  /// |PackedPoint|s. Only valid for pipelines whose vertex shader does nothing
+  /// but transform them, see |GeometryResult::packed_vertices|.
+  bool packed_vertices = false;
 
   struct Hash {
     constexpr uint64_t operator()(const ContentContextOptions& o) const {
@@ -329,6 +333,7 @@ struct ContentContextOptions {
              (o.wireframe ? 1llu : 0llu) << 1 |
              (o.has_depth_stencil_attachments ? 1llu : 0llu) << 2 |
              (o.depth_write_enabled ? 1llu : 0llu) << 3 |
+             (o.packed_vertices ? 1llu : 0llu) << 4 |
              // enums
              static_cast<uint64_t>(o.color_attachment_pixel_format) << 8 |
              static_cast<uint64_t>(o.primitive_type) << 16 |
@@ -353,14 +358,17 @@ struct ContentContextOptions {
              lhs.has_depth_stencil_attachments ==
                  rhs.has_depth_stencil_attachments &&
              lhs.wireframe == rhs.wireframe &&
-             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear;
+             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear &&
+             lhs.packed_vertices == rhs.packed_vertices;
     }
   };
 
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
+class FrameArena;
 class Tessellator;
+class TessellationCache;
 class RenderTargetCache;
 
 class ContentContext {
@@ -376,6 +384,21 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief Retrieve the cache of path tessellations that is retained across
+  ///        frames.
+  ///
+  /// Like the transients buffer, this is only safe to use from the raster
+  /// threads.
+  TessellationCache& GetTessellationCache() const;
+
+  /// @brief Retrieve the arena that transient entities, contents and geometry
+  ///        of the frame being recorded are allocated from.
+  ///
+  /// The arena is reset once the frame has been submitted. Objects that are
+  /// retained past the frame remain valid. Like the transients buffer, this
+  /// is only safe to use from the raster threads.
+  FrameArena& GetFrameArena() const;
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetFastGradientPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(fast_gradient_pipelines_, opts);
@@ -832,6 +855,21 @@ class ContentContext {
       SetDefault(options, std::make_unique<PipelineHandleT>(context, desc));
     }
 
+    /// Creates a variant ahead of its first use, without waiting for the
+    /// default pipeline.
+    void CreateVariant(const Context& context,
+                       const ContentContextOptions& options,
+                       const std::initializer_list<Scalar>& constants = {}) {
+      auto desc = PipelineHandleT::Builder::MakeDefaultPipelineDescriptor(
+          context, constants);
+      if (!desc.has_value()) {
+        VALIDATION_LOG << "Failed to create pipeline variant.";
+        return;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      Set(options, std::make_unique<PipelineHandleT>(context, desc));
+    }
+
     PipelineHandleT* Get(const ContentContextOptions& options) const {
       if (auto found = pipelines_.find(options); found != pipelines_.end()) {
         return found->second.get();
@@ -1002,6 +1040,8 @@ class ContentContext {
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::unique_ptr<TessellationCache> tessellation_cache_;
+  std::unique_ptr<FrameArena> frame_arena_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
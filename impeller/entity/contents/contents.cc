@@ -142,6 +142,10 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+const SolidColorContents* Contents::AsSolidColor() const {
+  return nullptr;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
@@ -22,6 +22,7 @@ class Entity;
 class Surface;
 class RenderPass;
 class FilterContents;
+class SolidColorContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -163,6 +164,12 @@ class Contents {
   ///
   virtual const FilterContents* AsFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Cast to solid color contents. Returns `nullptr` if this Contents
+  ///        does not fill its geometry with a solid color.
+  ///
+  virtual const SolidColorContents* AsSolidColor() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
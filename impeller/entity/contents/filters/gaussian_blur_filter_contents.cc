@@ -9,6 +9,8 @@
 #include "flutter/fml/make_copyable.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/entity/texture_downsample.frag.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
@@ -312,8 +314,23 @@ DownsamplePassArgs CalculateDownsamplePassArgs(
   }
 }
 
+/// Extends the UVs of a quad whose corners map to the corners of a rect of
+/// `logical_size` to the corners of a rect of `texture_size` with the same top
+/// left corner.
+Quad ExtendUVs(const Quad& uvs, ISize logical_size, ISize texture_size) {
+  Vector2 scale = Vector2(texture_size) / Vector2(logical_size);
+  Point right = (uvs[1] - uvs[0]) * scale.x;
+  Point down = (uvs[2] - uvs[0]) * scale.y;
+  return {uvs[0], uvs[0] + right, uvs[0] + down, uvs[0] + right + down};
+}
+
 /// Makes a subpass that will render the scaled down input and add the
 /// transparent gutter required for the blur halo.
+///
+/// The render target is rounded up to a size bucket so that it can be reused
+/// while the blur size changes. The part past `pass_args.subpass_size`
+/// continues the input, so that the blur passes sample the same pixels at the
+/// right and bottom edges as they would past the edge of the input.
 fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     const ContentContext& renderer,
     const std::shared_ptr<CommandBuffer>& command_buffer,
@@ -323,6 +340,9 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     Entity::TileMode tile_mode) {
   using VS = TextureFillVertexShader;
 
+  const ISize texture_size =
+      RenderTargetCache::RoundUpToSizeBucket(pass_args.subpass_size);
+
   // If the texture already had mip levels generated, then we can use the
   // original downsample shader.
   if (pass_args.effective_scalar.x >= 0.5f ||
@@ -345,7 +365,8 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
           TextureFillFragmentShader::FragInfo frag_info;
           frag_info.alpha = 1.0;
 
-          const Quad& uvs = pass_args.uvs;
+          const Quad uvs = ExtendUVs(pass_args.uvs, pass_args.subpass_size,
+                                     texture_size);
           std::array<VS::PerVertexData, 4> vertices = {
               VS::PerVertexData{Point(0, 0), uvs[0]},
               VS::PerVertexData{Point(1, 0), uvs[1]},
@@ -369,7 +390,7 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
 
           return pass.Draw().ok();
         };
-    return renderer.MakeSubpass("Gaussian Blur Filter", pass_args.subpass_size,
+    return renderer.MakeSubpass("Gaussian Blur Filter", texture_size,
                                 command_buffer, subpass_callback);
   } else {
     // This assumes we don't scale below 1/16.
@@ -401,7 +422,8 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
           frag_info.ratio = ratio;
           frag_info.pixel_size = Vector2(1.0f / Size(input_texture->GetSize()));
 
-          const Quad& uvs = pass_args.uvs;
+          const Quad uvs = ExtendUVs(pass_args.uvs, pass_args.subpass_size,
+                                     texture_size);
           std::array<VS::PerVertexData, 4> vertices = {
               VS::PerVertexData{Point(0, 0), uvs[0]},
               VS::PerVertexData{Point(1, 0), uvs[1]},
@@ -425,7 +447,7 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
 
           return pass.Draw().ok();
         };
-    return renderer.MakeSubpass("Gaussian Blur Filter", pass_args.subpass_size,
+    return renderer.MakeSubpass("Gaussian Blur Filter", texture_size,
                                 command_buffer, subpass_callback);
   }
 }
@@ -822,16 +844,22 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
       MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
 
-  Entity blur_output_entity = Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
-               .transform =
-                   entity.GetTransform() *                                   //
-                   Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
-                   downsample_pass_args.transform *                          //
-                   Matrix::MakeScale(1 / downsample_pass_args.effective_scalar),
-               .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity},
-      entity.GetBlendMode());
+  // Only the top left part of the rounded up render target is the result.
+  Rect blur_output_rect = Rect::MakeSize(downsample_pass_args.subpass_size);
+  auto blur_output_contents = TextureContents::MakeRect(blur_output_rect);
+  blur_output_contents->SetTexture(pass3_out.value().GetRenderTargetTexture());
+  blur_output_contents->SetSamplerDescriptor(sampler_desc);
+  blur_output_contents->SetSourceRect(blur_output_rect);
+  blur_output_contents->SetOpacity(input_snapshot->opacity);
+
+  Entity blur_output_entity;
+  blur_output_entity.SetBlendMode(entity.GetBlendMode());
+  blur_output_entity.SetTransform(
+      entity.GetTransform() *                                   //
+      Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
+      downsample_pass_args.transform *                          //
+      Matrix::MakeScale(1 / downsample_pass_args.effective_scalar));
+  blur_output_entity.SetContents(std::move(blur_output_contents));
 
   return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
                         input_snapshot.value(), std::move(blur_output_entity),
@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity_playground.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/renderer/testing/mocks.h"
@@ -331,6 +332,37 @@ TEST_P(GaussianBlurFilterContentsTest,
   }
 }
 
+TEST_P(GaussianBlurFilterContentsTest, ReusesRenderTargetsAsTheRadiusGrows) {
+  std::shared_ptr<Texture> texture = MakeTexture(ISize(100, 100));
+  auto render_target_cache = std::make_shared<RenderTargetCache>(
+      GetContext()->GetResourceAllocator(),
+      RenderTargetCache::kDefaultMaxRetainedBytes);
+  ContentContext renderer(GetContext(), /*typographer_context=*/nullptr,
+                          render_target_cache);
+
+  // An animated blur whose output grows by two pixels every frame.
+  Entity entity;
+  for (int frame = 0; frame < 16; frame++) {
+    fml::StatusOr<Scalar> sigma =
+        CalculateSigmaForBlurRadius(1.0 + frame, Matrix());
+    ASSERT_TRUE(sigma.ok());
+    auto contents = std::make_unique<GaussianBlurFilterContents>(
+        sigma.value(), sigma.value(), Entity::TileMode::kDecal,
+        FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+    contents->SetInputs({FilterInput::Make(texture)});
+    render_target_cache->Start();
+    std::optional<Entity> result =
+        contents->GetEntity(renderer, entity, /*coverage_hint=*/{});
+    render_target_cache->End();
+    ASSERT_TRUE(result.has_value());
+  }
+
+  // The render targets are rounded up to size buckets, so most frames reuse
+  // the textures of the previous frame.
+  EXPECT_GT(render_target_cache->GetStats().hit_count,
+            render_target_cache->GetStats().miss_count);
+}
+
 TEST_P(GaussianBlurFilterContentsTest, CalculateUVsSimple) {
   std::shared_ptr<Texture> texture = MakeTexture(ISize(100, 100));
   auto filter_input = FilterInput::Make(texture);
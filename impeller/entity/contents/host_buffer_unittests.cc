@@ -163,6 +163,140 @@ TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
   EXPECT_EQ(view.range, Range(32, 64));
 }
 
+TEST_P(HostBufferTest, EmplaceUpToOnlyUsesWrittenLength) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  size_t calls = 0u;
+  BufferView view =
+      buffer->EmplaceUpTo(64, 16, [&calls](uint8_t*, size_t room) {
+        calls++;
+        EXPECT_GE(room, 64u);
+        return 24u;
+      });
+  EXPECT_EQ(view.range, Range(0, 24));
+
+  view = buffer->Emplace(std::array<char, 8>());
+  EXPECT_EQ(view.range, Range(24, 8));
+
+  // Data longer than the hint that fits in the rest of the block is written
+  // in a single pass.
+  view = buffer->EmplaceUpTo(16, 16, [&calls](uint8_t*, size_t) {
+    calls++;
+    return 32u;
+  });
+  EXPECT_EQ(view.range, Range(32, 32));
+
+  view = buffer->EmplaceUpTo(1024, 0, [&calls](uint8_t*, size_t) {
+    calls++;
+    return 0u;
+  });
+  EXPECT_EQ(view.range, Range(64, 0));
+  EXPECT_EQ(calls, 3u);
+}
+
+TEST_P(HostBufferTest, EmplaceUpToRetriesWithTheWrittenLength) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  const size_t block_size = buffer->GetStateForTest().block_size;
+
+  // Leave 64 bytes in the first block.
+  BufferView view =
+      buffer->Emplace(block_size - 64, 0, [](uint8_t*) {});
+  ASSERT_TRUE(view);
+
+  // Data that does not fit in the rest of the block continues in a new block
+  // with room for it.
+  std::vector<size_t> rooms;
+  view = buffer->EmplaceUpTo(32, 0, [&rooms](uint8_t*, size_t room) {
+    rooms.push_back(room);
+    return 128u;
+  });
+  EXPECT_EQ(view.range, Range(0, 128));
+  EXPECT_EQ(rooms, std::vector<size_t>({64u, block_size}));
+  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 1u);
+
+  // Data longer than a block gets an allocation of its own, sized from the
+  // length reported by the first pass.
+  rooms.clear();
+  view = buffer->EmplaceUpTo(
+      block_size + 1, 0, [&rooms, block_size](uint8_t*, size_t room) {
+        rooms.push_back(room);
+        return 2 * block_size;
+      });
+  EXPECT_EQ(view.range, Range(0, 2 * block_size));
+  EXPECT_EQ(rooms, std::vector<size_t>({block_size + 1, 2 * block_size}));
+  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 1u);
+}
+
+TEST_P(HostBufferTest, RecordsFrameStats) {
+  struct Length2 {
+    uint8_t pad[2];
+  };
+  struct alignas(16) Align16 {
+    uint8_t pad[2];
+  };
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  EXPECT_TRUE(buffer->Emplace(Length2{}));
+  EXPECT_TRUE(buffer->Emplace(Align16{}));
+  EXPECT_TRUE(buffer->Emplace(nullptr, 1024000 + 10, 0));
+  buffer->Reset();
+
+  const HostBuffer::FrameStats& stats = buffer->GetLastFrameStats();
+  EXPECT_EQ(stats.block_size, 1024000u);
+  EXPECT_EQ(stats.block_count, 1u);
+  EXPECT_EQ(stats.reserved_bytes, 1024000u);
+  EXPECT_EQ(stats.consumed_bytes, 32u);
+  EXPECT_EQ(stats.used_bytes, 18u);
+  EXPECT_EQ(stats.large_allocation_count, 1u);
+  EXPECT_EQ(stats.large_allocation_bytes, 1024000u + 10u);
+}
+
+TEST_P(HostBufferTest, GrowsAndShrinksBlocksWithFrameUsage) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  // Every frame needs three blocks.
+  for (size_t i = 0; i < kHostBufferArenaSize; i++) {
+    EXPECT_EQ(buffer->GetStateForTest().block_size, 1024000u);
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_TRUE(buffer->Emplace(1000000, 0, [](uint8_t* data) {}));
+    }
+    EXPECT_EQ(buffer->GetStateForTest().current_buffer, 2u);
+    buffer->Reset();
+    EXPECT_EQ(buffer->GetLastFrameStats().block_count, 3u);
+    EXPECT_EQ(buffer->GetLastFrameStats().consumed_bytes, 3000000u);
+  }
+
+  // The blocks grow so that a frame fits in a single one.
+  EXPECT_EQ(buffer->GetStateForTest().block_size, 4096000u);
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
+  for (size_t j = 0; j < 3; j++) {
+    EXPECT_TRUE(buffer->Emplace(1000000, 0, [](uint8_t* data) {}));
+  }
+  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetLastFrameStats().block_count, 1u);
+  EXPECT_EQ(buffer->GetLastFrameStats().reserved_bytes, 4096000u);
+
+  // They only shrink once every frame of the history would have fit in
+  // smaller blocks.
+  for (size_t i = 1; i < kHostBufferUsageHistorySize; i++) {
+    EXPECT_TRUE(buffer->Emplace(1000, 0, [](uint8_t* data) {}));
+    buffer->Reset();
+    EXPECT_EQ(buffer->GetStateForTest().block_size, 4096000u);
+  }
+  EXPECT_TRUE(buffer->Emplace(1000, 0, [](uint8_t* data) {}));
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetStateForTest().block_size, 1024000u);
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
+
+  // Allocations larger than the smaller blocks get a buffer of their own
+  // again.
+  EXPECT_TRUE(buffer->Emplace(2000000, 0, [](uint8_t* data) {}));
+  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetLastFrameStats().large_allocation_count, 1u);
+}
+
 static constexpr const size_t kMagicFailingAllocation = 1024000 * 2;
 
 class FailingAllocator : public Allocator {
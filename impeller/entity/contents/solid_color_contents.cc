@@ -28,6 +28,10 @@ bool SolidColorContents::IsSolidColor() const {
   return true;
 }
 
+const SolidColorContents* SolidColorContents::AsSolidColor() const {
+  return this;
+}
+
 bool SolidColorContents::IsOpaque(const Matrix& transform) const {
   return GetColor().IsOpaque() && !AppliesAlphaForStrokeCoverage(transform);
 }
@@ -67,7 +71,8 @@ bool SolidColorContents::Render(const ContentContext& renderer,
         FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
         pass.SetCommandLabel("Solid Fill");
         return true;
-      });
+      },
+      /*force_stencil=*/false, PackedCreateGeometryCallback);
 }
 
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
@@ -30,6 +30,9 @@ class SolidColorContents final : public ColorSourceContents {
   // |ColorSourceContents|
   bool IsSolidColor() const override;
 
+  // |Contents|
+  const SolidColorContents* AsSolidColor() const override;
+
   // |Contents|
   bool IsOpaque(const Matrix& transform) const override;
 
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
@@ -151,9 +152,11 @@ bool TextContents::Render(const ContentContext& renderer,
   // interpolated vertex information is also used in the fragment shader to
   // sample from the glyph atlas.
 
-  constexpr std::array<Point, 6> unit_points = {Point{0, 0}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 1}};
+  // The two triangles of each quad share two of its corners, so only the four
+  // corners are transformed.
+  constexpr std::array<Point, 4> unit_corners = {Point{0, 0}, Point{1, 0},
+                                                 Point{0, 1}, Point{1, 1}};
+  constexpr std::array<size_t, 6> unit_corner_indices = {0, 1, 2, 1, 2, 3};
 
   auto& host_buffer = renderer.GetTransientsBuffer();
   size_t vertex_count = 0;
@@ -169,6 +172,10 @@ bool TextContents::Render(const ContentContext& renderer,
         VS::PerVertexData* vtx_contents =
             reinterpret_cast<VS::PerVertexData*>(contents);
         size_t i = 0u;
+        // The corners and UV rectangles of the glyphs of a run, so that the
+        // corners of a whole run are transformed at once.
+        std::vector<Point> corners;
+        std::vector<std::pair<Point, Point>> uvs;
         for (const TextRun& run : frame_->GetRuns()) {
           const Font& font = run.GetFont();
           Scalar rounded_scale = TextFrame::RoundScaledFontSize(
@@ -199,6 +206,10 @@ bool TextContents::Render(const ContentContext& renderer,
           }
 
           Point screen_offset = (entity_transform * Point(0, 0));
+          corners.clear();
+          uvs.clear();
+          corners.reserve(run.GetGlyphPositions().size() * unit_corners.size());
+          uvs.reserve(run.GetGlyphPositions().size());
           for (const TextRun::GlyphPosition& glyph_position :
                run.GetGlyphPositions()) {
             // Note: uses unrounded scale for more accurate subpixel position.
@@ -228,6 +239,7 @@ bool TextContents::Render(const ContentContext& renderer,
                 atlas_size;
             Point uv_size =
                 (atlas_glyph_bounds.GetSize() + Point(1, 1)) / atlas_size;
+            uvs.emplace_back(uv_origin, uv_size);
 
             Point unrounded_glyph_position =
                 basis_transform *
@@ -237,19 +249,32 @@ bool TextContents::Render(const ContentContext& renderer,
                 (screen_offset + unrounded_glyph_position + subpixel_adjustment)
                     .Floor();
 
-            for (const Point& point : unit_points) {
-              Point position;
-              if (is_translation_scale) {
-                position = (screen_glyph_position +
-                            (basis_transform * point * scaled_bounds.GetSize()))
-                               .Round();
-              } else {
-                position = entity_transform * (glyph_position.position +
-                                               scaled_bounds.GetLeftTop() +
-                                               point * scaled_bounds.GetSize());
+            if (is_translation_scale) {
+              for (const Point& unit_corner : unit_corners) {
+                corners.push_back((screen_glyph_position +
+                                   (basis_transform * unit_corner *
+                                    scaled_bounds.GetSize()))
+                                      .Round());
               }
-              vtx.uv = uv_origin + (uv_size * point);
-              vtx.position = position;
+            } else {
+              for (const Point& unit_corner : unit_corners) {
+                corners.push_back(glyph_position.position +
+                                  scaled_bounds.GetLeftTop() +
+                                  unit_corner * scaled_bounds.GetSize());
+              }
+            }
+          }
+          if (!is_translation_scale) {
+            entity_transform.TransformPoints(corners.data(), corners.data(),
+                                             corners.size());
+          }
+          for (size_t glyph = 0; glyph < uvs.size(); glyph++) {
+            const auto& [uv_origin, uv_size] = uvs[glyph];
+            const Point* glyph_corners =
+                corners.data() + glyph * unit_corners.size();
+            for (size_t index : unit_corner_indices) {
+              vtx.uv = uv_origin + (uv_size * unit_corners[index]);
+              vtx.position = glyph_corners[index];
               vtx_contents[i++] = vtx;
             }
           }
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "impeller/core/formats.h"
+#include "impeller/core/point_packer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.frag.h"
@@ -125,20 +126,51 @@ bool TextureContents::Render(const ContentContext& renderer,
       Rect::MakeSize(texture_->GetSize()).Project(source_rect_);
   auto& host_buffer = renderer.GetTransientsBuffer();
 
-  std::array<VS::PerVertexData, 4> vertices = {
-      VS::PerVertexData{destination_rect_.GetLeftTop(),
-                        texture_coords.GetLeftTop()},
-      VS::PerVertexData{destination_rect_.GetRightTop(),
-                        texture_coords.GetRightTop()},
-      VS::PerVertexData{destination_rect_.GetLeftBottom(),
-                        texture_coords.GetLeftBottom()},
-      VS::PerVertexData{destination_rect_.GetRightBottom(),
-                        texture_coords.GetRightBottom()},
-  };
-  auto vertex_buffer = CreateVertexBuffer(vertices, host_buffer);
+  // The corners of the destination rect pack exactly, but the texture
+  // coordinates are rounded, which is only invisible for small textures.
+  bool packed_vertices =
+      destination_rect_.IsFinite() &&
+      PointPacker::CanPackTextureCoords(texture_coords, texture_->GetSize());
+#ifdef IMPELLER_ENABLE_OPENGLES
+  packed_vertices = packed_vertices && !is_external_texture;
+#endif  // IMPELLER_ENABLE_OPENGLES
 
+  VertexBuffer vertex_buffer;
   VS::FrameInfo frame_info;
   frame_info.mvp = entity.GetShaderTransform(pass);
+  if (packed_vertices) {
+    struct PackedVertexData {
+      PackedPoint position;
+      PackedPoint texture_coords;
+    };
+    PointPacker position_packer(destination_rect_);
+    PointPacker coords_packer(Rect::MakeSize(Size(1, 1)));
+    auto pack = [&](Point position, Point coords) {
+      return PackedVertexData{position_packer.Pack(position),
+                              coords_packer.Pack(coords)};
+    };
+    std::array<PackedVertexData, 4> vertices = {
+        pack(destination_rect_.GetLeftTop(), texture_coords.GetLeftTop()),
+        pack(destination_rect_.GetRightTop(), texture_coords.GetRightTop()),
+        pack(destination_rect_.GetLeftBottom(), texture_coords.GetLeftBottom()),
+        pack(destination_rect_.GetRightBottom(),
+             texture_coords.GetRightBottom()),
+    };
+    vertex_buffer = CreateVertexBuffer(vertices, host_buffer);
+    frame_info.mvp = frame_info.mvp * position_packer.GetUnpackTransform();
+  } else {
+    std::array<VS::PerVertexData, 4> vertices = {
+        VS::PerVertexData{destination_rect_.GetLeftTop(),
+                          texture_coords.GetLeftTop()},
+        VS::PerVertexData{destination_rect_.GetRightTop(),
+                          texture_coords.GetRightTop()},
+        VS::PerVertexData{destination_rect_.GetLeftBottom(),
+                          texture_coords.GetLeftBottom()},
+        VS::PerVertexData{destination_rect_.GetRightBottom(),
+                          texture_coords.GetRightBottom()},
+    };
+    vertex_buffer = CreateVertexBuffer(vertices, host_buffer);
+  }
   frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
 
 #ifdef IMPELLER_DEBUG
@@ -154,6 +186,7 @@ bool TextureContents::Render(const ContentContext& renderer,
     pipeline_options.stencil_mode = ContentContextOptions::StencilMode::kIgnore;
   }
   pipeline_options.primitive_type = PrimitiveType::kTriangleStrip;
+  pipeline_options.packed_vertices = packed_vertices;
 
   pipeline_options.depth_write_enabled =
       stencil_enabled_ && pipeline_options.blend_mode == BlendMode::kSource;
@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/draw_batcher.h"
+
+#include <memory>
+#include <optional>
+
+#include "impeller/base/frame_arena.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+
+namespace impeller {
+
+namespace {
+
+/// The merged triangles of a batch, already in the coordinate space of the
+/// render pass.
+class TriangleBatchGeometry final : public Geometry {
+ public:
+  TriangleBatchGeometry(const TriangleBatch& batch, Rect bounds)
+      : batch_(batch), bounds_(bounds) {}
+
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const override {
+    auto& host_buffer = renderer.GetTransientsBuffer();
+    return GeometryResult{
+        .type = PrimitiveType::kTriangle,
+        .vertex_buffer =
+            {
+                .vertex_buffer = host_buffer.Emplace(
+                    batch_.points.data(), sizeof(Point) * batch_.points.size(),
+                    alignof(Point)),
+                .index_buffer = host_buffer.Emplace(
+                    batch_.indices.data(),
+                    sizeof(uint16_t) * batch_.indices.size(),
+                    alignof(uint16_t)),
+                .vertex_count = batch_.indices.size(),
+                .index_type = IndexType::k16bit,
+            },
+        .transform = entity.GetShaderTransform(pass),
+    };
+  }
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override {
+    return bounds_.TransformBounds(transform);
+  }
+
+ private:
+  const TriangleBatch& batch_;
+  const Rect bounds_;
+};
+
+}  // namespace
+
+DrawBatcher::DrawBatcher() = default;
+
+DrawBatcher::~DrawBatcher() = default;
+
+bool DrawBatcher::Add(const ContentContext& renderer,
+                      const Entity& entity,
+                      RenderPass& pass) {
+  const std::shared_ptr<Contents>& contents = entity.GetContents();
+  const SolidColorContents* solid_color =
+      contents ? contents->AsSolidColor() : nullptr;
+  if (solid_color == nullptr || solid_color->GetGeometry() == nullptr) {
+    return false;
+  }
+  const Geometry& geometry = *solid_color->GetGeometry();
+  const Matrix& transform = entity.GetTransform();
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      transform.HasPerspective() ||
+      geometry.GetResultMode() != GeometryResult::Mode::kNormal ||
+      geometry.ComputeAlphaCoverage(transform) != 1.0f) {
+    return false;
+  }
+
+  Color color = solid_color->GetColor();
+  if (entity_count_ > 0u &&
+      (pass_ != &pass || color != color_ ||
+       entity.GetBlendMode() != blend_mode_)) {
+    Flush(renderer);
+  }
+
+  // Most entities are not followed by one they can be merged with, so the
+  // first entity of a batch is only appended once a second one arrives.
+  if (entity_count_ == 0u) {
+    pass_ = &pass;
+    first_entity_ = entity.Clone();
+    color_ = color;
+    blend_mode_ = entity.GetBlendMode();
+    clip_depth_ = entity.GetClipDepth();
+    entity_count_ = 1u;
+    return true;
+  }
+
+  if (entity_count_ == 1u) {
+    const Geometry& first_geometry =
+        *first_entity_.GetContents()->AsSolidColor()->GetGeometry();
+    if (!first_geometry.AppendTriangles(
+            renderer, first_entity_.GetTransform(), triangles_)) {
+      // The first entity is drawn on its own, and this one is held instead.
+      Flush(renderer);
+      return Add(renderer, entity, pass);
+    }
+  }
+
+  if (!geometry.AppendTriangles(renderer, transform, triangles_)) {
+    // The batch is full or the entity cannot be merged, so start another.
+    Flush(renderer);
+    return Add(renderer, entity, pass);
+  }
+  clip_depth_ = entity.GetClipDepth();
+  entity_count_++;
+  return true;
+}
+
+bool DrawBatcher::Flush(const ContentContext& renderer) {
+  if (entity_count_ == 0u) {
+    return true;
+  }
+
+  bool result;
+  if (entity_count_ == 1u) {
+    result = first_entity_.Render(renderer, *pass_);
+  } else {
+    std::optional<Rect> bounds = Rect::MakePointBounds(
+        triangles_.points.begin(), triangles_.points.end());
+    FrameArena& arena = renderer.GetFrameArena();
+    auto contents = arena.MakeShared<SolidColorContents>();
+    contents->SetColor(color_);
+    contents->SetGeometry(arena.MakeShared<TriangleBatchGeometry>(
+        triangles_, bounds.value_or(Rect())));
+
+    Entity entity;
+    entity.SetBlendMode(blend_mode_);
+    entity.SetClipDepth(clip_depth_);
+    entity.SetContents(std::move(contents));
+    result = entity.Render(renderer, *pass_);
+    saved_draw_count_ += entity_count_ - 1u;
+  }
+
+  pass_ = nullptr;
+  first_entity_ = Entity();
+  entity_count_ = 0u;
+  triangles_.Clear();
+  return result;
+}
+
+bool DrawBatcher::HasPendingDraws() const {
+  return entity_count_ > 0u;
+}
+
+size_t DrawBatcher::GetSavedDrawCount() const {
+  return saved_draw_count_;
+}
+
+}  // namespace impeller
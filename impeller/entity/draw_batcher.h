@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_DRAW_BATCHER_H_
+#define FLUTTER_IMPELLER_ENTITY_DRAW_BATCHER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/geometry/color.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Merges runs of consecutive solid color fills into a single draw.
+///
+///             Entities that fill a geometry with the same solid color and
+///             blend mode use the same pipeline variant and uniforms, and so
+///             can be drawn together once their triangles have been
+///             transformed into a common coordinate space. The merged draw
+///             uses the clip depth of the last entity in the batch, which is
+///             only correct as long as the clip state does not change while
+///             the batch is pending.
+///
+///             The owner must |Flush| before anything else is encoded into
+///             the render pass of the pending batch, before the clip state or
+///             the scissor changes, and before the pass ends.
+///
+class DrawBatcher {
+ public:
+  DrawBatcher();
+
+  ~DrawBatcher();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the entity to the pending batch, first flushing the
+  ///             pending batch if the entity cannot be merged with it. The
+  ///             first entity of a batch is held as is, and its triangles are
+  ///             only generated once a second entity joins the batch.
+  ///
+  /// @return     `false` if the entity cannot be batched, in which case the
+  ///             caller must flush and then render the entity itself.
+  ///
+  bool Add(const ContentContext& renderer,
+           const Entity& entity,
+           RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the pending batch, if any, into its render pass.
+  ///             A batch of a single entity renders the entity unchanged.
+  ///
+  bool Flush(const ContentContext& renderer);
+
+  bool HasPendingDraws() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of draws that flushing has saved by merging
+  ///             entities.
+  ///
+  size_t GetSavedDrawCount() const;
+
+ private:
+  RenderPass* pass_ = nullptr;
+  Entity first_entity_;
+  size_t entity_count_ = 0u;
+  Color color_;
+  BlendMode blend_mode_ = BlendMode::kSourceOver;
+  uint32_t clip_depth_ = 0u;
+  TriangleBatch triangles_;
+  size_t saved_draw_count_ = 0u;
+
+  DrawBatcher(const DrawBatcher&) = delete;
+
+  DrawBatcher& operator=(const DrawBatcher&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_DRAW_BATCHER_H_
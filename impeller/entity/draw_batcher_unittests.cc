@@ -0,0 +1,185 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/test/recording_render_pass.h"
+#include "impeller/entity/draw_batcher.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+using EntityTest = EntityPlayground;
+
+namespace {
+
+Entity MakeSolidEntity(std::shared_ptr<Geometry> geometry,
+                       Color color,
+                       BlendMode blend_mode = BlendMode::kSourceOver) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(std::move(geometry));
+  contents->SetColor(color);
+
+  Entity entity;
+  entity.SetBlendMode(blend_mode);
+  entity.SetContents(std::move(contents));
+  return entity;
+}
+
+std::shared_ptr<RecordingRenderPass> MakeRecordingPass(
+    const ContentContext& content_context) {
+  auto context = content_context.GetContext();
+  auto buffer = context->CreateCommandBuffer();
+  auto render_target =
+      content_context.GetRenderTargetCache()->CreateOffscreenMSAA(
+          *context, {100, 100},
+          /*mip_count=*/1);
+  auto render_pass = buffer->CreateRenderPass(render_target);
+  return std::make_shared<RecordingRenderPass>(render_pass, context,
+                                               render_target);
+}
+
+}  // namespace
+
+TEST_P(EntityTest, DrawBatcherMergesSolidColorFills) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  DrawBatcher batcher;
+  for (int i = 0; i < 10; i++) {
+    Entity entity = MakeSolidEntity(
+        Geometry::MakeRect(Rect::MakeXYWH(i * 10, 0, 5, 5)), Color::Red());
+    ASSERT_TRUE(batcher.Add(*content_context, entity, *recording_pass));
+  }
+  EXPECT_TRUE(recording_pass->GetCommands().empty());
+  EXPECT_TRUE(batcher.HasPendingDraws());
+
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_FALSE(batcher.HasPendingDraws());
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+  EXPECT_EQ(batcher.GetSavedDrawCount(), 9u);
+}
+
+TEST_P(EntityTest, DrawBatcherMergesDifferentShapes) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  DrawBatcher batcher;
+  Entity rect = MakeSolidEntity(
+      Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)), Color::Blue());
+  Entity circle =
+      MakeSolidEntity(Geometry::MakeCircle({50, 50}, 10), Color::Blue());
+  Entity oval = MakeSolidEntity(
+      Geometry::MakeOval(Rect::MakeXYWH(20, 0, 30, 10)), Color::Blue());
+  Entity round_rect = MakeSolidEntity(
+      Geometry::MakeRoundRect(Rect::MakeXYWH(0, 60, 30, 30), {5, 5}),
+      Color::Blue());
+  ASSERT_TRUE(batcher.Add(*content_context, rect, *recording_pass));
+  ASSERT_TRUE(batcher.Add(*content_context, circle, *recording_pass));
+  ASSERT_TRUE(batcher.Add(*content_context, oval, *recording_pass));
+  ASSERT_TRUE(batcher.Add(*content_context, round_rect, *recording_pass));
+
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+  EXPECT_EQ(batcher.GetSavedDrawCount(), 3u);
+}
+
+TEST_P(EntityTest, DrawBatcherSplitsBatchesOnColorAndBlendChanges) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  DrawBatcher batcher;
+  auto rect = Rect::MakeXYWH(0, 0, 10, 10);
+  Entity red_1 = MakeSolidEntity(Geometry::MakeRect(rect), Color::Red());
+  Entity red_2 = MakeSolidEntity(Geometry::MakeRect(rect), Color::Red());
+  Entity green = MakeSolidEntity(Geometry::MakeRect(rect), Color::Green());
+  Entity green_source = MakeSolidEntity(Geometry::MakeRect(rect),
+                                        Color::Green(), BlendMode::kSource);
+  ASSERT_TRUE(batcher.Add(*content_context, red_1, *recording_pass));
+  ASSERT_TRUE(batcher.Add(*content_context, red_2, *recording_pass));
+  ASSERT_TRUE(batcher.Add(*content_context, green, *recording_pass));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+
+  ASSERT_TRUE(batcher.Add(*content_context, green_source, *recording_pass));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 2u);
+
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 3u);
+  EXPECT_EQ(batcher.GetSavedDrawCount(), 1u);
+}
+
+TEST_P(EntityTest, DrawBatcherRendersSingleEntitiesUnchanged) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  DrawBatcher batcher;
+  Entity entity = MakeSolidEntity(
+      Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)), Color::Red());
+  ASSERT_TRUE(batcher.Add(*content_context, entity, *recording_pass));
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+  EXPECT_EQ(batcher.GetSavedDrawCount(), 0u);
+
+  // Flushing with nothing pending is a no-op.
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+}
+
+TEST_P(EntityTest, DrawBatcherRejectsUnbatchableEntities) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  DrawBatcher batcher;
+  Entity advanced_blend =
+      MakeSolidEntity(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)),
+                      Color::Red(), BlendMode::kMultiply);
+  EXPECT_FALSE(batcher.Add(*content_context, advanced_blend, *recording_pass));
+
+  Entity perspective = MakeSolidEntity(
+      Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)), Color::Red());
+  Matrix transform;
+  transform.m[3] = 0.001;
+  perspective.SetTransform(transform);
+  EXPECT_FALSE(batcher.Add(*content_context, perspective, *recording_pass));
+
+  EXPECT_FALSE(batcher.HasPendingDraws());
+  EXPECT_TRUE(recording_pass->GetCommands().empty());
+}
+
+TEST_P(EntityTest, DrawBatcherRendersEntitiesThatCannotBeMergedAlone) {
+  auto content_context = GetContentContext();
+  auto recording_pass = MakeRecordingPass(*content_context);
+
+  // Whether the triangles of an entity can be merged is only known once a
+  // second entity joins the batch.
+  DrawBatcher batcher;
+  Entity stroked_circle = MakeSolidEntity(
+      Geometry::MakeStrokedCircle({50, 50}, 10, 2), Color::Red());
+  Entity rect_1 = MakeSolidEntity(
+      Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)), Color::Red());
+  Entity rect_2 = MakeSolidEntity(
+      Geometry::MakeRect(Rect::MakeXYWH(20, 0, 10, 10)), Color::Red());
+  ASSERT_TRUE(batcher.Add(*content_context, stroked_circle, *recording_pass));
+  EXPECT_TRUE(recording_pass->GetCommands().empty());
+
+  ASSERT_TRUE(batcher.Add(*content_context, rect_1, *recording_pass));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+  ASSERT_TRUE(batcher.Add(*content_context, rect_2, *recording_pass));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 1u);
+
+  ASSERT_TRUE(batcher.Flush(*content_context));
+  EXPECT_EQ(recording_pass->GetCommands().size(), 2u);
+  EXPECT_EQ(batcher.GetSavedDrawCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/point_packer.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
@@ -38,6 +39,7 @@
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/entity/geometry/superellipse_geometry.h"
 #include "impeller/geometry/color.h"
+#include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/point.h"
@@ -51,6 +53,7 @@
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/testing/mocks.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/tessellator/tessellation_cache.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "third_party/imgui/imgui.h"
@@ -2255,6 +2258,38 @@ TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
 }
 #endif
 
+TEST_P(EntityTest, ContentContextPrefetchesOnContextWorkers) {
+  auto content_context = GetContentContext();
+  TessellationCache& cache = content_context->GetTessellationCache();
+  if (!GetContext()->GetConcurrentWorkerTaskRunner()) {
+    EXPECT_FALSE(cache.IsPrefetching());
+    GTEST_SKIP() << "The context does not own worker threads.";
+  }
+  ASSERT_TRUE(cache.IsPrefetching());
+  cache.Clear();
+  cache.ResetStats();
+
+  RenderTarget target;
+  testing::MockRenderPass mock_pass(GetContext(), target);
+  Path path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+
+  auto stroke = Geometry::MakeStrokePath(path, /*stroke_width=*/4.0f);
+  stroke->PrefetchPositionBuffer(*content_context, Matrix());
+  EXPECT_EQ(cache.GetStats().prefetch_count, 1u);
+  GeometryResult result =
+      stroke->GetPositionBuffer(*content_context, {}, mock_pass);
+  EXPECT_GT(result.vertex_buffer.vertex_count, 0u);
+  EXPECT_EQ(cache.GetStats().prefetch_use_count, 1u);
+
+  // The width of hairlines depends on the sample count of the pass, which is
+  // not known when prefetching.
+  auto hairline = Geometry::MakeStrokePath(path, /*stroke_width=*/0.0f);
+  hairline->PrefetchPositionBuffer(*content_context, Matrix());
+  EXPECT_EQ(cache.GetStats().prefetch_count, 1u);
+
+  cache.DiscardPrefetches();
+}
+
 TEST_P(EntityTest, FillPathGeometryGetPositionBufferReturnsExpectedMode) {
   RenderTarget target;
   testing::MockRenderPass mock_pass(GetContext(), target);
@@ -2289,6 +2324,60 @@ TEST_P(EntityTest, FillPathGeometryGetPositionBufferReturnsExpectedMode) {
   }
 }
 
+TEST_P(EntityTest, PackedPositionBuffersUnpackToTheUnpackedPositions) {
+  auto content_context = GetContentContext();
+  RenderTarget target =
+      content_context->GetRenderTargetCache()->CreateOffscreen(
+          *GetContext(), {1000, 1000}, 1u);
+  testing::MockRenderPass mock_pass(GetContext(), target);
+
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({20, 40, 0}) *
+                      Matrix::MakeScale({2.625, 2.625, 1}));
+
+  std::vector<std::shared_ptr<Geometry>> geometries = {
+      Geometry::MakeRect(Rect::MakeXYWH(16, 20, 300, 100)),
+      Geometry::MakeFillPath(
+          PathBuilder{}
+              .AddRoundedRect(Rect::MakeXYWH(16, 140, 300, 100), 12)
+              .TakePath()),
+      Geometry::MakeFillPath(
+          PathBuilder{}.AddCircle(Point(60, 300), 24).TakePath()),
+  };
+  // Clip space spans two units across the render target.
+  Size device_scale = Size(target.GetRenderTargetSize()) / 2.0f;
+  for (const auto& geometry : geometries) {
+    GeometryResult unpacked =
+        geometry->GetPositionBuffer(*content_context, entity, mock_pass);
+    GeometryResult packed =
+        geometry->GetPackedPositionBuffer(*content_context, entity, mock_pass);
+    EXPECT_FALSE(unpacked.packed_vertices);
+    ASSERT_TRUE(packed.packed_vertices);
+    EXPECT_EQ(packed.type, unpacked.type);
+    EXPECT_EQ(packed.vertex_buffer.vertex_count,
+              unpacked.vertex_buffer.vertex_count);
+
+    const BufferView& unpacked_view = unpacked.vertex_buffer.vertex_buffer;
+    const BufferView& packed_view = packed.vertex_buffer.vertex_buffer;
+    ASSERT_GT(unpacked_view.range.length, 0u);
+    ASSERT_EQ(packed_view.range.length * 2u, unpacked_view.range.length);
+    const Point* points = reinterpret_cast<const Point*>(
+        unpacked_view.buffer->OnGetContents() + unpacked_view.range.offset);
+    const PackedPoint* packed_points = reinterpret_cast<const PackedPoint*>(
+        packed_view.buffer->OnGetContents() + packed_view.range.offset);
+
+    // The packed pipelines read each component as a normalized unsigned
+    // short, which the result transform maps back from the unit square.
+    for (size_t i = 0; i < unpacked_view.range.length / sizeof(Point); i++) {
+      Point unit(packed_points[i].x / 65535.0f, packed_points[i].y / 65535.0f);
+      Point error = (packed.transform * unit - unpacked.transform * points[i]) *
+                    device_scale;
+      EXPECT_LE(error.GetLength(),
+                PointPacker::kMaxDeviceError * kSqrt2 + kEhCloseEnough);
+    }
+  }
+}
+
 TEST_P(EntityTest, FailOnValidationError) {
   if (GetParam() != PlaygroundBackend::kVulkan) {
     GTEST_SKIP() << "Validation is only fatal on Vulkan backend.";
@@ -56,6 +56,19 @@ GeometryResult CircleGeometry::GetPositionBuffer(const ContentContext& renderer,
   return ComputePositionGeometry(renderer, generator, entity, pass);
 }
 
+bool CircleGeometry::AppendTriangles(const ContentContext& renderer,
+                                     const Matrix& transform,
+                                     TriangleBatch& batch) const {
+  // The outlines of strokes depend on the sample count of the render pass.
+  if (stroke_width_ >= 0) {
+    return false;
+  }
+  return AppendTriangleStrip(
+      transform, renderer.GetTessellator()->FilledCircle(transform, center_,
+                                                         radius_),
+      batch);
+}
+
 std::optional<Rect> CircleGeometry::GetCoverage(const Matrix& transform) const {
   Point corners[4]{
       {center_.x, center_.y - radius_},
@@ -39,6 +39,11 @@ class CircleGeometry final : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const ContentContext& renderer,
+                       const Matrix& transform,
+                       TriangleBatch& batch) const override;
+
   Point center_;
   Scalar radius_;
   Scalar stroke_width_;
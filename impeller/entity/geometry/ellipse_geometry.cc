@@ -22,6 +22,14 @@ GeometryResult EllipseGeometry::GetPositionBuffer(
       entity, pass);
 }
 
+bool EllipseGeometry::AppendTriangles(const ContentContext& renderer,
+                                      const Matrix& transform,
+                                      TriangleBatch& batch) const {
+  return AppendTriangleStrip(
+      transform, renderer.GetTessellator()->FilledEllipse(transform, bounds_),
+      batch);
+}
+
 std::optional<Rect> EllipseGeometry::GetCoverage(
     const Matrix& transform) const {
   return bounds_.TransformBounds(transform);
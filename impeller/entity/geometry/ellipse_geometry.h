@@ -34,6 +34,11 @@ class EllipseGeometry final : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const ContentContext& renderer,
+                       const Matrix& transform,
+                       TriangleBatch& batch) const override;
+
   Rect bounds_;
 
   EllipseGeometry(const EllipseGeometry&) = delete;
@@ -6,9 +6,12 @@
 
 #include "fml/logging.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/point_packer.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/tessellator/tessellation_cache.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -36,8 +39,14 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
-  VertexBuffer vertex_buffer = renderer.GetTessellator()->TessellateConvex(
-      path_, host_buffer, entity.GetTransform().GetMaxBasisLength());
+  VertexBuffer vertex_buffer = renderer.GetTessellationCache().GetOrTessellate(
+      path_,
+      TessellationCache::Key::Fill(entity.GetTransform().GetMaxBasisLength()),
+      host_buffer,
+      [this](Scalar scale, TessellationCache::Tessellation& tessellation) {
+        Tessellator::TessellateConvexInternal(path_, tessellation.vertices,
+                                              tessellation.indices, scale);
+      });
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -47,6 +56,82 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   };
 }
 
+GeometryResult FillPathGeometry::GetPackedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  // Stenciled paths are drawn into the stencil buffer unpacked, and the cover
+  // draw must match that exactly.
+  const auto& bounding_box = path_.GetBoundingBox();
+  if (GetResultMode() != GeometryResult::Mode::kNormal ||
+      !bounding_box.has_value() || bounding_box->IsEmpty() ||
+      !PointPacker::CanPackPositions(bounding_box.value(),
+                                     entity.GetTransform())) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+
+  const TessellationCache::Tessellation& tessellated =
+      renderer.GetTessellationCache().GetOrTessellate(
+          path_,
+          TessellationCache::Key::Fill(
+              entity.GetTransform().GetMaxBasisLength()),
+          [this](Scalar scale, TessellationCache::Tessellation& tessellation) {
+            Tessellator::TessellateConvexInternal(path_, tessellation.vertices,
+                                                  tessellation.indices, scale);
+          });
+  // Curves are flattened to points on them, which are within the bounding
+  // box of the path, but pack relative to the vertices to use the full range.
+  std::optional<Rect> vertex_bounds = Rect::MakePointBounds(
+      tessellated.vertices.begin(), tessellated.vertices.end());
+  if (!vertex_bounds.has_value() || tessellated.indices.empty()) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  PointPacker packer(vertex_bounds.value());
+  BufferView vertex_buffer =
+      packer.Emplace(host_buffer, tessellated.vertices.data(),
+                     tessellated.vertices.size());
+  BufferView index_buffer =
+      host_buffer.Emplace(tessellated.indices.data(),
+                          sizeof(uint16_t) * tessellated.indices.size(),
+                          alignof(uint16_t));
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = std::move(vertex_buffer),
+              .index_buffer = std::move(index_buffer),
+              .vertex_count = tessellated.indices.size(),
+              .index_type = IndexType::k16bit,
+          },
+      .transform =
+          entity.GetShaderTransform(pass) * packer.GetUnpackTransform(),
+      .mode = GetResultMode(),
+      .packed_vertices = true,
+  };
+}
+
+void FillPathGeometry::PrefetchPositionBuffer(const ContentContext& renderer,
+                                              const Matrix& transform) const {
+  TessellationCache& cache = renderer.GetTessellationCache();
+  if (!cache.IsPrefetching()) {
+    return;
+  }
+  const auto& bounding_box = path_.GetBoundingBox();
+  if (bounding_box.has_value() && bounding_box->IsEmpty()) {
+    return;
+  }
+
+  cache.Prefetch(
+      path_, TessellationCache::Key::Fill(transform.GetMaxBasisLength()),
+      [path = path_](Scalar scale,
+                     TessellationCache::Tessellation& tessellation) {
+        Tessellator::TessellateConvexInternal(path, tessellation.vertices,
+                                              tessellation.indices, scale);
+      });
+}
+
 GeometryResult::Mode FillPathGeometry::GetResultMode() const {
   const auto& bounding_box = path_.GetBoundingBox();
   if (path_.IsConvex() ||
@@ -64,6 +149,32 @@ GeometryResult::Mode FillPathGeometry::GetResultMode() const {
   FML_UNREACHABLE();
 }
 
+bool FillPathGeometry::AppendTriangles(const ContentContext& renderer,
+                                       const Matrix& transform,
+                                       TriangleBatch& batch) const {
+  // Paths that are not convex are stenciled and cannot share a draw.
+  const auto& bounding_box = path_.GetBoundingBox();
+  if (GetResultMode() != GeometryResult::Mode::kNormal ||
+      !bounding_box.has_value() || bounding_box->IsEmpty()) {
+    return false;
+  }
+
+  const TessellationCache::Tessellation& tessellated =
+      renderer.GetTessellationCache().GetOrTessellate(
+          path_, TessellationCache::Key::Fill(transform.GetMaxBasisLength()),
+          [this](Scalar scale, TessellationCache::Tessellation& tessellation) {
+            Tessellator::TessellateConvexInternal(path_, tessellation.vertices,
+                                                  tessellation.indices, scale);
+          });
+  if (tessellated.indices.empty()) {
+    return false;
+  }
+  return AppendTriangleStrip(transform, tessellated.vertices.data(),
+                             tessellated.vertices.size(),
+                             tessellated.indices.data(),
+                             tessellated.indices.size(), batch);
+}
+
 std::optional<Rect> FillPathGeometry::GetCoverage(
     const Matrix& transform) const {
   return path_.GetTransformedBoundingBox(transform);
@@ -23,15 +23,29 @@ class FillPathGeometry final : public Geometry {
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
+  // |Geometry|
+  void PrefetchPositionBuffer(const ContentContext& renderer,
+                              const Matrix& transform) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const override;
 
+  // |Geometry|
+  GeometryResult GetPackedPositionBuffer(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) const override;
+
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const ContentContext& renderer,
+                       const Matrix& transform,
+                       TriangleBatch& batch) const override;
+
   // |Geometry|
   GeometryResult::Mode GetResultMode() const override;
 
@@ -4,9 +4,11 @@
 
 #include "impeller/entity/geometry/geometry.h"
 
+#include <limits>
 #include <memory>
 #include <optional>
 
+#include "impeller/base/frame_arena.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/circle_geometry.h"
 #include "impeller/entity/geometry/cover_geometry.h"
@@ -23,98 +25,165 @@ namespace impeller {
 
 GeometryResult Geometry::ComputePositionGeometry(
     const ContentContext& renderer,
-    const Tessellator::VertexGenerator& generator,
+    const Tessellator::EllipticalVertexGenerator& generator,
     const Entity& entity,
     RenderPass& pass) {
   using VT = SolidFillVertexShader::PerVertexData;
 
-  size_t count = generator.GetVertexCount();
-
   return GeometryResult{
       .type = generator.GetTriangleType(),
       .vertex_buffer =
           {
-              .vertex_buffer = renderer.GetTransientsBuffer().Emplace(
-                  count * sizeof(VT), alignof(VT),
-                  [&generator](uint8_t* buffer) {
-                    auto vertices = reinterpret_cast<VT*>(buffer);
-                    generator.GenerateVertices([&vertices](const Point& p) {
-                      *vertices++ = {
-                          .position = p,
-                      };
-                    });
-                    FML_DCHECK(vertices == reinterpret_cast<VT*>(buffer) +
-                                               generator.GetVertexCount());
-                  }),
-              .vertex_count = count,
+              .vertex_buffer = generator.EmplaceVertices<VT>(
+                  renderer.GetTransientsBuffer()),
+              .vertex_count = generator.GetVertexCount(),
               .index_type = IndexType::kNone,
           },
       .transform = entity.GetShaderTransform(pass),
   };
 }
 
+GeometryResult Geometry::GetPackedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return GetPositionBuffer(renderer, entity, pass);
+}
+
 GeometryResult::Mode Geometry::GetResultMode() const {
   return GeometryResult::Mode::kNormal;
 }
 
 std::shared_ptr<Geometry> Geometry::MakeFillPath(
     const Path& path,
-    std::optional<Rect> inner_rect) {
-  return std::make_shared<FillPathGeometry>(path, inner_rect);
+    std::optional<Rect> inner_rect,
+    FrameArena* arena) {
+  return MakeSharedInArena<FillPathGeometry>(arena, path, inner_rect);
 }
 
 std::shared_ptr<Geometry> Geometry::MakePointField(std::vector<Point> points,
                                                    Scalar radius,
-                                                   bool round) {
-  return std::make_shared<PointFieldGeometry>(std::move(points), radius, round);
+                                                   bool round,
+                                                   FrameArena* arena) {
+  return MakeSharedInArena<PointFieldGeometry>(arena, std::move(points),
+                                               radius, round);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeStrokePath(const Path& path,
                                                    Scalar stroke_width,
                                                    Scalar miter_limit,
                                                    Cap stroke_cap,
-                                                   Join stroke_join) {
+                                                   Join stroke_join,
+                                                   FrameArena* arena) {
   // Skia behaves like this.
   if (miter_limit < 0) {
     miter_limit = 4.0;
   }
-  return std::make_shared<StrokePathGeometry>(path, stroke_width, miter_limit,
-                                              stroke_cap, stroke_join);
+  return MakeSharedInArena<StrokePathGeometry>(
+      arena, path, stroke_width, miter_limit, stroke_cap, stroke_join);
 }
 
-std::shared_ptr<Geometry> Geometry::MakeCover() {
-  return std::make_shared<CoverGeometry>();
+std::shared_ptr<Geometry> Geometry::MakeCover(FrameArena* arena) {
+  return MakeSharedInArena<CoverGeometry>(arena);
 }
 
-std::shared_ptr<Geometry> Geometry::MakeRect(const Rect& rect) {
-  return std::make_shared<RectGeometry>(rect);
+std::shared_ptr<Geometry> Geometry::MakeRect(const Rect& rect,
+                                             FrameArena* arena) {
+  return MakeSharedInArena<RectGeometry>(arena, rect);
 }
 
-std::shared_ptr<Geometry> Geometry::MakeOval(const Rect& rect) {
-  return std::make_shared<EllipseGeometry>(rect);
+std::shared_ptr<Geometry> Geometry::MakeOval(const Rect& rect,
+                                             FrameArena* arena) {
+  return MakeSharedInArena<EllipseGeometry>(arena, rect);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeLine(const Point& p0,
                                              const Point& p1,
                                              Scalar width,
-                                             Cap cap) {
-  return std::make_shared<LineGeometry>(p0, p1, width, cap);
+                                             Cap cap,
+                                             FrameArena* arena) {
+  return MakeSharedInArena<LineGeometry>(arena, p0, p1, width, cap);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeCircle(const Point& center,
-                                               Scalar radius) {
-  return std::make_shared<CircleGeometry>(center, radius);
+                                               Scalar radius,
+                                               FrameArena* arena) {
+  return MakeSharedInArena<CircleGeometry>(arena, center, radius);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeStrokedCircle(const Point& center,
                                                       Scalar radius,
-                                                      Scalar stroke_width) {
-  return std::make_shared<CircleGeometry>(center, radius, stroke_width);
+                                                      Scalar stroke_width,
+                                                      FrameArena* arena) {
+  return MakeSharedInArena<CircleGeometry>(arena, center, radius,
+                                           stroke_width);
 }
 
 std::shared_ptr<Geometry> Geometry::MakeRoundRect(const Rect& rect,
-                                                  const Size& radii) {
-  return std::make_shared<RoundRectGeometry>(rect, radii);
+                                                  const Size& radii,
+                                                  FrameArena* arena) {
+  return MakeSharedInArena<RoundRectGeometry>(arena, rect, radii);
+}
+
+bool Geometry::AppendTriangles(const ContentContext& renderer,
+                               const Matrix& transform,
+                               TriangleBatch& batch) const {
+  return false;
+}
+
+bool Geometry::AppendTriangleStrip(const Matrix& transform,
+                                   const Point* points,
+                                   size_t point_count,
+                                   const uint16_t* indices,
+                                   size_t index_count,
+                                   TriangleBatch& batch) {
+  const size_t base = batch.points.size();
+  if (base + point_count > std::numeric_limits<uint16_t>::max()) {
+    return false;
+  }
+  if (indices == nullptr) {
+    index_count = point_count;
+  }
+
+  batch.points.resize(base + point_count);
+  transform.TransformPoints(points, batch.points.data() + base, point_count);
+
+  auto index_at = [indices, base](size_t i) {
+    return static_cast<uint16_t>(base + (indices ? indices[i] : i));
+  };
+  for (size_t i = 2; i < index_count; i++) {
+    uint16_t a = index_at(i - 2);
+    uint16_t b = index_at(i - 1);
+    uint16_t c = index_at(i);
+    if (a == b || b == c || a == c) {
+      continue;
+    }
+    batch.indices.insert(batch.indices.end(), {a, b, c});
+  }
+  return true;
+}
+
+bool Geometry::AppendTriangleStrip(
+    const Matrix& transform,
+    const Tessellator::EllipticalVertexGenerator& generator,
+    TriangleBatch& batch) {
+  const size_t base = batch.points.size();
+  const size_t count = generator.GetVertexCount();
+  if (base + count > std::numeric_limits<uint16_t>::max()) {
+    return false;
+  }
+  batch.points.resize(base + count);
+  Point* vertices = batch.points.data() + base;
+  generator.WriteVertices(vertices);
+  // Transformed in place, as the generator writes untransformed vertices.
+  transform.TransformPoints(vertices, vertices, count);
+  for (size_t i = 2; i < count; i++) {
+    batch.indices.insert(batch.indices.end(),
+                         {static_cast<uint16_t>(base + i - 2),
+                          static_cast<uint16_t>(base + i - 1),
+                          static_cast<uint16_t>(base + i)});
+  }
+  return true;
 }
 
 bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
@@ -14,6 +14,7 @@
 
 namespace impeller {
 
+class FrameArena;
 class Tessellator;
 
 /// @brief The minimum stroke size can be less than one physical pixel because
@@ -43,6 +44,27 @@ struct GeometryResult {
   VertexBuffer vertex_buffer;
   Matrix transform;
   Mode mode = Mode::kNormal;
+  /// Whether the vertices are |PackedPoint|s, in which case the transform
+  /// also maps them back from the unit square to the local coordinates of the
+  /// geometry. Draws of packed vertices must use pipelines created with
+  /// |ContentContextOptions::packed_vertices|.
+  bool packed_vertices = false;
+};
+
+/// @brief Triangles of several geometries, already transformed into a common
+///        coordinate space, that are drawn together with a single draw call.
+///
+/// The indices form a list of independent triangles.
+struct TriangleBatch {
+  std::vector<Point> points;
+  std::vector<uint16_t> indices;
+
+  bool IsEmpty() const { return indices.empty(); }
+
+  void Clear() {
+    points.clear();
+    indices.clear();
+  }
 };
 
 static const GeometryResult kEmptyResult = {
@@ -54,48 +76,83 @@ static const GeometryResult kEmptyResult = {
 
 class Geometry {
  public:
+  // The factories below allocate the geometry from the given frame arena, or
+  // from the heap if there is none. See |ContentContext::GetFrameArena|.
+
   static std::shared_ptr<Geometry> MakeFillPath(
       const Path& path,
-      std::optional<Rect> inner_rect = std::nullopt);
+      std::optional<Rect> inner_rect = std::nullopt,
+      FrameArena* arena = nullptr);
 
   static std::shared_ptr<Geometry> MakeStrokePath(
       const Path& path,
       Scalar stroke_width = 0.0,
       Scalar miter_limit = 4.0,
       Cap stroke_cap = Cap::kButt,
-      Join stroke_join = Join::kMiter);
+      Join stroke_join = Join::kMiter,
+      FrameArena* arena = nullptr);
 
-  static std::shared_ptr<Geometry> MakeCover();
+  static std::shared_ptr<Geometry> MakeCover(FrameArena* arena = nullptr);
 
-  static std::shared_ptr<Geometry> MakeRect(const Rect& rect);
+  static std::shared_ptr<Geometry> MakeRect(const Rect& rect,
+                                            FrameArena* arena = nullptr);
 
-  static std::shared_ptr<Geometry> MakeOval(const Rect& rect);
+  static std::shared_ptr<Geometry> MakeOval(const Rect& rect,
+                                            FrameArena* arena = nullptr);
 
   static std::shared_ptr<Geometry> MakeLine(const Point& p0,
                                             const Point& p1,
                                             Scalar width,
-                                            Cap cap);
+                                            Cap cap,
+                                            FrameArena* arena = nullptr);
 
   static std::shared_ptr<Geometry> MakeCircle(const Point& center,
-                                              Scalar radius);
+                                              Scalar radius,
+                                              FrameArena* arena = nullptr);
 
-  static std::shared_ptr<Geometry> MakeStrokedCircle(const Point& center,
-                                                     Scalar radius,
-                                                     Scalar stroke_width);
+  static std::shared_ptr<Geometry> MakeStrokedCircle(
+      const Point& center,
+      Scalar radius,
+      Scalar stroke_width,
+      FrameArena* arena = nullptr);
 
   static std::shared_ptr<Geometry> MakeRoundRect(const Rect& rect,
-                                                 const Size& radii);
+                                                 const Size& radii,
+                                                 FrameArena* arena = nullptr);
 
   static std::shared_ptr<Geometry> MakePointField(std::vector<Point> points,
                                                   Scalar radius,
-                                                  bool round);
+                                                  bool round,
+                                                  FrameArena* arena = nullptr);
 
   virtual GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                            const Entity& entity,
                                            RenderPass& pass) const = 0;
 
+  /// @brief    Like `GetPositionBuffer`, but geometries that can do so
+  ///           without visibly moving their vertices return them as
+  ///           |PackedPoint|s, which take half the space in the transients
+  ///           buffer.
+  ///
+  ///           Only use this for draws whose vertex shader does nothing with
+  ///           the positions but transform them by the result's transform.
+  ///           Returns the unpacked positions by default.
+  virtual GeometryResult GetPackedPositionBuffer(const ContentContext& renderer,
+                                                 const Entity& entity,
+                                                 RenderPass& pass) const;
+
   virtual GeometryResult::Mode GetResultMode() const;
 
+  /// @brief    Starts generating the vertices of this geometry for a draw with
+  ///           the given `transform` on the workers of the renderer's
+  ///           tessellation cache, so that a later `GetPositionBuffer` can use
+  ///           them instead of generating them on the raster thread.
+  ///
+  ///           Does nothing for geometries that are cheap to generate or when
+  ///           the tessellation cache has no workers.
+  virtual void PrefetchPositionBuffer(const ContentContext& renderer,
+                                      const Matrix& transform) const {}
+
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
 
   /// @brief Compute an alpha value to simulate lower coverage of fractional
@@ -123,12 +180,40 @@ class Geometry {
     return 1.0;
   }
 
+  /// @brief    Appends the triangles of this geometry, transformed by the
+  ///           given `transform`, to a batch of triangles that is drawn with
+  ///           a single draw call.
+  ///
+  ///           Only geometries whose triangles do not overlap and whose
+  ///           vertices do not depend on the render pass can be batched.
+  ///
+  /// @returns  `false`, leaving the batch untouched, if the geometry cannot be
+  ///           batched or does not fit into the 16-bit indices of the batch.
+  virtual bool AppendTriangles(const ContentContext& renderer,
+                               const Matrix& transform,
+                               TriangleBatch& batch) const;
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const ContentContext& renderer,
-      const Tessellator::VertexGenerator& generator,
+      const Tessellator::EllipticalVertexGenerator& generator,
       const Entity& entity,
       RenderPass& pass);
+
+  /// @brief    Appends a triangle strip to the batch as a list of triangles,
+  ///           dropping the degenerate triangles that join separate strips.
+  ///           The strip is indexed if `indices` is not null.
+  static bool AppendTriangleStrip(const Matrix& transform,
+                                  const Point* points,
+                                  size_t point_count,
+                                  const uint16_t* indices,
+                                  size_t index_count,
+                                  TriangleBatch& batch);
+
+  static bool AppendTriangleStrip(
+      const Matrix& transform,
+      const Tessellator::EllipticalVertexGenerator& generator,
+      TriangleBatch& batch);
 };
 
 }  // namespace impeller
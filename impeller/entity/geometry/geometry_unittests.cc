@@ -53,6 +53,15 @@ namespace impeller {
 
 class ImpellerEntityUnitTestAccessor {
  public:
+  static size_t EstimateSolidStrokeVertexCount(const Path::Polyline& polyline,
+                                               Scalar stroke_width,
+                                               Join stroke_join,
+                                               Cap stroke_cap,
+                                               Scalar scale) {
+    return StrokePathGeometry::EstimateSolidStrokeVertexCount(
+        polyline, stroke_width, stroke_join, stroke_cap, scale);
+  }
+
   static std::vector<SolidFillVertexShader::PerVertexData>
   GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                               Scalar stroke_width,
@@ -134,6 +143,7 @@ TEST(EntityGeometryTest, GeometryResultHasReasonableDefaults) {
   EXPECT_EQ(result.type, PrimitiveType::kTriangleStrip);
   EXPECT_EQ(result.transform, Matrix());
   EXPECT_EQ(result.mode, GeometryResult::Mode::kNormal);
+  EXPECT_FALSE(result.packed_vertices);
 }
 
 TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
@@ -152,5 +162,37 @@ TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
   EXPECT_EQ(Geometry::MakeStrokePath({}, 40)->ComputeAlphaCoverage(matrix), 1);
 }
 
+TEST(EntityGeometryTest, StrokeVertexEstimateIsUpperBound) {
+  PathBuilder builder;
+  builder.MoveTo({10, 10})
+      .LineTo({100, 10})
+      .CubicCurveTo({120, 50}, {20, 80}, {50, 200})
+      .QuadraticCurveTo({0, 0}, {300, 40})
+      .Close();
+  builder.MoveTo({400, 400}).LineTo({500, 420});
+  builder.MoveTo({5, 5}).LineTo({5, 5});
+  builder.AddCircle({200, 200}, 4);
+  auto path = builder.TakePath();
+
+  for (auto scale : {0.1f, 1.0f, 8.0f}) {
+    auto polyline = path.CreatePolyline(scale);
+    for (auto join : {Join::kBevel, Join::kMiter, Join::kRound}) {
+      for (auto cap : {Cap::kButt, Cap::kRound, Cap::kSquare}) {
+        // Strokes are written directly into the transients buffer with room
+        // for the estimated number of vertices, and only rewritten when the
+        // estimate is too low.
+        auto vertices =
+            ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+                polyline, 20.0f, 4.0f, join, cap, scale);
+        auto estimate =
+            ImpellerEntityUnitTestAccessor::EstimateSolidStrokeVertexCount(
+                polyline, 20.0f, join, cap, scale);
+        EXPECT_FALSE(vertices.empty());
+        EXPECT_GE(estimate, vertices.size());
+      }
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -39,12 +39,8 @@ GeometryResult PointFieldGeometry::GetPositionBuffer(
     auto generator =
         renderer.GetTessellator()->FilledCircle(transform, {}, radius);
     FML_DCHECK(generator.GetTriangleType() == PrimitiveType::kTriangleStrip);
-    std::vector<Point> circle_vertices;
-    circle_vertices.reserve(generator.GetVertexCount());
-    generator.GenerateVertices([&circle_vertices](const Point& p) {  //
-      circle_vertices.push_back(p);
-    });
-    FML_DCHECK(circle_vertices.size() == generator.GetVertexCount());
+    std::vector<Point> circle_vertices(generator.GetVertexCount());
+    generator.WriteVertices(circle_vertices.data());
 
     vtx_builder.Reserve((circle_vertices.size() + 2) * points_.size() - 2);
     for (auto& center : points_) {
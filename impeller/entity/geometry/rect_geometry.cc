@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/rect_geometry.h"
 
+#include "impeller/core/point_packer.h"
+
 namespace impeller {
 
 RectGeometry::RectGeometry(Rect rect) : rect_(rect) {}
@@ -25,6 +27,40 @@ GeometryResult RectGeometry::GetPositionBuffer(const ContentContext& renderer,
   };
 }
 
+GeometryResult RectGeometry::GetPackedPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  if (!rect_.IsFinite()) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+  // The corners pack to the ends of the packed range exactly, so rects of any
+  // size can be packed.
+  PointPacker packer(rect_);
+  auto points = rect_.GetPoints();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = packer.Emplace(renderer.GetTransientsBuffer(),
+                                              points.data(), points.size()),
+              .vertex_count = points.size(),
+              .index_type = IndexType::kNone,
+          },
+      .transform =
+          entity.GetShaderTransform(pass) * packer.GetUnpackTransform(),
+      .packed_vertices = true,
+  };
+}
+
+bool RectGeometry::AppendTriangles(const ContentContext& renderer,
+                                   const Matrix& transform,
+                                   TriangleBatch& batch) const {
+  auto points = rect_.GetPoints();
+  return AppendTriangleStrip(transform, points.data(), points.size(), nullptr,
+                             0u, batch);
+}
+
 std::optional<Rect> RectGeometry::GetCoverage(const Matrix& transform) const {
   return rect_.TransformBounds(transform);
 }
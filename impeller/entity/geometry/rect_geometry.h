@@ -26,9 +26,19 @@ class RectGeometry final : public Geometry {
                                    const Entity& entity,
                                    RenderPass& pass) const override;
 
+  // |Geometry|
+  GeometryResult GetPackedPositionBuffer(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) const override;
+
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const ContentContext& renderer,
+                       const Matrix& transform,
+                       TriangleBatch& batch) const override;
+
  private:
   Rect rect_;
 
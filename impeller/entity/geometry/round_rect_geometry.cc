@@ -19,6 +19,15 @@ GeometryResult RoundRectGeometry::GetPositionBuffer(
                                  entity, pass);
 }
 
+bool RoundRectGeometry::AppendTriangles(const ContentContext& renderer,
+                                        const Matrix& transform,
+                                        TriangleBatch& batch) const {
+  return AppendTriangleStrip(
+      transform,
+      renderer.GetTessellator()->FilledRoundRect(transform, bounds_, radii_),
+      batch);
+}
+
 std::optional<Rect> RoundRectGeometry::GetCoverage(
     const Matrix& transform) const {
   return bounds_.TransformBounds(transform);
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
+#include <optional>
+
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -11,6 +13,8 @@
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/separated_vector.h"
+#include "impeller/geometry/wangs_formula.h"
+#include "impeller/tessellator/tessellation_cache.h"
 
 namespace impeller {
 using VS = SolidFillVertexShader;
@@ -32,18 +36,28 @@ using JoinProc = std::function<void(VertexWriter& vtx_builder,
                                     Scalar miter_limit,
                                     Scalar scale)>;
 
-class PositionWriter {
+// Writes the positions into storage sized by an estimate of the vertex count,
+// such as the transients buffer. Vertices past the end of the storage are only
+// counted so that the caller can retry with enough room.
+template <typename VertexType>
+class BoundedWriter {
  public:
+  BoundedWriter(VertexType* vertices, size_t max_count)
+      : vertices_(vertices), max_count_(max_count) {}
+
   void AppendVertex(const Point& point) {
-    data_.emplace_back(SolidFillVertexShader::PerVertexData{.position = point});
+    if (count_ < max_count_) {
+      vertices_[count_] = VertexType{point};
+    }
+    count_++;
   }
 
-  const std::vector<SolidFillVertexShader::PerVertexData>& GetData() const {
-    return data_;
-  }
+  size_t GetCount() const { return count_; }
 
  private:
-  std::vector<SolidFillVertexShader::PerVertexData> data_ = {};
+  VertexType* const vertices_;
+  const size_t max_count_;
+  size_t count_ = 0u;
 };
 
 template <typename VertexWriter>
@@ -510,8 +524,139 @@ CapProc<VertexWriter> GetCapProc(Cap stroke_cap) {
       return &CreateSquareCap<VertexWriter>;
   }
 }
+
+// The number of vertices generated for the arc of a round cap, which is also
+// the most generated for the arc of a round join.
+size_t CountRoundArcVertices(Scalar stroke_width, Scalar scale) {
+  const Point orientation(stroke_width * 0.5f, 0);
+  const Point forward(0, stroke_width * 0.5f);
+  const CubicPathComponent arc(
+      orientation, orientation + forward * PathBuilder::kArcApproximationMagic,
+      forward + orientation * PathBuilder::kArcApproximationMagic, forward);
+  // Every point of the flattened arc but the first generates two vertices.
+  const Scalar line_count = std::ceil(ComputeCubicSubdivisions(scale, arc));
+  return line_count > 1 ? 2u * static_cast<size_t>(line_count) : 2u;
+}
+
+// Writes up to |max_count| vertices of the stroke and returns the number of
+// vertices of the complete stroke.
+template <typename VertexType>
+size_t WriteStrokeVertices(VertexType* vertices,
+                           size_t max_count,
+                           const Path::Polyline& polyline,
+                           Scalar stroke_width,
+                           Scalar scaled_miter_limit,
+                           Join stroke_join,
+                           Cap stroke_cap,
+                           Scalar scale) {
+  using Writer = BoundedWriter<VertexType>;
+  Writer writer(vertices, max_count);
+  CreateSolidStrokeVertices(writer, polyline, stroke_width, scaled_miter_limit,
+                            GetJoinProc<Writer>(stroke_join),
+                            GetCapProc<Writer>(stroke_cap), scale);
+  return writer.GetCount();
+}
+
+// Replaces |vertices| with the complete stroke, starting with room for
+// |estimated_count| vertices.
+template <typename VertexType>
+void GenerateStrokeVertices(std::vector<VertexType>& vertices,
+                            size_t estimated_count,
+                            const Path::Polyline& polyline,
+                            Scalar stroke_width,
+                            Scalar scaled_miter_limit,
+                            Join stroke_join,
+                            Cap stroke_cap,
+                            Scalar scale) {
+  vertices.resize(estimated_count);
+  size_t count = WriteStrokeVertices(vertices.data(), vertices.size(),
+                                     polyline, stroke_width, scaled_miter_limit,
+                                     stroke_join, stroke_cap, scale);
+  if (count > vertices.size()) {
+    vertices.resize(count);
+    WriteStrokeVertices(vertices.data(), count, polyline, stroke_width,
+                        scaled_miter_limit, stroke_join, stroke_cap, scale);
+  }
+  vertices.resize(count);
+}
 }  // namespace
 
+size_t StrokePathGeometry::EstimateSolidStrokeVertexCount(
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    Join stroke_join,
+    Cap stroke_cap,
+    Scalar scale) {
+  // A flattened curve component turns by less than a full turn in all but
+  // degenerate cases, which the generator bridges with two vertices every 10
+  // degrees.
+  constexpr size_t kCurveTurnVertexCount = 2u * 36u;
+
+  const size_t arc_count =
+      (stroke_join == Join::kRound || stroke_cap == Cap::kRound)
+          ? CountRoundArcVertices(stroke_width, scale)
+          : 0u;
+  size_t cap_count = 0u;
+  switch (stroke_cap) {
+    case Cap::kButt:
+      cap_count = 2u;
+      break;
+    case Cap::kRound:
+      cap_count = 2u + arc_count;
+      break;
+    case Cap::kSquare:
+      cap_count = 4u;
+      break;
+  }
+  size_t join_count = 0u;
+  switch (stroke_join) {
+    case Join::kBevel:
+      join_count = 3u;
+      break;
+    case Join::kMiter:
+      join_count = 4u;
+      break;
+    case Join::kRound:
+      join_count = 3u + arc_count;
+      break;
+  }
+
+  size_t vertex_count = 0u;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    auto [start_point_i, end_point_i] =
+        polyline.GetContourPointBounds(contour_i);
+    const size_t point_count = end_point_i - start_point_i;
+    if (point_count <= 1u) {
+      vertex_count += point_count * 2u * cap_count;
+      continue;
+    }
+    // Picking up the pen, both caps or the closing join, and up to four
+    // vertices per point for the segments.
+    vertex_count += 4u + 2u * std::max(cap_count, join_count);
+    vertex_count += 4u * point_count;
+    for (const auto& component : polyline.contours[contour_i].components) {
+      vertex_count +=
+          join_count + (component.is_curve ? kCurveTurnVertexCount : 0u);
+    }
+  }
+  return vertex_count;
+}
+
+size_t StrokePathGeometry::WriteSolidStrokeVertices(
+    Point* vertices,
+    size_t max_count,
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    Scalar miter_limit,
+    Join stroke_join,
+    Cap stroke_cap,
+    Scalar scale) {
+  return WriteStrokeVertices(vertices, max_count, polyline, stroke_width,
+                             stroke_width * miter_limit * 0.5f, stroke_join,
+                             stroke_cap, scale);
+}
+
 std::vector<SolidFillVertexShader::PerVertexData>
 StrokePathGeometry::GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                                                 Scalar stroke_width,
@@ -519,14 +664,15 @@ StrokePathGeometry::GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                                                 Join stroke_join,
                                                 Cap stroke_cap,
                                                 Scalar scale) {
-  auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  auto join_proc = GetJoinProc<PositionWriter>(stroke_join);
-  auto cap_proc = GetCapProc<PositionWriter>(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  PositionWriter vtx_builder;
-  stroke_generator.Generate(vtx_builder);
-  return vtx_builder.GetData();
+  std::vector<SolidFillVertexShader::PerVertexData> vertices;
+  GenerateStrokeVertices(vertices,
+                         EstimateSolidStrokeVertexCount(
+                             polyline, stroke_width, stroke_join, stroke_cap,
+                             scale),
+                         polyline, stroke_width,
+                         stroke_width * miter_limit * 0.5f, stroke_join,
+                         stroke_cap, scale);
+  return vertices;
 }
 
 StrokePathGeometry::StrokePathGeometry(const Path& path,
@@ -562,6 +708,53 @@ Scalar StrokePathGeometry::ComputeAlphaCoverage(const Matrix& transform) const {
   return Geometry::ComputeStrokeAlphaCoverage(transform, stroke_width_);
 }
 
+Scalar StrokePathGeometry::ComputeStrokeWidth(Scalar max_basis,
+                                              SampleCount sample_count) const {
+  // Strokes that are thinner than a pixel are widened so that they remain
+  // visible.
+  Scalar min_size = (sample_count == SampleCount::kCount4 ? kMinStrokeSizeMSAA
+                                                          : kMinStrokeSize) /
+                    max_basis;
+  return std::max(stroke_width_, min_size);
+}
+
+void StrokePathGeometry::PrefetchPositionBuffer(const ContentContext& renderer,
+                                                const Matrix& transform) const {
+  TessellationCache& cache = renderer.GetTessellationCache();
+  if (!cache.IsPrefetching() || stroke_width_ < 0.0) {
+    return;
+  }
+  Scalar max_basis = transform.GetMaxBasisLengthXY();
+  if (max_basis == 0) {
+    return;
+  }
+
+  // The sample count of the pass is not known yet. It only affects the width
+  // of strokes that are widened to remain visible, which are not prefetched
+  // so that they are never tessellated at the wrong width.
+  Scalar stroke_width = ComputeStrokeWidth(max_basis, SampleCount::kCount1);
+  if (stroke_width != ComputeStrokeWidth(max_basis, SampleCount::kCount4)) {
+    return;
+  }
+  auto scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f;
+  auto key = TessellationCache::Key::Stroke(transform.GetMaxBasisLength(),
+                                            stroke_width, scaled_miter_limit,
+                                            stroke_cap_, stroke_join_);
+  cache.Prefetch(
+      path_, key,
+      [path = path_, stroke_width, scaled_miter_limit, join = stroke_join_,
+       cap = stroke_cap_](Scalar scale,
+                          TessellationCache::Tessellation& tessellation) {
+        // The tessellator's polyline buffers belong to the raster thread.
+        Path::Polyline polyline = path.CreatePolyline(scale);
+        GenerateStrokeVertices(
+            tessellation.vertices,
+            EstimateSolidStrokeVertexCount(polyline, stroke_width, join, cap,
+                                           scale),
+            polyline, stroke_width, scaled_miter_limit, join, cap, scale);
+      });
+}
+
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -574,36 +767,36 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
     return {};
   }
 
-  Scalar min_size =
-      (pass.GetSampleCount() == SampleCount::kCount4 ? kMinStrokeSizeMSAA
-                                                     : kMinStrokeSize) /
-      max_basis;
-  Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar stroke_width = ComputeStrokeWidth(max_basis, pass.GetSampleCount());
 
   auto& host_buffer = renderer.GetTransientsBuffer();
-  auto scale = entity.GetTransform().GetMaxBasisLength();
-
-  PositionWriter position_writer;
-  auto polyline = renderer.GetTessellator()->CreateTempPolyline(path_, scale);
-  CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc<PositionWriter>(stroke_join_),
-                            GetCapProc<PositionWriter>(stroke_cap_), scale);
-
-  BufferView buffer_view =
-      host_buffer.Emplace(position_writer.GetData().data(),
-                          position_writer.GetData().size() *
-                              sizeof(SolidFillVertexShader::PerVertexData),
-                          alignof(SolidFillVertexShader::PerVertexData));
+  auto scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f;
+  auto key = TessellationCache::Key::Stroke(
+      entity.GetTransform().GetMaxBasisLength(), stroke_width,
+      scaled_miter_limit, stroke_cap_, stroke_join_);
+
+  // The vertices are uploaded as points, which must match the layout of the
+  // vertex shader input.
+  static_assert(sizeof(VS::PerVertexData) == sizeof(Point));
+  std::optional<Path::Polyline> polyline;
+  VertexBuffer vertex_buffer =
+      renderer.GetTessellationCache().GetOrWriteVertices(
+          path_, key, host_buffer,
+          [&](Scalar scale) {
+            polyline.emplace(
+                renderer.GetTessellator()->CreateTempPolyline(path_, scale));
+            return EstimateSolidStrokeVertexCount(
+                *polyline, stroke_width, stroke_join_, stroke_cap_, scale);
+          },
+          [&](Scalar scale, Point* vertices, size_t max_count) {
+            return WriteStrokeVertices(vertices, max_count, *polyline,
+                                       stroke_width, scaled_miter_limit,
+                                       stroke_join_, stroke_cap_, scale);
+          });
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer =
-          {
-              .vertex_buffer = buffer_view,
-              .vertex_count = position_writer.GetData().size(),
-              .index_type = IndexType::kNone,
-          },
+      .vertex_buffer = vertex_buffer,
       .transform = entity.GetShaderTransform(pass),
       .mode = GeometryResult::Mode::kPreventOverdraw};
 }
@@ -31,6 +31,10 @@ class StrokePathGeometry final : public Geometry {
 
   Scalar ComputeAlphaCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  void PrefetchPositionBuffer(const ContentContext& renderer,
+                              const Matrix& transform) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -43,6 +47,27 @@ class StrokePathGeometry final : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // An estimate of the number of vertices of the stroke of the polyline that
+  // is an upper bound for all but degenerate paths. Private for benchmarking
+  // and testing.
+  static size_t EstimateSolidStrokeVertexCount(const Path::Polyline& polyline,
+                                               Scalar stroke_width,
+                                               Join stroke_join,
+                                               Cap stroke_cap,
+                                               Scalar scale);
+
+  // Writes up to |max_count| vertices of the stroke of the polyline and
+  // returns the number of vertices of the complete stroke. Private for
+  // benchmarking.
+  static size_t WriteSolidStrokeVertices(Point* vertices,
+                                         size_t max_count,
+                                         const Path::Polyline& polyline,
+                                         Scalar stroke_width,
+                                         Scalar miter_limit,
+                                         Join stroke_join,
+                                         Cap stroke_cap,
+                                         Scalar scale);
+
   // Private for benchmarking and debugging
   static std::vector<SolidFillVertexShader::PerVertexData>
   GenerateSolidStrokeVertices(const Path::Polyline& polyline,
@@ -57,6 +82,10 @@ class StrokePathGeometry final : public Geometry {
 
   bool SkipRendering() const;
 
+  // The width of the stroke drawn with a transform of the given max basis
+  // length into a pass with the given sample count.
+  Scalar ComputeStrokeWidth(Scalar max_basis, SampleCount sample_count) const;
+
   Path path_;
   Scalar stroke_width_;
   Scalar miter_limit_;
@@ -3,28 +3,143 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+namespace {
+
+size_t GetRenderTargetByteSize(const RenderTarget& render_target) {
+  std::vector<const Texture*> counted;
+  size_t byte_size = 0u;
+  auto add_texture = [&](const std::shared_ptr<Texture>& texture) {
+    if (!texture ||
+        std::find(counted.begin(), counted.end(), texture.get()) !=
+            counted.end()) {
+      return;
+    }
+    // The depth and stencil attachments usually share a texture.
+    counted.push_back(texture.get());
+    byte_size += texture->GetTextureDescriptor().GetByteSizeOfAllMipLevels();
+  };
+  render_target.IterateAllAttachments([&](const Attachment& attachment) {
+    add_texture(attachment.texture);
+    add_texture(attachment.resolve_texture);
+    return true;
+  });
+  return byte_size;
+}
+
+}  // namespace
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_retained_bytes)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_retained_bytes_(max_retained_bytes) {}
 
 void RenderTargetCache::Start() {
+  frame_++;
   for (auto& td : render_target_data_) {
     td.used_this_frame = false;
   }
+  IndexUnusedRenderTargets();
 }
 
 void RenderTargetCache::End() {
   std::vector<RenderTargetData> retain;
+  std::vector<const RenderTargetData*> unused;
 
   for (const auto& td : render_target_data_) {
     if (td.used_this_frame) {
       retain.push_back(td);
+    } else {
+      unused.push_back(&td);
     }
   }
+
+  // Keep the most recently used of the unused render targets that fit the
+  // budget.
+  std::stable_sort(unused.begin(), unused.end(),
+                   [](const RenderTargetData* a, const RenderTargetData* b) {
+                     return a->last_used_frame > b->last_used_frame;
+                   });
+  size_t retained_bytes = 0u;
+  for (const RenderTargetData* td : unused) {
+    if (retained_bytes + td->byte_size <= max_retained_bytes_) {
+      retained_bytes += td->byte_size;
+      retain.push_back(*td);
+    } else {
+      stats_.eviction_count++;
+    }
+  }
+  stats_.retained_bytes = retained_bytes;
+
   render_target_data_.swap(retain);
+  IndexUnusedRenderTargets();
+}
+
+void RenderTargetCache::DiscardUnused() {
+  const size_t count = render_target_data_.size();
+  render_target_data_.erase(
+      std::remove_if(render_target_data_.begin(), render_target_data_.end(),
+                     [](const RenderTargetData& td) {
+                       return !td.used_this_frame;
+                     }),
+      render_target_data_.end());
+  stats_.eviction_count += count - render_target_data_.size();
+  stats_.retained_bytes = 0u;
+  IndexUnusedRenderTargets();
+}
+
+void RenderTargetCache::IndexUnusedRenderTargets() {
+  for (auto& [config, indices] : unused_render_targets_) {
+    indices.clear();
+  }
+  for (size_t i = 0; i < render_target_data_.size(); i++) {
+    const auto& td = render_target_data_[i];
+    if (!td.used_this_frame) {
+      unused_render_targets_[td.config].push_back(i);
+    }
+  }
+  // Drop the configs without unused render targets, so that the map does not
+  // grow with every size that was ever requested.
+  for (auto it = unused_render_targets_.begin();
+       it != unused_render_targets_.end();) {
+    if (it->second.empty()) {
+      it = unused_render_targets_.erase(it);
+    } else {
+      it++;
+    }
+  }
+}
+
+RenderTargetCache::RenderTargetData* RenderTargetCache::FindUnused(
+    const RenderTargetConfig& config) {
+  auto found = unused_render_targets_.find(config);
+  if (found == unused_render_targets_.end() || found->second.empty()) {
+    stats_.miss_count++;
+    return nullptr;
+  }
+  auto& render_target_data = render_target_data_[found->second.back()];
+  found->second.pop_back();
+  render_target_data.used_this_frame = true;
+  render_target_data.last_used_frame = frame_;
+  stats_.hit_count++;
+  return &render_target_data;
+}
+
+void RenderTargetCache::AddUsed(const RenderTargetConfig& config,
+                                const RenderTarget& render_target) {
+  render_target_data_.push_back(RenderTargetData{
+      .used_this_frame = true,
+      .config = config,
+      .render_target = render_target,
+      .byte_size = GetRenderTargetByteSize(render_target),
+      .last_used_frame = frame_,
+  });
 }
 
 RenderTarget RenderTargetCache::CreateOffscreen(
@@ -48,19 +163,15 @@ RenderTarget RenderTargetCache::CreateOffscreen(
       .has_msaa = false,
       .has_depth_stencil = stencil_attachment_config.has_value(),
   };
-  for (auto& render_target_data : render_target_data_) {
-    const auto other_config = render_target_data.config;
-    if (!render_target_data.used_this_frame && other_config == config) {
-      render_target_data.used_this_frame = true;
-      auto color0 = render_target_data.render_target.GetColorAttachments()
-                        .find(0u)
-                        ->second;
-      auto depth = render_target_data.render_target.GetDepthAttachment();
-      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-      return RenderTargetAllocator::CreateOffscreen(
-          context, size, mip_count, label, color_attachment_config,
-          stencil_attachment_config, color0.texture, depth_tex);
-    }
+  if (auto render_target_data = FindUnused(config)) {
+    auto color0 = render_target_data->render_target.GetColorAttachments()
+                      .find(0u)
+                      ->second;
+    auto depth = render_target_data->render_target.GetDepthAttachment();
+    std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+    return RenderTargetAllocator::CreateOffscreen(
+        context, size, mip_count, label, color_attachment_config,
+        stencil_attachment_config, color0.texture, depth_tex);
   }
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreen(
       context, size, mip_count, label, color_attachment_config,
@@ -68,10 +179,7 @@ RenderTarget RenderTargetCache::CreateOffscreen(
   if (!created_target.IsValid()) {
     return created_target;
   }
-  render_target_data_.push_back(
-      RenderTargetData{.used_this_frame = true,
-                       .config = config,
-                       .render_target = created_target});
+  AddUsed(config, created_target);
   return created_target;
 }
 
@@ -98,20 +206,16 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
       .has_msaa = true,
       .has_depth_stencil = stencil_attachment_config.has_value(),
   };
-  for (auto& render_target_data : render_target_data_) {
-    const auto other_config = render_target_data.config;
-    if (!render_target_data.used_this_frame && other_config == config) {
-      render_target_data.used_this_frame = true;
-      auto color0 = render_target_data.render_target.GetColorAttachments()
-                        .find(0u)
-                        ->second;
-      auto depth = render_target_data.render_target.GetDepthAttachment();
-      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-      return RenderTargetAllocator::CreateOffscreenMSAA(
-          context, size, mip_count, label, color_attachment_config,
-          stencil_attachment_config, color0.texture, color0.resolve_texture,
-          depth_tex);
-    }
+  if (auto render_target_data = FindUnused(config)) {
+    auto color0 = render_target_data->render_target.GetColorAttachments()
+                      .find(0u)
+                      ->second;
+    auto depth = render_target_data->render_target.GetDepthAttachment();
+    std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+    return RenderTargetAllocator::CreateOffscreenMSAA(
+        context, size, mip_count, label, color_attachment_config,
+        stencil_attachment_config, color0.texture, color0.resolve_texture,
+        depth_tex);
   }
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreenMSAA(
       context, size, mip_count, label, color_attachment_config,
@@ -119,15 +223,27 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
   if (!created_target.IsValid()) {
     return created_target;
   }
-  render_target_data_.push_back(
-      RenderTargetData{.used_this_frame = true,
-                       .config = config,
-                       .render_target = created_target});
+  AddUsed(config, created_target);
   return created_target;
 }
 
+ISize RenderTargetCache::RoundUpToSizeBucket(ISize size) {
+  auto round_up = [](int64_t value) {
+    // Empty sizes stay empty.
+    if (value <= 0) {
+      return value;
+    }
+    return ((value + kSizeBucket - 1) / kSizeBucket) * kSizeBucket;
+  };
+  return ISize(round_up(size.width), round_up(size.height));
+}
+
 size_t RenderTargetCache::CachedTextureCount() const {
   return render_target_data_.size();
 }
 
+const RenderTargetCache::Stats& RenderTargetCache::GetStats() const {
+  return stats_;
+}
+
 }  // namespace impeller
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 #define FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -12,10 +16,45 @@ namespace impeller {
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
 ///        allocated texture data for one frame.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures unused in a frame are kept for later frames while their
+///        total size fits the retained byte budget, evicting the least
+///        recently used ones first. With the default budget of zero, any
+///        textures unused after a frame are immediately discarded.
+///
+///        Callers whose offscreen size changes from frame to frame can round
+///        it up with `RoundUpToSizeBucket`, so that nearby sizes share
+///        textures. They then only use the requested part of the texture.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  /// The retained byte budget used by the content context. Enough for a few
+  /// small layers or about one full screen layer with its stencil, so that
+  /// the offscreen targets of animated effects whose sizes come and go
+  /// between frames are reused.
+  static constexpr size_t kDefaultMaxRetainedBytes = 16u * 1024u * 1024u;
+
+  /// The granularity in pixels of the sizes returned by
+  /// `RoundUpToSizeBucket`.
+  static constexpr int64_t kSizeBucket = 64;
+
+  struct Stats {
+    /// The number of render targets that reused cached textures.
+    size_t hit_count = 0u;
+    /// The number of render targets that allocated new textures.
+    size_t miss_count = 0u;
+    /// The number of cached render targets that were discarded.
+    size_t eviction_count = 0u;
+    /// The size of the cached textures that were not used in the last frame.
+    size_t retained_bytes = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  allocator           The allocator of the textures.
+  /// @param[in]  max_retained_bytes  The maximum total size of the textures
+  ///                                 that are kept after a frame in which
+  ///                                 they were unused.
+  ///
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_retained_bytes = 0u);
 
   ~RenderTargetCache() = default;
 
@@ -25,6 +64,9 @@ class RenderTargetCache : public RenderTargetAllocator {
   // |RenderTargetAllocator|
   void End() override;
 
+  // |RenderTargetAllocator|
+  void DiscardUnused() override;
+
   RenderTarget CreateOffscreen(
       const Context& context,
       ISize size,
@@ -52,17 +94,52 @@ class RenderTargetCache : public RenderTargetAllocator {
       const std::shared_ptr<Texture>& existing_depth_stencil_texture =
           nullptr) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Rounds a render target size up to the next multiple of
+  ///             `kSizeBucket` in each dimension. Empty sizes stay empty.
+  ///
+  /// @param[in]  size  The size of the part of the render target that is
+  ///                   used.
+  ///
+  /// @return     The size of the render target to create.
+  ///
+  static ISize RoundUpToSizeBucket(ISize size);
+
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  const Stats& GetStats() const;
+
  private:
   struct RenderTargetData {
     bool used_this_frame;
     RenderTargetConfig config;
     RenderTarget render_target;
+    size_t byte_size = 0u;
+    uint64_t last_used_frame = 0u;
+  };
+
+  struct ConfigHash {
+    size_t operator()(const RenderTargetConfig& config) const {
+      return config.Hash();
+    }
   };
 
+  const size_t max_retained_bytes_;
   std::vector<RenderTargetData> render_target_data_;
+  // The indices of the render targets in `render_target_data_` that have not
+  // been used this frame, by config.
+  std::unordered_map<RenderTargetConfig, std::vector<size_t>, ConfigHash>
+      unused_render_targets_;
+  uint64_t frame_ = 0u;
+  Stats stats_;
+
+  RenderTargetData* FindUnused(const RenderTargetConfig& config);
+
+  void AddUsed(const RenderTargetConfig& config,
+               const RenderTarget& render_target);
+
+  void IndexUnusedRenderTargets();
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
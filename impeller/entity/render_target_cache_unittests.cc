@@ -72,6 +72,186 @@ TEST_P(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
 }
 
+TEST_P(RenderTargetCacheTest, RetainsUnusedTexturesWithinBudget) {
+  auto render_target_cache = RenderTargetCache(
+      GetContext()->GetResourceAllocator(),
+      RenderTargetCache::kDefaultMaxRetainedBytes);
+  auto discarding_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator());
+
+  // An animated blur whose offscreen size changes every frame and repeats
+  // every eight frames.
+  for (int frame = 0; frame < 32; frame++) {
+    ISize size(100 + 4 * (frame % 8), 100 + 4 * (frame % 8));
+    for (auto* cache : {&render_target_cache, &discarding_cache}) {
+      cache->Start();
+      EXPECT_TRUE(cache->CreateOffscreen(*GetContext(), size, 1).IsValid());
+      cache->End();
+    }
+  }
+
+  EXPECT_EQ(render_target_cache.GetStats().miss_count, 8u);
+  EXPECT_EQ(render_target_cache.GetStats().hit_count, 24u);
+  EXPECT_EQ(render_target_cache.GetStats().eviction_count, 0u);
+  EXPECT_GT(render_target_cache.GetStats().retained_bytes, 0u);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 8u);
+
+  // Without a budget, only the textures used in the last frame are kept.
+  EXPECT_EQ(discarding_cache.GetStats().miss_count, 32u);
+  EXPECT_EQ(discarding_cache.GetStats().hit_count, 0u);
+  EXPECT_EQ(discarding_cache.GetStats().eviction_count, 31u);
+  EXPECT_EQ(discarding_cache.GetStats().retained_bytes, 0u);
+  EXPECT_EQ(discarding_cache.CachedTextureCount(), 1u);
+}
+
+TEST_P(RenderTargetCacheTest, EvictsLeastRecentlyUsedTextures) {
+  // All render targets have the same number of pixels and no stencil, so the
+  // budget fits exactly one of them.
+  PixelFormat format =
+      GetContext()->GetCapabilities()->GetDefaultColorFormat();
+  size_t byte_size = BytesPerPixelForPixelFormat(format) * 100u * 100u;
+  auto render_target_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator(), byte_size);
+  auto create = [&](ISize size) {
+    return render_target_cache.CreateOffscreen(
+        *GetContext(), size, 1, "Offscreen",
+        RenderTarget::kDefaultColorAttachmentConfig, std::nullopt);
+  };
+
+  render_target_cache.Start();
+  RenderTarget target1 = create({100, 100});
+  render_target_cache.End();
+
+  render_target_cache.Start();
+  RenderTarget target2 = create({50, 200});
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(render_target_cache.GetStats().retained_bytes, byte_size);
+
+  // Only the render target used in the second frame still fits the budget.
+  render_target_cache.Start();
+  create({200, 50});
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(render_target_cache.GetStats().eviction_count, 1u);
+
+  render_target_cache.Start();
+  RenderTarget reused2 = create({50, 200});
+  RenderTarget recreated1 = create({100, 100});
+  render_target_cache.End();
+
+  EXPECT_EQ(reused2.GetRenderTargetTexture(), target2.GetRenderTargetTexture());
+  EXPECT_NE(recreated1.GetRenderTargetTexture(),
+            target1.GetRenderTargetTexture());
+  EXPECT_EQ(render_target_cache.GetStats().hit_count, 1u);
+  EXPECT_EQ(render_target_cache.GetStats().miss_count, 4u);
+}
+
+TEST_P(RenderTargetCacheTest, RoundsSizesUpToBuckets) {
+  EXPECT_EQ(RenderTargetCache::RoundUpToSizeBucket({1, 64}), ISize(64, 64));
+  EXPECT_EQ(RenderTargetCache::RoundUpToSizeBucket({65, 128}),
+            ISize(128, 128));
+  EXPECT_EQ(RenderTargetCache::RoundUpToSizeBucket({129, 1000}),
+            ISize(192, 1024));
+  // Empty sizes stay empty.
+  EXPECT_EQ(RenderTargetCache::RoundUpToSizeBucket({100, 0}), ISize(128, 0));
+}
+
+TEST_P(RenderTargetCacheTest, ReusesBucketedTexturesOfGrowingSizes) {
+  auto render_target_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator(),
+                        RenderTargetCache::kDefaultMaxRetainedBytes);
+  auto exact_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator(),
+                        RenderTargetCache::kDefaultMaxRetainedBytes);
+
+  // An animated blur whose offscreen size grows every frame, from 100x100 to
+  // 224x224.
+  for (int frame = 0; frame < 32; frame++) {
+    ISize size(100 + 4 * frame, 100 + 4 * frame);
+    render_target_cache.Start();
+    exact_cache.Start();
+    EXPECT_TRUE(render_target_cache
+                    .CreateOffscreen(*GetContext(),
+                                     RenderTargetCache::RoundUpToSizeBucket(
+                                         size),
+                                     1)
+                    .IsValid());
+    EXPECT_TRUE(exact_cache.CreateOffscreen(*GetContext(), size, 1).IsValid());
+    render_target_cache.End();
+    exact_cache.End();
+  }
+
+  // One texture is created for each of the 128, 192 and 256 buckets.
+  EXPECT_EQ(render_target_cache.GetStats().miss_count, 3u);
+  EXPECT_EQ(render_target_cache.GetStats().hit_count, 29u);
+
+  // Exact sizes never repeat, so no texture is reused.
+  EXPECT_EQ(exact_cache.GetStats().miss_count, 32u);
+  EXPECT_EQ(exact_cache.GetStats().hit_count, 0u);
+}
+
+TEST_P(RenderTargetCacheTest, BoundsRetainedTexturesOfGrowingSizes) {
+  const size_t budget = RenderTargetCache::kDefaultMaxRetainedBytes;
+  auto render_target_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator(), budget);
+
+  // An animation that grows its offscreen target quickly reuses each bucket
+  // for a few frames. The unused textures are only kept up to the budget.
+  size_t bucket_count = 0u;
+  ISize last_bucket;
+  for (int frame = 0; frame < 48; frame++) {
+    ISize bucket = RenderTargetCache::RoundUpToSizeBucket(
+        ISize(100 + 16 * frame, 100 + 16 * frame));
+    if (bucket != last_bucket) {
+      bucket_count++;
+      last_bucket = bucket;
+    }
+    render_target_cache.Start();
+    EXPECT_TRUE(render_target_cache.CreateOffscreen(*GetContext(), bucket, 1)
+                    .IsValid());
+    render_target_cache.End();
+    EXPECT_LE(render_target_cache.GetStats().retained_bytes, budget);
+  }
+
+  EXPECT_EQ(render_target_cache.GetStats().miss_count, bucket_count);
+  EXPECT_EQ(render_target_cache.GetStats().hit_count, 48u - bucket_count);
+  EXPECT_GT(render_target_cache.GetStats().hit_count,
+            render_target_cache.GetStats().miss_count);
+  // Every render target is either still cached or was evicted.
+  EXPECT_EQ(render_target_cache.GetStats().eviction_count +
+                render_target_cache.CachedTextureCount(),
+            bucket_count);
+}
+
+TEST_P(RenderTargetCacheTest, DiscardUnusedDropsRetainedTextures) {
+  auto render_target_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator(),
+                        RenderTargetCache::kDefaultMaxRetainedBytes);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {200, 200}, 1);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_GT(render_target_cache.GetStats().retained_bytes, 0u);
+
+  // The render target used in the last frame is kept.
+  render_target_cache.DiscardUnused();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  EXPECT_EQ(render_target_cache.GetStats().retained_bytes, 0u);
+  EXPECT_EQ(render_target_cache.GetStats().eviction_count, 1u);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {200, 200}, 1);
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.GetStats().hit_count, 1u);
+  EXPECT_EQ(render_target_cache.GetStats().miss_count, 3u);
+}
+
 TEST_P(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   ScopedValidationDisable disable;
   auto allocator = std::make_shared<TestAllocator>();
@@ -2,28 +2,72 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include "flutter/benchmarking/benchmarking.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
 
-#include "flutter/impeller/entity/solid_fill.vert.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
 
+#include "impeller/base/frame_arena.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/text_contents.h"
+#include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellation_cache.h"
+#include "impeller/tessellator/tessellator.h"
 #include "impeller/tessellator/tessellator_libtess.h"
+#include "impeller/tessellator/tessellator_monotone.h"
+
+namespace {
+// The number of heap allocations made by this process, used to report the
+// allocations made per iteration of a benchmark.
+std::atomic<size_t> allocation_count = 0u;
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1u, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0u ? 1u : size)) {
+    return pointer;
+  }
+  std::abort();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
 
 namespace impeller {
 
 class ImpellerBenchmarkAccessor {
  public:
-  static std::vector<SolidFillVertexShader::PerVertexData>
-  GenerateSolidStrokeVertices(const Path::Polyline& polyline,
-                              Scalar stroke_width,
-                              Scalar miter_limit,
-                              Join stroke_join,
-                              Cap stroke_cap,
-                              Scalar scale) {
-    return StrokePathGeometry::GenerateSolidStrokeVertices(
-        polyline, stroke_width, miter_limit, stroke_join, stroke_cap, scale);
+  static size_t EstimateSolidStrokeVertexCount(const Path::Polyline& polyline,
+                                               Scalar stroke_width,
+                                               Join stroke_join,
+                                               Cap stroke_cap,
+                                               Scalar scale) {
+    return StrokePathGeometry::EstimateSolidStrokeVertexCount(
+        polyline, stroke_width, stroke_join, stroke_cap, scale);
+  }
+
+  static size_t WriteSolidStrokeVertices(Point* vertices,
+                                         size_t max_count,
+                                         const Path::Polyline& polyline,
+                                         Scalar stroke_width,
+                                         Scalar miter_limit,
+                                         Join stroke_join,
+                                         Cap stroke_cap,
+                                         Scalar scale) {
+    return StrokePathGeometry::WriteSolidStrokeVertices(
+        vertices, max_count, polyline, stroke_width, miter_limit, stroke_join,
+        stroke_cap, scale);
   }
 };
 
@@ -35,17 +79,40 @@ Path CreateCubic(bool closed);
 Path CreateQuadratic(bool closed);
 /// Create a rounded rect.
 Path CreateRRect();
+/// A line of glyph outlines made of quadratics and cubics, with counters.
+Path CreateGlyphs();
+/// Map-like polygons with thousands of jagged edges, islands and lakes.
+Path CreateMapPolygons();
 }  // namespace
 
 static TessellatorLibtess tess;
 
+/// The scale to flatten curves at, which is 1 unless the benchmark captures a
+/// Scalar. Larger scales subdivide each curve into more lines.
 template <class... Args>
-static void BM_Polyline(benchmark::State& state, Args&&... args) {
+static Scalar GetFlatteningScale(const std::tuple<Args...>& args_tuple) {
+  if constexpr ((std::is_same_v<Args, Scalar> || ...)) {
+    return std::get<Scalar>(args_tuple);
+  } else {
+    return 1.0f;
+  }
+}
+
+// Flattens the path into a polyline. Paths retain the polyline of a scale
+// that is requested twice in a row, so unless |retained| is set the scale
+// alternates between two neighboring values to measure the flattening itself.
+template <class... Args>
+static void CreatePolylines(benchmark::State& state,
+                            bool retained,
+                            Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
   auto path = std::get<Path>(args_tuple);
+  auto scale = GetFlatteningScale(args_tuple);
+  const Scalar scales[] = {scale, retained ? scale : std::nextafter(scale, 0)};
 
   size_t point_count = 0u;
   size_t single_point_count = 0u;
+  size_t iteration = 0u;
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
   while (state.KeepRunning()) {
@@ -53,7 +120,7 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
         // Clang-tidy doesn't know that the points get moved back before
         // getting moved again in this loop.
         // NOLINTNEXTLINE(clang-analyzer-cplusplus.Move)
-        1.0f, std::move(points),
+        scales[iteration++ % 2u], std::move(points),
         [&points](Path::Polyline::PointBufferPtr reclaimed) {
           points = std::move(reclaimed);
         });
@@ -64,6 +131,62 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+template <class... Args>
+static void BM_Polyline(benchmark::State& state, Args&&... args) {
+  CreatePolylines(state, false, std::forward<Args>(args)...);
+}
+
+template <class... Args>
+static void BM_RetainedPolyline(benchmark::State& state, Args&&... args) {
+  CreatePolylines(state, true, std::forward<Args>(args)...);
+}
+
+// Builds a copy of the path with a reused builder, reporting the heap
+// allocations made for each path.
+template <class... Args>
+static void BM_PathBuild(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+
+  PathBuilder builder;
+  // Warm up the buffers kept by the builder.
+  builder.AddPath(path).TakePath();
+  size_t component_count = 0u;
+  const size_t start_allocation_count = allocation_count.load();
+  while (state.KeepRunning()) {
+    Path copy = builder.AddPath(path).TakePath();
+    component_count += copy.GetComponentCount();
+  }
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocation_count.load() - start_allocation_count,
+      benchmark::Counter::kAvgIterations);
+  state.counters["TotalComponentCount"] = component_count;
+}
+
+template <class... Args>
+static void BM_PathIterate(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+
+  Point sum;
+  auto add_linear = [&sum](size_t index, const LinearPathComponent& linear) {
+    sum += linear.p2;
+  };
+  auto add_quad = [&sum](size_t index, const QuadraticPathComponent& quad) {
+    sum += quad.cp + quad.p2;
+  };
+  auto add_cubic = [&sum](size_t index, const CubicPathComponent& cubic) {
+    sum += cubic.cp1 + cubic.cp2 + cubic.p2;
+  };
+  auto add_contour = [&sum](size_t index, const ContourComponent& contour) {
+    sum += contour.destination;
+  };
+  while (state.KeepRunning()) {
+    path.EnumerateComponents(add_linear, add_quad, add_cubic, add_contour);
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
 template <class... Args>
 static void BM_StrokePolyline(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -73,26 +196,40 @@ static void BM_StrokePolyline(benchmark::State& state, Args&&... args) {
 
   const Scalar stroke_width = 5.0f;
   const Scalar miter_limit = 10.0f;
-  const Scalar scale = 1.0f;
+  const Scalar scale = GetFlatteningScale(args_tuple);
 
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
   auto polyline =
-      path.CreatePolyline(1.0f, std::move(points),
+      path.CreatePolyline(scale, std::move(points),
                           [&points](Path::Polyline::PointBufferPtr reclaimed) {
                             points = std::move(reclaimed);
                           });
 
   size_t point_count = 0u;
   size_t single_point_count = 0u;
+  // Stands in for the transients buffer the vertices are written into.
+  std::vector<Point> vertices;
+  const size_t start_allocation_count = allocation_count.load();
   while (state.KeepRunning()) {
-    auto vertices = ImpellerBenchmarkAccessor::GenerateSolidStrokeVertices(
-        polyline, stroke_width, miter_limit, join, cap, scale);
-    single_point_count = vertices.size();
+    size_t max_count =
+        ImpellerBenchmarkAccessor::EstimateSolidStrokeVertexCount(
+            polyline, stroke_width, join, cap, scale);
+    if (vertices.size() < max_count) {
+      vertices.resize(max_count);
+    }
+    single_point_count = ImpellerBenchmarkAccessor::WriteSolidStrokeVertices(
+        vertices.data(), max_count, polyline, stroke_width, miter_limit, join,
+        cap, scale);
     point_count += single_point_count;
   }
   state.counters["SinglePointCount"] = single_point_count;
   state.counters["TotalPointCount"] = point_count;
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocation_count.load() - start_allocation_count,
+      benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(point_count);
+  state.SetBytesProcessed(point_count * sizeof(Point));
 }
 
 template <class... Args>
@@ -116,10 +253,310 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+// Tessellates the same path every iteration as a static icon would be drawn
+// every frame, copying the vertices out as the upload to the transients buffer
+// would.
+template <class... Args>
+static void BM_CachedConvex(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto cached = std::get<bool>(args_tuple);
+
+  TessellationCache cache;
+  auto key = TessellationCache::Key::Fill(1.0f);
+  auto tessellate = [&path](Scalar scale,
+                            TessellationCache::Tessellation& tessellation) {
+    Tessellator::TessellateConvexInternal(path, tessellation.vertices,
+                                          tessellation.indices, scale);
+  };
+  TessellationCache::Tessellation uncached;
+  std::vector<Point> points;
+  std::vector<uint16_t> indices;
+  points.reserve(2048);
+  indices.reserve(2048);
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    const TessellationCache::Tessellation* tessellation = &uncached;
+    if (cached) {
+      tessellation = &cache.GetOrTessellate(path, key, tessellate);
+    } else {
+      uncached.vertices.clear();
+      uncached.indices.clear();
+      tessellate(key.GetScale(), uncached);
+    }
+    points.assign(tessellation->vertices.begin(),
+                  tessellation->vertices.end());
+    indices.assign(tessellation->indices.begin(), tessellation->indices.end());
+    single_point_count = indices.size();
+    point_count += indices.size();
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["HitRate"] = cache.GetStats().GetHitRate();
+}
+
+// Draws a frame of many distinct paths, prefetching all of them on the given
+// number of workers before tessellating them in order as the raster thread
+// would. The CPU time is the time spent on the raster thread.
+template <class... Args>
+static void BM_PrefetchedConvex(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto worker_count = std::get<size_t>(args_tuple);
+
+  constexpr size_t kPathCount = 64u;
+  std::vector<Path> paths;
+  for (size_t i = 0; i < kPathCount; i++) {
+    paths.push_back(
+        PathBuilder{}.AddPath(path).Shift({i * 0.5f, 0}).TakePath());
+  }
+
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  TessellationCache cache;
+  if (worker_count > 0u) {
+    loop = fml::ConcurrentMessageLoop::Create(worker_count);
+    cache.SetWorkerTaskRunner(loop->GetTaskRunner());
+  }
+  auto tessellate = [](const Path& path) {
+    return [path](Scalar scale, TessellationCache::Tessellation& tessellation) {
+      Tessellator::TessellateConvexInternal(path, tessellation.vertices,
+                                            tessellation.indices, scale);
+    };
+  };
+  auto key = TessellationCache::Key::Fill(8.0f);
+
+  size_t point_count = 0u;
+  while (state.KeepRunning()) {
+    cache.Clear();
+    for (const Path& path : paths) {
+      cache.Prefetch(path, key, tessellate(path));
+    }
+    for (const Path& path : paths) {
+      point_count +=
+          cache.GetOrTessellate(path, key, tessellate(path)).vertices.size();
+    }
+  }
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["PrefetchUseCount"] = cache.GetStats().prefetch_use_count;
+}
+
+// Tessellates a concave fill, reporting the heap allocations made by each
+// tessellation.
+template <class T, class... Args>
+static void TessellateFill(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+
+  T tessellator;
+  size_t index_count = 0u;
+  size_t single_index_count = 0u;
+  auto callback = [&single_index_count](const float* vertices,
+                                        size_t vertices_count,
+                                        const uint16_t* indices,
+                                        size_t indices_count) {
+    single_index_count = indices ? indices_count : vertices_count;
+    return true;
+  };
+  // Warm up any working memory kept by the tessellator.
+  tessellator.Tessellate(path, 1.0f, callback);
+  const size_t start_allocation_count = allocation_count.load();
+  while (state.KeepRunning()) {
+    tessellator.Tessellate(path, 1.0f, callback);
+    index_count += single_index_count;
+  }
+  state.counters["SingleIndexCount"] = single_index_count;
+  state.counters["TotalIndexCount"] = index_count;
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocation_count.load() - start_allocation_count,
+      benchmark::Counter::kAvgIterations);
+}
+
+template <class... Args>
+static void BM_LibtessFill(benchmark::State& state, Args&&... args) {
+  TessellateFill<TessellatorLibtess>(state, std::forward<Args>(args)...);
+}
+
+template <class... Args>
+static void BM_MonotoneFill(benchmark::State& state, Args&&... args) {
+  TessellateFill<TessellatorMonotone>(state, std::forward<Args>(args)...);
+}
+
+// Records the entities of a frame of text and shapes the way the canvas
+// does, creating geometry and contents for each draw, and reports the heap
+// allocations made per frame. With |use_arena| they are allocated from a
+// frame arena that is reset at the end of each frame.
+static void BM_RecordTextAndShapes(benchmark::State& state, bool use_arena) {
+  const Path glyphs = CreateGlyphs();
+  FrameArena frame_arena;
+  FrameArena* arena = use_arena ? &frame_arena : nullptr;
+  std::vector<std::shared_ptr<Contents>> entities;
+  entities.reserve(400);
+
+  auto record_frame = [&]() {
+    for (int i = 0; i < 100; i++) {
+      Rect card = Rect::MakeXYWH(16, i * 120.0f, 400, 100);
+
+      auto background = MakeSharedInArena<SolidColorContents>(arena);
+      background->SetColor(Color::White());
+      background->SetGeometry(Geometry::MakeRoundRect(card, {12, 12}, arena));
+      entities.push_back(std::move(background));
+
+      auto divider = MakeSharedInArena<SolidColorContents>(arena);
+      divider->SetColor(Color::Black());
+      divider->SetGeometry(Geometry::MakeRect(
+          Rect::MakeXYWH(16, i * 120.0f + 110, 400, 1), arena));
+      entities.push_back(std::move(divider));
+
+      auto icon = MakeSharedInArena<SolidColorContents>(arena);
+      icon->SetColor(Color::Blue());
+      icon->SetGeometry(Geometry::MakeFillPath(glyphs, std::nullopt, arena));
+      entities.push_back(std::move(icon));
+
+      auto text = MakeSharedInArena<TextContents>(arena);
+      text->SetColor(Color::Black());
+      text->SetOffset(card.GetOrigin());
+      entities.push_back(std::move(text));
+    }
+    entities.clear();
+    frame_arena.Reset();
+  };
+
+  // Warm up the blocks kept by the arena.
+  record_frame();
+  const size_t start_allocation_count = allocation_count.load();
+  while (state.KeepRunning()) {
+    record_frame();
+  }
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocation_count.load() - start_allocation_count,
+      benchmark::Counter::kAvgIterations);
+}
+
+enum class EllipticalShape {
+  kFilledCircle,
+  kStrokedCircle,
+  kFilledEllipse,
+  kFilledRoundRect,
+};
+
+static Tessellator::EllipticalVertexGenerator CreateEllipticalGenerator(
+    Tessellator& tessellator,
+    EllipticalShape shape) {
+  // Large enough on screen to use one of the finer cached divisions.
+  const auto transform = Matrix::MakeScale({4.0f, 4.0f, 1.0f});
+  const auto bounds = Rect::MakeLTRB(0, 0, 200, 120);
+  switch (shape) {
+    case EllipticalShape::kFilledCircle:
+      return tessellator.FilledCircle(transform, {100, 100}, 100);
+    case EllipticalShape::kStrokedCircle:
+      return tessellator.StrokedCircle(transform, {100, 100}, 100, 5);
+    case EllipticalShape::kFilledEllipse:
+      return tessellator.FilledEllipse(transform, bounds);
+    case EllipticalShape::kFilledRoundRect:
+      return tessellator.FilledRoundRect(transform, bounds, {40, 30});
+  }
+}
+
+template <class... Args>
+static void BM_EllipticalVertices(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto shape = std::get<EllipticalShape>(args_tuple);
+  auto streaming = std::get<bool>(args_tuple);
+
+  Tessellator tessellator;
+  auto generator = CreateEllipticalGenerator(tessellator, shape);
+  std::vector<Point> vertices(generator.GetVertexCount());
+
+  size_t point_count = 0u;
+  while (state.KeepRunning()) {
+    if (streaming) {
+      generator.WriteVertices(vertices.data());
+    } else {
+      Point* vertex = vertices.data();
+      generator.GenerateVertices([&vertex](const Point& p) {  //
+        *vertex++ = p;
+      });
+    }
+    benchmark::ClobberMemory();
+    point_count += vertices.size();
+  }
+  state.counters["SinglePointCount"] = vertices.size();
+  state.counters["TotalPointCount"] = point_count;
+}
+
+static Matrix CreateTransform() {
+  return Matrix::MakeTranslation({30, -12}) *
+         Matrix::MakeRotationZ(Degrees(20)) *
+         Matrix::MakeScale({1.5f, 0.75f, 1.0f});
+}
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  Matrix a = CreateTransform();
+  Matrix b = Matrix::MakeSkew(0.25f, 0.5f);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    Matrix result = a * b;
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+}
+
+static void BM_MatrixInvert(benchmark::State& state) {
+  Matrix matrix = CreateTransform();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(matrix);
+    Matrix result = matrix.Invert();
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+}
+
+template <class... Args>
+static void BM_TransformPoints(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto batched = std::get<bool>(args_tuple);
+
+  Matrix matrix = CreateTransform();
+  std::vector<Point> points(1024);
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = {i * 0.5f, 1000.0f - i * 0.25f};
+  }
+  std::vector<Point> transformed(points.size());
+
+  while (state.KeepRunning()) {
+    if (batched) {
+      matrix.TransformPoints(points.data(), transformed.data(), points.size());
+    } else {
+      for (size_t i = 0; i < points.size(); i++) {
+        transformed[i] = matrix * points[i];
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+#define MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(shape)                          \
+  BENCHMARK_CAPTURE(BM_EllipticalVertices, shape##_callback,              \
+                    EllipticalShape::k##shape, false);                    \
+  BENCHMARK_CAPTURE(BM_EllipticalVertices, shape##_streaming,             \
+                    EllipticalShape::k##shape, true)
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed)         \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join, \
                     Create##path(closed), Cap::k##cap, Join::k##join)
 
+// Strokes a path that is drawn magnified, where curves and round joins are
+// subdivided into many lines.
+#define MAKE_SCALED_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed, scale) \
+  BENCHMARK_CAPTURE(BM_StrokePolyline,                                     \
+                    stroke_##path##_##cap##_##join##_x##scale,             \
+                    Create##path(closed), Cap::k##cap, Join::k##join,      \
+                    Scalar(scale))
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(path, closed) \
   MAKE_STROKE_BENCHMARK_CAPTURE(path, Butt, Bevel, closed);        \
   MAKE_STROKE_BENCHMARK_CAPTURE(path, Butt, Miter, closed);        \
@@ -128,14 +565,32 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   MAKE_STROKE_BENCHMARK_CAPTURE(path, Round, Bevel, closed)
 
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_RetainedPolyline, cubic_polyline, CreateCubic(true));
 BENCHMARK_CAPTURE(BM_Polyline, unclosed_cubic_polyline, CreateCubic(false));
+BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_x8, CreateCubic(true), 8.0f);
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Cubic, false);
+MAKE_SCALED_STROKE_BENCHMARK_CAPTURE(Cubic, Round, Round, false, 8);
 
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(true));
+BENCHMARK_CAPTURE(BM_RetainedPolyline, quad_polyline, CreateQuadratic(true));
 BENCHMARK_CAPTURE(BM_Polyline, unclosed_quad_polyline, CreateQuadratic(false));
+BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_x8, CreateQuadratic(true), 8.0f);
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Quadratic, false);
+MAKE_SCALED_STROKE_BENCHMARK_CAPTURE(Quadratic, Round, Round, false, 8);
 
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_CachedConvex, rrect_uncached, CreateRRect(), false);
+BENCHMARK_CAPTURE(BM_CachedConvex, rrect_cached, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_CachedConvex, cubic_uncached, CreateCubic(true), false);
+BENCHMARK_CAPTURE(BM_CachedConvex, cubic_cached, CreateCubic(true), true);
+BENCHMARK_CAPTURE(BM_PrefetchedConvex, cubic_x64_0_workers, CreateCubic(true),
+                  size_t(0));
+BENCHMARK_CAPTURE(BM_PrefetchedConvex, cubic_x64_1_workers, CreateCubic(true),
+                  size_t(1));
+BENCHMARK_CAPTURE(BM_PrefetchedConvex, cubic_x64_2_workers, CreateCubic(true),
+                  size_t(2));
+BENCHMARK_CAPTURE(BM_PrefetchedConvex, cubic_x64_4_workers, CreateCubic(true),
+                  size_t(4));
 // A round rect has no ends so we don't need to try it with all cap values
 // but it does have joins and even though they should all be almost
 // colinear, we run the benchmark against all 3 join values.
@@ -143,8 +598,101 @@ MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Miter, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Round, );
 
+BENCHMARK_CAPTURE(BM_PathBuild, cubic, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_PathBuild, glyphs, CreateGlyphs());
+BENCHMARK_CAPTURE(BM_PathBuild, map, CreateMapPolygons());
+BENCHMARK_CAPTURE(BM_PathIterate, cubic, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_PathIterate, glyphs, CreateGlyphs());
+BENCHMARK_CAPTURE(BM_PathIterate, map, CreateMapPolygons());
+
+BENCHMARK_CAPTURE(BM_RecordTextAndShapes, heap, false);
+BENCHMARK_CAPTURE(BM_RecordTextAndShapes, frame_arena, true);
+
+BENCHMARK_CAPTURE(BM_LibtessFill, glyphs, CreateGlyphs());
+BENCHMARK_CAPTURE(BM_MonotoneFill, glyphs, CreateGlyphs());
+BENCHMARK_CAPTURE(BM_LibtessFill, map, CreateMapPolygons());
+BENCHMARK_CAPTURE(BM_MonotoneFill, map, CreateMapPolygons());
+BENCHMARK_CAPTURE(BM_LibtessFill, cubic, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_MonotoneFill, cubic, CreateCubic(true));
+
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(FilledCircle);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(StrokedCircle);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(FilledEllipse);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(FilledRoundRect);
+
+BENCHMARK(BM_MatrixMultiply);
+BENCHMARK(BM_MatrixInvert);
+BENCHMARK_CAPTURE(BM_TransformPoints, scalar, false);
+BENCHMARK_CAPTURE(BM_TransformPoints, batched, true);
+
 namespace {
 
+Path CreateGlyphs() {
+  PathBuilder builder;
+  for (int i = 0; i < 16; i++) {
+    Scalar x = i * 60.0f;
+    // An "o" with its counter wound the opposite way.
+    builder.AddOval(Rect::MakeXYWH(x, 20, 40, 44));
+    builder.MoveTo({x + 20, 28})
+        .QuadraticCurveTo({x + 8, 28}, {x + 8, 42})
+        .QuadraticCurveTo({x + 8, 56}, {x + 20, 56})
+        .QuadraticCurveTo({x + 32, 56}, {x + 32, 42})
+        .QuadraticCurveTo({x + 32, 28}, {x + 20, 28})
+        .Close();
+    // A "B" with two counters.
+    builder.MoveTo({x, 70})
+        .LineTo({x + 22, 70})
+        .CubicCurveTo({x + 44, 70}, {x + 44, 96}, {x + 26, 98})
+        .CubicCurveTo({x + 48, 100}, {x + 48, 130}, {x + 22, 130})
+        .LineTo({x, 130})
+        .Close();
+    builder.MoveTo({x + 8, 78})
+        .LineTo({x + 8, 94})
+        .LineTo({x + 20, 94})
+        .CubicCurveTo({x + 32, 94}, {x + 32, 78}, {x + 20, 78})
+        .Close();
+    builder.MoveTo({x + 8, 102})
+        .LineTo({x + 8, 122})
+        .LineTo({x + 21, 122})
+        .CubicCurveTo({x + 36, 122}, {x + 36, 102}, {x + 21, 102})
+        .Close();
+  }
+  return builder.TakePath(FillType::kOdd);
+}
+
+Path CreateMapPolygons() {
+  PathBuilder builder;
+  // Deterministic noise so that every run tessellates the same outline.
+  uint32_t seed = 1u;
+  auto noise = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<Scalar>(seed >> 8) / static_cast<Scalar>(1u << 24);
+  };
+  auto add_region = [&builder, &noise](Point center, Scalar radius,
+                                       int vertex_count, bool clockwise) {
+    for (int i = 0; i < vertex_count; i++) {
+      Scalar angle = (clockwise ? 2 : -2) * kPi * i / vertex_count;
+      Scalar distance = radius * (0.75f + 0.25f * noise());
+      Point point =
+          center + Point(std::cos(angle), std::sin(angle)) * distance;
+      if (i == 0) {
+        builder.MoveTo(point);
+      } else {
+        builder.LineTo(point);
+      }
+    }
+    builder.Close();
+  };
+  add_region({500, 500}, 450, 4000, true);
+  for (int i = 0; i < 8; i++) {
+    // Lakes inside the mainland and islands off its coast.
+    add_region({350.0f + (i % 4) * 100, 400.0f + (i / 4) * 200}, 40, 200,
+               false);
+    add_region({100.0f + i * 110, 1000}, 30, 150, true);
+  }
+  return builder.TakePath(FillType::kNonZero);
+}
+
 Path CreateRRect() {
   return PathBuilder{}
       .AddRoundedRect(Rect::MakeLTRB(0, 0, 400, 400), 16)
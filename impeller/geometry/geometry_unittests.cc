@@ -539,6 +539,32 @@ TEST(GeometryTest, MatrixLookAt) {
   }
 }
 
+TEST(GeometryTest, MatrixTransformPointsMatchesPointTransform) {
+  std::vector<Point> points;
+  for (int i = 0; i < 11; i++) {
+    points.push_back({i * 3.7f - 12.0f, 100.0f - i * i * 0.3f});
+  }
+
+  for (const auto& matrix : {
+           Matrix(),
+           Matrix::MakeTranslation({5, -7}),
+           Matrix::MakeTranslation({5, -7}) * Matrix::MakeScale({3, 0.25, 1}),
+           Matrix::MakeRotationZ(Degrees(30)) * Matrix::MakeSkew(0.5, -0.1),
+           Matrix::MakePerspective(Degrees(60), 1.0f, 0.1f, 100.0f),
+       }) {
+    std::vector<Point> transformed(points.size());
+    matrix.TransformPoints(points.data(), transformed.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      EXPECT_EQ(transformed[i], matrix * points[i]);
+    }
+
+    // Transforming in place.
+    std::vector<Point> in_place = points;
+    matrix.TransformPoints(in_place.data(), in_place.data(), in_place.size());
+    EXPECT_EQ(in_place, transformed);
+  }
+}
+
 TEST(GeometryTest, QuaternionLerp) {
   auto q1 = Quaternion{{0.0, 0.0, 1.0}, 0.0};
   auto q2 = Quaternion{{0.0, 0.0, 1.0}, kPiOver4};
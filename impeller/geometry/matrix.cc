@@ -7,6 +7,8 @@
 #include <climits>
 #include <sstream>
 
+#include "impeller/geometry/simd.h"
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -95,68 +97,95 @@ Matrix Matrix::operator+(const Matrix& o) const {
 }
 
 Matrix Matrix::Invert() const {
-  Matrix tmp{
-      m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
-          m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
-
-      -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] -
-          m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10],
-
-      m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] +
-          m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6],
-
-      -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] -
-          m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6],
-
-      -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] -
-          m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10],
-
-      m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] +
-          m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10],
-
-      -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] -
-          m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6],
-
-      m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] +
-          m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6],
-
-      m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] +
-          m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9],
-
-      -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] -
-          m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9],
-
-      m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] +
-          m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5],
-
-      -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] -
-          m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5],
-
-      -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] -
-          m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9],
-
-      m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] +
-          m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9],
-
-      -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] -
-          m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5],
+  auto a00 = e[0][0];
+  auto a01 = e[0][1];
+  auto a02 = e[0][2];
+  auto a03 = e[0][3];
+  auto a10 = e[1][0];
+  auto a11 = e[1][1];
+  auto a12 = e[1][2];
+  auto a13 = e[1][3];
+  auto a20 = e[2][0];
+  auto a21 = e[2][1];
+  auto a22 = e[2][2];
+  auto a23 = e[2][3];
+  auto a30 = e[3][0];
+  auto a31 = e[3][1];
+  auto a32 = e[3][2];
+  auto a33 = e[3][3];
 
-      m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] +
-          m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5]};
+  // The 2x2 minors of the top and bottom halves are each shared by several
+  // cofactors.
+  auto b00 = a00 * a11 - a01 * a10;
+  auto b01 = a00 * a12 - a02 * a10;
+  auto b02 = a00 * a13 - a03 * a10;
+  auto b03 = a01 * a12 - a02 * a11;
+  auto b04 = a01 * a13 - a03 * a11;
+  auto b05 = a02 * a13 - a03 * a12;
+  auto b06 = a20 * a31 - a21 * a30;
+  auto b07 = a20 * a32 - a22 * a30;
+  auto b08 = a20 * a33 - a23 * a30;
+  auto b09 = a21 * a32 - a22 * a31;
+  auto b10 = a21 * a33 - a23 * a31;
+  auto b11 = a22 * a33 - a23 * a32;
 
   Scalar det =
-      m[0] * tmp.m[0] + m[1] * tmp.m[4] + m[2] * tmp.m[8] + m[3] * tmp.m[12];
+      b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
 
   if (det == 0) {
     return {};
   }
 
-  det = 1.0 / det;
+  // clang-format off
+  Matrix adjugate{
+      a11 * b11 - a12 * b10 + a13 * b09,
+      a02 * b10 - a01 * b11 - a03 * b09,
+      a31 * b05 - a32 * b04 + a33 * b03,
+      a22 * b04 - a21 * b05 - a23 * b03,
+      a12 * b08 - a10 * b11 - a13 * b07,
+      a00 * b11 - a02 * b08 + a03 * b07,
+      a32 * b02 - a30 * b05 - a33 * b01,
+      a20 * b05 - a22 * b02 + a23 * b01,
+      a10 * b10 - a11 * b08 + a13 * b06,
+      a01 * b08 - a00 * b10 - a03 * b06,
+      a30 * b04 - a31 * b02 + a33 * b00,
+      a21 * b02 - a20 * b04 - a23 * b00,
+      a11 * b07 - a10 * b09 - a12 * b06,
+      a00 * b09 - a01 * b07 + a02 * b06,
+      a31 * b01 - a30 * b03 - a32 * b00,
+      a20 * b03 - a21 * b01 + a22 * b00};
+  // clang-format on
+
+  const Float4 inverse_det = Float4::Splat(1.0 / det);
+  for (size_t i = 0; i < 4; i++) {
+    (Float4::Load(&adjugate.m[4 * i]) * inverse_det).Store(&adjugate.m[4 * i]);
+  }
+  return adjugate;
+}
 
-  return {tmp.m[0] * det,  tmp.m[1] * det,  tmp.m[2] * det,  tmp.m[3] * det,
-          tmp.m[4] * det,  tmp.m[5] * det,  tmp.m[6] * det,  tmp.m[7] * det,
-          tmp.m[8] * det,  tmp.m[9] * det,  tmp.m[10] * det, tmp.m[11] * det,
-          tmp.m[12] * det, tmp.m[13] * det, tmp.m[14] * det, tmp.m[15] * det};
+void Matrix::TransformPoints(const Point* points,
+                             Point* transformed,
+                             size_t count) const {
+  size_t i = 0;
+  // With perspective every point needs its own division, which is left to
+  // the scalar path.
+  if (!HasPerspective2D()) {
+    const Float4 m0 = Float4::Splat(m[0]);
+    const Float4 m1 = Float4::Splat(m[1]);
+    const Float4 m4 = Float4::Splat(m[4]);
+    const Float4 m5 = Float4::Splat(m[5]);
+    const Float4 m12 = Float4::Splat(m[12]);
+    const Float4 m13 = Float4::Splat(m[13]);
+    for (; i + Float4::kLaneCount <= count; i += Float4::kLaneCount) {
+      auto [x, y] = Float4::LoadPoints(points + i);
+      Float4::StorePoints(x * m0 + y * m4 + m12,  //
+                          x * m1 + y * m5 + m13,  //
+                          transformed + i);
+    }
+  }
+  for (; i < count; i++) {
+    transformed[i] = *this * points[i];
+  }
 }
 
 Scalar Matrix::GetDeterminant() const {
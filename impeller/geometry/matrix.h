@@ -469,6 +469,17 @@ struct Matrix {
     return result * w;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms |count| points, four at a time where possible.
+  ///
+  ///             The results are identical to transforming each point with
+  ///             |operator*|. |points| and |transformed| may be the same
+  ///             array.
+  ///
+  void TransformPoints(const Point* points,
+                       Point* transformed,
+                       size_t count) const;
+
   constexpr Vector3 TransformHomogenous(const Point& v) const {
     return Vector3(v.x * m[0] + v.y * m[4] + m[12],
                    v.x * m[1] + v.y * m[5] + m[13],
@@ -4,17 +4,302 @@
 
 #include "impeller/geometry/path.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
 
 namespace impeller {
 
-Path::Path() : data_(new Data()) {}
+namespace {
 
-Path::Path(Data data) : data_(std::make_shared<Data>(std::move(data))) {}
+uint32_t ScalarBits(Scalar scalar) {
+  uint32_t bits;
+  static_assert(sizeof(bits) == sizeof(scalar));
+  memcpy(&bits, &scalar, sizeof(bits));
+  return bits;
+}
+
+// Contours keep their closed flag in the high bit of the stored component
+// type.
+constexpr uint8_t kClosedContourBit = 0x80u;
+
+// The number of points that each component adds to the storage of a path.
+// The start point of a segment is not stored again, it is the last point of
+// the component before it.
+constexpr size_t StoredPointCount(Path::ComponentType type) {
+  switch (type) {
+    case Path::ComponentType::kLinear:
+      return 1u;
+    case Path::ComponentType::kQuadratic:
+      return 2u;
+    case Path::ComponentType::kCubic:
+      return 3u;
+    case Path::ComponentType::kContour:
+      return 1u;
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace
+
+struct Path::Storage {
+  Storage(FillType p_fill,
+          Convexity p_convexity,
+          std::optional<Rect> p_bounds,
+          size_t p_point_count,
+          size_t p_component_count)
+      : fill(p_fill),
+        convexity(p_convexity),
+        bounds(p_bounds),
+        point_count(p_point_count),
+        component_count(p_component_count) {}
+
+  // The x coordinates of the points, followed by their y coordinates, the
+  // offset of the first point of each component and then the component
+  // types, which are all kept in the same allocation right after this
+  // structure.
+  Scalar* GetXs() { return reinterpret_cast<Scalar*>(this + 1); }
+  const Scalar* GetXs() const {
+    return reinterpret_cast<const Scalar*>(this + 1);
+  }
+  Scalar* GetYs() { return GetXs() + point_count; }
+  const Scalar* GetYs() const { return GetXs() + point_count; }
+  uint32_t* GetOffsets() {
+    return reinterpret_cast<uint32_t*>(GetYs() + point_count);
+  }
+  const uint32_t* GetOffsets() const {
+    return reinterpret_cast<const uint32_t*>(GetYs() + point_count);
+  }
+  uint8_t* GetComponents() {
+    return reinterpret_cast<uint8_t*>(GetOffsets() + component_count);
+  }
+  const uint8_t* GetComponents() const {
+    return reinterpret_cast<const uint8_t*>(GetOffsets() + component_count);
+  }
+
+  static size_t GetAllocationSize(size_t point_count, size_t component_count) {
+    return sizeof(Storage) + point_count * 2u * sizeof(Scalar) +
+           component_count * (sizeof(uint32_t) + 1u);
+  }
+
+  static void Delete(Storage* storage) {
+    storage->~Storage();
+    // Some of our target environments do not have a sized delete, see
+    // |DlVertices|.
+    ::operator delete(storage);
+  }
+
+  ComponentType GetComponentType(size_t index) const {
+    return static_cast<ComponentType>(GetComponents()[index] &
+                                      ~kClosedContourBit);
+  }
+
+  Point GetPoint(size_t index) const {
+    return Point(GetXs()[index], GetYs()[index]);
+  }
+
+  LinearPathComponent GetLinear(size_t offset) const {
+    return LinearPathComponent(GetPoint(offset - 1), GetPoint(offset));
+  }
+
+  QuadraticPathComponent GetQuadratic(size_t offset) const {
+    return QuadraticPathComponent(GetPoint(offset - 1), GetPoint(offset),
+                                  GetPoint(offset + 1));
+  }
+
+  CubicPathComponent GetCubic(size_t offset) const {
+    return CubicPathComponent(GetPoint(offset - 1), GetPoint(offset),
+                              GetPoint(offset + 1), GetPoint(offset + 2));
+  }
+
+  ContourComponent GetContour(size_t offset, size_t index) const {
+    bool closed = (GetComponents()[index] & kClosedContourBit) != 0u;
+    return ContourComponent(GetPoint(offset),
+                            closed ? Point(0, 0) : Point(1, 1));
+  }
+
+  /// The offset of the first stored point of the component at |index|.
+  size_t GetStorageOffset(size_t index) const { return GetOffsets()[index]; }
+
+  /// Whether the path is a single contour whose points, including the
+  /// control points of its curves, form a convex polygon. As a curve never
+  /// crosses a line more often than its control polygon, the contour is then
+  /// convex as well.
+  Convexity ComputeConvexity() const;
+
+  FillType fill;
+  Convexity convexity;
+  std::optional<Rect> bounds;
+  size_t point_count;
+  size_t component_count;
+  bool has_curves = false;
+
+  // Computed on first use by |GetContentHash|, zero until then.
+  mutable std::atomic<size_t> content_hash = 0u;
+
+  // The polyline last generated by |CreatePolyline|. It is only retained
+  // when the same scale is requested twice in a row, so paths that are
+  // flattened once do not pay for the copy.
+  mutable std::mutex polyline_mutex;
+  mutable std::optional<Scalar> polyline_scale;
+  mutable bool has_polyline = false;
+  mutable std::vector<Point> polyline_points;
+  mutable std::vector<PolylineContour> polyline_contours;
+};
+
+Convexity Path::Storage::ComputeConvexity() const {
+  // The points of the only contour that has segments. Trailing empty
+  // contours do not affect the fill.
+  size_t start = 0u;
+  size_t end = 0u;
+  for (size_t i = 0; i < component_count; i++) {
+    if (GetComponentType(i) != ComponentType::kContour ||
+        i + 1 == component_count ||
+        GetComponentType(i + 1) == ComponentType::kContour) {
+      continue;
+    }
+    if (end != 0u) {
+      return Convexity::kUnknown;
+    }
+    start = GetStorageOffset(i);
+    end = point_count;
+    for (size_t j = i + 1; j < component_count; j++) {
+      if (GetComponentType(j) == ComponentType::kContour) {
+        end = GetStorageOffset(j);
+        break;
+      }
+    }
+  }
+  if (end - start < 3u) {
+    return Convexity::kUnknown;
+  }
+
+  // The polygon is implicitly closed. It is convex if it always turns the
+  // same way and its edges change horizontal and vertical direction no more
+  // than twice each, which rules out polygons that wind more than once.
+  const size_t count = end - start;
+  Scalar turn = 0;
+  std::optional<Vector2> first_edge;
+  std::optional<Vector2> previous_edge;
+  int x_changes = 0;
+  int y_changes = 0;
+  Scalar last_dx = 0;
+  Scalar last_dy = 0;
+  auto add_edge = [&](Vector2 edge) {
+    if (previous_edge.has_value()) {
+      Scalar cross = previous_edge->Cross(edge);
+      if (cross == 0 && previous_edge->Dot(edge) < 0) {
+        return false;
+      }
+      if (cross != 0) {
+        if (turn != 0 && (cross > 0) != (turn > 0)) {
+          return false;
+        }
+        turn = cross;
+      }
+    }
+    if (edge.x != 0) {
+      x_changes += last_dx != 0 && (edge.x > 0) != (last_dx > 0);
+      last_dx = edge.x;
+    }
+    if (edge.y != 0) {
+      y_changes += last_dy != 0 && (edge.y > 0) != (last_dy > 0);
+      last_dy = edge.y;
+    }
+    previous_edge = edge;
+    return x_changes <= 2 && y_changes <= 2;
+  };
+  for (size_t i = 0; i < count; i++) {
+    Vector2 edge = GetPoint(start + (i + 1) % count) - GetPoint(start + i);
+    if (edge.IsZero()) {
+      continue;
+    }
+    if (!first_edge.has_value()) {
+      first_edge = edge;
+    }
+    if (!add_edge(edge)) {
+      return Convexity::kUnknown;
+    }
+  }
+  // The turn back into the first edge.
+  if (!first_edge.has_value() || !add_edge(first_edge.value()) || turn == 0) {
+    return Convexity::kUnknown;
+  }
+  return Convexity::kConvex;
+}
+
+Path::Path() {
+  static const std::shared_ptr<const Storage> empty_storage(
+      new (::operator new(Storage::GetAllocationSize(0u, 0u)))
+          Storage(FillType::kNonZero, Convexity::kUnknown, std::nullopt, 0u,
+                  0u),
+      Storage::Delete);
+  data_ = empty_storage;
+}
+
+Path::Path(const Data& data) {
+  const auto& components = data.components;
+  size_t point_count = 0u;
+  for (auto component : components) {
+    point_count += StoredPointCount(component);
+  }
+  void* allocation = ::operator new(
+      Storage::GetAllocationSize(point_count, components.size()));
+  auto* storage =
+      new (allocation) Storage(data.fill, data.convexity, data.bounds,
+                               point_count, components.size());
+
+  Scalar* xs = storage->GetXs();
+  Scalar* ys = storage->GetYs();
+  uint32_t* offsets = storage->GetOffsets();
+  uint8_t* types = storage->GetComponents();
+  size_t data_offset = 0u;
+  size_t storage_offset = 0u;
+  FML_DCHECK(components.empty() ||
+             components.front() == ComponentType::kContour);
+  for (size_t i = 0; i < components.size(); i++) {
+    auto component = components[i];
+    types[i] = static_cast<uint8_t>(component);
+    offsets[i] = static_cast<uint32_t>(storage_offset);
+    // The builder repeats the start point of every segment, which is the
+    // end point of the component before it.
+    size_t skipped = 1u;
+    switch (component) {
+      case ComponentType::kContour:
+        if (data.points[data_offset + 1] == Point(0, 0)) {
+          types[i] |= kClosedContourBit;
+        }
+        skipped = 0u;
+        break;
+      case ComponentType::kQuadratic:
+      case ComponentType::kCubic:
+        storage->has_curves = true;
+        break;
+      case ComponentType::kLinear:
+        break;
+    }
+    for (size_t j = 0; j < StoredPointCount(component); j++) {
+      const Point& point = data.points[data_offset + skipped + j];
+      xs[storage_offset + j] = point.x;
+      ys[storage_offset + j] = point.y;
+    }
+    data_offset += VerbToOffset(component);
+    storage_offset += StoredPointCount(component);
+  }
+  if (storage->convexity == Convexity::kUnknown) {
+    storage->convexity = storage->ComputeConvexity();
+  }
+
+  data_.reset(storage, Storage::Delete);
+}
 
 Path::~Path() = default;
 
@@ -32,12 +317,12 @@ std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
 
 size_t Path::GetComponentCount(std::optional<ComponentType> type) const {
   if (!type.has_value()) {
-    return data_->components.size();
+    return data_->component_count;
   }
   auto type_value = type.value();
   size_t count = 0u;
-  for (const auto& component : data_->components) {
-    if (component == type_value) {
+  for (size_t i = 0; i < data_->component_count; i++) {
+    if (data_->GetComponentType(i) == type_value) {
       count++;
     }
   }
@@ -53,57 +338,48 @@ bool Path::IsConvex() const {
 }
 
 bool Path::IsEmpty() const {
-  return data_->points.empty() ||
-         (data_->components.size() == 1 &&
-          data_->components[0] == ComponentType::kContour);
+  return data_->point_count == 0u ||
+         (data_->component_count == 1 &&
+          data_->GetComponentType(0) == ComponentType::kContour);
 }
 
 void Path::WritePolyline(Scalar scale, VertexWriter& writer) const {
-  auto& path_components = data_->components;
-  auto& path_points = data_->points;
+  const Storage& storage = *data_;
   bool started_contour = false;
   bool first_point = true;
 
   size_t storage_offset = 0u;
-  for (size_t component_i = 0; component_i < path_components.size();
+  for (size_t component_i = 0; component_i < storage.component_count;
        component_i++) {
-    const auto& path_component = path_components[component_i];
+    const auto path_component = storage.GetComponentType(component_i);
     switch (path_component) {
       case ComponentType::kLinear: {
-        const LinearPathComponent* linear =
-            reinterpret_cast<const LinearPathComponent*>(
-                &path_points[storage_offset]);
         if (first_point) {
-          writer.Write(linear->p1);
+          writer.Write(storage.GetPoint(storage_offset - 1));
           first_point = false;
         }
-        writer.Write(linear->p2);
+        writer.Write(storage.GetPoint(storage_offset));
         break;
       }
       case ComponentType::kQuadratic: {
-        const QuadraticPathComponent* quad =
-            reinterpret_cast<const QuadraticPathComponent*>(
-                &path_points[storage_offset]);
         if (first_point) {
-          writer.Write(quad->p1);
+          writer.Write(storage.GetPoint(storage_offset - 1));
           first_point = false;
         }
-        quad->ToLinearPathComponents(scale, writer);
+        storage.GetQuadratic(storage_offset)
+            .ToLinearPathComponents(scale, writer);
         break;
       }
       case ComponentType::kCubic: {
-        const CubicPathComponent* cubic =
-            reinterpret_cast<const CubicPathComponent*>(
-                &path_points[storage_offset]);
         if (first_point) {
-          writer.Write(cubic->p1);
+          writer.Write(storage.GetPoint(storage_offset - 1));
           first_point = false;
         }
-        cubic->ToLinearPathComponents(scale, writer);
+        storage.GetCubic(storage_offset).ToLinearPathComponents(scale, writer);
         break;
       }
       case Path::ComponentType::kContour:
-        if (component_i == path_components.size() - 1) {
+        if (component_i == storage.component_count - 1) {
           // If the last component is a contour, that means it's an empty
           // contour, so skip it.
           continue;
@@ -119,88 +395,111 @@ void Path::WritePolyline(Scalar scale, VertexWriter& writer) const {
         started_contour = true;
         first_point = true;
     }
-    storage_offset += VerbToOffset(path_component);
+    storage_offset += StoredPointCount(path_component);
   }
   if (started_contour) {
     writer.EndContour();
   }
 }
 
+void Path::EnumerateComponents(
+    const Applier<LinearPathComponent>& linear_applier,
+    const Applier<QuadraticPathComponent>& quad_applier,
+    const Applier<CubicPathComponent>& cubic_applier,
+    const Applier<ContourComponent>& contour_applier) const {
+  const Storage& storage = *data_;
+  size_t storage_offset = 0u;
+  for (size_t i = 0; i < storage.component_count; i++) {
+    const auto component = storage.GetComponentType(i);
+    switch (component) {
+      case ComponentType::kLinear:
+        if (linear_applier) {
+          linear_applier(i, storage.GetLinear(storage_offset));
+        }
+        break;
+      case ComponentType::kQuadratic:
+        if (quad_applier) {
+          quad_applier(i, storage.GetQuadratic(storage_offset));
+        }
+        break;
+      case ComponentType::kCubic:
+        if (cubic_applier) {
+          cubic_applier(i, storage.GetCubic(storage_offset));
+        }
+        break;
+      case ComponentType::kContour:
+        if (contour_applier) {
+          contour_applier(i, storage.GetContour(storage_offset, i));
+        }
+        break;
+    }
+    storage_offset += StoredPointCount(component);
+  }
+}
+
 bool Path::GetLinearComponentAtIndex(size_t index,
                                      LinearPathComponent& linear) const {
-  auto& components = data_->components;
-  if (index >= components.size() ||
-      components[index] != ComponentType::kLinear) {
+  if (index >= data_->component_count ||
+      data_->GetComponentType(index) != ComponentType::kLinear) {
     return false;
   }
-
-  size_t storage_offset = 0u;
-  for (auto i = 0u; i < index; i++) {
-    storage_offset += VerbToOffset(components[i]);
-  }
-  auto& points = data_->points;
-  linear =
-      LinearPathComponent(points[storage_offset], points[storage_offset + 1]);
+  linear = data_->GetLinear(data_->GetStorageOffset(index));
   return true;
 }
 
 bool Path::GetQuadraticComponentAtIndex(
     size_t index,
     QuadraticPathComponent& quadratic) const {
-  auto& components = data_->components;
-  if (index >= components.size() ||
-      components[index] != ComponentType::kQuadratic) {
+  if (index >= data_->component_count ||
+      data_->GetComponentType(index) != ComponentType::kQuadratic) {
     return false;
   }
-
-  size_t storage_offset = 0u;
-  for (auto i = 0u; i < index; i++) {
-    storage_offset += VerbToOffset(components[i]);
-  }
-  auto& points = data_->points;
-
-  quadratic =
-      QuadraticPathComponent(points[storage_offset], points[storage_offset + 1],
-                             points[storage_offset + 2]);
+  quadratic = data_->GetQuadratic(data_->GetStorageOffset(index));
   return true;
 }
 
 bool Path::GetCubicComponentAtIndex(size_t index,
                                     CubicPathComponent& cubic) const {
-  auto& components = data_->components;
-  if (index >= components.size() ||
-      components[index] != ComponentType::kCubic) {
+  if (index >= data_->component_count ||
+      data_->GetComponentType(index) != ComponentType::kCubic) {
     return false;
   }
-
-  size_t storage_offset = 0u;
-  for (auto i = 0u; i < index; i++) {
-    storage_offset += VerbToOffset(components[i]);
-  }
-  auto& points = data_->points;
-
-  cubic = CubicPathComponent(points[storage_offset], points[storage_offset + 1],
-                             points[storage_offset + 2],
-                             points[storage_offset + 3]);
+  cubic = data_->GetCubic(data_->GetStorageOffset(index));
   return true;
 }
 
 bool Path::GetContourComponentAtIndex(size_t index,
                                       ContourComponent& move) const {
-  auto& components = data_->components;
-  if (index >= components.size() ||
-      components[index] != ComponentType::kContour) {
+  if (index >= data_->component_count ||
+      data_->GetComponentType(index) != ComponentType::kContour) {
     return false;
   }
+  move = data_->GetContour(data_->GetStorageOffset(index), index);
+  return true;
+}
 
+void Path::AppendTo(Data& data) const {
+  const Storage& storage = *data_;
+  auto& points = data.points;
+  auto& components = data.components;
+  points.reserve(points.size() + storage.point_count * 2u);
+  components.reserve(components.size() + storage.component_count);
   size_t storage_offset = 0u;
-  for (auto i = 0u; i < index; i++) {
-    storage_offset += VerbToOffset(components[i]);
+  for (size_t i = 0; i < storage.component_count; i++) {
+    const auto component = storage.GetComponentType(i);
+    if (component == ComponentType::kContour) {
+      ContourComponent contour = storage.GetContour(storage_offset, i);
+      points.push_back(contour.destination);
+      points.push_back(contour.closed);
+    } else {
+      // Each segment starts at the end point of the component before it.
+      for (size_t j = 0; j <= StoredPointCount(component); j++) {
+        points.push_back(storage.GetPoint(storage_offset + j - 1));
+      }
+    }
+    components.push_back(component);
+    storage_offset += StoredPointCount(component);
   }
-  auto& points = data_->points;
-
-  move = ContourComponent(points[storage_offset], points[storage_offset + 1]);
-  return true;
 }
 
 Path::Polyline::Polyline(Path::Polyline::PointBufferPtr point_buffer,
@@ -227,8 +526,7 @@ void Path::EndContour(
     Polyline& polyline,
     size_t component_index,
     std::vector<PolylineContour::Component>& poly_components) const {
-  auto& path_components = data_->components;
-  auto& path_points = data_->points;
+  const Storage& storage = *data_;
   // Whenever a contour has ended, extract the exact end direction from
   // the last component.
   if (polyline.contours.empty() || component_index == 0) {
@@ -241,15 +539,13 @@ void Path::EndContour(
   poly_components.clear();
 
   size_t previous_index = component_index - 1;
-  storage_offset -= VerbToOffset(path_components[previous_index]);
+  storage_offset -= StoredPointCount(storage.GetComponentType(previous_index));
 
   while (previous_index >= 0 && storage_offset >= 0) {
-    const auto& path_component = path_components[previous_index];
+    const auto path_component = storage.GetComponentType(previous_index);
     switch (path_component) {
       case ComponentType::kLinear: {
-        auto* linear = reinterpret_cast<const LinearPathComponent*>(
-            &path_points[storage_offset]);
-        auto maybe_end = linear->GetEndDirection();
+        auto maybe_end = storage.GetLinear(storage_offset).GetEndDirection();
         if (maybe_end.has_value()) {
           contour.end_direction = maybe_end.value();
           return;
@@ -257,9 +553,8 @@ void Path::EndContour(
         break;
       }
       case ComponentType::kQuadratic: {
-        auto* quad = reinterpret_cast<const QuadraticPathComponent*>(
-            &path_points[storage_offset]);
-        auto maybe_end = quad->GetEndDirection();
+        auto maybe_end =
+            storage.GetQuadratic(storage_offset).GetEndDirection();
         if (maybe_end.has_value()) {
           contour.end_direction = maybe_end.value();
           return;
@@ -267,9 +562,7 @@ void Path::EndContour(
         break;
       }
       case ComponentType::kCubic: {
-        auto* cubic = reinterpret_cast<const CubicPathComponent*>(
-            &path_points[storage_offset]);
-        auto maybe_end = cubic->GetEndDirection();
+        auto maybe_end = storage.GetCubic(storage_offset).GetEndDirection();
         if (maybe_end.has_value()) {
           contour.end_direction = maybe_end.value();
           return;
@@ -281,7 +574,7 @@ void Path::EndContour(
         return;
       };
     }
-    storage_offset -= VerbToOffset(path_component);
+    storage_offset -= StoredPointCount(path_component);
     previous_index--;
   }
 };
@@ -291,27 +584,63 @@ Path::Polyline Path::CreatePolyline(
     Path::Polyline::PointBufferPtr point_buffer,
     Path::Polyline::ReclaimPointBufferCallback reclaim) const {
   Polyline polyline(std::move(point_buffer), std::move(reclaim));
+  // Flattening a path without curves is no more expensive than copying it.
+  if (!data_->has_curves || !polyline.points->empty()) {
+    GeneratePolyline(scale, polyline);
+    return polyline;
+  }
 
-  auto& path_components = data_->components;
-  auto& path_points = data_->points;
+  const Storage& storage = *data_;
+  bool retain = false;
+  {
+    std::scoped_lock lock(storage.polyline_mutex);
+    if (storage.polyline_scale == scale) {
+      if (storage.has_polyline) {
+        *polyline.points = storage.polyline_points;
+        polyline.contours = storage.polyline_contours;
+        return polyline;
+      }
+      retain = true;
+    } else {
+      storage.polyline_scale = scale;
+      storage.has_polyline = false;
+      storage.polyline_points.clear();
+      storage.polyline_contours.clear();
+    }
+  }
+
+  GeneratePolyline(scale, polyline);
+
+  if (retain) {
+    std::scoped_lock lock(storage.polyline_mutex);
+    if (storage.polyline_scale == scale && !storage.has_polyline) {
+      storage.polyline_points = *polyline.points;
+      storage.polyline_contours = polyline.contours;
+      storage.has_polyline = true;
+    }
+  }
+  return polyline;
+}
+
+void Path::GeneratePolyline(Scalar scale, Polyline& polyline) const {
+  const Storage& storage = *data_;
   std::optional<Vector2> start_direction;
   std::vector<PolylineContour::Component> poly_components;
   size_t storage_offset = 0u;
   size_t component_i = 0;
 
-  for (; component_i < path_components.size(); component_i++) {
-    auto path_component = path_components[component_i];
+  for (; component_i < storage.component_count; component_i++) {
+    auto path_component = storage.GetComponentType(component_i);
     switch (path_component) {
       case ComponentType::kLinear: {
         poly_components.push_back({
             .component_start_index = polyline.points->size() - 1,
             .is_curve = false,
         });
-        auto* linear = reinterpret_cast<const LinearPathComponent*>(
-            &path_points[storage_offset]);
-        linear->AppendPolylinePoints(*polyline.points);
+        auto linear = storage.GetLinear(storage_offset);
+        linear.AppendPolylinePoints(*polyline.points);
         if (!start_direction.has_value()) {
-          start_direction = linear->GetStartDirection();
+          start_direction = linear.GetStartDirection();
         }
         break;
       }
@@ -320,11 +649,10 @@ Path::Polyline Path::CreatePolyline(
             .component_start_index = polyline.points->size() - 1,
             .is_curve = true,
         });
-        auto* quad = reinterpret_cast<const QuadraticPathComponent*>(
-            &path_points[storage_offset]);
-        quad->AppendPolylinePoints(scale, *polyline.points);
+        auto quad = storage.GetQuadratic(storage_offset);
+        quad.AppendPolylinePoints(scale, *polyline.points);
         if (!start_direction.has_value()) {
-          start_direction = quad->GetStartDirection();
+          start_direction = quad.GetStartDirection();
         }
         break;
       }
@@ -333,16 +661,15 @@ Path::Polyline Path::CreatePolyline(
             .component_start_index = polyline.points->size() - 1,
             .is_curve = true,
         });
-        auto* cubic = reinterpret_cast<const CubicPathComponent*>(
-            &path_points[storage_offset]);
-        cubic->AppendPolylinePoints(scale, *polyline.points);
+        auto cubic = storage.GetCubic(storage_offset);
+        cubic.AppendPolylinePoints(scale, *polyline.points);
         if (!start_direction.has_value()) {
-          start_direction = cubic->GetStartDirection();
+          start_direction = cubic.GetStartDirection();
         }
         break;
       }
       case ComponentType::kContour:
-        if (component_i == path_components.size() - 1) {
+        if (component_i == storage.component_count - 1) {
           // If the last component is a contour, that means it's an empty
           // contour, so skip it.
           break;
@@ -354,25 +681,26 @@ Path::Polyline Path::CreatePolyline(
         }
         EndContour(storage_offset, polyline, component_i, poly_components);
 
-        auto* contour = reinterpret_cast<const ContourComponent*>(
-            &path_points[storage_offset]);
+        auto contour = storage.GetContour(storage_offset, component_i);
         polyline.contours.push_back(PolylineContour{
             .start_index = polyline.points->size(),  //
-            .is_closed = contour->IsClosed(),        //
+            .is_closed = contour.IsClosed(),         //
             .start_direction = Vector2(0, -1),       //
             .components = poly_components            //
         });
 
-        polyline.points->push_back(contour->destination);
+        polyline.points->push_back(contour.destination);
         break;
     }
-    storage_offset += VerbToOffset(path_component);
+    storage_offset += StoredPointCount(path_component);
   }
 
   // Subtract the last storage offset increment so that the storage lookup is
   // correct, including potentially an empty contour as well.
-  if (component_i > 0 && path_components.back() == ComponentType::kContour) {
-    storage_offset -= VerbToOffset(ComponentType::kContour);
+  if (component_i > 0 &&
+      storage.GetComponentType(storage.component_count - 1) ==
+          ComponentType::kContour) {
+    storage_offset -= StoredPointCount(ComponentType::kContour);
     component_i--;
   }
 
@@ -381,7 +709,6 @@ Path::Polyline Path::CreatePolyline(
         start_direction.value_or(Vector2(0, -1));
   }
   EndContour(storage_offset, polyline, component_i, poly_components);
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
@@ -397,4 +724,51 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
   return bounds->TransformBounds(transform);
 }
 
+size_t Path::GetContentHash() const {
+  size_t hash = data_->content_hash.load(std::memory_order_relaxed);
+  if (hash != 0u) {
+    return hash;
+  }
+  const Storage& storage = *data_;
+  hash = fml::HashCombine(storage.fill, storage.convexity,
+                          storage.component_count, storage.point_count);
+  // Hashing each scalar with std::hash would cost more than flattening
+  // simple paths, so the points are mixed in one word at a time instead.
+  const Scalar* xs = storage.GetXs();
+  const Scalar* ys = storage.GetYs();
+  uint64_t points_hash = 0u;
+  for (size_t i = 0; i < storage.point_count; i++) {
+    uint64_t bits =
+        (static_cast<uint64_t>(ScalarBits(xs[i])) << 32) | ScalarBits(ys[i]);
+    points_hash = (points_hash ^ bits) * 0x9e3779b97f4a7c15ull;
+    points_hash ^= points_hash >> 32;
+  }
+  const uint8_t* components = storage.GetComponents();
+  uint64_t components_hash = 0u;
+  for (size_t i = 0; i < storage.component_count; i++) {
+    components_hash = components_hash * 31u + components[i];
+  }
+  fml::HashCombineSeed(hash, points_hash, components_hash);
+  // Zero is reserved for "not yet computed".
+  hash = hash == 0u ? 1u : hash;
+  data_->content_hash.store(hash, std::memory_order_relaxed);
+  return hash;
+}
+
+bool Path::HasSameContent(const Path& other) const {
+  if (data_ == other.data_) {
+    return true;
+  }
+  const Storage& a = *data_;
+  const Storage& b = *other.data_;
+  if (a.fill != b.fill || a.convexity != b.convexity ||
+      a.component_count != b.component_count ||
+      a.point_count != b.point_count) {
+    return false;
+  }
+  return std::equal(a.GetXs(), a.GetXs() + a.point_count * 2u, b.GetXs()) &&
+         std::equal(a.GetComponents(), a.GetComponents() + a.component_count,
+                    b.GetComponents());
+}
+
 }  // namespace impeller
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_GEOMETRY_PATH_H_
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <tuple>
 #include <vector>
@@ -49,6 +50,13 @@ enum class Convexity {
 ///             Paths are externally immutable once created, Creating paths must
 ///             be done using a path builder.
 ///
+///             The data of a path is packed into a single allocation that is
+///             shared by all copies of the path. The convexity of a path that
+///             the builder does not know to be convex is computed when it is
+///             packed. The most recently flattened polyline of a path with
+///             curves is retained along with it, so repeatedly flattening the
+///             same path at the same scale only copies the points.
+///
 class Path {
  public:
   enum class ComponentType {
@@ -141,6 +149,9 @@ class Path {
     ReclaimPointBufferCallback reclaim_points_;
   };
 
+  template <class T>
+  using Applier = std::function<void(size_t index, const T& component)>;
+
   Path();
 
   ~Path();
@@ -153,6 +164,15 @@ class Path {
 
   bool IsEmpty() const;
 
+  /// Invokes the applier for each component of the path in order, with the
+  /// index of the component. Appliers may be null for the component types
+  /// that are of no interest.
+  void EnumerateComponents(
+      const Applier<LinearPathComponent>& linear_applier,
+      const Applier<QuadraticPathComponent>& quad_applier,
+      const Applier<CubicPathComponent>& cubic_applier,
+      const Applier<ContourComponent>& contour_applier) const;
+
   bool GetLinearComponentAtIndex(size_t index,
                                  LinearPathComponent& linear) const;
 
@@ -176,16 +196,21 @@ class Path {
           std::make_unique<std::vector<Point>>(),
       Polyline::ReclaimPointBufferCallback reclaim = nullptr) const;
 
-  void EndContour(
-      size_t storage_offset,
-      Polyline& polyline,
-      size_t component_index,
-      std::vector<PolylineContour::Component>& poly_components) const;
-
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
 
+  /// A hash of the fill type, convexity, components and points of this path.
+  ///
+  /// Paths with bitwise identical content have the same hash regardless of
+  /// whether they share storage. The hash is computed on first use and
+  /// retained by the (immutable) path data.
+  size_t GetContentHash() const;
+
+  /// Whether this path has the same fill type, convexity, components and
+  /// points as |other|.
+  bool HasSameContent(const Path& other) const;
+
   /// Generate a polyline into the temporary storage held by the [writer].
   ///
   /// It is suitable to use the max basis length of the matrix used to transform
@@ -196,15 +221,10 @@ class Path {
  private:
   friend class PathBuilder;
 
-  // All of the data for the path is stored in this structure which is
-  // held by a shared_ptr. Since they all share the structure, the
-  // copy constructor for Path is very cheap and we don't need to deal
-  // with shared pointers for Path fields and method arguments.
-  //
-  // PathBuilder also uses this structure to accumulate the path data
-  // but the Path constructor used in |TakePath()| will clone the
-  // structure to prevent sharing and future modifications within the
-  // builder from affecting the existing taken paths.
+  // PathBuilder accumulates the path data in this structure, which keeps
+  // every point of every component in one growable vector. It is packed
+  // into a |Storage| whenever a path is copied or taken from the builder, so
+  // later modifications within the builder do not affect the taken paths.
   struct Data {
     Data() = default;
 
@@ -221,9 +241,25 @@ class Path {
     std::vector<ComponentType> components;
   };
 
-  explicit Path(Data data);
+  // The immutable data of a path, defined in path.cc. Since all copies of a
+  // path share it, the copy constructor for Path is very cheap and we don't
+  // need to deal with shared pointers for Path fields and method arguments.
+  struct Storage;
+
+  explicit Path(const Data& data);
+
+  /// Appends the components of this path to the builder data.
+  void AppendTo(Data& data) const;
+
+  void GeneratePolyline(Scalar scale, Polyline& polyline) const;
+
+  void EndContour(
+      size_t storage_offset,
+      Polyline& polyline,
+      size_t component_index,
+      std::vector<PolylineContour::Component>& poly_components) const;
 
-  std::shared_ptr<const Data> data_;
+  std::shared_ptr<const Storage> data_;
 };
 
 static_assert(sizeof(Path) == sizeof(std::shared_ptr<struct Anonymous>));
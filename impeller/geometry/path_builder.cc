@@ -18,14 +18,21 @@ PathBuilder::~PathBuilder() = default;
 
 Path PathBuilder::CopyPath(FillType fill) {
   prototype_.fill = fill;
+  UpdateBounds();
   return Path(prototype_);
 }
 
 Path PathBuilder::TakePath(FillType fill) {
   prototype_.fill = fill;
   UpdateBounds();
-  current_contour_location_ = 0u;
-  return Path(std::move(prototype_));
+  Path path(prototype_);
+  // The path packs its own copy of the data, so the buffers are kept for
+  // building the next path. Like a new builder it starts with a contour, at
+  // the current position.
+  prototype_.points.clear();
+  prototype_.components.clear();
+  AddContourComponent(current_);
+  return path;
 }
 
 void PathBuilder::Reserve(size_t point_size, size_t verb_size) {
@@ -433,21 +440,18 @@ PathBuilder& PathBuilder::AddLine(const Point& p1, const Point& p2) {
 }
 
 PathBuilder& PathBuilder::AddPath(const Path& path) {
-  auto& points = prototype_.points;
-  auto& components = prototype_.components;
-
-  points.insert(points.end(), path.data_->points.begin(),
-                path.data_->points.end());
-  components.insert(components.end(), path.data_->components.begin(),
-                    path.data_->components.end());
+  size_t source_offset = prototype_.points.size();
+  size_t source_index = prototype_.components.size();
+  path.AppendTo(prototype_);
 
-  size_t source_offset = points.size();
-  for (auto component : path.data_->components) {
-    if (component == Path::ComponentType::kContour) {
+  auto& components = prototype_.components;
+  for (; source_index < components.size(); source_index++) {
+    if (components[source_index] == Path::ComponentType::kContour) {
       current_contour_location_ = source_offset;
     }
-    source_offset += Path::VerbToOffset(component);
+    source_offset += Path::VerbToOffset(components[source_index]);
   }
+  prototype_.bounds.reset();
   return *this;
 }
 
@@ -535,6 +539,13 @@ std::optional<std::pair<Point, Point>> PathBuilder::GetMinMaxCoveragePoints()
     }
   };
 
+  // Curves stay within the hull of their points, so their extrema are only
+  // solved for when a control point is outside of the bounds so far.
+  auto contains = [&min, &max](const Point& point) {
+    return point.x >= min->x && point.y >= min->y &&  //
+           point.x <= max->x && point.y <= max->y;
+  };
+
   size_t storage_offset = 0u;
   for (const auto& component : prototype_.components) {
     switch (component) {
@@ -545,21 +556,32 @@ std::optional<std::pair<Point, Point>> PathBuilder::GetMinMaxCoveragePoints()
         clamp(linear->p2);
         break;
       }
-      case Path::ComponentType::kQuadratic:
-        for (const auto& extrema :
-             reinterpret_cast<const QuadraticPathComponent*>(
-                 &points[storage_offset])
-                 ->Extrema()) {
+      case Path::ComponentType::kQuadratic: {
+        auto* quad = reinterpret_cast<const QuadraticPathComponent*>(
+            &points[storage_offset]);
+        clamp(quad->p1);
+        clamp(quad->p2);
+        if (contains(quad->cp)) {
+          break;
+        }
+        for (const auto& extrema : quad->Extrema()) {
           clamp(extrema);
         }
         break;
-      case Path::ComponentType::kCubic:
-        for (const auto& extrema : reinterpret_cast<const CubicPathComponent*>(
-                                       &points[storage_offset])
-                                       ->Extrema()) {
+      }
+      case Path::ComponentType::kCubic: {
+        auto* cubic = reinterpret_cast<const CubicPathComponent*>(
+            &points[storage_offset]);
+        clamp(cubic->p1);
+        clamp(cubic->p2);
+        if (contains(cubic->cp1) && contains(cubic->cp2)) {
+          break;
+        }
+        for (const auto& extrema : cubic->Extrema()) {
           clamp(extrema);
         }
         break;
+      }
       case Path::ComponentType::kContour:
         break;
     }
@@ -28,6 +28,13 @@ class PathBuilder {
 
   Path CopyPath(FillType fill = FillType::kNonZero);
 
+  /// @brief Returns the path built so far and resets the builder to build the
+  ///        next path, keeping its buffers.
+  ///
+  ///        Like a new builder, the reset builder starts with a contour, but
+  ///        the contour is at the current position rather than the origin.
+  ///        Segments added before the next |MoveTo| continue from the end of
+  ///        the taken path.
   Path TakePath(FillType fill = FillType::kNonZero);
 
   /// @brief Reserve [point_size] points and [verb_size] verbs in the underlying
@@ -4,8 +4,10 @@
 
 #include "path_component.h"
 
+#include <algorithm>
 #include <cmath>
 
+#include "impeller/geometry/simd.h"
 #include "impeller/geometry/wangs_formula.h"
 
 namespace impeller {
@@ -68,6 +70,12 @@ void VertexWriter::Write(Point point) {
   points_.push_back(point);
 }
 
+Point* VertexWriter::Append(size_t count) {
+  const size_t start = points_.size();
+  points_.resize(start + count);
+  return points_.data() + start;
+}
+
 /*
  *  Based on: https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Specific_cases
  */
@@ -112,6 +120,109 @@ static inline Scalar CubicSolveDerivative(Scalar t,
          3 * p3 * t * t;
 }
 
+// The number of points strictly between the ends of a curve that is
+// subdivided into |line_count| lines.
+static inline size_t InteriorPointCount(Scalar line_count) {
+  return line_count > 1 ? static_cast<size_t>(line_count) - 1u : 0u;
+}
+
+// The SIMD equivalents of |QuadraticSolve| and |CubicSolve|, which perform the
+// same operations in the same order for each of the four parameters.
+static inline Float4 QuadraticSolve(const Float4& t,
+                                    Scalar p0,
+                                    Scalar p1,
+                                    Scalar p2) {
+  Float4 one_minus_t = 1 - t;
+  return one_minus_t * one_minus_t * p0 +  //
+         2 * one_minus_t * t * p1 +        //
+         t * t * p2;
+}
+
+static inline Float4 CubicSolve(const Float4& t,
+                                Scalar p0,
+                                Scalar p1,
+                                Scalar p2,
+                                Scalar p3) {
+  Float4 one_minus_t = 1 - t;
+  return one_minus_t * one_minus_t * one_minus_t * p0 +  //
+         3 * one_minus_t * one_minus_t * t * p1 +        //
+         3 * one_minus_t * t * t * p2 +                  //
+         t * t * t * p3;
+}
+
+static inline void SolveLanes(const QuadraticPathComponent& quad,
+                              const Float4& t,
+                              Point* points) {
+  Float4::StorePoints(QuadraticSolve(t, quad.p1.x, quad.cp.x, quad.p2.x),
+                      QuadraticSolve(t, quad.p1.y, quad.cp.y, quad.p2.y),
+                      points);
+}
+
+static inline void SolveLanes(const CubicPathComponent& cubic,
+                              const Float4& t,
+                              Point* points) {
+  Float4::StorePoints(
+      CubicSolve(t, cubic.p1.x, cubic.cp1.x, cubic.cp2.x, cubic.p2.x),
+      CubicSolve(t, cubic.p1.y, cubic.cp1.y, cubic.cp2.y, cubic.p2.y),
+      points);
+}
+
+// Writes the points of the curve at the parameters |i| / |line_count| for |i|
+// in [|first|, |first| + |count|) to |points|, four at a time.
+template <typename Curve>
+static void SolveUniform(const Curve& curve,
+                         Scalar line_count,
+                         size_t first,
+                         size_t count,
+                         Point* points) {
+  const Float4 divisor = Float4::Splat(line_count);
+  auto parameters = [&divisor, first](size_t i) {
+    return Float4::Iota(static_cast<Scalar>(first + i)) / divisor;
+  };
+  size_t i = 0u;
+  for (; i + Float4::kLaneCount <= count; i += Float4::kLaneCount) {
+    SolveLanes(curve, parameters(i), points + i);
+  }
+  if (i < count) {
+    Point tail[Float4::kLaneCount];
+    SolveLanes(curve, parameters(i), tail);
+    std::copy(tail, tail + (count - i), points + i);
+  }
+}
+
+// Appends the points of the curve subdivided into |line_count| lines,
+// excluding the start point, to |points|.
+template <typename Curve>
+static void AppendUniform(const Curve& curve,
+                          Scalar line_count,
+                          std::vector<Point>& points) {
+  const size_t interior_count = InteriorPointCount(line_count);
+  const size_t start = points.size();
+  points.resize(start + interior_count + 1u);
+  SolveUniform(curve, line_count, 1u, interior_count, points.data() + start);
+  points.back() = curve.p2;
+}
+
+// Invokes |proc| with the points of the curve subdivided into |line_count|
+// lines, excluding the start point.
+template <typename Curve, typename PointProc>
+static void ProcUniform(const Curve& curve,
+                        Scalar line_count,
+                        const PointProc& proc) {
+  // Points are solved in small batches on the stack.
+  constexpr size_t kBatchSize = 8u * Float4::kLaneCount;
+  Point batch[kBatchSize];
+  const size_t interior_count = InteriorPointCount(line_count);
+  for (size_t first = 1u; first <= interior_count; first += kBatchSize) {
+    const size_t count = std::min(kBatchSize, interior_count + 1u - first);
+    SolveUniform(curve, line_count, first, count, batch);
+    for (size_t i = 0u; i < count; i++) {
+      proc(batch[i]);
+    }
+  }
+  proc(curve.p2);
+}
+
 Point LinearPathComponent::Solve(Scalar time) const {
   return {
       LinearSolve(time, p1.x, p2.x),  // x
@@ -162,29 +273,26 @@ void QuadraticPathComponent::ToLinearPathComponents(
     Scalar scale,
     VertexWriter& writer) const {
   Scalar line_count = std::ceilf(ComputeQuadradicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i += 1) {
-    writer.Write(Solve(i / line_count));
-  }
-  writer.Write(p2);
+  const size_t interior_count = InteriorPointCount(line_count);
+  Point* points = writer.Append(interior_count + 1u);
+  SolveUniform(*this, line_count, 1u, interior_count, points);
+  points[interior_count] = p2;
 }
 
 void QuadraticPathComponent::AppendPolylinePoints(
     Scalar scale_factor,
     std::vector<Point>& points) const {
-  ToLinearPathComponents(scale_factor, [&points](const Point& point) {
-    points.emplace_back(point);
-  });
+  AppendUniform(*this,
+                std::ceilf(ComputeQuadradicSubdivisions(scale_factor, *this)),
+                points);
 }
 
 void QuadraticPathComponent::ToLinearPathComponents(
     Scalar scale_factor,
     const PointProc& proc) const {
-  Scalar line_count =
-      std::ceilf(ComputeQuadradicSubdivisions(scale_factor, *this));
-  for (size_t i = 1; i < line_count; i += 1) {
-    proc(Solve(i / line_count));
-  }
-  proc(p2);
+  ProcUniform(*this,
+              std::ceilf(ComputeQuadradicSubdivisions(scale_factor, *this)),
+              proc);
 }
 
 std::vector<Point> QuadraticPathComponent::Extrema() const {
@@ -229,17 +337,17 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 void CubicPathComponent::AppendPolylinePoints(
     Scalar scale,
     std::vector<Point>& points) const {
-  ToLinearPathComponents(
-      scale, [&points](const Point& point) { points.emplace_back(point); });
+  AppendUniform(*this, std::ceilf(ComputeCubicSubdivisions(scale, *this)),
+                points);
 }
 
 void CubicPathComponent::ToLinearPathComponents(Scalar scale,
                                                 VertexWriter& writer) const {
   Scalar line_count = std::ceilf(ComputeCubicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i++) {
-    writer.Write(Solve(i / line_count));
-  }
-  writer.Write(p2);
+  const size_t interior_count = InteriorPointCount(line_count);
+  Point* points = writer.Append(interior_count + 1u);
+  SolveUniform(*this, line_count, 1u, interior_count, points);
+  points[interior_count] = p2;
 }
 
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
@@ -259,11 +367,8 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
 
 void CubicPathComponent::ToLinearPathComponents(Scalar scale,
                                                 const PointProc& proc) const {
-  Scalar line_count = std::ceilf(ComputeCubicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i++) {
-    proc(Solve(i / line_count));
-  }
-  proc(p2);
+  ProcUniform(*this, std::ceilf(ComputeCubicSubdivisions(scale, *this)),
+              proc);
 }
 
 static inline bool NearEqual(Scalar a, Scalar b, Scalar epsilon) {
@@ -28,6 +28,10 @@ class VertexWriter {
 
   void Write(Point point);
 
+  /// Appends |count| points for the caller to fill in and returns the first
+  /// of them. The pointer is invalidated by the next write.
+  Point* Append(size_t count);
+
  private:
   bool previous_contour_odd_points_ = false;
   size_t contour_start_ = 0u;
@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "flutter/testing/testing.h"
@@ -756,5 +760,371 @@ TEST(PathTest, PathBuilderDoesNotMutateCopiedPaths) {
       false, {23, 42}, "Shift");
 }
 
+TEST(PathTest, ContentHashAndEqualityIgnoreStorage) {
+  auto make_path = [](Scalar x, FillType fill) {
+    return PathBuilder{}
+        .MoveTo({x, 10})
+        .QuadraticCurveTo({20, 20}, {30, 10})
+        .Close()
+        .TakePath(fill);
+  };
+
+  Path path = make_path(10, FillType::kNonZero);
+  Path copy = path;
+  Path rebuilt = make_path(10, FillType::kNonZero);
+  Path moved = make_path(11, FillType::kNonZero);
+  Path odd = make_path(10, FillType::kOdd);
+
+  EXPECT_TRUE(path.HasSameContent(copy));
+  EXPECT_TRUE(path.HasSameContent(rebuilt));
+  EXPECT_EQ(path.GetContentHash(), rebuilt.GetContentHash());
+
+  EXPECT_FALSE(path.HasSameContent(moved));
+  EXPECT_NE(path.GetContentHash(), moved.GetContentHash());
+  EXPECT_FALSE(path.HasSameContent(odd));
+  EXPECT_NE(path.GetContentHash(), odd.GetContentHash());
+}
+
+TEST(PathTest, EnumerateComponentsMatchesIndexedAccess) {
+  Path path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .LineTo({20, 10})
+                  .QuadraticCurveTo({30, 10}, {30, 20})
+                  .CubicCurveTo({30, 30}, {20, 40}, {10, 30})
+                  .Close()
+                  .MoveTo({50, 50})
+                  .LineTo({60, 60})
+                  .TakePath();
+
+  std::vector<Path::ComponentType> types;
+  std::optional<Point> end;
+  path.EnumerateComponents(
+      [&](size_t index, const LinearPathComponent& linear) {
+        types.push_back(Path::ComponentType::kLinear);
+        LinearPathComponent expected;
+        EXPECT_TRUE(path.GetLinearComponentAtIndex(index, expected));
+        EXPECT_EQ(linear, expected);
+        EXPECT_EQ(linear.p1, end);
+        end = linear.p2;
+      },
+      [&](size_t index, const QuadraticPathComponent& quad) {
+        types.push_back(Path::ComponentType::kQuadratic);
+        QuadraticPathComponent expected;
+        EXPECT_TRUE(path.GetQuadraticComponentAtIndex(index, expected));
+        EXPECT_EQ(quad, expected);
+        EXPECT_EQ(quad.p1, end);
+        end = quad.p2;
+      },
+      [&](size_t index, const CubicPathComponent& cubic) {
+        types.push_back(Path::ComponentType::kCubic);
+        CubicPathComponent expected;
+        EXPECT_TRUE(path.GetCubicComponentAtIndex(index, expected));
+        EXPECT_EQ(cubic, expected);
+        EXPECT_EQ(cubic.p1, end);
+        end = cubic.p2;
+      },
+      [&](size_t index, const ContourComponent& contour) {
+        types.push_back(Path::ComponentType::kContour);
+        ContourComponent expected;
+        EXPECT_TRUE(path.GetContourComponentAtIndex(index, expected));
+        EXPECT_EQ(contour, expected);
+        end = contour.destination;
+      });
+
+  using Type = Path::ComponentType;
+  EXPECT_EQ(types, std::vector<Type>({Type::kContour, Type::kLinear,
+                                      Type::kQuadratic, Type::kCubic,
+                                      Type::kLinear, Type::kContour,
+                                      Type::kLinear}));
+  EXPECT_EQ(types.size(), path.GetComponentCount());
+
+  ContourComponent contour;
+  EXPECT_TRUE(path.GetContourComponentAtIndex(0, contour));
+  EXPECT_TRUE(contour.IsClosed());
+  EXPECT_TRUE(path.GetContourComponentAtIndex(5, contour));
+  EXPECT_FALSE(contour.IsClosed());
+  EXPECT_EQ(contour.destination, Point(50, 50));
+
+  // Null appliers skip their component types.
+  size_t cubic_count = 0u;
+  path.EnumerateComponents(
+      nullptr, nullptr,
+      [&cubic_count](size_t index, const CubicPathComponent& cubic) {
+        cubic_count++;
+      },
+      nullptr);
+  EXPECT_EQ(cubic_count, 1u);
+}
+
+TEST(PathTest, AddPathCopiesAllComponents) {
+  Path path = PathBuilder{}
+                  .AddCircle({100, 100}, 50)
+                  .MoveTo({10, 10})
+                  .QuadraticCurveTo({20, 0}, {30, 10})
+                  .LineTo({10, 30})
+                  .TakePath(FillType::kOdd);
+
+  Path copy = PathBuilder{}.AddPath(path).TakePath(FillType::kOdd);
+  EXPECT_EQ(copy.GetBoundingBox(), path.GetBoundingBox());
+
+  // The copy starts with the empty contour of the new builder.
+  ASSERT_EQ(copy.GetComponentCount(), path.GetComponentCount() + 1);
+  for (size_t i = 0; i < path.GetComponentCount(); i++) {
+    LinearPathComponent linear, copied_linear;
+    QuadraticPathComponent quad, copied_quad;
+    CubicPathComponent cubic, copied_cubic;
+    ContourComponent contour, copied_contour;
+    if (path.GetLinearComponentAtIndex(i, linear)) {
+      ASSERT_TRUE(copy.GetLinearComponentAtIndex(i + 1, copied_linear));
+      EXPECT_EQ(linear, copied_linear);
+    } else if (path.GetQuadraticComponentAtIndex(i, quad)) {
+      ASSERT_TRUE(copy.GetQuadraticComponentAtIndex(i + 1, copied_quad));
+      EXPECT_EQ(quad, copied_quad);
+    } else if (path.GetCubicComponentAtIndex(i, cubic)) {
+      ASSERT_TRUE(copy.GetCubicComponentAtIndex(i + 1, copied_cubic));
+      EXPECT_EQ(cubic, copied_cubic);
+    } else {
+      ASSERT_TRUE(path.GetContourComponentAtIndex(i, contour));
+      ASSERT_TRUE(copy.GetContourComponentAtIndex(i + 1, copied_contour));
+      EXPECT_EQ(contour, copied_contour);
+    }
+  }
+}
+
+TEST(PathTest, TakePathLeavesBuilderReadyForNextPath) {
+  PathBuilder builder;
+  Path first = builder.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath();
+  Path second = builder.LineTo({20, 0}).LineTo({20, 20}).Close().TakePath();
+
+  EXPECT_EQ(first.GetComponentCount(Path::ComponentType::kLinear), 4u);
+  EXPECT_EQ(second.GetComponentCount(Path::ComponentType::kLinear), 3u);
+  ContourComponent contour;
+  ASSERT_TRUE(second.GetContourComponentAtIndex(0, contour));
+  EXPECT_EQ(contour.destination, Point(0, 0));
+  EXPECT_EQ(second.GetBoundingBox(), Rect::MakeLTRB(0, 0, 20, 20));
+
+  // Segments added without a MoveTo continue from the end of the taken path.
+  builder.MoveTo({5, 5}).LineTo({15, 5});
+  builder.TakePath();
+  Path third = builder.LineTo({15, 15}).TakePath();
+  EXPECT_EQ(third.GetComponentCount(), 2u);
+  ASSERT_TRUE(third.GetContourComponentAtIndex(0, contour));
+  EXPECT_EQ(contour.destination, Point(15, 5));
+
+  // A MoveTo replaces the contour that the builder starts with.
+  Path fourth = builder.MoveTo({30, 30}).LineTo({40, 30}).TakePath();
+  EXPECT_EQ(fourth.GetComponentCount(), 2u);
+  ASSERT_TRUE(fourth.GetContourComponentAtIndex(0, contour));
+  EXPECT_EQ(contour.destination, Point(30, 30));
+
+  // Taking a path from a builder that was just reset gives an empty path.
+  EXPECT_TRUE(builder.TakePath().IsEmpty());
+}
+
+TEST(PathTest, CopyPathComputesBounds) {
+  PathBuilder builder;
+  builder.MoveTo({10, 20}).LineTo({30, 5});
+  EXPECT_EQ(builder.CopyPath().GetBoundingBox(), Rect::MakeLTRB(10, 5, 30, 20));
+  builder.LineTo({40, 40});
+  EXPECT_EQ(builder.CopyPath().GetBoundingBox(),
+            Rect::MakeLTRB(10, 5, 40, 40));
+}
+
+TEST(PathTest, RepeatedPolylinesAtTheSameScaleMatch) {
+  Path path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .CubicCurveTo({20, 135}, {135, 20}, {140, 140})
+                  .MoveTo({200, 10})
+                  .QuadraticCurveTo({300, 100}, {200, 200})
+                  .Close()
+                  .TakePath();
+  Path copy = path;
+
+  auto expect_same = [](const Path::Polyline& a, const Path::Polyline& b) {
+    EXPECT_EQ(*a.points, *b.points);
+    ASSERT_EQ(a.contours.size(), b.contours.size());
+    for (size_t i = 0; i < a.contours.size(); i++) {
+      EXPECT_EQ(a.contours[i].start_index, b.contours[i].start_index);
+      EXPECT_EQ(a.contours[i].is_closed, b.contours[i].is_closed);
+      EXPECT_EQ(a.contours[i].start_direction, b.contours[i].start_direction);
+      EXPECT_EQ(a.contours[i].end_direction, b.contours[i].end_direction);
+      EXPECT_EQ(a.contours[i].components.size(),
+                b.contours[i].components.size());
+    }
+  };
+
+  auto first = path.CreatePolyline(2.0f);
+  // Copies share the retained polyline of the path.
+  for (int i = 0; i < 3; i++) {
+    auto again = copy.CreatePolyline(2.0f);
+    expect_same(first, again);
+  }
+
+  auto finer = path.CreatePolyline(8.0f);
+  EXPECT_GT(finer.points->size(), first.points->size());
+  for (int i = 0; i < 3; i++) {
+    expect_same(finer, path.CreatePolyline(8.0f));
+  }
+  expect_same(first, path.CreatePolyline(2.0f));
+}
+
+TEST(PathTest, RetainedPolylineIsSharedAcrossThreads) {
+  Path path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .CubicCurveTo({20, 135}, {135, 20}, {140, 140})
+                  .Close()
+                  .TakePath();
+  const std::vector<Point> coarse = *path.CreatePolyline(1.0f).points;
+  const std::vector<Point> fine = *path.CreatePolyline(4.0f).points;
+
+  // Threads flattening at alternating scales always get the polyline of the
+  // scale they asked for.
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches = 0;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 200; i++) {
+        bool use_fine = (i / 3 + t) % 2 == 0;
+        auto polyline = path.CreatePolyline(use_fine ? 4.0f : 1.0f);
+        if (*polyline.points != (use_fine ? fine : coarse)) {
+          mismatches++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(PathTest, ComputesConvexityOfSingleContours) {
+  // Closed or not, turning either way.
+  EXPECT_TRUE(PathBuilder{}
+                  .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                  .TakePath()
+                  .IsConvex());
+  EXPECT_TRUE(PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({0, 10})
+                  .LineTo({10, 10})
+                  .LineTo({10, 0})
+                  .TakePath()
+                  .IsConvex());
+  // Repeated and collinear points.
+  EXPECT_TRUE(PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({5, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .Close()
+                  .TakePath()
+                  .IsConvex());
+  // Curves whose control points form a convex polygon.
+  EXPECT_TRUE(PathBuilder{}.AddCircle({50, 50}, 20).TakePath().IsConvex());
+  EXPECT_TRUE(PathBuilder{}
+                  .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 50), 10)
+                  .TakePath()
+                  .IsConvex());
+  // A trailing MoveTo does not add to the fill.
+  EXPECT_TRUE(PathBuilder{}
+                  .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                  .MoveTo({50, 50})
+                  .TakePath()
+                  .IsConvex());
+
+  // Concave.
+  EXPECT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .LineTo({20, 0})
+                   .LineTo({20, 10})
+                   .LineTo({10, 10})
+                   .LineTo({10, 20})
+                   .LineTo({0, 20})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  EXPECT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .CubicCurveTo({10, 20}, {20, -20}, {30, 0})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  // A star turns the same way at every point but winds twice.
+  EXPECT_FALSE(PathBuilder{}
+                   .MoveTo({50, 0})
+                   .LineTo({79, 90})
+                   .LineTo({2, 35})
+                   .LineTo({98, 35})
+                   .LineTo({21, 90})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  // Two contours, even if each is convex.
+  EXPECT_FALSE(PathBuilder{}
+                   .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                   .AddRect(Rect::MakeLTRB(20, 0, 30, 10))
+                   .TakePath()
+                   .IsConvex());
+  // Lines without area.
+  EXPECT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .LineTo({10, 10})
+                   .TakePath()
+                   .IsConvex());
+  EXPECT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .LineTo({10, 0})
+                   .LineTo({5, 0})
+                   .TakePath()
+                   .IsConvex());
+  EXPECT_FALSE(PathBuilder{}.TakePath().IsConvex());
+}
+
+TEST(PathTest, CurveFlatteningMatchesSolve) {
+  QuadraticPathComponent quad({10, 10}, {60, 90}, {110, 15});
+  CubicPathComponent cubic({10, 10}, {20, 135}, {135, 20}, {140, 140});
+
+  // Covers subdivisions with every remainder of the SIMD lane count and more
+  // points than a single batch of the proc based flattening.
+  for (Scalar scale = 0.0f; scale < 20.0f; scale += 0.25f) {
+    auto verify = [scale](const auto& curve, const std::vector<Point>& points,
+                          const std::string& label) {
+      ASSERT_FALSE(points.empty()) << label;
+      EXPECT_EQ(points.back(), curve.p2) << label;
+      Scalar line_count = static_cast<Scalar>(points.size());
+      for (size_t i = 1; i < points.size(); i++) {
+        EXPECT_POINT_NEAR(points[i - 1], curve.Solve(i / line_count))
+            << label << " at scale " << scale << " point " << i;
+      }
+    };
+
+    std::vector<Point> appended;
+    quad.AppendPolylinePoints(scale, appended);
+    verify(quad, appended, "quad append");
+    std::vector<Point> procced;
+    quad.ToLinearPathComponents(
+        scale, [&procced](const Point& point) { procced.push_back(point); });
+    EXPECT_EQ(procced, appended);
+    std::vector<Point> written;
+    std::vector<uint16_t> indices;
+    VertexWriter writer(written, indices);
+    quad.ToLinearPathComponents(scale, writer);
+    EXPECT_EQ(written, appended);
+
+    appended.clear();
+    cubic.AppendPolylinePoints(scale, appended);
+    verify(cubic, appended, "cubic append");
+    procced.clear();
+    cubic.ToLinearPathComponents(
+        scale, [&procced](const Point& point) { procced.push_back(point); });
+    EXPECT_EQ(procced, appended);
+    written.clear();
+    cubic.ToLinearPathComponents(scale, writer);
+    EXPECT_EQ(written, appended);
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,208 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_GEOMETRY_SIMD_H_
+#define FLUTTER_IMPELLER_GEOMETRY_SIMD_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+
+// SSE2 and NEON are part of the baseline of the respective 64-bit
+// architectures so no runtime detection is necessary.
+#if defined(FML_ARCH_CPU_X86_64)
+#include <emmintrin.h>
+#define IMPELLER_SIMD_SSE2 1
+#elif defined(FML_ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#define IMPELLER_SIMD_NEON 1
+#endif
+
+namespace impeller {
+
+static_assert(sizeof(Point) == 2 * sizeof(Scalar));
+
+//------------------------------------------------------------------------------
+/// @brief      Four scalars that are operated on together using SSE2 or NEON
+///             where available, and one at a time otherwise.
+///
+///             Only the operations needed to evaluate polynomials for several
+///             parameters at once and to transform several points at once are
+///             provided. The results are identical to performing the same
+///             operations in the same order on each lane with scalars.
+///
+class Float4 {
+ public:
+  static constexpr size_t kLaneCount = 4u;
+
+  /// All four lanes set to |value|.
+  static Float4 Splat(Scalar value) {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_set1_ps(value));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vdupq_n_f32(value));
+#else
+    return Float4(value, value, value, value);
+#endif
+  }
+
+  /// The lanes set to |start|, |start| + 1, |start| + 2 and |start| + 3.
+  static Float4 Iota(Scalar start) {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_add_ps(_mm_set1_ps(start), _mm_setr_ps(0, 1, 2, 3)));
+#elif IMPELLER_SIMD_NEON
+    static constexpr float kOffsets[kLaneCount] = {0, 1, 2, 3};
+    return Float4(vaddq_f32(vdupq_n_f32(start), vld1q_f32(kOffsets)));
+#else
+    return Float4(start, start + 1, start + 2, start + 3);
+#endif
+  }
+
+  /// The lanes set to four consecutive scalars starting at |values|.
+  static Float4 Load(const Scalar* values) {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_loadu_ps(values));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vld1q_f32(values));
+#else
+    return Float4(values[0], values[1], values[2], values[3]);
+#endif
+  }
+
+  /// The coordinates of four consecutive points as the lanes of an x and a y
+  /// vector. This is the inverse of |StorePoints|.
+  static std::pair<Float4, Float4> LoadPoints(const Point* points) {
+    const Scalar* in = reinterpret_cast<const Scalar*>(points);
+#if IMPELLER_SIMD_SSE2
+    __m128 lo = _mm_loadu_ps(in);
+    __m128 hi = _mm_loadu_ps(in + 4);
+    return {Float4(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))),
+            Float4(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)))};
+#elif IMPELLER_SIMD_NEON
+    float32x4x2_t xy = vld2q_f32(in);
+    return {Float4(xy.val[0]), Float4(xy.val[1])};
+#else
+    return {Float4(in[0], in[2], in[4], in[6]),
+            Float4(in[1], in[3], in[5], in[7])};
+#endif
+  }
+
+  /// Stores the lanes of |x| and |y| as the coordinates of four consecutive
+  /// points.
+  static void StorePoints(const Float4& x, const Float4& y, Point* points) {
+    Scalar* out = reinterpret_cast<Scalar*>(points);
+#if IMPELLER_SIMD_SSE2
+    _mm_storeu_ps(out, _mm_unpacklo_ps(x.value_, y.value_));
+    _mm_storeu_ps(out + 4, _mm_unpackhi_ps(x.value_, y.value_));
+#elif IMPELLER_SIMD_NEON
+    vst2q_f32(out, (float32x4x2_t{{x.value_, y.value_}}));
+#else
+    for (size_t i = 0; i < kLaneCount; i++) {
+      out[2 * i] = x.value_[i];
+      out[2 * i + 1] = y.value_[i];
+    }
+#endif
+  }
+
+  /// Stores the lanes to four consecutive scalars starting at |values|.
+  void Store(Scalar* values) const {
+#if IMPELLER_SIMD_SSE2
+    _mm_storeu_ps(values, value_);
+#elif IMPELLER_SIMD_NEON
+    vst1q_f32(values, value_);
+#else
+    for (size_t i = 0; i < kLaneCount; i++) {
+      values[i] = value_[i];
+    }
+#endif
+  }
+
+  Float4 operator+(const Float4& other) const {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_add_ps(value_, other.value_));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vaddq_f32(value_, other.value_));
+#else
+    return Apply(other, [](Scalar a, Scalar b) { return a + b; });
+#endif
+  }
+
+  Float4 operator-(const Float4& other) const {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_sub_ps(value_, other.value_));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vsubq_f32(value_, other.value_));
+#else
+    return Apply(other, [](Scalar a, Scalar b) { return a - b; });
+#endif
+  }
+
+  Float4 operator*(const Float4& other) const {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_mul_ps(value_, other.value_));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vmulq_f32(value_, other.value_));
+#else
+    return Apply(other, [](Scalar a, Scalar b) { return a * b; });
+#endif
+  }
+
+  Float4 operator/(const Float4& other) const {
+#if IMPELLER_SIMD_SSE2
+    return Float4(_mm_div_ps(value_, other.value_));
+#elif IMPELLER_SIMD_NEON
+    return Float4(vdivq_f32(value_, other.value_));
+#else
+    return Apply(other, [](Scalar a, Scalar b) { return a / b; });
+#endif
+  }
+
+  Float4 operator*(Scalar other) const { return *this * Splat(other); }
+
+ private:
+#if IMPELLER_SIMD_SSE2
+  using Storage = __m128;
+#elif IMPELLER_SIMD_NEON
+  using Storage = float32x4_t;
+#else
+  struct Storage {
+    Scalar lanes[kLaneCount];
+
+    Scalar& operator[](size_t index) { return lanes[index]; }
+    Scalar operator[](size_t index) const { return lanes[index]; }
+  };
+#endif
+
+  Storage value_;
+
+#if IMPELLER_SIMD_SSE2 || IMPELLER_SIMD_NEON
+  explicit Float4(Storage value) : value_(value) {}
+#else
+  Float4(Scalar a, Scalar b, Scalar c, Scalar d) : value_{{a, b, c, d}} {}
+
+  template <typename Operation>
+  Float4 Apply(const Float4& other, Operation operation) const {
+    return Float4(operation(value_[0], other.value_[0]),
+                  operation(value_[1], other.value_[1]),
+                  operation(value_[2], other.value_[2]),
+                  operation(value_[3], other.value_[3]));
+  }
+#endif
+};
+
+inline Float4 operator*(Scalar scalar, const Float4& vector) {
+  return Float4::Splat(scalar) * vector;
+}
+
+inline Float4 operator-(Scalar scalar, const Float4& vector) {
+  return Float4::Splat(scalar) - vector;
+}
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_GEOMETRY_SIMD_H_
@@ -14,9 +14,12 @@
 
 namespace impeller {
 
-BlitPassGLES::BlitPassGLES(ReactorGLES::Ref reactor)
+BlitPassGLES::BlitPassGLES(
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations)
     : reactor_(std::move(reactor)),
-      is_valid_(reactor_ && reactor_->IsValid()) {}
+      pending_operations_(std::move(pending_operations)),
+      is_valid_(reactor_ && reactor_->IsValid() && pending_operations_) {}
 
 // |BlitPass|
 BlitPassGLES::~BlitPassGLES() = default;
@@ -81,13 +84,16 @@ bool BlitPassGLES::EncodeCommands(
   }
 
   std::shared_ptr<const BlitPassGLES> shared_this = shared_from_this();
-  return reactor_->AddOperation([transients_allocator,
-                                 blit_pass = std::move(shared_this),
-                                 label = label_](const auto& reactor) {
-    auto result = EncodeCommandsInReactor(transients_allocator, reactor,
-                                          blit_pass->commands_, label);
-    FML_CHECK(result) << "Must be able to encode GL commands without error.";
-  });
+  // Runs when the command buffer is submitted.
+  pending_operations_->emplace_back(
+      [reactor = reactor_, transients_allocator,
+       blit_pass = std::move(shared_this), label = label_]() {
+        auto result = EncodeCommandsInReactor(transients_allocator, *reactor,
+                                              blit_pass->commands_, label);
+        FML_CHECK(result)
+            << "Must be able to encode GL commands without error.";
+      });
+  return true;
 }
 
 // |BlitPass|
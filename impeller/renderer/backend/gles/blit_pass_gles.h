@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BLIT_PASS_GLES_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/impeller/base/config.h"
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
@@ -25,10 +26,13 @@ class BlitPassGLES final : public BlitPass,
 
   std::vector<std::unique_ptr<BlitEncodeGLES>> commands_;
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations_;
   std::string label_;
   bool is_valid_ = false;
 
-  explicit BlitPassGLES(ReactorGLES::Ref reactor);
+  BlitPassGLES(
+      ReactorGLES::Ref reactor,
+      std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations);
 
   // |BlitPass|
   bool IsValid() const override;
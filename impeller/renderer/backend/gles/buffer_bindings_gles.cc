@@ -21,6 +21,28 @@ namespace impeller {
 static constexpr std::string_view kAngleInputAttachmentPrefix =
     "ANGLEInputAttachment";
 
+UniformValueCacheGLES::UniformValueCacheGLES() = default;
+
+UniformValueCacheGLES::~UniformValueCacheGLES() = default;
+
+bool UniformValueCacheGLES::IsCurrent(size_t index,
+                                      const void* data,
+                                      size_t size) const {
+  if (index >= values_.size()) {
+    return false;
+  }
+  const std::vector<uint8_t>& value = values_[index];
+  return value.size() == size && std::memcmp(value.data(), data, size) == 0;
+}
+
+void UniformValueCacheGLES::Set(size_t index, const void* data, size_t size) {
+  if (index >= values_.size()) {
+    values_.resize(index + 1u);
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  values_[index].assign(bytes, bytes + size);
+}
+
 BufferBindingsGLES::BufferBindingsGLES() = default;
 
 BufferBindingsGLES::~BufferBindingsGLES() = default;
@@ -30,11 +52,18 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     const std::vector<ShaderStageIOSlot>& p_inputs,
     const std::vector<ShaderStageBufferLayout>& layouts) {
   std::vector<VertexAttribPointer> vertex_attrib_arrays;
+  uint32_t vertex_attrib_mask = 0u;
   for (auto i = 0u; i < p_inputs.size(); i++) {
     const auto& input = p_inputs[i];
     const auto& layout = layouts[input.binding];
     VertexAttribPointer attrib;
     attrib.index = input.location;
+    // The state cache tracks the enabled arrays in a 32 bit mask.
+    if (attrib.index >= 32u) {
+      VALIDATION_LOG << "Vertex attribute location " << attrib.index
+                     << " is out of range.";
+      return false;
+    }
     // Component counts must be 1, 2, 3 or 4. Do that validation now.
     if (input.vec_size < 1u || input.vec_size > 4u) {
       return false;
@@ -45,12 +74,14 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
       return false;
     }
     attrib.type = type.value();
-    attrib.normalized = GL_FALSE;
+    attrib.normalized = input.normalized ? GL_TRUE : GL_FALSE;
     attrib.offset = input.offset;
     attrib.stride = layout.stride;
     vertex_attrib_arrays.emplace_back(attrib);
+    vertex_attrib_mask |= 1u << attrib.index;
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
+  vertex_attrib_mask_ = vertex_attrib_mask;
   return true;
 }
 
@@ -86,11 +117,14 @@ static std::string CreateUniformMemberKey(
   return NormalizeUniformKey(non_struct_member);
 }
 
-bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
-                                              GLuint program) {
+bool BufferBindingsGLES::ReadUniformsBindings(
+    const ProcTableGLES& gl,
+    GLuint program,
+    std::shared_ptr<UniformValueCacheGLES> uniform_values) {
   if (!gl.IsProgram(program)) {
     return false;
   }
+  uniform_values_ = std::move(uniform_values);
   GLint max_name_size = 0;
   gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_size);
 
@@ -137,15 +171,16 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
       return false;
     }
     uniform_locations_[NormalizeUniformKey(std::string{
-        name.data(), static_cast<size_t>(written_count)})] = location;
+        name.data(), static_cast<size_t>(written_count)})] =
+        UniformLocation{.location = location, .index = static_cast<size_t>(i)};
   }
   return true;
 }
 
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
                                               size_t vertex_offset) const {
+  gl.GetStateCache().SetEnabledVertexAttribArrays(gl, vertex_attrib_mask_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -163,13 +198,17 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
                                          Allocator& transients_allocator,
                                          const Bindings& vertex_bindings,
                                          const Bindings& fragment_bindings) {
-  for (const auto& buffer : vertex_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.view)) {
+  for (size_t i = 0; i < vertex_bindings.buffers.size(); i++) {
+    if (!BindUniformBuffer(gl, transients_allocator,
+                           vertex_bindings.buffers[i].view,
+                           GetSlot(uniform_slots_, ShaderStage::kVertex, i))) {
       return false;
     }
   }
-  for (const auto& buffer : fragment_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.view)) {
+  for (size_t i = 0; i < fragment_bindings.buffers.size(); i++) {
+    if (!BindUniformBuffer(
+            gl, transients_allocator, fragment_bindings.buffers[i].view,
+            GetSlot(uniform_slots_, ShaderStage::kFragment, i))) {
       return false;
     }
   }
@@ -189,45 +228,57 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
+BufferBindingsGLES::SlotLocations& BufferBindingsGLES::GetSlot(
+    StageSlots& slots,
+    ShaderStage stage,
+    size_t slot) {
+  std::vector<SlotLocations>& stage_slots =
+      slots[stage == ShaderStage::kFragment ? 1u : 0u];
+  if (slot >= stage_slots.size()) {
+    stage_slots.resize(slot + 1u);
   }
-  return true;
+  return stage_slots[slot];
 }
 
-GLint BufferBindingsGLES::ComputeTextureLocation(
-    const ShaderMetadata* metadata) {
-  auto location = binding_map_.find(metadata->name);
-  if (location != binding_map_.end()) {
-    return location->second[0];
+const BufferBindingsGLES::UniformLocation&
+BufferBindingsGLES::ComputeTextureLocation(const ShaderMetadata* metadata,
+                                           SlotLocations& slot) {
+  if (slot.resolved && slot.name == metadata->name) {
+    return slot.locations[0];
   }
-  auto& locations = binding_map_[metadata->name] = {};
+  slot.resolved = true;
+  slot.name = metadata->name;
+  slot.locations.clear();
   auto computed_location =
       uniform_locations_.find(CreateUniformMemberKey(metadata->name));
   if (computed_location == uniform_locations_.end()) {
-    locations.push_back(-1);
+    slot.locations.push_back(UniformLocation{});
   } else {
-    locations.push_back(computed_location->second);
+    slot.locations.push_back(computed_location->second);
   }
-  return locations[0];
+  return slot.locations[0];
 }
 
-const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
-    const ShaderMetadata* metadata) {
-  auto location = binding_map_.find(metadata->name);
-  if (location != binding_map_.end()) {
-    return location->second;
+const std::vector<BufferBindingsGLES::UniformLocation>&
+BufferBindingsGLES::ComputeUniformLocations(const ShaderMetadata* metadata,
+                                            SlotLocations& slot) {
+  // A slot may be bound to different structs by different draws, but a struct
+  // of a given name always has the same members in a given program.
+  if (slot.resolved && slot.name == metadata->name &&
+      slot.locations.size() == metadata->members.size()) {
+    return slot.locations;
   }
+  slot.resolved = true;
+  slot.name = metadata->name;
+  slot.locations.clear();
 
   // For each metadata member, look up the binding location and record
-  // it in the binding map.
-  auto& locations = binding_map_[metadata->name] = {};
+  // it in the slot.
   for (const auto& member : metadata->members) {
     if (member.type == ShaderType::kVoid) {
       // Void types are used for padding. We are obviously not going to find
       // mappings for these. Keep going.
-      locations.push_back(-1);
+      slot.locations.push_back(UniformLocation{});
       continue;
     }
 
@@ -237,17 +288,77 @@ const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
     const auto computed_location = uniform_locations_.find(member_key);
     if (computed_location == uniform_locations_.end()) {
       // Uniform was not active.
-      locations.push_back(-1);
+      slot.locations.push_back(UniformLocation{});
       continue;
     }
-    locations.push_back(computed_location->second);
+    slot.locations.push_back(computed_location->second);
   }
-  return locations;
+  return slot.locations;
+}
+
+bool BufferBindingsGLES::IsUniformValueCurrent(
+    const UniformLocation& location,
+    const void* data,
+    size_t size) const {
+  return uniform_values_ &&
+         uniform_values_->IsCurrent(location.index, data, size);
+}
+
+void BufferBindingsGLES::RecordUniformValue(const UniformLocation& location,
+                                            const void* data,
+                                            size_t size) {
+  if (uniform_values_) {
+    uniform_values_->Set(location.index, data, size);
+  }
+}
+
+// Uploads a float uniform, or an array of them, of the given member size.
+// Returns false if no upload matches the size.
+static bool UploadFloatUniform(const ProcTableGLES& gl,
+                               GLint location,
+                               size_t member_size,
+                               size_t element_count,
+                               const GLfloat* data) {
+  switch (member_size) {
+    case sizeof(Matrix):
+      gl.UniformMatrix4fv(location,       // location
+                          element_count,  // count
+                          GL_FALSE,       // normalize
+                          data            // data
+      );
+      return true;
+    case sizeof(Vector4):
+      gl.Uniform4fv(location,       // location
+                    element_count,  // count
+                    data            // data
+      );
+      return true;
+    case sizeof(Vector3):
+      gl.Uniform3fv(location,       // location
+                    element_count,  // count
+                    data            // data
+      );
+      return true;
+    case sizeof(Vector2):
+      gl.Uniform2fv(location,       // location
+                    element_count,  // count
+                    data            // data
+      );
+      return true;
+    case sizeof(Scalar):
+      gl.Uniform1fv(location,       // location
+                    element_count,  // count
+                    data            // data
+      );
+      return true;
+  }
+  return false;
 }
 
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
                                            Allocator& transients_allocator,
-                                           const BufferResource& buffer) {
+                                           const BufferResource& buffer,
+                                           SlotLocations& slot) {
   const auto* metadata = buffer.GetMetadata();
   auto device_buffer = buffer.resource.buffer;
   if (!device_buffer) {
@@ -265,10 +376,11 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
 
-  const auto& locations = ComputeUniformLocations(metadata);
+  const auto& locations = ComputeUniformLocations(metadata, slot);
   for (auto i = 0u; i < metadata->members.size(); i++) {
     const auto& member = metadata->members[i];
-    auto location = locations[i];
+    const auto& uniform = locations[i];
+    auto location = uniform.location;
     // Void type or inactive uniform.
     if (location == -1 || member.type == ShaderType::kVoid) {
       continue;
@@ -295,40 +407,20 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
           reinterpret_cast<const GLfloat*>(array_element_buffer_.data());
     }
 
+    // Skip the upload if the program already holds this value.
+    size_t value_size = member.size * element_count;
+    if (IsUniformValueCurrent(uniform, buffer_data, value_size)) {
+      continue;
+    }
+
     switch (member.type) {
       case ShaderType::kFloat:
-        switch (member.size) {
-          case sizeof(Matrix):
-            gl.UniformMatrix4fv(location,       // location
-                                element_count,  // count
-                                GL_FALSE,       // normalize
-                                buffer_data     // data
-            );
-            continue;
-          case sizeof(Vector4):
-            gl.Uniform4fv(location,       // location
-                          element_count,  // count
-                          buffer_data     // data
-            );
-            continue;
-          case sizeof(Vector3):
-            gl.Uniform3fv(location,       // location
-                          element_count,  // count
-                          buffer_data     // data
-            );
-            continue;
-          case sizeof(Vector2):
-            gl.Uniform2fv(location,       // location
-                          element_count,  // count
-                          buffer_data     // data
-            );
-            continue;
-          case sizeof(Scalar):
-            gl.Uniform1fv(location,       // location
-                          element_count,  // count
-                          buffer_data     // data
-            );
-            continue;
+        if (UploadFloatUniform(gl, location, member.size, element_count,
+                               buffer_data)) {
+          // Only uploaded values are recorded, so that a later draw with a
+          // value that failed to upload does not skip its upload.
+          RecordUniformValue(uniform, buffer_data, value_size);
+          continue;
         }
         VALIDATION_LOG << "Size " << member.size
                        << " could not be mapped ShaderType::kFloat for key: "
@@ -372,8 +464,10 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
       return std::nullopt;
     }
 
-    auto location = ComputeTextureLocation(data.texture.GetMetadata());
-    if (location == -1) {
+    const auto& uniform = ComputeTextureLocation(
+        data.texture.GetMetadata(),
+        GetSlot(texture_slots_, stage, active_index - unit_start_index));
+    if (uniform.location == -1) {
       return std::nullopt;
     }
 
@@ -406,7 +500,11 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(location, active_index);
+    GLint unit = static_cast<GLint>(active_index);
+    if (!IsUniformValueCurrent(uniform, &unit, sizeof(unit))) {
+      gl.Uniform1i(uniform.location, unit);
+      RecordUniformValue(uniform, &unit, sizeof(unit));
+    }
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
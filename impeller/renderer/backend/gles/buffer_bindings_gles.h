@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 
+#include <array>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +17,41 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The values last uploaded to the uniforms of a program object.
+///
+///             Uniform values are part of the state of a program object, and
+///             a program object is shared by all pipeline variants created
+///             from the same shaders. These variants share one cache so that
+///             uploads of unchanged values can be skipped no matter which
+///             variant made the previous upload.
+///
+class UniformValueCacheGLES {
+ public:
+  UniformValueCacheGLES();
+
+  ~UniformValueCacheGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the value is the one last recorded for the active
+  ///             uniform at `index`, in which case its upload can be skipped.
+  ///
+  bool IsCurrent(size_t index, const void* data, size_t size) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the value just uploaded to the active uniform at
+  ///             `index`.
+  ///
+  void Set(size_t index, const void* data, size_t size);
+
+ private:
+  std::vector<std::vector<uint8_t>> values_;
+
+  UniformValueCacheGLES(const UniformValueCacheGLES&) = delete;
+
+  UniformValueCacheGLES& operator=(const UniformValueCacheGLES&) = delete;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Sets up stage bindings for single draw call in the OpenGLES
 ///             backend.
@@ -30,8 +67,25 @@ class BufferBindingsGLES {
       const std::vector<ShaderStageIOSlot>& inputs,
       const std::vector<ShaderStageBufferLayout>& layouts);
 
-  bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the locations of the active uniforms of the linked
+  ///             program.
+  ///
+  /// @param[in]  uniform_values  The cache of the values uploaded to the
+  ///                             program, shared with the other pipelines
+  ///                             that use it. If null, every draw uploads
+  ///                             all uniform values.
+  ///
+  bool ReadUniformsBindings(
+      const ProcTableGLES& gl,
+      GLuint program,
+      std::shared_ptr<UniformValueCacheGLES> uniform_values = nullptr);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Enables the vertex attribute arrays of the pipeline, disables
+  ///             those of the previous pipeline that it does not use, and
+  ///             points the arrays at the bound vertex buffer.
+  ///
   bool BindVertexAttributes(const ProcTableGLES& gl,
                             size_t vertex_offset) const;
 
@@ -40,8 +94,6 @@ class BufferBindingsGLES {
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -55,20 +107,62 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  uint32_t vertex_attrib_mask_ = 0u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The location of an active uniform, along with its index
+  ///             among the active uniforms of the program.
+  ///
+  struct UniformLocation {
+    GLint location = -1;
+    size_t index = 0u;
+  };
+  std::unordered_map<std::string, UniformLocation> uniform_locations_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The uniform locations resolved for the struct or texture
+  ///             last bound at a binding slot.
+  ///
+  ///             Resolving locations builds and hashes the name of every
+  ///             member. Draws using a pipeline bind the same resources at
+  ///             the same slots, so the locations are resolved once per slot
+  ///             and only looked up by slot afterwards.
+  ///
+  struct SlotLocations {
+    bool resolved = false;
+    std::string name;
+    std::vector<UniformLocation> locations;
+  };
+  /// The slots of the vertex and fragment stages, in that order.
+  using StageSlots = std::array<std::vector<SlotLocations>, 2u>;
+  StageSlots uniform_slots_;
+  StageSlots texture_slots_;
+
+  std::shared_ptr<UniformValueCacheGLES> uniform_values_;
+
+  static SlotLocations& GetSlot(StageSlots& slots,
+                                ShaderStage stage,
+                                size_t slot);
 
-  std::unordered_map<std::string, GLint> uniform_locations_;
+  const std::vector<UniformLocation>& ComputeUniformLocations(
+      const ShaderMetadata* metadata,
+      SlotLocations& slot);
 
-  using BindingMap = std::unordered_map<std::string, std::vector<GLint>>;
-  BindingMap binding_map_ = {};
+  const UniformLocation& ComputeTextureLocation(const ShaderMetadata* metadata,
+                                                SlotLocations& slot);
 
-  const std::vector<GLint>& ComputeUniformLocations(
-      const ShaderMetadata* metadata);
+  bool IsUniformValueCurrent(const UniformLocation& location,
+                             const void* data,
+                             size_t size) const;
 
-  GLint ComputeTextureLocation(const ShaderMetadata* metadata);
+  void RecordUniformValue(const UniformLocation& location,
+                          const void* data,
+                          size_t size);
 
   bool BindUniformBuffer(const ProcTableGLES& gl,
                          Allocator& transients_allocator,
-                         const BufferResource& buffer);
+                         const BufferResource& buffer,
+                         SlotLocations& slot);
 
   std::optional<size_t> BindTextures(const ProcTableGLES& gl,
                                      const Bindings& bindings,
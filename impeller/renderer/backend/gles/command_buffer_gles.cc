@@ -14,6 +14,8 @@ CommandBufferGLES::CommandBufferGLES(std::weak_ptr<const Context> context,
                                      ReactorGLES::Ref reactor)
     : CommandBuffer(std::move(context)),
       reactor_(std::move(reactor)),
+      pending_operations_(
+          std::make_shared<std::vector<fml::UniqueClosure>>()),
       is_valid_(reactor_ && reactor_->IsValid()) {}
 
 CommandBufferGLES::~CommandBufferGLES() = default;
@@ -30,6 +32,21 @@ bool CommandBufferGLES::IsValid() const {
 
 // |CommandBuffer|
 bool CommandBufferGLES::OnSubmitCommands(CompletionCallback callback) {
+  if (!pending_operations_->empty()) {
+    auto operations = std::move(*pending_operations_);
+    pending_operations_->clear();
+    if (!reactor_->AddOperation(
+            [operations = std::move(operations)](const ReactorGLES& reactor) {
+              for (const auto& operation : operations) {
+                operation();
+              }
+            })) {
+      if (callback) {
+        callback(CommandBuffer::Status::kError);
+      }
+      return false;
+    }
+  }
   const auto result = reactor_->React();
   if (callback) {
     callback(result ? CommandBuffer::Status::kCompleted
@@ -54,7 +71,7 @@ std::shared_ptr<RenderPass> CommandBufferGLES::OnCreateRenderPass(
     return nullptr;
   }
   auto pass = std::shared_ptr<RenderPassGLES>(
-      new RenderPassGLES(context, target, reactor_));
+      new RenderPassGLES(context, target, reactor_, pending_operations_));
   if (!pass->IsValid()) {
     return nullptr;
   }
@@ -66,7 +83,8 @@ std::shared_ptr<BlitPass> CommandBufferGLES::OnCreateBlitPass() {
   if (!IsValid()) {
     return nullptr;
   }
-  auto pass = std::shared_ptr<BlitPassGLES>(new BlitPassGLES(reactor_));
+  auto pass = std::shared_ptr<BlitPassGLES>(
+      new BlitPassGLES(reactor_, pending_operations_));
   if (!pass->IsValid()) {
     return nullptr;
   }
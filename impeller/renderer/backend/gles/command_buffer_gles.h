@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_COMMAND_BUFFER_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_COMMAND_BUFFER_GLES_H_
 
+#include <memory>
+#include <vector>
+
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_target.h"
@@ -20,6 +23,10 @@ class CommandBufferGLES final : public CommandBuffer {
   friend class ContextGLES;
 
   ReactorGLES::Ref reactor_;
+  // The operations of the encoded passes. They are added to the reactor as
+  // one operation on submission, so that they run together and only once the
+  // command buffer is submitted.
+  std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations_;
   bool is_valid_ = false;
 
   CommandBufferGLES(std::weak_ptr<const Context> context,
@@ -39,8 +39,10 @@ BufferBindingsGLES* PipelineGLES::GetBufferBindings() const {
   return buffer_bindings_.get();
 }
 
-bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
-                                         GLuint program) {
+bool PipelineGLES::BuildVertexDescriptor(
+    const ProcTableGLES& gl,
+    GLuint program,
+    std::shared_ptr<UniformValueCacheGLES> uniform_values) {
   if (buffer_bindings_) {
     return false;
   }
@@ -50,7 +52,8 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
           GetDescriptor().GetVertexDescriptor()->GetStageLayouts())) {
     return false;
   }
-  if (!vtx_desc->ReadUniformsBindings(gl, program)) {
+  if (!vtx_desc->ReadUniformsBindings(gl, program,
+                                      std::move(uniform_values))) {
     return false;
   }
   buffer_bindings_ = std::move(vtx_desc);
@@ -65,14 +68,8 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   if (!handle.has_value()) {
     return false;
   }
-  reactor_->GetProcTable().UseProgram(handle.value());
-  return true;
-}
-
-[[nodiscard]] bool PipelineGLES::UnbindProgram() const {
-  if (reactor_) {
-    reactor_->GetProcTable().UseProgram(0u);
-  }
+  const auto& gl = reactor_->GetProcTable();
+  gl.GetStateCache().UseProgram(gl, handle.value());
   return true;
 }
 
@@ -28,12 +28,12 @@ class PipelineGLES final
 
   [[nodiscard]] bool BindProgram() const;
 
-  [[nodiscard]] bool UnbindProgram() const;
-
   BufferBindingsGLES* GetBufferBindings() const;
 
-  [[nodiscard]] bool BuildVertexDescriptor(const ProcTableGLES& gl,
-                                           GLuint program);
+  [[nodiscard]] bool BuildVertexDescriptor(
+      const ProcTableGLES& gl,
+      GLuint program,
+      std::shared_ptr<UniformValueCacheGLES> uniform_values = nullptr);
 
  private:
   friend PipelineLibraryGLES;
@@ -205,15 +205,22 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
 
   auto cached_program = library.GetProgramForKey(program_key);
 
-  const auto has_cached_program = !!cached_program;
+  const auto has_cached_program = cached_program.has_value();
 
-  auto pipeline = std::shared_ptr<PipelineGLES>(new PipelineGLES(
-      reactor,       //
-      weak_library,  //
-      desc,          //
-      has_cached_program
-          ? std::move(cached_program)
-          : std::make_shared<UniqueHandleGLES>(reactor, HandleType::kProgram)));
+  if (!has_cached_program) {
+    cached_program = CachedProgram{
+        .handle =
+            std::make_shared<UniqueHandleGLES>(reactor, HandleType::kProgram),
+        .uniform_values = std::make_shared<UniformValueCacheGLES>(),
+    };
+  }
+
+  auto pipeline = std::shared_ptr<PipelineGLES>(
+      new PipelineGLES(reactor,                //
+                       weak_library,           //
+                       desc,                   //
+                       cached_program->handle  //
+                       ));
 
   auto program = reactor->GetGLHandle(pipeline->GetProgramHandle());
 
@@ -235,7 +242,8 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
   }
 
   if (!pipeline->BuildVertexDescriptor(reactor->GetProcTable(),
-                                       program.value())) {
+                                       program.value(),
+                                       cached_program->uniform_values)) {
     VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
     return nullptr;
   }
@@ -246,7 +254,7 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
   }
 
   if (!has_cached_program) {
-    library.SetProgramForKey(program_key, pipeline->GetSharedHandle());
+    library.SetProgramForKey(program_key, std::move(cached_program.value()));
   }
 
   return pipeline;
@@ -323,19 +331,18 @@ const ReactorGLES::Ref& PipelineLibraryGLES::GetReactor() const {
   return reactor_;
 }
 
-std::shared_ptr<UniqueHandleGLES> PipelineLibraryGLES::GetProgramForKey(
-    const ProgramKey& key) {
+std::optional<PipelineLibraryGLES::CachedProgram>
+PipelineLibraryGLES::GetProgramForKey(const ProgramKey& key) {
   Lock lock(programs_mutex_);
   auto found = programs_.find(key);
   if (found != programs_.end()) {
     return found->second;
   }
-  return nullptr;
+  return std::nullopt;
 }
 
-void PipelineLibraryGLES::SetProgramForKey(
-    const ProgramKey& key,
-    std::shared_ptr<UniqueHandleGLES> program) {
+void PipelineLibraryGLES::SetProgramForKey(const ProgramKey& key,
+                                           CachedProgram program) {
   Lock lock(programs_mutex_);
   programs_[key] = std::move(program);
 }
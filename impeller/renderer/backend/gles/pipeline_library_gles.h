@@ -5,11 +5,13 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/unique_handle_gles.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -82,8 +84,17 @@ class PipelineLibraryGLES final
     };
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      A linked program object, along with the cache of the uniform
+  ///             values uploaded to it by the pipelines sharing it.
+  ///
+  struct CachedProgram {
+    std::shared_ptr<UniqueHandleGLES> handle;
+    std::shared_ptr<UniformValueCacheGLES> uniform_values;
+  };
+
   using ProgramMap = std::unordered_map<ProgramKey,
-                                        std::shared_ptr<UniqueHandleGLES>,
+                                        CachedProgram,
                                         ProgramKey::Hash,
                                         ProgramKey::Equal>;
 
@@ -118,10 +129,9 @@ class PipelineLibraryGLES final
       const std::shared_ptr<const ShaderFunction>& vert_shader,
       const std::shared_ptr<const ShaderFunction>& frag_shader);
 
-  std::shared_ptr<UniqueHandleGLES> GetProgramForKey(const ProgramKey& key);
+  std::optional<CachedProgram> GetProgramForKey(const ProgramKey& key);
 
-  void SetProgramForKey(const ProgramKey& key,
-                        std::shared_ptr<UniqueHandleGLES> program);
+  void SetProgramForKey(const ProgramKey& key, CachedProgram program);
 };
 
 }  // namespace impeller
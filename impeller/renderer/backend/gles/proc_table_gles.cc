@@ -205,6 +205,10 @@ const std::shared_ptr<const CapabilitiesGLES>& ProcTableGLES::GetCapabilities()
   return capabilities_;
 }
 
+StateCacheGLES& ProcTableGLES::GetStateCache() const {
+  return *state_cache_;
+}
+
 static const char* FramebufferStatusToString(GLenum status) {
   switch (status) {
     case GL_FRAMEBUFFER_COMPLETE:
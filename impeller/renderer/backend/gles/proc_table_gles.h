@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROC_TABLE_GLES_H_
 
 #include <functional>
+#include <memory>
 #include <string>
 
 #include "flutter/fml/logging.h"
@@ -13,6 +14,7 @@
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 #include "impeller/renderer/backend/gles/description_gles.h"
 #include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 
 namespace impeller {
 
@@ -257,6 +259,13 @@ class ProcTableGLES {
 
   const std::shared_ptr<const CapabilitiesGLES>& GetCapabilities() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The shadow of the fixed function state of the context the
+  ///             procs are called on. Setting state through it skips calls
+  ///             that would not change the state.
+  ///
+  StateCacheGLES& GetStateCache() const;
+
   std::string DescribeCurrentFramebuffer() const;
 
   std::string GetProgramInfoLogString(GLuint program) const;
@@ -281,6 +290,8 @@ class ProcTableGLES {
   std::unique_ptr<DescriptionGLES> description_;
   std::shared_ptr<const CapabilitiesGLES> capabilities_;
   GLint debug_label_max_length_ = 0;
+  std::unique_ptr<StateCacheGLES> state_cache_ =
+      std::make_unique<StateCacheGLES>();
 
   ProcTableGLES(const ProcTableGLES&) = delete;
 
@@ -5,6 +5,8 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 
 #include <algorithm>
+#include <array>
+#include <iterator>
 
 #include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
@@ -40,11 +42,6 @@ bool ReactorGLES::RemoveWorker(WorkerID worker) {
   return workers_.erase(worker) == 1;
 }
 
-bool ReactorGLES::HasPendingOperations() const {
-  Lock ops_lock(ops_mutex_);
-  return !ops_.empty();
-}
-
 const ProcTableGLES& ReactorGLES::GetProcTable() const {
   FML_DCHECK(IsValid());
   return *proc_table_;
@@ -68,10 +65,7 @@ std::optional<GLuint> ReactorGLES::GetGLHandle(const HandleGLES& handle) const {
   return std::nullopt;
 }
 
-bool ReactorGLES::AddOperation(Operation operation) {
-  if (!operation) {
-    return false;
-  }
+bool ReactorGLES::EnqueueOperation(fml::UniqueClosure operation) {
   {
     Lock ops_lock(ops_mutex_);
     ops_.emplace_back(std::move(operation));
@@ -105,26 +99,61 @@ static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
   return std::nullopt;
 }
 
-static bool CollectGLHandle(const ProcTableGLES& gl,
+// Creates one GL object for each of the names with a single call where the
+// type of the objects allows it.
+static bool CreateGLHandles(const ProcTableGLES& gl,
                             HandleType type,
-                            GLuint handle) {
+                            std::vector<GLuint>& names) {
+  const auto count = static_cast<GLsizei>(names.size());
   switch (type) {
     case HandleType::kUnknown:
       return false;
     case HandleType::kTexture:
-      gl.DeleteTextures(1u, &handle);
+      gl.GenTextures(count, names.data());
       return true;
     case HandleType::kBuffer:
-      gl.DeleteBuffers(1u, &handle);
+      gl.GenBuffers(count, names.data());
       return true;
     case HandleType::kProgram:
-      gl.DeleteProgram(handle);
+      for (auto& name : names) {
+        name = gl.CreateProgram();
+      }
       return true;
     case HandleType::kRenderBuffer:
-      gl.DeleteRenderbuffers(1u, &handle);
+      gl.GenRenderbuffers(count, names.data());
       return true;
     case HandleType::kFrameBuffer:
-      gl.DeleteFramebuffers(1u, &handle);
+      gl.GenFramebuffers(count, names.data());
+      return true;
+  }
+  return false;
+}
+
+// Deletes the GL objects with a single call where the type of the objects
+// allows it.
+static bool CollectGLHandles(const ProcTableGLES& gl,
+                             HandleType type,
+                             const std::vector<GLuint>& names) {
+  const auto count = static_cast<GLsizei>(names.size());
+  switch (type) {
+    case HandleType::kUnknown:
+      return false;
+    case HandleType::kTexture:
+      gl.DeleteTextures(count, names.data());
+      return true;
+    case HandleType::kBuffer:
+      gl.DeleteBuffers(count, names.data());
+      return true;
+    case HandleType::kProgram:
+      for (auto name : names) {
+        gl.DeleteProgram(name);
+      }
+      return true;
+    case HandleType::kRenderBuffer:
+      gl.DeleteRenderbuffers(count, names.data());
+      return true;
+    case HandleType::kFrameBuffer:
+      gl.DeleteFramebuffers(count, names.data());
       return true;
   }
   return false;
@@ -158,11 +187,11 @@ bool ReactorGLES::React() {
     return false;
   }
   TRACE_EVENT0("impeller", "ReactorGLES::React");
-  while (HasPendingOperations()) {
-    // Both the raster thread and the IO thread can flush queued operations.
-    // Ensure that execution of the ops is serialized.
-    Lock execution_lock(ops_execution_mutex_);
-
+  // Both the raster thread and the IO thread can flush queued operations.
+  // Ensure that execution of the ops is serialized.
+  Lock execution_lock(ops_execution_mutex_);
+  // Operations queued while others execute are picked up by the next batch.
+  while (TakePendingOperations()) {
     if (!ReactOnce()) {
       return false;
     }
@@ -170,6 +199,19 @@ bool ReactorGLES::React() {
   return true;
 }
 
+bool ReactorGLES::TakePendingOperations() {
+  Lock ops_lock(ops_mutex_);
+  if (ops_to_flush_.empty()) {
+    std::swap(ops_, ops_to_flush_);
+  } else {
+    // A previous reaction failed before flushing its operations. Run them
+    // before the ones queued since.
+    std::move(ops_.begin(), ops_.end(), std::back_inserter(ops_to_flush_));
+    ops_.clear();
+  }
+  return !ops_to_flush_.empty();
+}
+
 static DebugResourceType ToDebugResourceType(HandleType type) {
   switch (type) {
     case HandleType::kUnknown:
@@ -200,39 +242,64 @@ bool ReactorGLES::ConsolidateHandles() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
+  // GL objects are created and deleted in one call per handle type.
+  constexpr size_t kHandleTypeCount =
+      static_cast<size_t>(HandleType::kFrameBuffer) + 1u;
+  std::array<std::vector<LiveHandle*>, kHandleTypeCount> handles_to_create;
+  std::array<std::vector<GLuint>, kHandleTypeCount> names_to_collect;
   std::vector<HandleGLES> handles_to_delete;
+  std::vector<LiveHandles::value_type*> handles_to_label;
   for (auto& handle : handles_) {
+    const auto type_index = static_cast<size_t>(handle.first.type);
     // Collect dead handles.
     if (handle.second.pending_collection) {
       // This could be false if the handle was created and collected without
       // use. We still need to get rid of map entry.
       if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
+        names_to_collect[type_index].push_back(handle.second.name.value());
       }
       handles_to_delete.push_back(handle.first);
       continue;
     }
     // Create live handles.
     if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
-      if (!gl_handle) {
-        VALIDATION_LOG << "Could not create GL handle.";
-        return false;
-      }
-      handle.second.name = gl_handle;
+      handles_to_create[type_index].push_back(&handle.second);
     }
-    // Set pending debug labels.
     if (handle.second.pending_debug_label.has_value()) {
-      if (gl.SetDebugLabel(ToDebugResourceType(handle.first.type),
-                           handle.second.name.value(),
-                           handle.second.pending_debug_label.value())) {
-        handle.second.pending_debug_label = std::nullopt;
-      }
+      handles_to_label.push_back(&handle);
+    }
+  }
+  for (size_t i = 0; i < kHandleTypeCount; i++) {
+    if (names_to_collect[i].empty()) {
+      continue;
     }
+    CollectGLHandles(gl, static_cast<HandleType>(i), names_to_collect[i]);
   }
   for (const auto& handle_to_delete : handles_to_delete) {
     handles_.erase(handle_to_delete);
   }
+  std::vector<GLuint> names;
+  for (size_t i = 0; i < kHandleTypeCount; i++) {
+    if (handles_to_create[i].empty()) {
+      continue;
+    }
+    names.resize(handles_to_create[i].size());
+    if (!CreateGLHandles(gl, static_cast<HandleType>(i), names)) {
+      VALIDATION_LOG << "Could not create GL handle.";
+      return false;
+    }
+    for (size_t j = 0; j < names.size(); j++) {
+      handles_to_create[i][j]->name = names[j];
+    }
+  }
+  // Set pending debug labels.
+  for (auto* handle : handles_to_label) {
+    if (gl.SetDebugLabel(ToDebugResourceType(handle->first.type),
+                         handle->second.name.value(),
+                         handle->second.pending_debug_label.value())) {
+      handle->second.pending_debug_label = std::nullopt;
+    }
+  }
   return true;
 }
 
@@ -247,15 +314,11 @@ bool ReactorGLES::FlushOps() {
 
   // Do NOT hold the ops or handles locks while performing operations in case
   // the ops enqueue more ops.
-  decltype(ops_) ops;
-  {
-    Lock ops_lock(ops_mutex_);
-    std::swap(ops_, ops);
-  }
-  for (const auto& op : ops) {
+  for (const auto& op : ops_to_flush_) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
-    op(*this);
+    op();
   }
+  ops_to_flush_.clear();
   return true;
 }
 
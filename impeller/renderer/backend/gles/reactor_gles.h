@@ -5,10 +5,12 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 
-#include <functional>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "flutter/fml/unique_closure.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
@@ -141,7 +143,8 @@ class ReactorGLES {
   //----------------------------------------------------------------------------
   /// @brief      Returns the OpenGL handle for a reactor handle if one is
   ///             available. This is typically only safe to call within a
-  ///             reaction. That is, within a `ReactorGLES::Operation`.
+  ///             reaction. That is, within an operation added with
+  ///             `AddOperation`.
   ///
   ///             Asking for the OpenGL handle before the reactor has a chance
   ///             to reactor will return `std::nullopt`.
@@ -191,8 +194,6 @@ class ReactorGLES {
   ///
   void SetDebugLabel(const HandleGLES& handle, std::string label);
 
-  using Operation = std::function<void(const ReactorGLES& reactor)>;
-
   //----------------------------------------------------------------------------
   /// @brief      Adds an operation that the reactor runs on a worker that
   ///             ensures that an OpenGL context is current.
@@ -202,11 +203,31 @@ class ReactorGLES {
   ///             there is a reactor worker and the reactor itself is not being
   ///             torn down.
   ///
+  ///             The operation is called with this reactor. It is queued as a
+  ///             move-only `fml::UniqueClosure`, so it may capture move-only
+  ///             state and small captures are not allocated separately.
+  ///
   /// @param[in]  operation  The operation
   ///
   /// @return     If the operation was successfully queued for completion.
   ///
-  [[nodiscard]] bool AddOperation(Operation operation);
+  template <typename Operation,
+            typename = std::enable_if_t<
+                std::is_invocable_v<std::decay_t<Operation>&,
+                                    const ReactorGLES&>>>
+  [[nodiscard]] bool AddOperation(Operation&& operation) {
+    if constexpr (std::is_constructible_v<bool,
+                                          const std::decay_t<Operation>&>) {
+      if (!static_cast<bool>(operation)) {
+        return false;
+      }
+    }
+    return EnqueueOperation(fml::UniqueClosure(
+        [reactor = this,
+         operation = std::forward<Operation>(operation)]() mutable {
+          operation(*reactor);
+        }));
+  }
 
   //----------------------------------------------------------------------------
   /// @brief      Perform a reaction on the current thread if able.
@@ -235,7 +256,11 @@ class ReactorGLES {
 
   Mutex ops_execution_mutex_;
   mutable Mutex ops_mutex_;
-  std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  std::vector<fml::UniqueClosure> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  // The operations being executed. Swapped with |ops_| so that both vectors
+  // keep their capacity across reactions.
+  std::vector<fml::UniqueClosure> ops_to_flush_
+      IPLR_GUARDED_BY(ops_execution_mutex_);
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -253,15 +278,17 @@ class ReactorGLES {
   bool can_set_debug_labels_ = false;
   bool is_valid_ = false;
 
+  bool EnqueueOperation(fml::UniqueClosure operation);
+
   bool ReactOnce() IPLR_REQUIRES(ops_execution_mutex_);
 
-  bool HasPendingOperations() const;
+  bool TakePendingOperations() IPLR_REQUIRES(ops_execution_mutex_);
 
   bool CanReactOnCurrentThread() const;
 
   bool ConsolidateHandles();
 
-  bool FlushOps();
+  bool FlushOps() IPLR_REQUIRES(ops_execution_mutex_);
 
   void SetupDebugGroups();
 
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+
+namespace {
+
+class BenchmarkWorker final : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+// Shared by all threads of a benchmark run. Only the first thread sets them up
+// and tears them down, outside of the timed loop.
+std::shared_ptr<testing::MockGLES> mock_gles;
+std::shared_ptr<ReactorGLES> reactor;
+std::shared_ptr<BenchmarkWorker> worker;
+std::atomic<size_t> executed_operations = 0u;
+
+}  // namespace
+
+// Adds operations to a reactor from every thread of the benchmark. Each thread
+// also reacts, contending for execution like the raster and IO threads do.
+static void BM_ReactorAddOperation(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    mock_gles = testing::MockGLES::Init();
+    reactor = std::make_shared<ReactorGLES>(
+        std::make_unique<ProcTableGLES>(testing::kMockResolverGLES));
+    worker = std::make_shared<BenchmarkWorker>();
+    reactor->AddWorker(worker);
+    executed_operations = 0u;
+  }
+  for (auto _ : state) {
+    auto added = reactor->AddOperation([](const ReactorGLES& reactor) {
+      executed_operations.fetch_add(1u, std::memory_order_relaxed);
+    });
+    benchmark::DoNotOptimize(added);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    [[maybe_unused]] auto reacted = reactor->React();
+    reactor.reset();
+    worker.reset();
+    mock_gles.reset();
+  }
+}
+
+BENCHMARK(BM_ReactorAddOperation)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace impeller
@@ -20,12 +20,15 @@
 
 namespace impeller {
 
-RenderPassGLES::RenderPassGLES(std::shared_ptr<const Context> context,
-                               const RenderTarget& target,
-                               ReactorGLES::Ref reactor)
+RenderPassGLES::RenderPassGLES(
+    std::shared_ptr<const Context> context,
+    const RenderTarget& target,
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations)
     : RenderPass(std::move(context), target),
       reactor_(std::move(reactor)),
-      is_valid_(reactor_ && reactor_->IsValid()) {}
+      pending_operations_(std::move(pending_operations)),
+      is_valid_(reactor_ && reactor_->IsValid() && pending_operations_) {}
 
 // |RenderPass|
 RenderPassGLES::~RenderPassGLES() = default;
@@ -42,20 +45,23 @@ void RenderPassGLES::OnSetLabel(std::string label) {
 
 void ConfigureBlending(const ProcTableGLES& gl,
                        const ColorAttachmentDescriptor* color) {
+  auto& state = gl.GetStateCache();
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.Enable(gl, GL_BLEND);
+    state.BlendFuncSeparate(
+        gl,                                            //
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
+        gl,                                       //
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.Disable(gl, GL_BLEND);
   }
 
   {
@@ -64,7 +70,8 @@ void ConfigureBlending(const ProcTableGLES& gl,
       return (mask & check) ? GL_TRUE : GL_FALSE;
     };
 
-    gl.ColorMask(
+    state.ColorMask(
+        gl,                                                     //
         is_set(color->write_mask, ColorWriteMaskBits::kRed),    // red
         is_set(color->write_mask, ColorWriteMaskBits::kGreen),  // green
         is_set(color->write_mask, ColorWriteMaskBits::kBlue),   // blue
@@ -77,29 +84,33 @@ void ConfigureStencil(GLenum face,
                       const ProcTableGLES& gl,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  auto& state = gl.GetStateCache();
+  state.StencilOpSeparate(
+      gl,                                      //
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      gl,                                          //
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(gl, face, stencil.write_mask);
 }
 
 void ConfigureStencil(const ProcTableGLES& gl,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    gl.GetStateCache().Disable(gl, GL_STENCIL_TEST);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  gl.GetStateCache().Enable(gl, GL_STENCIL_TEST);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
@@ -150,6 +161,9 @@ struct RenderPassData {
   TRACE_EVENT0("impeller", "RenderPassGLES::EncodeCommandsInReactor");
 
   const auto& gl = reactor.GetProcTable();
+  // Code outside of Impeller may have used the context since the last pass.
+  auto& state = gl.GetStateCache();
+  state.Invalidate();
 #ifdef IMPELLER_DEBUG
   tracer->MarkFrameStart(gl);
 #endif  // IMPELLER_DEBUG
@@ -236,16 +250,16 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.Disable(GL_DITHER);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-  gl.DepthMask(GL_TRUE);
-  gl.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
-  gl.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Disable(gl, GL_DEPTH_TEST);
+  state.Disable(gl, GL_STENCIL_TEST);
+  state.Disable(gl, GL_CULL_FACE);
+  state.Disable(gl, GL_BLEND);
+  state.Disable(gl, GL_DITHER);
+  state.ColorMask(gl, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.DepthMask(gl, GL_TRUE);
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFFFFFFFF);
+  state.StencilMaskSeparate(gl, GL_BACK, 0xFFFFFFFF);
 
   gl.Clear(clear_bits);
 
@@ -296,11 +310,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.Enable(gl, GL_DEPTH_TEST);
+      state.DepthFunc(gl, ToCompareFunction(depth->depth_compare));
+      state.DepthMask(gl, depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.Disable(gl, GL_DEPTH_TEST);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -312,18 +326,16 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.GetX(),  // x
-                target_size.height - viewport.rect.GetY() -
-                    viewport.rect.GetHeight(),  // y
-                viewport.rect.GetWidth(),       // width
-                viewport.rect.GetHeight()       // height
+    state.Viewport(gl,                   //
+                   viewport.rect.GetX(),  // x
+                   target_size.height - viewport.rect.GetY() -
+                       viewport.rect.GetHeight(),  // y
+                   viewport.rect.GetWidth(),       // width
+                   viewport.rect.GetHeight()       // height
     );
     if (pass_data.depth_attachment) {
-      if (gl.DepthRangef.IsAvailable()) {
-        gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      } else {
-        gl.DepthRange(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      }
+      state.DepthRange(gl, viewport.depth_range.z_near,
+                       viewport.depth_range.z_far);
     }
 
     //--------------------------------------------------------------------------
@@ -331,15 +343,16 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.Enable(gl, GL_SCISSOR_TEST);
+      state.Scissor(
+          gl,                                                         //
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
           scissor.GetHeight()                                         // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.Disable(gl, GL_SCISSOR_TEST);
     }
 
     //--------------------------------------------------------------------------
@@ -347,15 +360,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.Disable(gl, GL_CULL_FACE);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.Enable(gl, GL_CULL_FACE);
+        state.CullFace(gl, GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.Enable(gl, GL_CULL_FACE);
+        state.CullFace(gl, GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -363,10 +376,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(gl, GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(gl, GL_CCW);
         break;
     }
 
@@ -457,22 +470,16 @@ struct RenderPassData {
                           index_buffer_view.range.offset))  // indices
       );
     }
-
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
-      return false;
-    }
-
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
   }
 
+  //--------------------------------------------------------------------------
+  /// Unbind the vertex attribs and the program. They are left bound between
+  /// commands so that consecutive commands using the same pipeline do not
+  /// bind them again.
+  ///
+  state.SetEnabledVertexAttribArrays(gl, 0u);
+  state.UseProgram(gl, GL_NONE);
+
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
     std::vector<GLenum> attachments;
 
@@ -568,14 +575,17 @@ bool RenderPassGLES::OnEncodeCommands(const Context& context) const {
 
   std::shared_ptr<const RenderPassGLES> shared_this = shared_from_this();
   auto tracer = ContextGLES::Cast(context).GetGPUTracer();
-  return reactor_->AddOperation([pass_data,
-                                 allocator = context.GetResourceAllocator(),
-                                 render_pass = std::move(shared_this),
-                                 tracer](const auto& reactor) {
-    auto result = EncodeCommandsInReactor(*pass_data, allocator, reactor,
-                                          render_pass->commands_, tracer);
-    FML_CHECK(result) << "Must be able to encode GL commands without error.";
-  });
+  // Runs when the command buffer is submitted.
+  pending_operations_->emplace_back(
+      [reactor = reactor_, pass_data,
+       allocator = context.GetResourceAllocator(),
+       render_pass = std::move(shared_this), tracer]() {
+        auto result = EncodeCommandsInReactor(*pass_data, allocator, *reactor,
+                                              render_pass->commands_, tracer);
+        FML_CHECK(result)
+            << "Must be able to encode GL commands without error.";
+      });
+  return true;
 }
 
 }  // namespace impeller
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_RENDER_PASS_GLES_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
 #include "flutter/impeller/renderer/render_pass.h"
@@ -23,12 +24,15 @@ class RenderPassGLES final
   friend class CommandBufferGLES;
 
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations_;
   std::string label_;
   bool is_valid_ = false;
 
-  RenderPassGLES(std::shared_ptr<const Context> context,
-                 const RenderTarget& target,
-                 ReactorGLES::Ref reactor);
+  RenderPassGLES(
+      std::shared_ptr<const Context> context,
+      const RenderTarget& target,
+      ReactorGLES::Ref reactor,
+      std::shared_ptr<std::vector<fml::UniqueClosure>> pending_operations);
 
   // |RenderPass|
   bool IsValid() const override;
@@ -0,0 +1,252 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+namespace {
+
+/// Records `value` as the new state, and returns whether it differs from the
+/// previous one (or whether the previous one is unknown).
+template <class T>
+bool UpdateState(std::optional<T>& state, const T& value) {
+  if (state.has_value() && state.value() == value) {
+    return false;
+  }
+  state = value;
+  return true;
+}
+
+/// The faces of the stencil state a call to one of the `*Separate` stencil
+/// functions applies to, as bits for the front and the back face.
+uint32_t GetStencilFaces(GLenum face) {
+  switch (face) {
+    case GL_FRONT:
+      return 0b01u;
+    case GL_BACK:
+      return 0b10u;
+    case GL_FRONT_AND_BACK:
+      return 0b11u;
+  }
+  return 0u;
+}
+
+/// Applies the state to the given faces. Returns whether any of them changed.
+template <class T>
+bool UpdateStencilState(uint32_t faces,
+                        std::optional<T>& front,
+                        std::optional<T>& back,
+                        const T& value) {
+  bool changed = false;
+  if (faces & 0b01u) {
+    changed |= UpdateState(front, value);
+  }
+  if (faces & 0b10u) {
+    changed |= UpdateState(back, value);
+  }
+  // Unknown faces must be treated as changed.
+  return changed || faces == 0u;
+}
+
+}  // namespace
+
+StateCacheGLES::StateCacheGLES() = default;
+
+StateCacheGLES::~StateCacheGLES() = default;
+
+void StateCacheGLES::Invalidate() {
+  known_capabilities_ = 0u;
+  blend_func_.reset();
+  blend_equation_.reset();
+  color_mask_.reset();
+  depth_func_.reset();
+  depth_mask_.reset();
+  depth_range_.reset();
+  stencil_ = {};
+  viewport_.reset();
+  scissor_.reset();
+  cull_face_.reset();
+  front_face_.reset();
+  program_.reset();
+  vertex_attrib_arrays_.reset();
+}
+
+bool StateCacheGLES::SetCapability(GLenum capability, bool enabled) {
+  for (size_t i = 0; i < kCapabilities.size(); i++) {
+    if (kCapabilities[i] != capability) {
+      continue;
+    }
+    const uint32_t bit = 1u << i;
+    if ((known_capabilities_ & bit) &&
+        static_cast<bool>(enabled_capabilities_ & bit) == enabled) {
+      return false;
+    }
+    known_capabilities_ |= bit;
+    if (enabled) {
+      enabled_capabilities_ |= bit;
+    } else {
+      enabled_capabilities_ &= ~bit;
+    }
+    return true;
+  }
+  // Capabilities that are not tracked always reach GL.
+  return true;
+}
+
+void StateCacheGLES::Enable(const ProcTableGLES& gl, GLenum capability) {
+  if (SetCapability(capability, true)) {
+    gl.Enable(capability);
+  }
+}
+
+void StateCacheGLES::Disable(const ProcTableGLES& gl, GLenum capability) {
+  if (SetCapability(capability, false)) {
+    gl.Disable(capability);
+  }
+}
+
+void StateCacheGLES::BlendFuncSeparate(const ProcTableGLES& gl,
+                                       GLenum src_color,
+                                       GLenum dst_color,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  if (UpdateState(blend_func_, {src_color, dst_color, src_alpha, dst_alpha})) {
+    gl.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateCacheGLES::BlendEquationSeparate(const ProcTableGLES& gl,
+                                           GLenum color_mode,
+                                           GLenum alpha_mode) {
+  if (UpdateState(blend_equation_, {color_mode, alpha_mode})) {
+    gl.BlendEquationSeparate(color_mode, alpha_mode);
+  }
+}
+
+void StateCacheGLES::ColorMask(const ProcTableGLES& gl,
+                               GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  if (UpdateState(color_mask_, {red, green, blue, alpha})) {
+    gl.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateCacheGLES::DepthFunc(const ProcTableGLES& gl, GLenum func) {
+  if (UpdateState(depth_func_, func)) {
+    gl.DepthFunc(func);
+  }
+}
+
+void StateCacheGLES::DepthMask(const ProcTableGLES& gl, GLboolean mask) {
+  if (UpdateState(depth_mask_, mask)) {
+    gl.DepthMask(mask);
+  }
+}
+
+void StateCacheGLES::DepthRange(const ProcTableGLES& gl,
+                                GLfloat z_near,
+                                GLfloat z_far) {
+  if (!UpdateState(depth_range_, {z_near, z_far})) {
+    return;
+  }
+  if (gl.DepthRangef.IsAvailable()) {
+    gl.DepthRangef(z_near, z_far);
+  } else {
+    gl.DepthRange(z_near, z_far);
+  }
+}
+
+void StateCacheGLES::StencilOpSeparate(const ProcTableGLES& gl,
+                                       GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_stencil_pass) {
+  if (UpdateStencilState<std::array<GLenum, 3u>>(
+          GetStencilFaces(face), stencil_[0].op, stencil_[1].op,
+          {stencil_fail, depth_fail, depth_stencil_pass})) {
+    gl.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  }
+}
+
+void StateCacheGLES::StencilFuncSeparate(const ProcTableGLES& gl,
+                                         GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  if (UpdateStencilState<std::array<GLuint, 3u>>(
+          GetStencilFaces(face), stencil_[0].func, stencil_[1].func,
+          {func, static_cast<GLuint>(ref), mask})) {
+    gl.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void StateCacheGLES::StencilMaskSeparate(const ProcTableGLES& gl,
+                                         GLenum face,
+                                         GLuint mask) {
+  if (UpdateStencilState(GetStencilFaces(face), stencil_[0].write_mask,
+                         stencil_[1].write_mask, mask)) {
+    gl.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateCacheGLES::Viewport(const ProcTableGLES& gl,
+                              GLint x,
+                              GLint y,
+                              GLsizei width,
+                              GLsizei height) {
+  if (UpdateState(viewport_, {x, y, width, height})) {
+    gl.Viewport(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::Scissor(const ProcTableGLES& gl,
+                             GLint x,
+                             GLint y,
+                             GLsizei width,
+                             GLsizei height) {
+  if (UpdateState(scissor_, {x, y, width, height})) {
+    gl.Scissor(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::CullFace(const ProcTableGLES& gl, GLenum mode) {
+  if (UpdateState(cull_face_, mode)) {
+    gl.CullFace(mode);
+  }
+}
+
+void StateCacheGLES::FrontFace(const ProcTableGLES& gl, GLenum mode) {
+  if (UpdateState(front_face_, mode)) {
+    gl.FrontFace(mode);
+  }
+}
+
+void StateCacheGLES::UseProgram(const ProcTableGLES& gl, GLuint program) {
+  if (UpdateState(program_, program)) {
+    gl.UseProgram(program);
+  }
+}
+
+void StateCacheGLES::SetEnabledVertexAttribArrays(const ProcTableGLES& gl,
+                                                  uint32_t mask) {
+  // Arrays not enabled through the cache are assumed to be disabled.
+  const uint32_t enabled = vertex_attrib_arrays_.value_or(0u);
+  const bool known = vertex_attrib_arrays_.has_value();
+  for (GLuint index = 0u; index < 32u; index++) {
+    const uint32_t bit = 1u << index;
+    if ((mask & bit) && (!known || !(enabled & bit))) {
+      gl.EnableVertexAttribArray(index);
+    } else if (!(mask & bit) && (enabled & bit)) {
+      gl.DisableVertexAttribArray(index);
+    }
+  }
+  vertex_attrib_arrays_ = mask;
+}
+
+}  // namespace impeller
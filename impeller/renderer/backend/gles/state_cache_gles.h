@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "impeller/renderer/backend/gles/gles.h"
+
+namespace impeller {
+
+class ProcTableGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      A shadow of the fixed function state of a GL context that
+///             filters out calls that would set state to the value it already
+///             has.
+///
+///             The shadow only knows about the calls made through it. Any
+///             other code using the context (the embedder, another GL client
+///             sharing the context, or code calling the proc table directly)
+///             may change the state behind its back, so the shadow must be
+///             invalidated before it is used after such code may have run.
+///             Render passes invalidate it before they are encoded.
+///
+///             Like the context itself, the cache must only be used on the
+///             thread the context is current on.
+///
+class StateCacheGLES {
+ public:
+  StateCacheGLES();
+
+  ~StateCacheGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all state so that the next call to each setter
+  ///             reaches GL.
+  ///
+  void Invalidate();
+
+  void Enable(const ProcTableGLES& gl, GLenum capability);
+
+  void Disable(const ProcTableGLES& gl, GLenum capability);
+
+  void BlendFuncSeparate(const ProcTableGLES& gl,
+                         GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(const ProcTableGLES& gl,
+                             GLenum color_mode,
+                             GLenum alpha_mode);
+
+  void ColorMask(const ProcTableGLES& gl,
+                 GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void DepthFunc(const ProcTableGLES& gl, GLenum func);
+
+  void DepthMask(const ProcTableGLES& gl, GLboolean mask);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the depth range with `glDepthRangef` where available,
+  ///             and with `glDepthRange` otherwise.
+  ///
+  void DepthRange(const ProcTableGLES& gl, GLfloat z_near, GLfloat z_far);
+
+  void StencilOpSeparate(const ProcTableGLES& gl,
+                         GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(const ProcTableGLES& gl,
+                           GLenum face,
+                           GLenum func,
+                           GLint ref,
+                           GLuint mask);
+
+  void StencilMaskSeparate(const ProcTableGLES& gl, GLenum face, GLuint mask);
+
+  void Viewport(const ProcTableGLES& gl,
+                GLint x,
+                GLint y,
+                GLsizei width,
+                GLsizei height);
+
+  void Scissor(const ProcTableGLES& gl,
+               GLint x,
+               GLint y,
+               GLsizei width,
+               GLsizei height);
+
+  void CullFace(const ProcTableGLES& gl, GLenum mode);
+
+  void FrontFace(const ProcTableGLES& gl, GLenum mode);
+
+  void UseProgram(const ProcTableGLES& gl, GLuint program);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables exactly the generic vertex attribute arrays whose
+  ///             bits are set in `mask`, and disables all others that were
+  ///             enabled through the cache.
+  ///
+  void SetEnabledVertexAttribArrays(const ProcTableGLES& gl, uint32_t mask);
+
+ private:
+  /// The capabilities toggled by Impeller, in the order of the bits of
+  /// |enabled_capabilities_| and |known_capabilities_|.
+  static constexpr std::array<GLenum, 6u> kCapabilities = {
+      GL_BLEND,         //
+      GL_CULL_FACE,     //
+      GL_DEPTH_TEST,    //
+      GL_DITHER,        //
+      GL_SCISSOR_TEST,  //
+      GL_STENCIL_TEST,  //
+  };
+
+  /// The stencil state of the front and the back faces, in that order.
+  struct StencilState {
+    std::optional<std::array<GLenum, 3u>> op;
+    std::optional<std::array<GLuint, 3u>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  uint32_t enabled_capabilities_ = 0u;
+  uint32_t known_capabilities_ = 0u;
+  std::optional<std::array<GLenum, 4u>> blend_func_;
+  std::optional<std::array<GLenum, 2u>> blend_equation_;
+  std::optional<std::array<GLboolean, 4u>> color_mask_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLfloat, 2u>> depth_range_;
+  std::array<StencilState, 2u> stencil_;
+  std::optional<std::array<GLint, 4u>> viewport_;
+  std::optional<std::array<GLint, 4u>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::optional<uint32_t> vertex_attrib_arrays_;
+
+  bool SetCapability(GLenum capability, bool enabled);
+
+  StateCacheGLES(const StateCacheGLES&) = delete;
+
+  StateCacheGLES& operator=(const StateCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
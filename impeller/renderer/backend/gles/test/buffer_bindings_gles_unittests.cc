@@ -0,0 +1,318 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/base/allocation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
+#include "impeller/renderer/backend/gles/device_buffer_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// A program with one active uniform per uniform struct member below. The
+// location of each uniform is its index plus one.
+const char* kActiveUniforms[] = {"FrameInfo.mvp", "FragInfo.color"};
+
+struct UniformCalls {
+  int matrix_uploads = 0;
+  int vector_uploads = 0;
+  GLint last_location = -1;
+};
+
+UniformCalls g_uniform_calls;
+
+GLboolean mockIsProgram(GLuint program) {
+  return GL_TRUE;
+}
+
+void mockGetProgramiv(GLuint program, GLenum name, GLint* value) {
+  switch (name) {
+    case GL_ACTIVE_UNIFORMS:
+      *value = std::size(kActiveUniforms);
+      break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+      *value = 32;
+      break;
+    default:
+      *value = 0;
+      break;
+  }
+}
+
+void mockGetActiveUniform(GLuint program,
+                          GLuint index,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLint* size,
+                          GLenum* type,
+                          GLchar* name) {
+  *length = std::strlen(kActiveUniforms[index]);
+  *size = 1;
+  std::strncpy(name, kActiveUniforms[index], buffer_size);
+}
+
+GLint mockGetUniformLocation(GLuint program, const GLchar* name) {
+  for (size_t i = 0; i < std::size(kActiveUniforms); i++) {
+    if (std::strcmp(name, kActiveUniforms[i]) == 0) {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+void mockUniformMatrix4fv(GLint location,
+                          GLsizei count,
+                          GLboolean transpose,
+                          const GLfloat* value) {
+  g_uniform_calls.matrix_uploads++;
+  g_uniform_calls.last_location = location;
+}
+
+void mockUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+  g_uniform_calls.vector_uploads++;
+  g_uniform_calls.last_location = location;
+}
+
+const ProcTableGLES::Resolver kUniformResolver = [](const char* name) {
+  if (std::strcmp(name, "glIsProgram") == 0) {
+    return reinterpret_cast<void*>(&mockIsProgram);
+  } else if (std::strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramiv);
+  } else if (std::strcmp(name, "glGetActiveUniform") == 0) {
+    return reinterpret_cast<void*>(&mockGetActiveUniform);
+  } else if (std::strcmp(name, "glGetUniformLocation") == 0) {
+    return reinterpret_cast<void*>(&mockGetUniformLocation);
+  } else if (std::strcmp(name, "glUniformMatrix4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniformMatrix4fv);
+  } else if (std::strcmp(name, "glUniform4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniform4fv);
+  }
+  return kMockResolverGLES(name);
+};
+
+// Uniform buffers are read from host memory and never allocated here.
+class TestAllocator final : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+ private:
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+const ShaderMetadata kFrameInfoMetadata = {
+    .name = "FrameInfo",
+    .members = {{.type = ShaderType::kFloat,
+                 .name = "mvp",
+                 .offset = 0u,
+                 .size = sizeof(Matrix),
+                 .byte_length = sizeof(Matrix)}},
+};
+
+// The same uniform as above, with a type the backend cannot upload.
+const ShaderMetadata kUnsupportedFrameInfoMetadata = {
+    .name = "FrameInfo",
+    .members = {{.type = ShaderType::kSignedInt,
+                 .name = "mvp",
+                 .offset = 0u,
+                 .size = sizeof(Matrix),
+                 .byte_length = sizeof(Matrix)}},
+};
+
+const ShaderMetadata kFragInfoMetadata = {
+    .name = "FragInfo",
+    .members = {{.type = ShaderType::kFloat,
+                 .name = "color",
+                 .offset = 0u,
+                 .size = sizeof(Vector4),
+                 .byte_length = sizeof(Vector4)}},
+};
+
+std::shared_ptr<DeviceBufferGLES> MakeUniformBuffer(const void* data,
+                                                    size_t size) {
+  auto backing_store = std::make_shared<Allocation>();
+  FML_CHECK(backing_store->Truncate(Bytes{size}));
+  std::memcpy(backing_store->GetBuffer(), data, size);
+  DeviceBufferDescriptor desc;
+  desc.size = size;
+  return std::make_shared<DeviceBufferGLES>(desc, nullptr,
+                                            std::move(backing_store));
+}
+
+BufferAndUniformSlot MakeBinding(const ShaderMetadata& metadata,
+                                 std::shared_ptr<DeviceBufferGLES> buffer) {
+  size_t size = buffer->GetDeviceBufferDescriptor().size;
+  return BufferAndUniformSlot{
+      .slot = ShaderUniformSlot{.name = metadata.name.c_str()},
+      .view = BufferResource(&metadata,
+                             BufferView{std::move(buffer), Range{0u, size}}),
+  };
+}
+
+}  // namespace
+
+class BufferBindingsGLESTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    mock_gles_ =
+        MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kUniformResolver);
+    g_uniform_calls = {};
+  }
+
+  void TearDown() override { mock_gles_.reset(); }
+
+  const ProcTableGLES& GetProcTable() const {
+    return mock_gles_->GetProcTable();
+  }
+
+ private:
+  std::shared_ptr<MockGLES> mock_gles_;
+};
+
+TEST_F(BufferBindingsGLESTest, SkipsUploadsOfUnchangedUniforms) {
+  const auto& gl = GetProcTable();
+  TestAllocator allocator;
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(
+      gl, 1u, std::make_shared<UniformValueCacheGLES>()));
+
+  Matrix mvp = Matrix::MakeScale({2, 2, 1});
+  Bindings vertex_bindings;
+  vertex_bindings.buffers.push_back(
+      MakeBinding(kFrameInfoMetadata, MakeUniformBuffer(&mvp, sizeof(mvp))));
+  Bindings fragment_bindings;
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(bindings.BindUniformData(gl, allocator, vertex_bindings,
+                                         fragment_bindings));
+  }
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 1);
+  EXPECT_EQ(g_uniform_calls.last_location, 1);
+
+  Matrix translated = Matrix::MakeTranslation({1, 2, 3});
+  vertex_bindings.buffers[0] = MakeBinding(
+      kFrameInfoMetadata, MakeUniformBuffer(&translated, sizeof(translated)));
+  ASSERT_TRUE(bindings.BindUniformData(gl, allocator, vertex_bindings,
+                                       fragment_bindings));
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 2);
+}
+
+TEST_F(BufferBindingsGLESTest, UploadsEveryDrawWithoutValueCache) {
+  const auto& gl = GetProcTable();
+  TestAllocator allocator;
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(gl, 1u));
+
+  Matrix mvp;
+  Bindings vertex_bindings;
+  vertex_bindings.buffers.push_back(
+      MakeBinding(kFrameInfoMetadata, MakeUniformBuffer(&mvp, sizeof(mvp))));
+  Bindings fragment_bindings;
+
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(bindings.BindUniformData(gl, allocator, vertex_bindings,
+                                         fragment_bindings));
+  }
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 3);
+}
+
+TEST_F(BufferBindingsGLESTest, PipelinesSharingAProgramShareUniformValues) {
+  const auto& gl = GetProcTable();
+  TestAllocator allocator;
+  auto uniform_values = std::make_shared<UniformValueCacheGLES>();
+  BufferBindingsGLES first;
+  BufferBindingsGLES second;
+  ASSERT_TRUE(first.ReadUniformsBindings(gl, 1u, uniform_values));
+  ASSERT_TRUE(second.ReadUniformsBindings(gl, 1u, uniform_values));
+
+  Matrix a = Matrix::MakeScale({2, 2, 1});
+  Matrix b = Matrix::MakeScale({3, 3, 1});
+  Bindings bindings_a;
+  bindings_a.buffers.push_back(
+      MakeBinding(kFrameInfoMetadata, MakeUniformBuffer(&a, sizeof(a))));
+  Bindings bindings_b;
+  bindings_b.buffers.push_back(
+      MakeBinding(kFrameInfoMetadata, MakeUniformBuffer(&b, sizeof(b))));
+  Bindings empty;
+
+  ASSERT_TRUE(first.BindUniformData(gl, allocator, bindings_a, empty));
+  ASSERT_TRUE(second.BindUniformData(gl, allocator, bindings_a, empty));
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 1);
+
+  // The second pipeline changes the program's value, so the first one must
+  // upload its value again.
+  ASSERT_TRUE(second.BindUniformData(gl, allocator, bindings_b, empty));
+  ASSERT_TRUE(first.BindUniformData(gl, allocator, bindings_a, empty));
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 3);
+}
+
+TEST_F(BufferBindingsGLESTest, DoesNotRecordValuesThatFailedToUpload) {
+  const auto& gl = GetProcTable();
+  TestAllocator allocator;
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(
+      gl, 1u, std::make_shared<UniformValueCacheGLES>()));
+
+  Matrix mvp = Matrix::MakeScale({2, 2, 1});
+  auto buffer = MakeUniformBuffer(&mvp, sizeof(mvp));
+  Bindings unsupported;
+  unsupported.buffers.push_back(
+      MakeBinding(kUnsupportedFrameInfoMetadata, buffer));
+  Bindings supported;
+  supported.buffers.push_back(MakeBinding(kFrameInfoMetadata, buffer));
+  Bindings empty;
+
+  EXPECT_FALSE(bindings.BindUniformData(gl, allocator, unsupported, empty));
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 0);
+
+  // The program does not hold the value yet, so it must be uploaded.
+  ASSERT_TRUE(bindings.BindUniformData(gl, allocator, supported, empty));
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 1);
+}
+
+TEST_F(BufferBindingsGLESTest, ResolvesLocationsAgainWhenSlotContentsChange) {
+  const auto& gl = GetProcTable();
+  TestAllocator allocator;
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(
+      gl, 1u, std::make_shared<UniformValueCacheGLES>()));
+
+  Matrix mvp;
+  Vector4 color(1, 0, 0, 1);
+  Bindings empty;
+  Bindings frame_info;
+  frame_info.buffers.push_back(
+      MakeBinding(kFrameInfoMetadata, MakeUniformBuffer(&mvp, sizeof(mvp))));
+  Bindings frag_info;
+  frag_info.buffers.push_back(
+      MakeBinding(kFragInfoMetadata, MakeUniformBuffer(&color, sizeof(color))));
+
+  // Bind different structs at the first fragment slot.
+  ASSERT_TRUE(bindings.BindUniformData(gl, allocator, empty, frame_info));
+  EXPECT_EQ(g_uniform_calls.last_location, 1);
+  ASSERT_TRUE(bindings.BindUniformData(gl, allocator, empty, frag_info));
+  EXPECT_EQ(g_uniform_calls.last_location, 2);
+  EXPECT_EQ(g_uniform_calls.matrix_uploads, 1);
+  EXPECT_EQ(g_uniform_calls.vector_uploads, 1);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -163,6 +163,210 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  RecordGLCall("glEnable");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  RecordGLCall("glDisable");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockBlendFuncSeparate(GLenum src_color,
+                           GLenum dst_color,
+                           GLenum src_alpha,
+                           GLenum dst_alpha) {
+  RecordGLCall("glBlendFuncSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockBlendFuncSeparate),  //
+                                 decltype(glBlendFuncSeparate)>::value);
+
+void mockBlendEquationSeparate(GLenum color_mode, GLenum alpha_mode) {
+  RecordGLCall("glBlendEquationSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockBlendEquationSeparate),  //
+                                 decltype(glBlendEquationSeparate)>::value);
+
+void mockColorMask(GLboolean red,
+                   GLboolean green,
+                   GLboolean blue,
+                   GLboolean alpha) {
+  RecordGLCall("glColorMask");
+}
+
+static_assert(CheckSameSignature<decltype(mockColorMask),  //
+                                 decltype(glColorMask)>::value);
+
+void mockDepthFunc(GLenum func) {
+  RecordGLCall("glDepthFunc");
+}
+
+static_assert(CheckSameSignature<decltype(mockDepthFunc),  //
+                                 decltype(glDepthFunc)>::value);
+
+void mockDepthMask(GLboolean flag) {
+  RecordGLCall("glDepthMask");
+}
+
+static_assert(CheckSameSignature<decltype(mockDepthMask),  //
+                                 decltype(glDepthMask)>::value);
+
+void mockDepthRangef(GLfloat z_near, GLfloat z_far) {
+  RecordGLCall("glDepthRangef");
+}
+
+static_assert(CheckSameSignature<decltype(mockDepthRangef),  //
+                                 decltype(glDepthRangef)>::value);
+
+void mockStencilOpSeparate(GLenum face,
+                           GLenum sfail,
+                           GLenum dpfail,
+                           GLenum dppass) {
+  RecordGLCall("glStencilOpSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilOpSeparate),  //
+                                 decltype(glStencilOpSeparate)>::value);
+
+void mockStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+  RecordGLCall("glStencilFuncSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilFuncSeparate),  //
+                                 decltype(glStencilFuncSeparate)>::value);
+
+void mockStencilMaskSeparate(GLenum face, GLuint mask) {
+  RecordGLCall("glStencilMaskSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilMaskSeparate),  //
+                                 decltype(glStencilMaskSeparate)>::value);
+
+void mockViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glViewport");
+}
+
+static_assert(CheckSameSignature<decltype(mockViewport),  //
+                                 decltype(glViewport)>::value);
+
+void mockScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glScissor");
+}
+
+static_assert(CheckSameSignature<decltype(mockScissor),  //
+                                 decltype(glScissor)>::value);
+
+void mockCullFace(GLenum mode) {
+  RecordGLCall("glCullFace");
+}
+
+static_assert(CheckSameSignature<decltype(mockCullFace),  //
+                                 decltype(glCullFace)>::value);
+
+void mockFrontFace(GLenum mode) {
+  RecordGLCall("glFrontFace");
+}
+
+static_assert(CheckSameSignature<decltype(mockFrontFace),  //
+                                 decltype(glFrontFace)>::value);
+
+void mockUseProgram(GLuint program) {
+  RecordGLCall("glUseProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockEnableVertexAttribArray(GLuint index) {
+  RecordGLCall("glEnableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnableVertexAttribArray),  //
+                                 decltype(glEnableVertexAttribArray)>::value);
+
+void mockDisableVertexAttribArray(GLuint index) {
+  RecordGLCall("glDisableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisableVertexAttribArray),  //
+                                 decltype(glDisableVertexAttribArray)>::value);
+
+// Object names handed out by the mocked glGen* calls.
+static GLuint g_next_object_name = 1u;
+
+static void GenObjectNames(GLsizei n, GLuint* names) {
+  for (GLsizei i = 0; i < n; i++) {
+    names[i] = g_next_object_name++;
+  }
+}
+
+void mockGenTextures(GLsizei n, GLuint* textures) {
+  RecordGLCall("glGenTextures");
+  GenObjectNames(n, textures);
+}
+
+static_assert(CheckSameSignature<decltype(mockGenTextures),  //
+                                 decltype(glGenTextures)>::value);
+
+void mockDeleteTextures(GLsizei n, const GLuint* textures) {
+  RecordGLCall("glDeleteTextures");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteTextures),  //
+                                 decltype(glDeleteTextures)>::value);
+
+void mockGenBuffers(GLsizei n, GLuint* buffers) {
+  RecordGLCall("glGenBuffers");
+  GenObjectNames(n, buffers);
+}
+
+static_assert(CheckSameSignature<decltype(mockGenBuffers),  //
+                                 decltype(glGenBuffers)>::value);
+
+void mockDeleteBuffers(GLsizei n, const GLuint* buffers) {
+  RecordGLCall("glDeleteBuffers");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteBuffers),  //
+                                 decltype(glDeleteBuffers)>::value);
+
+void mockGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+  RecordGLCall("glGenRenderbuffers");
+  GenObjectNames(n, renderbuffers);
+}
+
+static_assert(CheckSameSignature<decltype(mockGenRenderbuffers),  //
+                                 decltype(glGenRenderbuffers)>::value);
+
+void mockDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+  RecordGLCall("glDeleteRenderbuffers");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteRenderbuffers),  //
+                                 decltype(glDeleteRenderbuffers)>::value);
+
+void mockGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+  RecordGLCall("glGenFramebuffers");
+  GenObjectNames(n, framebuffers);
+}
+
+static_assert(CheckSameSignature<decltype(mockGenFramebuffers),  //
+                                 decltype(glGenFramebuffers)>::value);
+
+void mockDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+  RecordGLCall("glDeleteFramebuffers");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteFramebuffers),  //
+                                 decltype(glDeleteFramebuffers)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions,
     const char* version_string,
@@ -202,6 +406,58 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(&mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(&mockDisable);
+  } else if (strcmp(name, "glBlendFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockBlendFuncSeparate);
+  } else if (strcmp(name, "glBlendEquationSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockBlendEquationSeparate);
+  } else if (strcmp(name, "glColorMask") == 0) {
+    return reinterpret_cast<void*>(&mockColorMask);
+  } else if (strcmp(name, "glDepthFunc") == 0) {
+    return reinterpret_cast<void*>(&mockDepthFunc);
+  } else if (strcmp(name, "glDepthMask") == 0) {
+    return reinterpret_cast<void*>(&mockDepthMask);
+  } else if (strcmp(name, "glDepthRangef") == 0) {
+    return reinterpret_cast<void*>(&mockDepthRangef);
+  } else if (strcmp(name, "glStencilOpSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilOpSeparate);
+  } else if (strcmp(name, "glStencilFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilFuncSeparate);
+  } else if (strcmp(name, "glStencilMaskSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilMaskSeparate);
+  } else if (strcmp(name, "glViewport") == 0) {
+    return reinterpret_cast<void*>(&mockViewport);
+  } else if (strcmp(name, "glScissor") == 0) {
+    return reinterpret_cast<void*>(&mockScissor);
+  } else if (strcmp(name, "glCullFace") == 0) {
+    return reinterpret_cast<void*>(&mockCullFace);
+  } else if (strcmp(name, "glFrontFace") == 0) {
+    return reinterpret_cast<void*>(&mockFrontFace);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(&mockUseProgram);
+  } else if (strcmp(name, "glEnableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockEnableVertexAttribArray);
+  } else if (strcmp(name, "glDisableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockDisableVertexAttribArray);
+  } else if (strcmp(name, "glGenTextures") == 0) {
+    return reinterpret_cast<void*>(&mockGenTextures);
+  } else if (strcmp(name, "glDeleteTextures") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteTextures);
+  } else if (strcmp(name, "glGenBuffers") == 0) {
+    return reinterpret_cast<void*>(&mockGenBuffers);
+  } else if (strcmp(name, "glDeleteBuffers") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteBuffers);
+  } else if (strcmp(name, "glGenRenderbuffers") == 0) {
+    return reinterpret_cast<void*>(&mockGenRenderbuffers);
+  } else if (strcmp(name, "glDeleteRenderbuffers") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteRenderbuffers);
+  } else if (strcmp(name, "glGenFramebuffers") == 0) {
+    return reinterpret_cast<void*>(&mockGenFramebuffers);
+  } else if (strcmp(name, "glDeleteFramebuffers") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteFramebuffers);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/handle_gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestWorker final : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return can_react;
+  }
+
+  std::atomic<bool> can_react = true;
+};
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+}  // namespace
+
+class ReactorGLESTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    mock_gles_ = MockGLES::Init();
+    reactor_ = std::make_shared<ReactorGLES>(
+        std::make_unique<ProcTableGLES>(kMockResolverGLES));
+    ASSERT_TRUE(reactor_->IsValid());
+    worker_ = std::make_shared<TestWorker>();
+    reactor_->AddWorker(worker_);
+    // Ignore the calls made while setting up the proc table.
+    mock_gles_->GetCapturedCalls();
+  }
+
+  void TearDown() override {
+    reactor_.reset();
+    mock_gles_.reset();
+  }
+
+  MockGLES& GetMockGLES() { return *mock_gles_; }
+
+  ReactorGLES& GetReactor() { return *reactor_; }
+
+  TestWorker& GetWorker() { return *worker_; }
+
+ private:
+  std::shared_ptr<MockGLES> mock_gles_;
+  std::shared_ptr<ReactorGLES> reactor_;
+  std::shared_ptr<TestWorker> worker_;
+};
+
+TEST_F(ReactorGLESTest, CreatesPendingHandlesInOneCallPerType) {
+  auto& reactor = GetReactor();
+  GetWorker().can_react = false;
+  std::vector<HandleGLES> handles;
+  for (int i = 0; i < 10; i++) {
+    handles.push_back(reactor.CreateHandle(HandleType::kTexture));
+    handles.push_back(reactor.CreateHandle(HandleType::kBuffer));
+  }
+  EXPECT_TRUE(GetMockGLES().GetCapturedCalls().empty());
+
+  GetWorker().can_react = true;
+  std::set<GLuint> names;
+  ASSERT_TRUE(reactor.AddOperation([&](const ReactorGLES& reactor) {
+    for (const auto& handle : handles) {
+      auto name = reactor.GetGLHandle(handle);
+      ASSERT_TRUE(name.has_value());
+      names.insert(name.value());
+    }
+  }));
+  EXPECT_EQ(names.size(), handles.size());
+  auto calls = GetMockGLES().GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGenTextures"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glGenBuffers"), 1u);
+}
+
+TEST_F(ReactorGLESTest, CollectsHandlesInOneCallPerType) {
+  auto& reactor = GetReactor();
+  std::vector<HandleGLES> handles;
+  for (int i = 0; i < 10; i++) {
+    handles.push_back(reactor.CreateHandle(HandleType::kRenderBuffer));
+    handles.push_back(reactor.CreateHandle(HandleType::kFrameBuffer));
+  }
+  // Handles created on a thread that can react are live immediately.
+  auto calls = GetMockGLES().GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glGenRenderbuffers"), 10u);
+  EXPECT_EQ(CountCalls(calls, "glGenFramebuffers"), 10u);
+
+  for (const auto& handle : handles) {
+    reactor.CollectHandle(handle);
+  }
+  ASSERT_TRUE(reactor.AddOperation([](const ReactorGLES& reactor) {}));
+  calls = GetMockGLES().GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glDeleteRenderbuffers"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glDeleteFramebuffers"), 1u);
+}
+
+TEST_F(ReactorGLESTest, QueuedOperationsRunInOrderWithTheNextReaction) {
+  auto& reactor = GetReactor();
+  GetWorker().can_react = false;
+  std::vector<int> order;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(reactor.AddOperation(
+        [&order, i](const ReactorGLES& reactor) { order.push_back(i); }));
+  }
+  EXPECT_TRUE(order.empty());
+
+  GetWorker().can_react = true;
+  ASSERT_TRUE(reactor.React());
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+
+  // Queues are reused across reactions.
+  ASSERT_TRUE(reactor.AddOperation(
+      [&order](const ReactorGLES& reactor) { order.push_back(3); }));
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST_F(ReactorGLESTest, QueuedOperationsMayCaptureMoveOnlyState) {
+  auto& reactor = GetReactor();
+  GetWorker().can_react = false;
+  std::vector<int> seen;
+  auto value = std::make_unique<int>(42);
+  std::weak_ptr<int> tracker;
+  {
+    auto shared = std::make_shared<int>(7);
+    tracker = shared;
+    ASSERT_TRUE(reactor.AddOperation(
+        [value = std::move(value), shared = std::move(shared),
+         &seen](const ReactorGLES& reactor) {
+          seen.push_back(*value);
+          seen.push_back(*shared);
+        }));
+  }
+  EXPECT_TRUE(seen.empty());
+  EXPECT_FALSE(tracker.expired());
+
+  GetWorker().can_react = true;
+  ASSERT_TRUE(reactor.React());
+  EXPECT_EQ(seen, std::vector<int>({42, 7}));
+  // The operation and its captures are released once it has run.
+  EXPECT_TRUE(tracker.expired());
+}
+
+TEST_F(ReactorGLESTest, RunsOperationsAddedFromManyThreads) {
+  auto& reactor = GetReactor();
+  GetWorker().can_react = false;
+  constexpr int kThreadCount = 4;
+  constexpr int kOperationsPerThread = 1000;
+  std::atomic<int> executed = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&reactor, &executed]() {
+      for (int j = 0; j < kOperationsPerThread; j++) {
+        ASSERT_TRUE(reactor.AddOperation(
+            [&executed](const ReactorGLES& reactor) { executed++; }));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(executed, 0);
+
+  GetWorker().can_react = true;
+  ASSERT_TRUE(reactor.React());
+  EXPECT_EQ(executed, kThreadCount * kOperationsPerThread);
+}
+
+}  // namespace testing
+}  // namespace impeller
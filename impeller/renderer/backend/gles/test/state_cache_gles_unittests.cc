@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+/// Sets the state of one draw the way the render pass does for a pipeline
+/// that blends and tests depth.
+void SetDrawState(const ProcTableGLES& gl, GLuint program, GLenum blend_src) {
+  auto& state = gl.GetStateCache();
+  state.Enable(gl, GL_BLEND);
+  state.BlendFuncSeparate(gl, blend_src, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                          GL_ONE_MINUS_SRC_ALPHA);
+  state.BlendEquationSeparate(gl, GL_FUNC_ADD, GL_FUNC_ADD);
+  state.ColorMask(gl, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.Disable(gl, GL_STENCIL_TEST);
+  state.Enable(gl, GL_DEPTH_TEST);
+  state.DepthFunc(gl, GL_GEQUAL);
+  state.DepthMask(gl, GL_FALSE);
+  state.Viewport(gl, 0, 0, 100, 100);
+  state.DepthRange(gl, 0.0f, 1.0f);
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Disable(gl, GL_CULL_FACE);
+  state.FrontFace(gl, GL_CW);
+  state.UseProgram(gl, program);
+  state.SetEnabledVertexAttribArrays(gl, 0b11u);
+}
+
+}  // namespace
+
+TEST(StateCacheGLESTest, FiltersRedundantStateAcrossDraws) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+
+  SetDrawState(gl, 1u, GL_ONE);
+  auto first_draw = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(first_draw.size(), 16u);
+
+  for (int i = 0; i < 99; i++) {
+    SetDrawState(gl, 1u, GL_ONE);
+  }
+  EXPECT_TRUE(mock_gles->GetCapturedCalls().empty());
+}
+
+TEST(StateCacheGLESTest, ForwardsChangedState) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+
+  // A typical frame alternates between a few pipelines, which only differ
+  // in some of their state.
+  for (int i = 0; i < 10; i++) {
+    SetDrawState(gl, 1u, GL_ONE);
+    SetDrawState(gl, 2u, GL_SRC_ALPHA);
+  }
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(CountCalls(calls, "glUseProgram"), 20u);
+  EXPECT_EQ(CountCalls(calls, "glBlendFuncSeparate"), 20u);
+  EXPECT_EQ(CountCalls(calls, "glBlendEquationSeparate"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glViewport"), 1u);
+  EXPECT_EQ(CountCalls(calls, "glEnable"), 2u);
+  EXPECT_EQ(CountCalls(calls, "glDisable"), 3u);
+  EXPECT_EQ(CountCalls(calls, "glEnableVertexAttribArray"), 2u);
+}
+
+TEST(StateCacheGLESTest, InvalidateForgetsState) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  auto& state = gl.GetStateCache();
+
+  state.Disable(gl, GL_BLEND);
+  state.Viewport(gl, 0, 0, 10, 10);
+  state.Disable(gl, GL_BLEND);
+  state.Viewport(gl, 0, 0, 10, 10);
+  EXPECT_EQ(mock_gles->GetCapturedCalls().size(), 2u);
+
+  // Another client of the context may have changed the state.
+  state.Invalidate();
+  state.Disable(gl, GL_BLEND);
+  state.Viewport(gl, 0, 0, 10, 10);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glDisable", "glViewport"}));
+}
+
+TEST(StateCacheGLESTest, UntrackedCapabilitiesAlwaysReachGL) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  auto& state = gl.GetStateCache();
+
+  state.Enable(gl, GL_POLYGON_OFFSET_FILL);
+  state.Enable(gl, GL_POLYGON_OFFSET_FILL);
+  EXPECT_EQ(mock_gles->GetCapturedCalls().size(), 2u);
+}
+
+TEST(StateCacheGLESTest, TracksStencilFacesSeparately) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  auto& state = gl.GetStateCache();
+
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFFu);
+  // The back face is not known yet.
+  state.StencilMaskSeparate(gl, GL_FRONT_AND_BACK, 0xFFu);
+  EXPECT_EQ(mock_gles->GetCapturedCalls().size(), 2u);
+
+  state.StencilMaskSeparate(gl, GL_FRONT_AND_BACK, 0xFFu);
+  state.StencilMaskSeparate(gl, GL_BACK, 0xFFu);
+  EXPECT_TRUE(mock_gles->GetCapturedCalls().empty());
+
+  state.StencilMaskSeparate(gl, GL_BACK, 0x0u);
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFFu);
+  EXPECT_EQ(mock_gles->GetCapturedCalls().size(), 1u);
+}
+
+TEST(StateCacheGLESTest, EnablesOnlyChangedVertexAttribArrays) {
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  auto& state = gl.GetStateCache();
+
+  state.SetEnabledVertexAttribArrays(gl, 0b011u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glEnableVertexAttribArray",
+                                      "glEnableVertexAttribArray"}));
+
+  state.SetEnabledVertexAttribArrays(gl, 0b011u);
+  EXPECT_TRUE(mock_gles->GetCapturedCalls().empty());
+
+  state.SetEnabledVertexAttribArrays(gl, 0b101u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glDisableVertexAttribArray",
+                                      "glEnableVertexAttribArray"}));
+
+  state.SetEnabledVertexAttribArrays(gl, 0u);
+  EXPECT_EQ(CountCalls(mock_gles->GetCapturedCalls(),
+                       "glDisableVertexAttribArray"),
+            2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
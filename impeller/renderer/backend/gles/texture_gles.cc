@@ -269,11 +269,11 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
 
-  ReactorGLES::Operation texture_upload = [handle = handle_,            //
-                                           data,                        //
-                                           size = tex_descriptor.size,  //
-                                           texture_type,                //
-                                           texture_target               //
+  auto texture_upload = [handle = handle_,            //
+                         data,                        //
+                         size = tex_descriptor.size,  //
+                         texture_type,                //
+                         texture_target               //
   ](const auto& reactor) {
     auto gl_handle = reactor.GetGLHandle(handle);
     if (!gl_handle.has_value()) {
@@ -305,7 +305,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     }
   };
 
-  slices_initialized_ = reactor_->AddOperation(texture_upload);
+  slices_initialized_ = reactor_->AddOperation(std::move(texture_upload));
   return slices_initialized_[0];
 }
 
@@ -106,6 +106,18 @@ static MTLVertexFormat ReadStageInputFormat(const ShaderStageIOSlot& input) {
       return MTLVertexFormatInvalid;
     }
     case ShaderType::kUnsignedShort: {
+      if (input.bit_width == 8 * sizeof(ushort) && input.normalized) {
+        switch (input.vec_size) {
+          case 1:
+            return MTLVertexFormatUShortNormalized;
+          case 2:
+            return MTLVertexFormatUShort2Normalized;
+          case 3:
+            return MTLVertexFormatUShort3Normalized;
+          case 4:
+            return MTLVertexFormatUShort4Normalized;
+        }
+      }
       if (input.bit_width == 8 * sizeof(ushort)) {
         switch (input.vec_size) {
           case 1:
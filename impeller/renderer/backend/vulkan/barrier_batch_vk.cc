@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
+
+namespace impeller {
+
+BarrierBatchVK::BarrierBatchVK() = default;
+
+BarrierBatchVK::~BarrierBatchVK() = default;
+
+void BarrierBatchVK::AddImageBarrier(vk::PipelineStageFlags src_stage,
+                                     vk::PipelineStageFlags dst_stage,
+                                     const vk::ImageMemoryBarrier& barrier) {
+  src_stage_ |= src_stage;
+  dst_stage_ |= dst_stage;
+  for (auto& pending : image_barriers_) {
+    if (pending.image == barrier.image &&
+        pending.subresourceRange == barrier.subresourceRange) {
+      pending.srcAccessMask |= barrier.srcAccessMask;
+      pending.dstAccessMask |= barrier.dstAccessMask;
+      pending.newLayout = barrier.newLayout;
+      return;
+    }
+  }
+  image_barriers_.push_back(barrier);
+}
+
+size_t BarrierBatchVK::GetImageBarrierCount() const {
+  return image_barriers_.size();
+}
+
+void BarrierBatchVK::Encode(const vk::CommandBuffer& cmd_buffer) {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  cmd_buffer.pipelineBarrier(src_stage_,       // src stage
+                             dst_stage_,       // dst stage
+                             {},               // dependency flags
+                             nullptr,          // memory barriers
+                             nullptr,          // buffer barriers
+                             image_barriers_   // image barriers
+  );
+  image_barriers_.clear();
+  src_stage_ = {};
+  dst_stage_ = {};
+}
+
+}  // namespace impeller
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_BATCH_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_BATCH_VK_H_
+
+#include <vector>
+
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Accumulates image memory barriers so that they can be encoded
+///             with a single pipeline barrier command.
+///
+///             Barriers in one command are not ordered with respect to each
+///             other. So a barrier added for an image that already has one in
+///             the batch is merged into it: the merged barrier transitions
+///             from the old layout of the first one to the new layout of the
+///             last one and covers the accesses of both. This is only correct
+///             if no command accessing the image is encoded between the
+///             barriers, so the batch must be encoded before any command that
+///             uses its images.
+///
+///             The stages of all barriers are combined, which may synchronize
+///             more than each barrier would on its own.
+///
+class BarrierBatchVK {
+ public:
+  BarrierBatchVK();
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add an image memory barrier to the batch.
+  ///
+  /// @param[in]  src_stage  The stages the barrier waits for.
+  /// @param[in]  dst_stage  The stages that wait for the barrier.
+  /// @param[in]  barrier    The image memory barrier.
+  ///
+  void AddImageBarrier(vk::PipelineStageFlags src_stage,
+                       vk::PipelineStageFlags dst_stage,
+                       const vk::ImageMemoryBarrier& barrier);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of image barriers in the batch, after merging.
+  ///
+  size_t GetImageBarrierCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode all barriers of the batch in one pipeline barrier
+  ///             command and clear the batch. Does nothing if the batch is
+  ///             empty.
+  ///
+  /// @param[in]  cmd_buffer  The command buffer to encode the barriers to.
+  ///
+  void Encode(const vk::CommandBuffer& cmd_buffer);
+
+ private:
+  vk::PipelineStageFlags src_stage_ = {};
+  vk::PipelineStageFlags dst_stage_ = {};
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+
+  BarrierBatchVK(const BarrierBatchVK&) = delete;
+
+  BarrierBatchVK& operator=(const BarrierBatchVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_BATCH_VK_H_
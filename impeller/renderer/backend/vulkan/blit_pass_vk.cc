@@ -107,10 +107,12 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  if (!encoder.SetLayout(src, src_barrier) ||
+      !encoder.SetLayout(dst, dst_barrier)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  encoder.FlushBarriers();
 
   vk::ImageCopy image_copy;
 
@@ -149,7 +151,7 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   barrier.dst_access = vk::AccessFlagBits::eShaderRead;
   barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
 
-  return dst.SetLayout(barrier);
+  return encoder.SetLayout(dst, barrier);
 }
 
 // |BlitPass|
@@ -195,10 +197,11 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
   image_copy.setImageExtent(
       vk::Extent3D(source_region.GetWidth(), source_region.GetHeight(), 1));
 
-  if (!src.SetLayout(barrier)) {
+  if (!encoder.SetLayout(src, barrier)) {
     VALIDATION_LOG << "Could not encode layout transition.";
     return false;
   }
+  encoder.FlushBarriers();
 
   cmd_buffer.copyImageToBuffer(src.GetImage(),      //
                                barrier.new_layout,  //
@@ -241,7 +244,7 @@ bool BlitPassVK::ConvertTextureToShaderRead(
     return false;
   }
 
-  return texture_vk.SetLayout(barrier);
+  return encoder.SetLayout(texture_vk, barrier);
 }
 
 // |BlitPass|
@@ -289,10 +292,11 @@ bool BlitPassVK::OnCopyBufferToTextureCommand(
   // Note: this barrier should do nothing if we're already in the transfer dst
   // optimal state. This is important for performance of repeated blit pass
   // encoding.
-  if (!dst.SetLayout(dst_barrier)) {
+  if (!encoder.SetLayout(dst, dst_barrier)) {
     VALIDATION_LOG << "Could not encode layout transition.";
     return false;
   }
+  encoder.FlushBarriers();
 
   cmd_buffer.copyBufferToImage(src.GetBuffer(),         //
                                dst.GetImage(),          //
@@ -311,7 +315,7 @@ bool BlitPassVK::OnCopyBufferToTextureCommand(
 
     barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
-    if (!dst.SetLayout(barrier)) {
+    if (!encoder.SetLayout(dst, barrier)) {
       return false;
     }
   }
@@ -354,10 +358,12 @@ bool BlitPassVK::ResizeTexture(const std::shared_ptr<Texture>& source,
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  if (!encoder.SetLayout(src, src_barrier) ||
+      !encoder.SetLayout(dst, dst_barrier)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  encoder.FlushBarriers();
 
   vk::ImageBlit blit;
   blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
@@ -400,7 +406,7 @@ bool BlitPassVK::ResizeTexture(const std::shared_ptr<Texture>& source,
   barrier.dst_access = vk::AccessFlagBits::eShaderRead;
   barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
 
-  return dst.SetLayout(barrier);
+  return encoder.SetLayout(dst, barrier);
 }
 
 // |BlitPass|
@@ -423,6 +429,10 @@ bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
     return false;
   }
 
+  // The barriers below are encoded directly and transition from the current
+  // layout, so pending transitions must be encoded first.
+  encoder.FlushBarriers();
+
   // Initialize all mip levels to be in TransferDst mode. Later, in a loop,
   // after writing to that mip level, we'll first switch its layout to
   // TransferSrc to prepare the mip level after it, use the image as the source
@@ -82,6 +82,7 @@ bool CommandEncoderVK::IsValid() const {
 }
 
 bool CommandEncoderVK::EndCommandBuffer() const {
+  FlushBarriers();
   InsertDebugMarker("QueueSubmit");
 
   auto command_buffer = GetCommandBuffer();
@@ -102,6 +103,21 @@ vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
   return {};
 }
 
+bool CommandEncoderVK::SetLayout(const TextureVK& texture,
+                                 const BarrierVK& barrier) const {
+  if (!IsValid()) {
+    return false;
+  }
+  return texture.SetLayout(barrier, tracked_objects_->GetBarrierBatch());
+}
+
+void CommandEncoderVK::FlushBarriers() const {
+  if (!IsValid()) {
+    return;
+  }
+  tracked_objects_->GetBarrierBatch().Encode(GetCommandBuffer());
+}
+
 void CommandEncoderVK::Reset() {
   tracked_objects_.reset();
 
@@ -172,6 +188,19 @@ fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSets(
                                                                       context);
 }
 
+fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context) {
+  if (!IsValid()) {
+    return fml::Status(fml::StatusCode::kUnknown, "command encoder invalid");
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetDescriptorSet(
+      layout, writes, write_count, context);
+}
+
 void CommandEncoderVK::PushDebugGroup(std::string_view label) const {
   if (!HasValidationLayers()) {
     return;
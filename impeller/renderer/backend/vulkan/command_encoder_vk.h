@@ -9,6 +9,7 @@
 #include <functional>
 #include <optional>
 
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/command_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -25,6 +26,7 @@ class DeviceBuffer;
 class Buffer;
 class Texture;
 class TextureSourceVK;
+class TextureVK;
 class TrackedObjectsVK;
 class FenceWaiterVK;
 class GPUProbe;
@@ -75,6 +77,23 @@ class CommandEncoderVK {
 
   vk::CommandBuffer GetCommandBuffer() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Transition the layout of a texture with the next pipeline
+  ///             barrier encoded by `FlushBarriers`.
+  ///
+  ///             Transitions added between two flushes are merged into one
+  ///             pipeline barrier command. They must be flushed before any
+  ///             command that uses the textures is encoded.
+  ///
+  /// @return     If the layout transition was successfully made.
+  ///
+  bool SetLayout(const TextureVK& texture, const BarrierVK& barrier) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the pending layout transitions added via `SetLayout`.
+  ///
+  void FlushBarriers() const;
+
   void PushDebugGroup(std::string_view label) const;
 
   void PopDebugGroup() const;
@@ -87,6 +106,19 @@ class CommandEncoderVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set containing the given descriptors from
+  ///             the descriptor pool of this encoder, reusing a set with the
+  ///             same contents if one was written before.
+  ///
+  /// @see        |DescriptorPoolVK::GetDescriptorSet|
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context);
+
  private:
   friend class ContextVK;
   friend class CommandQueueVK;
@@ -2,17 +2,73 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <thread>
 
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "fml/synchronization/waitable_event.h"
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 #include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+
+class FakeTextureSourceVK final : public TextureSourceVK {
+ public:
+  FakeTextureSourceVK(TextureDescriptor desc, vk::Image image)
+      : TextureSourceVK(desc), image_(image) {}
+
+  // |TextureSourceVK|
+  vk::Image GetImage() const override { return image_; }
+
+  // |TextureSourceVK|
+  vk::ImageView GetImageView() const override { return {}; }
+
+  // |TextureSourceVK|
+  vk::ImageView GetRenderTargetView() const override { return {}; }
+
+  // |TextureSourceVK|
+  bool IsSwapchainImage() const override { return false; }
+
+ private:
+  vk::Image image_;
+};
+
+std::shared_ptr<TextureVK> CreateFakeTexture(
+    const std::shared_ptr<ContextVK>& context,
+    uint64_t image) {
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  return std::make_shared<TextureVK>(
+      context, std::make_shared<FakeTextureSourceVK>(
+                   desc, vk::Image(reinterpret_cast<VkImage>(image))));
+}
+
+BarrierVK MakeBarrier(vk::ImageLayout layout) {
+  BarrierVK barrier;
+  barrier.new_layout = layout;
+  barrier.src_access = vk::AccessFlagBits::eTransferWrite;
+  barrier.src_stage = vk::PipelineStageFlagBits::eTransfer;
+  barrier.dst_access = vk::AccessFlagBits::eShaderRead;
+  barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  return barrier;
+}
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+
+}  // namespace
+
 TEST(CommandEncoderVKTest, DeleteEncoderAfterThreadDies) {
   // Tests that when a CommandEncoderVK is deleted that it will clean up its
   // command buffers before it cleans up its command pool.
@@ -75,5 +131,70 @@ TEST(CommandEncoderVKTest, CleanupAfterSubmit) {
   EXPECT_TRUE(free_buffers < destroy_pool);
 }
 
+TEST(CommandEncoderVKTest, BatchesLayoutTransitions) {
+  auto context = MockVulkanContextBuilder().Build();
+  auto buffer = context->CreateCommandBuffer();
+  const auto& encoder = CommandBufferVK::Cast(*buffer).GetEncoder();
+  auto a = CreateFakeTexture(context, 0x1000);
+  auto b = CreateFakeTexture(context, 0x2000);
+
+  auto called = GetMockVulkanFunctions(context->GetDevice());
+  const auto barriers_before = CountCalls(*called, "vkCmdPipelineBarrier");
+
+  EXPECT_TRUE(encoder->SetLayout(
+      *a, MakeBarrier(vk::ImageLayout::eTransferDstOptimal)));
+  EXPECT_TRUE(encoder->SetLayout(
+      *b, MakeBarrier(vk::ImageLayout::eTransferDstOptimal)));
+  EXPECT_TRUE(encoder->SetLayout(
+      *a, MakeBarrier(vk::ImageLayout::eShaderReadOnlyOptimal)));
+  // Already in the requested layout.
+  EXPECT_TRUE(encoder->SetLayout(
+      *b, MakeBarrier(vk::ImageLayout::eTransferDstOptimal)));
+  EXPECT_EQ(CountCalls(*called, "vkCmdPipelineBarrier"), barriers_before);
+  EXPECT_EQ(a->GetLayout(), vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  encoder->FlushBarriers();
+  EXPECT_EQ(CountCalls(*called, "vkCmdPipelineBarrier"), barriers_before + 1);
+
+  // Nothing is pending anymore.
+  encoder->FlushBarriers();
+  EXPECT_EQ(CountCalls(*called, "vkCmdPipelineBarrier"), barriers_before + 1);
+
+  // Pending transitions are encoded when the command buffer ends.
+  EXPECT_TRUE(encoder->SetLayout(
+      *b, MakeBarrier(vk::ImageLayout::eShaderReadOnlyOptimal)));
+  EXPECT_TRUE(encoder->EndCommandBuffer());
+  EXPECT_EQ(CountCalls(*called, "vkCmdPipelineBarrier"), barriers_before + 2);
+
+  context->Shutdown();
+}
+
+TEST(BarrierBatchVKTest, MergesBarriersOfTheSameImage) {
+  vk::ImageMemoryBarrier first;
+  first.image = vk::Image(reinterpret_cast<VkImage>(0x1000));
+  first.oldLayout = vk::ImageLayout::eUndefined;
+  first.newLayout = vk::ImageLayout::eTransferDstOptimal;
+  first.srcAccessMask = vk::AccessFlagBits::eShaderRead;
+  first.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+
+  vk::ImageMemoryBarrier second = first;
+  second.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+  second.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  second.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+  second.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+  vk::ImageMemoryBarrier other = first;
+  other.image = vk::Image(reinterpret_cast<VkImage>(0x2000));
+
+  BarrierBatchVK batch;
+  batch.AddImageBarrier(vk::PipelineStageFlagBits::eFragmentShader,
+                        vk::PipelineStageFlagBits::eTransfer, first);
+  batch.AddImageBarrier(vk::PipelineStageFlagBits::eTransfer,
+                        vk::PipelineStageFlagBits::eFragmentShader, other);
+  batch.AddImageBarrier(vk::PipelineStageFlagBits::eTransfer,
+                        vk::PipelineStageFlagBits::eFragmentShader, second);
+  EXPECT_EQ(batch.GetImageBarrierCount(), 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
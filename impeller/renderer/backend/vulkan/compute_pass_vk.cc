@@ -23,6 +23,8 @@ ComputePassVK::ComputePassVK(std::shared_ptr<const Context> context,
                      .GetPhysicalDevice()
                      .getProperties()
                      .limits.maxComputeWorkGroupSize;
+  // Dispatches may read textures whose layout transitions are still pending.
+  command_buffer_->GetEncoder()->FlushBarriers();
   is_valid_ = true;
 }
 
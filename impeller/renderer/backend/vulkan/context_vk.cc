@@ -454,6 +454,10 @@ void ContextVK::Setup(Settings settings) {
                                               settings.enable_gpu_tracing);
   gpu_tracer_->InitializeQueryPool(*this);
 
+  // Create the pipelines used by previous runs as soon as possible. The usage
+  // profile is read from disk on a worker thread.
+  pipeline_library_->WarmUpPipelinesFromUsageProfile();
+
   //----------------------------------------------------------------------------
   /// Label all the relevant objects. This happens after setup so that the
   /// debug messengers have had a chance to be set up.
@@ -144,8 +144,9 @@ class ContextVK final : public Context,
 
   const std::unique_ptr<DriverInfoVK>& GetDriverInfo() const;
 
+  // |Context|
   const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  GetConcurrentWorkerTaskRunner() const override;
 
   std::shared_ptr<SurfaceContextVK> CreateSurfaceContext();
 
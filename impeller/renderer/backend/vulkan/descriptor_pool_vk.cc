@@ -4,8 +4,11 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <algorithm>
+#include <cstring>
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "vulkan/vulkan_enums.hpp"
@@ -120,6 +123,85 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   return set;
 }
 
+template <class T>
+static uint64_t HandleBits(T handle) {
+  // Non-dispatchable handles are pointers on 64-bit platforms and integers on
+  // 32-bit ones.
+  const auto raw = static_cast<typename T::CType>(handle);
+  uint64_t bits = 0u;
+  std::memcpy(&bits, &raw, sizeof(raw));
+  return bits;
+}
+
+fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context_vk) {
+  // The key is built at the end of the key storage and only kept there if a
+  // new set is allocated for it.
+  const size_t key_offset = descriptor_set_keys_.size();
+  descriptor_set_keys_.push_back(HandleBits(layout));
+  for (auto i = 0u; i < write_count; i++) {
+    const auto& write = writes[i];
+    descriptor_set_keys_.push_back(
+        (static_cast<uint64_t>(write.dstBinding) << 32u) |
+        static_cast<uint64_t>(write.descriptorType));
+    if (write.pBufferInfo) {
+      descriptor_set_keys_.push_back(HandleBits(write.pBufferInfo->buffer));
+      descriptor_set_keys_.push_back(write.pBufferInfo->offset);
+      descriptor_set_keys_.push_back(write.pBufferInfo->range);
+    } else if (write.pImageInfo) {
+      descriptor_set_keys_.push_back(HandleBits(write.pImageInfo->sampler));
+      descriptor_set_keys_.push_back(HandleBits(write.pImageInfo->imageView));
+      descriptor_set_keys_.push_back(
+          static_cast<uint64_t>(write.pImageInfo->imageLayout));
+    }
+  }
+  const size_t key_size = descriptor_set_keys_.size() - key_offset;
+  const auto key_begin = descriptor_set_keys_.begin() + key_offset;
+
+  std::size_t key_hash = fml::HashCombine();
+  for (auto word = key_begin; word != descriptor_set_keys_.end(); word++) {
+    fml::HashCombineSeed(key_hash, *word);
+  }
+
+  const auto [first, last] = descriptor_sets_.equal_range(key_hash);
+  for (auto it = first; it != last; it++) {
+    const auto& cached = it->second;
+    if (cached.key_size == key_size &&
+        std::equal(key_begin, descriptor_set_keys_.end(),
+                   descriptor_set_keys_.begin() + cached.key_offset)) {
+      descriptor_set_keys_.resize(key_offset);
+      descriptor_set_cache_stats_.reused_sets++;
+      return cached.descriptor_set;
+    }
+  }
+
+  auto descriptor_result = AllocateDescriptorSets(layout, context_vk);
+  if (!descriptor_result.ok()) {
+    descriptor_set_keys_.resize(key_offset);
+    return descriptor_result;
+  }
+  const auto descriptor_set = descriptor_result.value();
+  for (auto i = 0u; i < write_count; i++) {
+    writes[i].dstSet = descriptor_set;
+  }
+  context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+
+  descriptor_sets_.emplace(
+      key_hash, CachedDescriptorSet{.key_offset = key_offset,
+                                    .key_size = key_size,
+                                    .descriptor_set = descriptor_set});
+  descriptor_set_cache_stats_.allocated_sets++;
+  return descriptor_set;
+}
+
+const DescriptorPoolVK::DescriptorSetCacheStats&
+DescriptorPoolVK::GetDescriptorSetCacheStats() const {
+  return descriptor_set_cache_stats_;
+}
+
 fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   auto new_pool = context_vk.GetDescriptorPoolRecycler()->Get();
   if (!new_pool) {
@@ -169,6 +251,8 @@ vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
                              kDefaultBindingSize.texture_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
                              kDefaultBindingSize.buffer_bindings},
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
+                             kDefaultBindingSize.buffer_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
                              kDefaultBindingSize.storage_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
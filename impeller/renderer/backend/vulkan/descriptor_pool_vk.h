@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -30,13 +32,61 @@ class DescriptorPoolVK {
 
   ~DescriptorPoolVK();
 
+  /// Counts the descriptor sets requested via |GetDescriptorSet|.
+  struct DescriptorSetCacheStats {
+    /// The number of sets that were allocated and written.
+    size_t allocated_sets = 0u;
+    /// The number of requests served by a set with the same contents.
+    size_t reused_sets = 0u;
+  };
+
   fml::StatusOr<vk::DescriptorSet> AllocateDescriptorSets(
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context_vk);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set of the given layout that contains the
+  ///             given descriptors.
+  ///
+  ///             Sets are cached by their layout and contents for the lifetime
+  ///             of the pool. Requesting the same contents again returns the
+  ///             set that was already written, without allocating or updating
+  ///             a new one. Render passes bind uniform buffers as dynamic
+  ///             uniform buffers whose descriptors don't contain the offset
+  ///             of the uniform data. So draws that bind the same buffers,
+  ///             textures and samplers (such as glyph atlas draws) share one
+  ///             set.
+  ///
+  /// @param[in]  layout       The layout of the set.
+  /// @param[in]  writes       The descriptors of the set. Each write must
+  ///                          contain a single buffer or image descriptor. The
+  ///                          destination set of the writes is overwritten.
+  /// @param[in]  write_count  The number of writes.
+  /// @param[in]  context_vk   The context.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context_vk);
+
+  const DescriptorSetCacheStats& GetDescriptorSetCacheStats() const;
+
  private:
+  struct CachedDescriptorSet {
+    size_t key_offset = 0u;
+    size_t key_size = 0u;
+    vk::DescriptorSet descriptor_set;
+  };
+
   std::weak_ptr<const ContextVK> context_;
   std::vector<vk::UniqueDescriptorPool> pools_;
+  // The keys of the cached descriptor sets, back to back. A key is the layout
+  // followed by the binding, type and resources of each descriptor.
+  std::vector<uint64_t> descriptor_set_keys_;
+  // The cached descriptor sets by the hash of their keys.
+  std::unordered_multimap<std::size_t, CachedDescriptorSet> descriptor_sets_;
+  DescriptorSetCacheStats descriptor_set_cache_stats_;
 
   fml::Status CreateNewPool(const ContextVK& context_vk);
 
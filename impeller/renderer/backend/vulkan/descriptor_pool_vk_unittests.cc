@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+
 #include "flutter/testing/testing.h"  // IWYU pragma: keep.
 #include "fml/closure.h"
 #include "fml/synchronization/waitable_event.h"
@@ -123,5 +125,71 @@ TEST(DescriptorPoolRecyclerVKTest, ReclaimDropsDescriptorPoolIfSizeIsExceeded) {
   context->Shutdown();
 }
 
+TEST(DescriptorPoolVKTest, ReusesDescriptorSetsWithTheSameContents) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    DescriptorPoolVK pool(context);
+    auto layout = vk::DescriptorSetLayout(
+        reinterpret_cast<VkDescriptorSetLayout>(0x1000));
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = vk::Buffer(reinterpret_cast<VkBuffer>(0x2000));
+    buffer_info.offset = 256u;
+    buffer_info.range = 64u;
+    vk::DescriptorImageInfo image_info;
+    image_info.sampler = vk::Sampler(reinterpret_cast<VkSampler>(0x3000));
+    image_info.imageView = vk::ImageView(reinterpret_cast<VkImageView>(0x4000));
+    image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+    std::array<vk::WriteDescriptorSet, 2> writes;
+    writes[0].dstBinding = 0u;
+    writes[0].descriptorCount = 1u;
+    writes[0].descriptorType = vk::DescriptorType::eUniformBuffer;
+    writes[0].pBufferInfo = &buffer_info;
+    writes[1].dstBinding = 1u;
+    writes[1].descriptorCount = 1u;
+    writes[1].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+    writes[1].pImageInfo = &image_info;
+
+    auto first =
+        pool.GetDescriptorSet(layout, writes.data(), writes.size(), *context);
+    ASSERT_TRUE(first.ok());
+    for (auto i = 0u; i < 10u; i++) {
+      auto set =
+          pool.GetDescriptorSet(layout, writes.data(), writes.size(), *context);
+      ASSERT_TRUE(set.ok());
+      EXPECT_EQ(set.value(), first.value());
+    }
+
+    // Binding another range of the buffer needs another set.
+    buffer_info.offset = 512u;
+    auto second =
+        pool.GetDescriptorSet(layout, writes.data(), writes.size(), *context);
+    ASSERT_TRUE(second.ok());
+    EXPECT_NE(second.value(), first.value());
+
+    // So does another layout.
+    auto other_layout = vk::DescriptorSetLayout(
+        reinterpret_cast<VkDescriptorSetLayout>(0x5000));
+    auto third = pool.GetDescriptorSet(other_layout, writes.data(),
+                                       writes.size(), *context);
+    ASSERT_TRUE(third.ok());
+    EXPECT_NE(third.value(), second.value());
+
+    EXPECT_EQ(pool.GetDescriptorSetCacheStats().allocated_sets, 3u);
+    EXPECT_EQ(pool.GetDescriptorSetCacheStats().reused_sets, 10u);
+  }
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateDescriptorSets"),
+      3u);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkUpdateDescriptorSets"),
+      3u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -13,6 +13,9 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+static constexpr const char* kPipelineUsageProfileFileName =
+    "flutter.impeller.vkprofile";
+
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
                               const vk::UniquePipelineCache& cache) {
@@ -28,6 +31,19 @@ bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
   if (data_size == 0u) {
     return true;
   }
+  if (data_size > kMaxPipelineCacheDataSize) {
+    FML_LOG(WARNING) << "Pipeline cache data of " << data_size
+                     << " bytes exceeds the limit of "
+                     << kMaxPipelineCacheDataSize
+                     << " bytes. The persisted cache is discarded.";
+    // The previously persisted cache would otherwise be loaded again on every
+    // launch and grow past the limit in the same way.
+    if (fml::FileExists(cache_directory, kPipelineCacheFileName) &&
+        !fml::UnlinkFile(cache_directory, kPipelineCacheFileName)) {
+      VALIDATION_LOG << "Could not remove the oversized pipeline cache file.";
+    }
+    return false;
+  }
   auto allocation = std::make_shared<Allocation>();
   if (!allocation->Truncate(Bytes{sizeof(PipelineCacheHeaderVK) + data_size},
                             false)) {
@@ -55,14 +71,16 @@ bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
   return true;
 }
 
-std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+// Reads the data following a compatible header from the file.
+static std::unique_ptr<fml::Mapping> RetrieveWithHeader(
     const fml::UniqueFD& cache_directory,
+    const char* file_name,
     const VkPhysicalDeviceProperties& props) {
   if (!cache_directory.is_valid()) {
     return nullptr;
   }
   std::shared_ptr<fml::FileMapping> on_disk_data =
-      fml::FileMapping::CreateReadOnly(cache_directory, kPipelineCacheFileName);
+      fml::FileMapping::CreateReadOnly(cache_directory, file_name);
   if (!on_disk_data) {
     return nullptr;
   }
@@ -86,11 +104,60 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
   if (on_disk_header.data_size == 0u) {
     return nullptr;
   }
+  if (on_disk_header.data_size >
+      on_disk_data->GetSize() - sizeof(on_disk_header)) {
+    VALIDATION_LOG << "Pipeline cache data is truncated.";
+    return nullptr;
+  }
   return std::make_unique<fml::NonOwnedMapping>(
       on_disk_data->GetMapping() + sizeof(on_disk_header),
       on_disk_header.data_size, [on_disk_data](auto, auto) {});
 }
 
+std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props) {
+  return RetrieveWithHeader(cache_directory, kPipelineCacheFileName, props);
+}
+
+bool PipelineUsageProfileDataPersist(const fml::UniqueFD& cache_directory,
+                                     const VkPhysicalDeviceProperties& props,
+                                     const fml::Mapping& profile) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  if (profile.GetSize() == 0u) {
+    return true;
+  }
+  auto allocation = std::make_shared<Allocation>();
+  if (!allocation->Truncate(
+          Bytes{sizeof(PipelineCacheHeaderVK) + profile.GetSize()}, false)) {
+    VALIDATION_LOG << "Could not allocate pipeline usage profile buffer.";
+    return false;
+  }
+  const auto header = PipelineCacheHeaderVK{props, profile.GetSize()};
+  std::memcpy(allocation->GetBuffer(), &header, sizeof(header));
+  std::memcpy(allocation->GetBuffer() + sizeof(header), profile.GetMapping(),
+              profile.GetSize());
+  auto allocation_mapping = CreateMappingFromAllocation(allocation);
+  if (!allocation_mapping) {
+    return false;
+  }
+  if (!fml::WriteAtomically(cache_directory, kPipelineUsageProfileFileName,
+                            *allocation_mapping)) {
+    VALIDATION_LOG << "Could not write pipeline usage profile to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfileDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props) {
+  return RetrieveWithHeader(cache_directory, kPipelineUsageProfileFileName,
+                            props);
+}
+
 PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
 
 PipelineCacheHeaderVK::PipelineCacheHeaderVK(
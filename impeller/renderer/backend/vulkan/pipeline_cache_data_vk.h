@@ -11,6 +11,10 @@
 
 namespace impeller {
 
+// Drivers append to the cache data whenever new pipelines are created. Caches
+// larger than this are not persisted so that the disk usage is bounded.
+static constexpr size_t kMaxPipelineCacheDataSize = 32u * 1024u * 1024u;
+
 //------------------------------------------------------------------------------
 /// @brief      An Impeller specific header prepended to all pipeline cache
 ///             information that is persisted on disk. This information is used
@@ -79,7 +83,9 @@ struct PipelineCacheHeaderVK {
 /// @param[in]  props            The physical device properties
 /// @param[in]  cache            The cache
 ///
-/// @return     If the cache data could be persisted to disk.
+/// @return     If the cache data could be persisted to disk. Caches larger
+///             than `kMaxPipelineCacheDataSize` are not persisted and the
+///             previously persisted cache is removed.
 ///
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
@@ -104,6 +110,36 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
     const fml::UniqueFD& cache_directory,
     const VkPhysicalDeviceProperties& props);
 
+//------------------------------------------------------------------------------
+/// @brief      Persist a serialized pipeline usage profile next to the pipeline
+///             cache in the given cache directory. The profile is written with
+///             the same header as the pipeline cache so that it is discarded
+///             along with the cache when the device or driver changes.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The physical device properties
+/// @param[in]  profile          The serialized profile
+///
+/// @return     If the profile could be persisted to disk.
+///
+bool PipelineUsageProfileDataPersist(const fml::UniqueFD& cache_directory,
+                                     const VkPhysicalDeviceProperties& props,
+                                     const fml::Mapping& profile);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve the previously persisted pipeline usage profile if it
+///             is compatible with the given physical device.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The properties
+///
+/// @return     The serialized profile if it was found and its header passed
+///             the integrity checks.
+///
+std::unique_ptr<fml::Mapping> PipelineUsageProfileDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
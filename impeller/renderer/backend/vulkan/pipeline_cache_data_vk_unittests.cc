@@ -10,6 +10,7 @@
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
 namespace impeller::testing {
 
@@ -92,6 +93,53 @@ TEST(PipelineCacheDataVKTest, CanCreateFromDeviceProperties) {
   }
 }
 
+TEST(PipelineCacheDataVKTest, RejectsTruncatedData) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  VkPhysicalDeviceProperties props = {};
+  props.deviceID = 10;
+
+  std::vector<uint8_t> data(sizeof(PipelineCacheHeaderVK) + 16u, 0u);
+  PipelineCacheHeaderVK header(props, 16u);
+  std::memcpy(data.data(), &header, sizeof(header));
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "flutter.impeller.vkcache",
+                                   fml::DataMapping(data)));
+  auto mapping = PipelineCacheDataRetrieve(temp_dir.fd(), props);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(mapping->GetSize(), 16u);
+
+  // The header claims more data than the file contains.
+  header.data_size = 17u;
+  std::memcpy(data.data(), &header, sizeof(header));
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "flutter.impeller.vkcache",
+                                   fml::DataMapping(data)));
+  EXPECT_EQ(PipelineCacheDataRetrieve(temp_dir.fd(), props), nullptr);
+
+  // The file is too small to contain a header.
+  data.resize(sizeof(PipelineCacheHeaderVK) - 1u);
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "flutter.impeller.vkcache",
+                                   fml::DataMapping(data)));
+  EXPECT_EQ(PipelineCacheDataRetrieve(temp_dir.fd(), props), nullptr);
+}
+
+TEST(PipelineCacheDataVKTest, RemovesPersistedCacheWhenDataIsTooLarge) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto context = MockVulkanContextBuilder().Build();
+  ASSERT_TRUE(context);
+  const auto& props = CapabilitiesVK::Cast(*context->GetCapabilities())
+                          .GetPhysicalDeviceProperties();
+  auto cache = context->GetDevice().createPipelineCacheUnique({});
+  ASSERT_EQ(cache.result, vk::Result::eSuccess);
+
+  SetPipelineCacheDataSize(16u);
+  ASSERT_TRUE(PipelineCacheDataPersist(temp_dir.fd(), props, cache.value));
+  ASSERT_TRUE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkcache"));
+
+  SetPipelineCacheDataSize(kMaxPipelineCacheDataSize + 1u);
+  EXPECT_FALSE(PipelineCacheDataPersist(temp_dir.fd(), props, cache.value));
+  EXPECT_FALSE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkcache"));
+  SetPipelineCacheDataSize(0u);
+}
+
 using PipelineCacheDataVKPlaygroundTest = PlaygroundTest;
 INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheDataVKPlaygroundTest);
 
@@ -116,6 +116,47 @@ void PipelineCacheVK::PersistCacheToDisk() const {
                            vk_caps.GetPhysicalDeviceProperties(),  //
                            cache_                                  //
   );
+
+  std::unique_ptr<fml::Mapping> profile;
+  {
+    Lock lock(usage_profile_mutex_);
+    if (!usage_profile_.IsDirty()) {
+      return;
+    }
+    profile = usage_profile_.Serialize();
+  }
+  if (!profile) {
+    return;
+  }
+  PipelineUsageProfileDataPersist(cache_directory_,                       //
+                                  vk_caps.GetPhysicalDeviceProperties(),  //
+                                  *profile                                //
+  );
+}
+
+std::vector<PipelineDescriptor> PipelineCacheVK::RecordPipelineUsage(
+    const PipelineDescriptor& desc) {
+  Lock lock(usage_profile_mutex_);
+  return usage_profile_.RecordPipeline(desc);
+}
+
+std::vector<PipelineDescriptor> PipelineCacheVK::LoadUsageProfile() {
+  if (!is_valid_) {
+    return {};
+  }
+  const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
+  auto data = PipelineUsageProfileDataRetrieve(
+      cache_directory_, vk_caps.GetPhysicalDeviceProperties());
+  if (!data) {
+    return {};
+  }
+  Lock lock(usage_profile_mutex_);
+  auto descriptors = usage_profile_.AddSerializedProfile(*data);
+  if (!descriptors.has_value()) {
+    FML_LOG(WARNING) << "Ignoring invalid pipeline usage profile.";
+    return {};
+  }
+  return std::move(descriptors.value());
 }
 
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
@@ -5,9 +5,14 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 
+#include <vector>
+
 #include "flutter/fml/file.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_usage_profile_vk.h"
+#include "impeller/renderer/pipeline_descriptor.h"
 
 namespace impeller {
 
@@ -31,14 +36,43 @@ class PipelineCacheVK {
 
   const CapabilitiesVK* GetCapabilities() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Persist the pipeline cache and, if new pipelines were
+  ///             recorded, the pipeline usage profile to the cache directory.
+  ///             This performs file IO and must not be called on the raster
+  ///             thread.
+  ///
   void PersistCacheToDisk() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record the creation of a render pipeline in the pipeline usage
+  ///             profile.
+  ///
+  /// @return     The descriptors of pipelines used in previous runs that can
+  ///             now be created ahead of time.
+  ///
+  std::vector<PipelineDescriptor> RecordPipelineUsage(
+      const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read the pipeline usage profile persisted by previous runs.
+  ///             This performs file IO and must not be called on the raster
+  ///             thread.
+  ///
+  /// @return     The descriptors of pipelines used in previous runs that can
+  ///             already be created ahead of time. The others are returned by
+  ///             `RecordPipelineUsage` once their templates are created.
+  ///
+  std::vector<PipelineDescriptor> LoadUsageProfile();
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
   const fml::UniqueFD cache_directory_;
   vk::UniquePipelineCache cache_;
   bool is_valid_ = false;
+  mutable Mutex usage_profile_mutex_;
+  PipelineUsageProfileVK usage_profile_ IPLR_GUARDED_BY(usage_profile_mutex_);
 
   PipelineCacheVK(const PipelineCacheVK&) = delete;
 
@@ -159,8 +159,21 @@ std::unique_ptr<ComputePipelineVK> PipelineLibraryVK::CreateComputePipeline(
 PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
     PipelineDescriptor descriptor,
     bool async) {
+  return GetRenderPipeline(std::move(descriptor), async,
+                           /*record_usage=*/true);
+}
+
+PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetRenderPipeline(
+    PipelineDescriptor descriptor,
+    bool async,
+    bool record_usage) {
   Lock lock(pipelines_mutex_);
   if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
+    // The first request for a warmed up pipeline is its first use in this run.
+    if (record_usage && !warmed_up_pipelines_.empty() &&
+        warmed_up_pipelines_.erase(descriptor) > 0u) {
+      WarmUpPipelines(pso_cache_->RecordPipelineUsage(descriptor));
+    }
     return found->second;
   }
 
@@ -177,6 +190,12 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
 
+  if (record_usage) {
+    WarmUpPipelines(pso_cache_->RecordPipelineUsage(descriptor));
+  } else {
+    warmed_up_pipelines_.insert(descriptor);
+  }
+
   auto weak_this = weak_from_this();
 
   auto generation_task = [descriptor, weak_this, promise]() {
@@ -268,6 +287,10 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
   });
+  fml::erase_if(warmed_up_pipelines_, [&](auto item) {
+    return item->GetEntrypointForStage(function->GetStage())
+        ->IsEqual(*function);
+  });
 }
 
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
@@ -291,6 +314,39 @@ void PipelineLibraryVK::PersistPipelineCacheToDisk() {
       });
 }
 
+void PipelineLibraryVK::WarmUpPipelinesFromUsageProfile() {
+  worker_task_runner_->PostTask([weak_this = weak_from_this()]() {
+    auto thiz = weak_this.lock();
+    if (!thiz) {
+      return;
+    }
+    auto& library = PipelineLibraryVK::Cast(*thiz);
+    TRACE_EVENT0("flutter", "LoadPipelineUsageProfile");
+    library.WarmUpPipelines(library.pso_cache_->LoadUsageProfile());
+  });
+}
+
+void PipelineLibraryVK::WarmUpPipelines(
+    std::vector<PipelineDescriptor> descriptors) {
+  if (descriptors.empty()) {
+    return;
+  }
+  // The pipelines are requested from a separate task because the caller may
+  // hold the pipelines mutex.
+  worker_task_runner_->PostTask([weak_this = weak_from_this(),
+                                 descriptors = std::move(descriptors)]() {
+    auto thiz = weak_this.lock();
+    if (!thiz) {
+      return;
+    }
+    auto& library = PipelineLibraryVK::Cast(*thiz);
+    for (const auto& descriptor : descriptors) {
+      library.GetRenderPipeline(descriptor, /*async=*/true,
+                                /*record_usage=*/false);
+    }
+  });
+}
+
 const std::shared_ptr<PipelineCacheVK>& PipelineLibraryVK::GetPSOCache() const {
   return pso_cache_;
 }
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_LIBRARY_VK_H_
 
 #include <atomic>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/unique_fd.h"
@@ -42,6 +44,12 @@ class PipelineLibraryVK final
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
+  // Pipelines created from the usage profile that have not been requested in
+  // this run yet.
+  std::unordered_set<PipelineDescriptor,
+                     ComparableHash<PipelineDescriptor>,
+                     ComparableEqual<PipelineDescriptor>>
+      warmed_up_pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   Mutex compute_pipelines_mutex_;
   ComputePipelineMap compute_pipelines_ IPLR_GUARDED_BY(
       compute_pipelines_mutex_);
@@ -62,6 +70,19 @@ class PipelineLibraryVK final
   PipelineFuture<PipelineDescriptor> GetPipeline(PipelineDescriptor descriptor,
                                                  bool async) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get or create a render pipeline.
+  ///
+  /// @param[in]  record_usage  Whether the request is a use of the pipeline
+  ///                           that is recorded in the usage profile. Warming
+  ///                           up a pipeline is not. Its usage is recorded
+  ///                           when it is first requested.
+  ///
+  PipelineFuture<PipelineDescriptor> GetRenderPipeline(
+      PipelineDescriptor descriptor,
+      bool async,
+      bool record_usage);
+
   // |PipelineLibrary|
   PipelineFuture<ComputePipelineDescriptor> GetPipeline(
       ComputePipelineDescriptor descriptor,
@@ -76,6 +97,15 @@ class PipelineLibraryVK final
 
   void PersistPipelineCacheToDisk();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Load the pipeline usage profile of previous runs on a worker
+  ///             thread and create the recorded pipelines as soon as the
+  ///             pipelines they are derived from are requested.
+  ///
+  void WarmUpPipelinesFromUsageProfile();
+
+  void WarmUpPipelines(std::vector<PipelineDescriptor> descriptors);
+
   PipelineLibraryVK(const PipelineLibraryVK&) = delete;
 
   PipelineLibraryVK& operator=(const PipelineLibraryVK&) = delete;
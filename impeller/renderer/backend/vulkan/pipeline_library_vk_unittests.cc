@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+constexpr const char* kProfileFileName = "flutter.impeller.vkprofile";
+
+std::shared_ptr<ContextVK> CreateContext(
+    const fml::ScopedTemporaryDirectory& cache_directory) {
+  return MockVulkanContextBuilder()
+      .SetSettingsCallback([&cache_directory](ContextVK::Settings& settings) {
+        settings.cache_directory =
+            fml::OpenDirectory(cache_directory.path().c_str(), false,
+                               fml::FilePermission::kReadWrite);
+      })
+      .Build();
+}
+
+PipelineDescriptor MakeDescriptor(
+    const std::string& label,
+    const std::shared_ptr<VertexDescriptor>& vertex_descriptor,
+    CullMode cull_mode = CullMode::kNone,
+    std::vector<Scalar> specialization_constants = {}) {
+  PipelineDescriptor desc;
+  desc.SetLabel(label);
+  desc.SetVertexDescriptor(vertex_descriptor);
+  desc.SetCullMode(cull_mode);
+  desc.SetSpecializationConstants(std::move(specialization_constants));
+  return desc;
+}
+
+size_t CountCreatedPipelines(const ContextVK& context) {
+  return CountMockVulkanFunctionCalls(context.GetDevice(),
+                                      "vkCreateGraphicsPipelines");
+}
+
+// Pipelines are warmed up by a chain of tasks on the worker task runner.
+bool WaitForCreatedPipelines(const ContextVK& context, size_t count) {
+  const auto deadline =
+      fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  while (CountCreatedPipelines(context) < count) {
+    if (fml::TimePoint::Now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(PipelineLibraryVKTest, PersistCacheToDiskWritesUsageProfile) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto context = CreateContext(temp_dir);
+  ASSERT_TRUE(context);
+  auto& library = PipelineLibraryVK::Cast(*context->GetPipelineLibrary());
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+
+  library.GetPSOCache()->PersistCacheToDisk();
+  // Nothing has been recorded yet.
+  EXPECT_FALSE(fml::FileExists(temp_dir.fd(), kProfileFileName));
+
+  ASSERT_TRUE(
+      library.GetPipeline(MakeDescriptor("base", vertex_descriptor)).Get());
+  library.GetPSOCache()->PersistCacheToDisk();
+  EXPECT_TRUE(fml::FileExists(temp_dir.fd(), kProfileFileName));
+}
+
+TEST(PipelineLibraryVKTest, LoadsUsageProfileOnWorkerAndWarmsUpPipelines) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  const auto base = MakeDescriptor("base", vertex_descriptor);
+  const auto variant =
+      MakeDescriptor("variant", vertex_descriptor, CullMode::kBackFace);
+  {
+    auto context = CreateContext(temp_dir);
+    ASSERT_TRUE(context);
+    auto& library = PipelineLibraryVK::Cast(*context->GetPipelineLibrary());
+    ASSERT_TRUE(library.GetPipeline(base).Get());
+    ASSERT_TRUE(library.GetPipeline(variant).Get());
+    library.GetPSOCache()->PersistCacheToDisk();
+  }
+  ASSERT_TRUE(fml::FileExists(temp_dir.fd(), kProfileFileName));
+
+  auto context = CreateContext(temp_dir);
+  ASSERT_TRUE(context);
+  auto& library = PipelineLibraryVK::Cast(*context->GetPipelineLibrary());
+  const size_t initial_count = CountCreatedPipelines(*context);
+
+  // The profile is read on a worker and the variant is created as soon as its
+  // template is requested, whichever happens first.
+  ASSERT_TRUE(library.GetPipeline(base).Get());
+  ASSERT_TRUE(WaitForCreatedPipelines(*context, initial_count + 2u));
+
+  // The warmed up pipeline is reused.
+  ASSERT_TRUE(library.GetPipeline(variant).Get());
+  EXPECT_EQ(CountCreatedPipelines(*context), initial_count + 2u);
+}
+
+TEST(PipelineLibraryVKTest, GetPipelineWarmsUpAllVariantsOfItsTemplate) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  const auto base_a = MakeDescriptor("a", vertex_descriptor);
+  const auto variant_a1 =
+      MakeDescriptor("a1", vertex_descriptor, CullMode::kBackFace);
+  const auto variant_a2 =
+      MakeDescriptor("a2", vertex_descriptor, CullMode::kFrontFace);
+  const auto base_b =
+      MakeDescriptor("b", vertex_descriptor, CullMode::kNone, {1.0f});
+  const auto variant_b1 =
+      MakeDescriptor("b1", vertex_descriptor, CullMode::kBackFace, {1.0f});
+  {
+    auto context = CreateContext(temp_dir);
+    ASSERT_TRUE(context);
+    auto& library = PipelineLibraryVK::Cast(*context->GetPipelineLibrary());
+    for (const auto& desc :
+         {base_a, variant_a1, variant_a2, base_b, variant_b1}) {
+      ASSERT_TRUE(library.GetPipeline(desc).Get());
+    }
+    library.GetPSOCache()->PersistCacheToDisk();
+  }
+
+  auto context = CreateContext(temp_dir);
+  ASSERT_TRUE(context);
+  auto& library = PipelineLibraryVK::Cast(*context->GetPipelineLibrary());
+  const size_t initial_count = CountCreatedPipelines(*context);
+
+  ASSERT_TRUE(library.GetPipeline(base_a).Get());
+  ASSERT_TRUE(WaitForCreatedPipelines(*context, initial_count + 3u));
+  ASSERT_TRUE(library.GetPipeline(variant_a1).Get());
+  ASSERT_TRUE(library.GetPipeline(variant_a2).Get());
+  // The variant of the other template waits for its own template.
+  EXPECT_EQ(CountCreatedPipelines(*context), initial_count + 3u);
+
+  ASSERT_TRUE(library.GetPipeline(base_b).Get());
+  ASSERT_TRUE(WaitForCreatedPipelines(*context, initial_count + 5u));
+  ASSERT_TRUE(library.GetPipeline(variant_b1).Get());
+  EXPECT_EQ(CountCreatedPipelines(*context), initial_count + 5u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,500 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/pipeline_usage_profile_vk.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include "impeller/renderer/shader_function.h"
+
+namespace impeller {
+
+namespace {
+
+// Bump the version whenever the layout of the serialized records changes.
+constexpr uint32_t kProfileMagic = 0x50495053;  // "PIPS"
+constexpr uint32_t kProfileVersion = 2u;
+
+// Guards against allocating absurd amounts of memory for corrupt data.
+constexpr uint32_t kMaxStringLength = 1024u;
+constexpr uint32_t kMaxCollectionSize = 64u;
+
+class ProfileWriter {
+ public:
+  template <class T>
+  void Write(T value) {
+    static_assert(std::is_arithmetic_v<T>);
+    const auto offset = data_.size();
+    data_.resize(offset + sizeof(T));
+    std::memcpy(data_.data() + offset, &value, sizeof(T));
+  }
+
+  template <class T>
+  void WriteEnum(T value) {
+    Write(static_cast<uint32_t>(value));
+  }
+
+  void WriteString(const std::string& value) {
+    Write(static_cast<uint32_t>(value.size()));
+    data_.insert(data_.end(), value.begin(), value.end());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class ProfileReader {
+ public:
+  explicit ProfileReader(const fml::Mapping& data)
+      : data_(data.GetMapping()), size_(data.GetSize()) {}
+
+  template <class T>
+  [[nodiscard]] bool Read(T& value) {
+    static_assert(std::is_arithmetic_v<T>);
+    if (data_ == nullptr || size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  /// Reads an enum value, rejecting values past the last enumerator.
+  template <class T>
+  [[nodiscard]] bool ReadEnum(T& value, T last) {
+    uint32_t raw = 0u;
+    if (!Read(raw) || raw > static_cast<uint32_t>(last)) {
+      return false;
+    }
+    value = static_cast<T>(raw);
+    return true;
+  }
+
+  [[nodiscard]] bool ReadString(std::string& value) {
+    uint32_t length = 0u;
+    if (!Read(length) || length > kMaxStringLength ||
+        size_ - offset_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0u;
+};
+
+void WriteStencil(ProfileWriter& writer,
+                  const std::optional<StencilAttachmentDescriptor>& stencil) {
+  writer.Write<uint8_t>(stencil.has_value());
+  if (!stencil.has_value()) {
+    return;
+  }
+  writer.WriteEnum(stencil->stencil_compare);
+  writer.WriteEnum(stencil->stencil_failure);
+  writer.WriteEnum(stencil->depth_failure);
+  writer.WriteEnum(stencil->depth_stencil_pass);
+  writer.Write(stencil->read_mask);
+  writer.Write(stencil->write_mask);
+}
+
+bool ReadStencil(ProfileReader& reader,
+                 std::optional<StencilAttachmentDescriptor>& stencil) {
+  uint8_t has_stencil = 0u;
+  if (!reader.Read(has_stencil)) {
+    return false;
+  }
+  if (!has_stencil) {
+    stencil = std::nullopt;
+    return true;
+  }
+  StencilAttachmentDescriptor desc;
+  if (!reader.ReadEnum(desc.stencil_compare, CompareFunction::kGreaterEqual) ||
+      !reader.ReadEnum(desc.stencil_failure,
+                       StencilOperation::kDecrementWrap) ||
+      !reader.ReadEnum(desc.depth_failure, StencilOperation::kDecrementWrap) ||
+      !reader.ReadEnum(desc.depth_stencil_pass,
+                       StencilOperation::kDecrementWrap) ||
+      !reader.Read(desc.read_mask) || !reader.Read(desc.write_mask)) {
+    return false;
+  }
+  stencil = desc;
+  return true;
+}
+
+void WriteState(ProfileWriter& writer, const PipelineDescriptor& state) {
+  writer.WriteString(state.GetLabel());
+  writer.WriteEnum(state.GetSampleCount());
+  writer.Write(
+      static_cast<uint32_t>(state.GetColorAttachmentDescriptors().size()));
+  for (const auto& [index, color] : state.GetColorAttachmentDescriptors()) {
+    writer.Write(static_cast<uint32_t>(index));
+    writer.WriteEnum(color.format);
+    writer.Write<uint8_t>(color.blending_enabled);
+    writer.WriteEnum(color.src_color_blend_factor);
+    writer.WriteEnum(color.color_blend_op);
+    writer.WriteEnum(color.dst_color_blend_factor);
+    writer.WriteEnum(color.src_alpha_blend_factor);
+    writer.WriteEnum(color.alpha_blend_op);
+    writer.WriteEnum(color.dst_alpha_blend_factor);
+    writer.Write(static_cast<uint64_t>(color.write_mask));
+  }
+  writer.WriteEnum(state.GetDepthPixelFormat());
+  writer.WriteEnum(state.GetStencilPixelFormat());
+  const auto depth = state.GetDepthStencilAttachmentDescriptor();
+  writer.Write<uint8_t>(depth.has_value());
+  if (depth.has_value()) {
+    writer.WriteEnum(depth->depth_compare);
+    writer.Write<uint8_t>(depth->depth_write_enabled);
+  }
+  WriteStencil(writer, state.GetFrontStencilAttachmentDescriptor());
+  WriteStencil(writer, state.GetBackStencilAttachmentDescriptor());
+  writer.WriteEnum(state.GetWindingOrder());
+  writer.WriteEnum(state.GetCullMode());
+  writer.WriteEnum(state.GetPrimitiveType());
+  writer.WriteEnum(state.GetPolygonMode());
+  const auto& constants = state.GetSpecializationConstants();
+  writer.Write(static_cast<uint32_t>(constants.size()));
+  for (auto constant : constants) {
+    writer.Write(constant);
+  }
+}
+
+bool ReadState(ProfileReader& reader, PipelineDescriptor& state) {
+  std::string label;
+  uint32_t sample_count = 0u;
+  if (!reader.ReadString(label) || !reader.Read(sample_count)) {
+    return false;
+  }
+  switch (static_cast<SampleCount>(sample_count)) {
+    case SampleCount::kCount1:
+    case SampleCount::kCount4:
+      break;
+    default:
+      return false;
+  }
+  state.SetLabel(std::move(label));
+  state.SetSampleCount(static_cast<SampleCount>(sample_count));
+
+  uint32_t color_count = 0u;
+  if (!reader.Read(color_count) || color_count > kMaxCollectionSize) {
+    return false;
+  }
+  std::map<size_t, ColorAttachmentDescriptor> colors;
+  for (uint32_t i = 0; i < color_count; i++) {
+    uint32_t index = 0u;
+    uint8_t blending_enabled = 0u;
+    uint64_t write_mask = 0u;
+    ColorAttachmentDescriptor color;
+    if (!reader.Read(index) ||
+        !reader.ReadEnum(color.format, PixelFormat::kD32FloatS8UInt) ||
+        !reader.Read(blending_enabled) ||
+        !reader.ReadEnum(color.src_color_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.color_blend_op,
+                         BlendOperation::kReverseSubtract) ||
+        !reader.ReadEnum(color.dst_color_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.src_alpha_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.ReadEnum(color.alpha_blend_op,
+                         BlendOperation::kReverseSubtract) ||
+        !reader.ReadEnum(color.dst_alpha_blend_factor,
+                         BlendFactor::kOneMinusBlendAlpha) ||
+        !reader.Read(write_mask)) {
+      return false;
+    }
+    color.blending_enabled = blending_enabled != 0u;
+    color.write_mask =
+        ColorWriteMask{write_mask} & ColorWriteMaskBits::kAll;
+    colors[index] = color;
+  }
+  state.SetColorAttachmentDescriptors(std::move(colors));
+
+  PixelFormat depth_format = PixelFormat::kUnknown;
+  PixelFormat stencil_format = PixelFormat::kUnknown;
+  uint8_t has_depth = 0u;
+  if (!reader.ReadEnum(depth_format, PixelFormat::kD32FloatS8UInt) ||
+      !reader.ReadEnum(stencil_format, PixelFormat::kD32FloatS8UInt) ||
+      !reader.Read(has_depth)) {
+    return false;
+  }
+  state.SetDepthPixelFormat(depth_format);
+  state.SetStencilPixelFormat(stencil_format);
+  if (has_depth) {
+    DepthAttachmentDescriptor depth;
+    uint8_t depth_write_enabled = 0u;
+    if (!reader.ReadEnum(depth.depth_compare, CompareFunction::kGreaterEqual) ||
+        !reader.Read(depth_write_enabled)) {
+      return false;
+    }
+    depth.depth_write_enabled = depth_write_enabled != 0u;
+    state.SetDepthStencilAttachmentDescriptor(depth);
+  }
+
+  std::optional<StencilAttachmentDescriptor> front;
+  std::optional<StencilAttachmentDescriptor> back;
+  if (!ReadStencil(reader, front) || !ReadStencil(reader, back)) {
+    return false;
+  }
+  state.SetStencilAttachmentDescriptors(front, back);
+
+  WindingOrder winding_order = WindingOrder::kClockwise;
+  CullMode cull_mode = CullMode::kNone;
+  PrimitiveType primitive_type = PrimitiveType::kTriangle;
+  PolygonMode polygon_mode = PolygonMode::kFill;
+  uint32_t constant_count = 0u;
+  if (!reader.ReadEnum(winding_order, WindingOrder::kCounterClockwise) ||
+      !reader.ReadEnum(cull_mode, CullMode::kBackFace) ||
+      !reader.ReadEnum(primitive_type, PrimitiveType::kTriangleFan) ||
+      !reader.ReadEnum(polygon_mode, PolygonMode::kLine) ||
+      !reader.Read(constant_count) || constant_count > kMaxCollectionSize) {
+    return false;
+  }
+  state.SetWindingOrder(winding_order);
+  state.SetCullMode(cull_mode);
+  state.SetPrimitiveType(primitive_type);
+  state.SetPolygonMode(polygon_mode);
+  std::vector<Scalar> constants(constant_count);
+  for (auto& constant : constants) {
+    if (!reader.Read(constant)) {
+      return false;
+    }
+  }
+  state.SetSpecializationConstants(std::move(constants));
+  return true;
+}
+
+}  // namespace
+
+PipelineUsageProfileVK::PipelineUsageProfileVK() = default;
+
+PipelineUsageProfileVK::~PipelineUsageProfileVK() = default;
+
+bool PipelineUsageProfileVK::Record::operator==(const Record& other) const {
+  return entrypoints == other.entrypoints && state.IsEqual(other.state);
+}
+
+PipelineUsageProfileVK::Record PipelineUsageProfileVK::MakeRecord(
+    const PipelineDescriptor& desc) {
+  Record record;
+  for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+    if (function) {
+      record.entrypoints[stage] = function->GetName();
+    }
+  }
+  // Entrypoints can't be removed from a descriptor. Copy the state into a
+  // fresh one instead.
+  record.state = BuildDescriptor(PipelineDescriptor{}, desc);
+  return record;
+}
+
+std::string PipelineUsageProfileVK::GetTemplateKey(
+    const std::map<ShaderStage, std::string>& entrypoints,
+    const std::vector<Scalar>& specialization_constants) {
+  std::stringstream key;
+  for (const auto& [stage, name] : entrypoints) {
+    key << static_cast<uint32_t>(stage) << ':' << name << ';';
+  }
+  for (auto constant : specialization_constants) {
+    key << constant << ',';
+  }
+  return key.str();
+}
+
+PipelineDescriptor PipelineUsageProfileVK::BuildDescriptor(
+    const PipelineDescriptor& base,
+    const PipelineDescriptor& state) {
+  PipelineDescriptor desc = base;
+  desc.SetLabel(state.GetLabel());
+  desc.SetSampleCount(state.GetSampleCount());
+  desc.SetColorAttachmentDescriptors(state.GetColorAttachmentDescriptors());
+  desc.SetDepthPixelFormat(state.GetDepthPixelFormat());
+  desc.SetStencilPixelFormat(state.GetStencilPixelFormat());
+  desc.SetDepthStencilAttachmentDescriptor(
+      state.GetDepthStencilAttachmentDescriptor());
+  desc.SetStencilAttachmentDescriptors(
+      state.GetFrontStencilAttachmentDescriptor(),
+      state.GetBackStencilAttachmentDescriptor());
+  desc.SetWindingOrder(state.GetWindingOrder());
+  desc.SetCullMode(state.GetCullMode());
+  desc.SetPrimitiveType(state.GetPrimitiveType());
+  desc.SetPolygonMode(state.GetPolygonMode());
+  desc.SetSpecializationConstants(state.GetSpecializationConstants());
+  return desc;
+}
+
+bool PipelineUsageProfileVK::AddRecord(Record record) {
+  if (records_.size() >= kMaxRecordCount) {
+    auto least_recently_used = std::min_element(
+        records_.begin(), records_.end(), [](const auto& a, const auto& b) {
+          return a.last_used_run < b.last_used_run;
+        });
+    if (least_recently_used->last_used_run >= record.last_used_run) {
+      return false;
+    }
+    RemovePendingRecord(*least_recently_used);
+    records_.erase(least_recently_used);
+  }
+  records_.emplace_back(std::move(record));
+  return true;
+}
+
+void PipelineUsageProfileVK::RemovePendingRecord(const Record& record) {
+  auto pending = pending_records_.find(GetTemplateKey(
+      record.entrypoints, record.state.GetSpecializationConstants()));
+  if (pending == pending_records_.end()) {
+    return;
+  }
+  auto& pending_records = pending->second;
+  pending_records.erase(
+      std::remove(pending_records.begin(), pending_records.end(), record),
+      pending_records.end());
+  if (pending_records.empty()) {
+    pending_records_.erase(pending);
+  }
+}
+
+std::vector<PipelineDescriptor> PipelineUsageProfileVK::RecordPipeline(
+    const PipelineDescriptor& desc) {
+  auto record = MakeRecord(desc);
+  record.last_used_run = run_;
+  const auto key = GetTemplateKey(record.entrypoints,
+                                  desc.GetSpecializationConstants());
+  if (auto found = std::find(records_.begin(), records_.end(), record);
+      found != records_.end()) {
+    if (found->last_used_run != run_) {
+      found->last_used_run = run_;
+      dirty_ = true;
+    }
+  } else {
+    dirty_ |= AddRecord(record);
+  }
+  templates_.try_emplace(key, desc);
+
+  std::vector<PipelineDescriptor> descriptors;
+  auto pending = pending_records_.find(key);
+  if (pending == pending_records_.end()) {
+    return descriptors;
+  }
+  for (const auto& pending_record : pending->second) {
+    // The template itself has just been created.
+    if (pending_record == record) {
+      continue;
+    }
+    descriptors.push_back(BuildDescriptor(desc, pending_record.state));
+  }
+  pending_records_.erase(pending);
+  return descriptors;
+}
+
+std::optional<std::vector<PipelineDescriptor>>
+PipelineUsageProfileVK::AddSerializedProfile(const fml::Mapping& data) {
+  ProfileReader reader(data);
+  uint32_t magic = 0u;
+  uint32_t version = 0u;
+  uint32_t run = 0u;
+  uint32_t record_count = 0u;
+  if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(run) ||
+      !reader.Read(record_count) || magic != kProfileMagic ||
+      version != kProfileVersion ||
+      run == std::numeric_limits<uint32_t>::max() ||
+      record_count > kMaxRecordCount) {
+    return std::nullopt;
+  }
+  std::vector<Record> records(record_count);
+  for (auto& record : records) {
+    uint32_t entrypoint_count = 0u;
+    if (!reader.Read(record.last_used_run) || record.last_used_run > run ||
+        !reader.Read(entrypoint_count) ||
+        entrypoint_count > kMaxCollectionSize) {
+      return std::nullopt;
+    }
+    for (uint32_t i = 0; i < entrypoint_count; i++) {
+      ShaderStage stage = ShaderStage::kUnknown;
+      std::string name;
+      if (!reader.ReadEnum(stage, ShaderStage::kCompute) ||
+          !reader.ReadString(name)) {
+        return std::nullopt;
+      }
+      record.entrypoints[stage] = std::move(name);
+    }
+    if (!ReadState(reader, record.state)) {
+      return std::nullopt;
+    }
+  }
+  if (!reader.IsAtEnd()) {
+    return std::nullopt;
+  }
+
+  // This run follows the one that serialized the profile. The pipelines
+  // recorded so far were used in this run.
+  if (run >= run_) {
+    for (auto& record : records_) {
+      record.last_used_run = run + 1u;
+    }
+    run_ = run + 1u;
+  }
+
+  std::vector<PipelineDescriptor> descriptors;
+  for (auto& record : records) {
+    if (run_ - record.last_used_run > kMaxUnusedRunCount) {
+      continue;
+    }
+    const auto key = GetTemplateKey(record.entrypoints,
+                                    record.state.GetSpecializationConstants());
+    if (std::find(records_.begin(), records_.end(), record) !=
+            records_.end() ||
+        !AddRecord(record)) {
+      // Already used in this run, or less recently used than every record.
+      continue;
+    }
+    if (auto found = templates_.find(key); found != templates_.end()) {
+      descriptors.push_back(BuildDescriptor(found->second, record.state));
+    } else {
+      pending_records_[key].emplace_back(std::move(record));
+    }
+  }
+  return descriptors;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfileVK::Serialize() const {
+  ProfileWriter writer;
+  writer.Write(kProfileMagic);
+  writer.Write(kProfileVersion);
+  writer.Write(run_);
+  writer.Write(static_cast<uint32_t>(records_.size()));
+  for (const auto& record : records_) {
+    writer.Write(record.last_used_run);
+    writer.Write(static_cast<uint32_t>(record.entrypoints.size()));
+    for (const auto& [stage, name] : record.entrypoints) {
+      writer.WriteEnum(stage);
+      writer.WriteString(name);
+    }
+    WriteState(writer, record.state);
+  }
+  dirty_ = false;
+  return std::make_unique<fml::DataMapping>(writer.TakeData());
+}
+
+size_t PipelineUsageProfileVK::GetRecordCount() const {
+  return records_.size();
+}
+
+bool PipelineUsageProfileVK::IsDirty() const {
+  return dirty_;
+}
+
+}  // namespace impeller
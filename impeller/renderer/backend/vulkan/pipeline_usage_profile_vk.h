@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_USAGE_PROFILE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_USAGE_PROFILE_VK_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Records the render pipelines created by a pipeline library so
+///             that they can be created ahead of time when the application is
+///             launched again.
+///
+///             Pipeline descriptors reference shader functions and vertex
+///             descriptors that only exist while the application runs. So
+///             records only contain the names of the stage entrypoints and the
+///             fixed function state. A recorded pipeline is rebuilt from the
+///             first pipeline requested in a later run that has the same
+///             entrypoints and specialization constants. That pipeline is the
+///             template that provides the shader functions and the vertex
+///             descriptor.
+///
+///             Each record remembers the last run that used it. Records that
+///             were not used in the last `kMaxUnusedRunCount` runs are dropped
+///             when the profile is loaded, and once the profile is full the
+///             least recently used record makes room for a new one.
+///
+///             This class is not thread-safe.
+///
+class PipelineUsageProfileVK {
+ public:
+  /// The maximum number of pipelines recorded in a profile. Once it is
+  /// reached, a new pipeline replaces the least recently used one if that was
+  /// not used in this run.
+  static constexpr size_t kMaxRecordCount = 1024u;
+
+  /// The number of runs after which a pipeline that was not used again is
+  /// dropped from the profile.
+  static constexpr uint32_t kMaxUnusedRunCount = 8u;
+
+  PipelineUsageProfileVK();
+
+  ~PipelineUsageProfileVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the use of a pipeline in this run.
+  ///
+  /// @param[in]  desc  The descriptor of the created pipeline.
+  ///
+  /// @return     The descriptors of pipelines recorded in previous runs that
+  ///             have the given descriptor as their template and have not been
+  ///             returned before.
+  ///
+  std::vector<PipelineDescriptor> RecordPipeline(
+      const PipelineDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the pipelines of a profile serialized in a previous run.
+  ///             The runs recorded from then on follow that run. Pipelines
+  ///             that were not used in the last `kMaxUnusedRunCount` runs are
+  ///             dropped.
+  ///
+  /// @param[in]  data  The serialized profile.
+  ///
+  /// @return     The descriptors of the added pipelines whose template has
+  ///             already been recorded in this run, or `std::nullopt` if the
+  ///             data is not a valid profile.
+  ///
+  std::optional<std::vector<PipelineDescriptor>> AddSerializedProfile(
+      const fml::Mapping& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize all recorded pipelines.
+  ///
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of distinct pipelines in the profile.
+  ///
+  size_t GetRecordCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether pipelines were recorded or first used in this run
+  ///             since the profile was last serialized.
+  ///
+  bool IsDirty() const;
+
+ private:
+  struct Record {
+    std::map<ShaderStage, std::string> entrypoints;
+    /// The fixed function state. The descriptor has no entrypoints and no
+    /// vertex descriptor.
+    PipelineDescriptor state;
+    /// The last run that used the pipeline.
+    uint32_t last_used_run = 0u;
+
+    /// Whether both records are of the same pipeline, regardless of when it
+    /// was used.
+    bool operator==(const Record& other) const;
+  };
+
+  std::vector<Record> records_;
+  // The first pipeline recorded in this run for each template key.
+  std::unordered_map<std::string, PipelineDescriptor> templates_;
+  // The pipelines of previous runs that have not been built yet, by the key of
+  // their templates.
+  std::unordered_map<std::string, std::vector<Record>> pending_records_;
+  // The index of this run. Runs are counted by the serialized profiles.
+  uint32_t run_ = 0u;
+  mutable bool dirty_ = false;
+
+  static Record MakeRecord(const PipelineDescriptor& desc);
+
+  static std::string GetTemplateKey(
+      const std::map<ShaderStage, std::string>& entrypoints,
+      const std::vector<Scalar>& specialization_constants);
+
+  static PipelineDescriptor BuildDescriptor(const PipelineDescriptor& base,
+                                            const PipelineDescriptor& state);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a record that is not in the profile yet, evicting the
+  ///             least recently used record if the profile is full.
+  ///
+  /// @return     Whether the record was added. It is not if every record was
+  ///             used at least as recently.
+  ///
+  bool AddRecord(Record record);
+
+  void RemovePendingRecord(const Record& record);
+
+  PipelineUsageProfileVK(const PipelineUsageProfileVK&) = delete;
+
+  PipelineUsageProfileVK& operator=(const PipelineUsageProfileVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_USAGE_PROFILE_VK_H_
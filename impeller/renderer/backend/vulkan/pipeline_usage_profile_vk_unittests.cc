@@ -0,0 +1,255 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/pipeline_usage_profile_vk.h"
+#include "impeller/renderer/shader_function.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestShaderFunction final : public ShaderFunction {
+ public:
+  TestShaderFunction(std::string name, ShaderStage stage)
+      : ShaderFunction(UniqueID{}, std::move(name), stage) {}
+};
+
+PipelineDescriptor MakeDescriptor(const std::string& name) {
+  PipelineDescriptor desc;
+  desc.SetLabel(name);
+  desc.AddStageEntrypoint(std::make_shared<TestShaderFunction>(
+      name + "_vertex", ShaderStage::kVertex));
+  desc.AddStageEntrypoint(std::make_shared<TestShaderFunction>(
+      name + "_fragment", ShaderStage::kFragment));
+  return desc;
+}
+
+PipelineDescriptor MakeVariant(const PipelineDescriptor& base) {
+  PipelineDescriptor desc = base;
+  desc.SetSampleCount(SampleCount::kCount4);
+  desc.SetStencilPixelFormat(PixelFormat::kS8UInt);
+  ColorAttachmentDescriptor color;
+  color.format = PixelFormat::kB8G8R8A8UNormInt;
+  color.blending_enabled = true;
+  color.src_color_blend_factor = BlendFactor::kDestinationAlpha;
+  color.write_mask = ColorWriteMaskBits::kRed | ColorWriteMaskBits::kAlpha;
+  desc.SetColorAttachmentDescriptor(0u, color);
+  StencilAttachmentDescriptor stencil;
+  stencil.stencil_compare = CompareFunction::kEqual;
+  stencil.depth_stencil_pass = StencilOperation::kIncrementClamp;
+  desc.SetStencilAttachmentDescriptors(stencil);
+  desc.SetCullMode(CullMode::kBackFace);
+  desc.SetPrimitiveType(PrimitiveType::kTriangleStrip);
+  return desc;
+}
+
+std::unique_ptr<fml::Mapping> MakeProfile(
+    const std::vector<PipelineDescriptor>& descriptors) {
+  PipelineUsageProfileVK profile;
+  for (const auto& desc : descriptors) {
+    profile.RecordPipeline(desc);
+  }
+  return profile.Serialize();
+}
+
+// Loads the profile serialized by the previous run into a profile for the next
+// run.
+std::unique_ptr<PipelineUsageProfileVK> StartNextRun(
+    const PipelineUsageProfileVK& previous) {
+  auto data = previous.Serialize();
+  auto next = std::make_unique<PipelineUsageProfileVK>();
+  if (!data || !next->AddSerializedProfile(*data).has_value()) {
+    return nullptr;
+  }
+  return next;
+}
+
+}  // namespace
+
+TEST(PipelineUsageProfileVKTest, RecordsDistinctPipelines) {
+  PipelineUsageProfileVK profile;
+  EXPECT_FALSE(profile.IsDirty());
+  auto base = MakeDescriptor("solid");
+  EXPECT_TRUE(profile.RecordPipeline(base).empty());
+  EXPECT_TRUE(profile.RecordPipeline(MakeVariant(base)).empty());
+  EXPECT_TRUE(profile.RecordPipeline(MakeDescriptor("solid")).empty());
+  EXPECT_EQ(profile.GetRecordCount(), 2u);
+  EXPECT_TRUE(profile.IsDirty());
+
+  ASSERT_TRUE(profile.Serialize());
+  EXPECT_FALSE(profile.IsDirty());
+}
+
+TEST(PipelineUsageProfileVKTest, BuildsRecordedPipelinesFromTemplates) {
+  auto base = MakeDescriptor("solid");
+  auto variant = MakeVariant(base);
+  auto data = MakeProfile({base, variant});
+  ASSERT_TRUE(data);
+
+  PipelineUsageProfileVK profile;
+  auto added = profile.AddSerializedProfile(*data);
+  ASSERT_TRUE(added.has_value());
+  // No template has been requested yet.
+  EXPECT_TRUE(added->empty());
+  EXPECT_EQ(profile.GetRecordCount(), 2u);
+  EXPECT_FALSE(profile.IsDirty());
+
+  // Shader functions of this run differ from the ones of the previous run.
+  auto template_desc = MakeDescriptor("solid");
+  auto warm_up = profile.RecordPipeline(template_desc);
+  ASSERT_EQ(warm_up.size(), 1u);
+  EXPECT_TRUE(warm_up[0].IsEqual(MakeVariant(template_desc)));
+  // The template was used again in this run.
+  EXPECT_TRUE(profile.IsDirty());
+
+  // Pipelines are only returned once.
+  EXPECT_TRUE(profile.RecordPipeline(template_desc).empty());
+}
+
+TEST(PipelineUsageProfileVKTest, BuildsPipelinesOfKnownTemplatesImmediately) {
+  auto base = MakeDescriptor("solid");
+  auto variant = MakeVariant(base);
+  auto other = MakeDescriptor("texture");
+  auto data = MakeProfile({base, variant, MakeVariant(other)});
+  ASSERT_TRUE(data);
+
+  PipelineUsageProfileVK profile;
+  profile.RecordPipeline(base);
+  auto added = profile.AddSerializedProfile(*data);
+  ASSERT_TRUE(added.has_value());
+  ASSERT_EQ(added->size(), 1u);
+  EXPECT_TRUE(added->at(0).IsEqual(variant));
+  EXPECT_EQ(profile.GetRecordCount(), 3u);
+}
+
+TEST(PipelineUsageProfileVKTest, RejectsCorruptProfiles) {
+  auto base = MakeDescriptor("solid");
+  auto data = MakeProfile({base, MakeVariant(base)});
+  ASSERT_TRUE(data);
+  std::vector<uint8_t> bytes(data->GetMapping(),
+                             data->GetMapping() + data->GetSize());
+
+  // Every truncation is rejected.
+  for (size_t size = 0u; size < bytes.size(); size++) {
+    PipelineUsageProfileVK profile;
+    fml::NonOwnedMapping truncated(bytes.data(), size);
+    EXPECT_FALSE(profile.AddSerializedProfile(truncated).has_value());
+    EXPECT_EQ(profile.GetRecordCount(), 0u);
+  }
+
+  // So is trailing data.
+  {
+    auto padded = bytes;
+    padded.push_back(0u);
+    PipelineUsageProfileVK profile;
+    fml::NonOwnedMapping mapping(padded.data(), padded.size());
+    EXPECT_FALSE(profile.AddSerializedProfile(mapping).has_value());
+  }
+
+  // And a profile of another version.
+  {
+    auto versioned = bytes;
+    versioned[4] += 1u;
+    PipelineUsageProfileVK profile;
+    fml::NonOwnedMapping mapping(versioned.data(), versioned.size());
+    EXPECT_FALSE(profile.AddSerializedProfile(mapping).has_value());
+  }
+}
+
+TEST(PipelineUsageProfileVKTest, LimitsTheNumberOfRecords) {
+  PipelineUsageProfileVK profile;
+  for (size_t i = 0u; i < PipelineUsageProfileVK::kMaxRecordCount + 10u;
+       i++) {
+    profile.RecordPipeline(MakeDescriptor(std::to_string(i)));
+  }
+  EXPECT_EQ(profile.GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+
+  auto data = profile.Serialize();
+  ASSERT_TRUE(data);
+  PipelineUsageProfileVK loaded;
+  ASSERT_TRUE(loaded.AddSerializedProfile(*data).has_value());
+  EXPECT_EQ(loaded.GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+}
+
+TEST(PipelineUsageProfileVKTest, DropsPipelinesUnusedForManyRuns) {
+  auto used = MakeDescriptor("used");
+  auto unused = MakeDescriptor("unused");
+  auto profile = std::make_unique<PipelineUsageProfileVK>();
+  profile->RecordPipeline(MakeVariant(used));
+  profile->RecordPipeline(MakeVariant(unused));
+
+  for (uint32_t run = 1u; run <= PipelineUsageProfileVK::kMaxUnusedRunCount;
+       run++) {
+    profile = StartNextRun(*profile);
+    ASSERT_TRUE(profile);
+    EXPECT_EQ(profile->GetRecordCount(), 2u);
+    EXPECT_FALSE(profile->IsDirty());
+    // Using a pipeline of a previous run for the first time in this run
+    // updates the profile.
+    profile->RecordPipeline(MakeVariant(used));
+    EXPECT_TRUE(profile->IsDirty());
+  }
+
+  profile = StartNextRun(*profile);
+  ASSERT_TRUE(profile);
+  EXPECT_EQ(profile->GetRecordCount(), 1u);
+  EXPECT_EQ(profile->RecordPipeline(used).size(), 1u);
+  EXPECT_TRUE(profile->RecordPipeline(unused).empty());
+}
+
+TEST(PipelineUsageProfileVKTest, EvictsLeastRecentlyUsedPipelinesOnceFull) {
+  constexpr size_t kNewCount = 10u;
+  auto profile = std::make_unique<PipelineUsageProfileVK>();
+  for (size_t i = 0u; i < PipelineUsageProfileVK::kMaxRecordCount; i++) {
+    profile->RecordPipeline(
+        MakeVariant(MakeDescriptor("old" + std::to_string(i))));
+  }
+  ASSERT_EQ(profile->GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+
+  // The next run uses the first pipeline again along with new pipelines.
+  profile = StartNextRun(*profile);
+  ASSERT_TRUE(profile);
+  profile->RecordPipeline(MakeVariant(MakeDescriptor("old0")));
+  for (size_t i = 0u; i < kNewCount; i++) {
+    profile->RecordPipeline(
+        MakeVariant(MakeDescriptor("new" + std::to_string(i))));
+  }
+  EXPECT_EQ(profile->GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+
+  // The new pipelines replaced pipelines that were not used in that run.
+  profile = StartNextRun(*profile);
+  ASSERT_TRUE(profile);
+  EXPECT_EQ(profile->GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+  for (size_t i = 0u; i < kNewCount; i++) {
+    EXPECT_EQ(
+        profile->RecordPipeline(MakeDescriptor("new" + std::to_string(i)))
+            .size(),
+        1u);
+  }
+  EXPECT_EQ(profile->RecordPipeline(MakeDescriptor("old0")).size(), 1u);
+}
+
+TEST(PipelineUsageProfileVKTest, KeepsPipelinesUsedInThisRunOnceFull) {
+  PipelineUsageProfileVK profile;
+  for (size_t i = 0u; i < PipelineUsageProfileVK::kMaxRecordCount; i++) {
+    profile.RecordPipeline(MakeDescriptor(std::to_string(i)));
+  }
+  ASSERT_TRUE(profile.Serialize());
+
+  // A full profile of pipelines used in this run has no room for new ones.
+  profile.RecordPipeline(MakeDescriptor("new"));
+  EXPECT_EQ(profile.GetRecordCount(), PipelineUsageProfileVK::kMaxRecordCount);
+  EXPECT_FALSE(profile.IsDirty());
+}
+
+}  // namespace testing
+}  // namespace impeller
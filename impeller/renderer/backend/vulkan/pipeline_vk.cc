@@ -180,7 +180,12 @@ fml::StatusOr<vk::UniqueDescriptorSetLayout> MakeDescriptorSetLayout(
     vk::DescriptorSetLayoutBinding set_binding;
     set_binding.binding = layout.binding;
     set_binding.descriptorCount = 1u;
-    set_binding.descriptorType = ToVKDescriptorType(layout.descriptor_type);
+    // Uniform buffers are bound with dynamic offsets so that draws binding
+    // different ranges of the same buffer can share a descriptor set.
+    set_binding.descriptorType =
+        layout.descriptor_type == DescriptorType::kUniformBuffer
+            ? vk::DescriptorType::eUniformBufferDynamic
+            : ToVKDescriptorType(layout.descriptor_type);
     set_binding.stageFlags = ToVkShaderStage(layout.shader_stage);
     // TODO(143719): This specifies the immutable sampler for all sampled
     // images. This is incorrect. In cases where the shader samples from the
@@ -4,10 +4,13 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <limits>
 #include <vector>
 
+#include "flutter/fml/logging.h"
 #include "fml/status.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
@@ -79,9 +82,10 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     const ContextVK& context,
     const SharedHandleVK<vk::RenderPass>& recycled_renderpass,
     const std::shared_ptr<CommandBufferVK>& command_buffer) const {
+  const auto& encoder = command_buffer->GetEncoder();
   BarrierVK barrier;
   barrier.new_layout = vk::ImageLayout::eGeneral;
-  barrier.cmd_buffer = command_buffer->GetEncoder()->GetCommandBuffer();
+  barrier.cmd_buffer = encoder->GetCommandBuffer();
   barrier.src_access = vk::AccessFlagBits::eShaderRead;
   barrier.src_stage = vk::PipelineStageFlagBits::eFragmentShader;
   barrier.dst_access = vk::AccessFlagBits::eColorAttachmentWrite |
@@ -99,9 +103,9 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         color.load_action,                                   //
         color.store_action                                   //
     );
-    TextureVK::Cast(*color.texture).SetLayout(barrier);
+    encoder->SetLayout(TextureVK::Cast(*color.texture), barrier);
     if (color.resolve_texture) {
-      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier);
+      encoder->SetLayout(TextureVK::Cast(*color.resolve_texture), barrier);
     }
   }
 
@@ -205,6 +209,9 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
+  // Encodes the attachment transitions of this pass along with the pending
+  // transitions of previous passes in one pipeline barrier.
+  encoder->FlushBarriers();
   command_buffer_vk_.beginRenderPass(pass_info, vk::SubpassContents::eInline);
 
   // Set the initial viewport.
@@ -460,9 +467,11 @@ fml::Status RenderPassVK::Draw() {
   const auto& context_vk = ContextVK::Cast(*context_);
   const auto& pipeline_vk = PipelineVK::Cast(*pipeline_);
 
-  auto descriptor_result =
-      command_buffer_->GetEncoder()->AllocateDescriptorSets(
-          pipeline_vk.GetDescriptorSetLayout(), context_vk);
+  // Draws binding the same resources share a descriptor set, which is only
+  // allocated and written for the first of them.
+  auto descriptor_result = command_buffer_->GetEncoder()->GetDescriptorSet(
+      pipeline_vk.GetDescriptorSetLayout(), write_workspace_.data(),
+      descriptor_write_offset_, context_vk);
   if (!descriptor_result.ok()) {
     return fml::Status(fml::StatusCode::kAborted,
                        "Could not allocate descriptor sets.");
@@ -472,21 +481,21 @@ fml::Status RenderPassVK::Draw() {
   command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
                                   pipeline_vk.GetPipeline());
 
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set;
+  // Dynamic offsets are consumed in the order of the bindings.
+  std::sort(dynamic_offset_workspace_.begin(),
+            dynamic_offset_workspace_.begin() + dynamic_offset_count_);
+  for (auto i = 0u; i < dynamic_offset_count_; i++) {
+    dynamic_offsets_[i] = dynamic_offset_workspace_[i].second;
   }
 
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
-
   command_buffer_vk_.bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,  // bind point
       pipeline_layout,                   // layout
       0,                                 // first set
       1,                                 // set count
       &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
+      dynamic_offset_count_,             // offset count
+      dynamic_offsets_.data()            // offsets
   );
 
   if (pipeline_uses_input_attachments_) {
@@ -519,6 +528,7 @@ fml::Status RenderPassVK::Draw() {
   bound_image_offset_ = 0u;
   bound_buffer_offset_ = 0u;
   descriptor_write_offset_ = 0u;
+  dynamic_offset_count_ = 0u;
   instance_count_ = 1u;
   base_vertex_ = 0u;
   vertex_count_ = 0u;
@@ -564,18 +574,29 @@ bool RenderPassVK::BindResource(size_t binding,
     return false;
   }
 
-  uint32_t offset = view.range.offset;
-
   vk::DescriptorBufferInfo buffer_info;
   buffer_info.buffer = buffer;
-  buffer_info.offset = offset;
+  buffer_info.offset = view.range.offset;
   buffer_info.range = view.range.length;
-  buffer_workspace_[bound_buffer_offset_++] = buffer_info;
 
   vk::WriteDescriptorSet write_set;
   write_set.dstBinding = binding;
   write_set.descriptorCount = 1u;
   write_set.descriptorType = ToVKDescriptorType(type);
+
+  // The offset of uniform data is passed when the descriptor set is bound.
+  // Draws that only differ in their uniform data then share a descriptor set.
+  if (type == DescriptorType::kUniformBuffer) {
+    // Dynamic offsets are 32 bits wide.
+    FML_DCHECK(view.range.offset <= std::numeric_limits<uint32_t>::max());
+    buffer_info.offset = 0u;
+    write_set.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+    dynamic_offset_workspace_[dynamic_offset_count_++] = std::make_pair(
+        static_cast<uint32_t>(binding),
+        static_cast<uint32_t>(view.range.offset));
+  }
+
+  buffer_workspace_[bound_buffer_offset_++] = buffer_info;
   write_set.pBufferInfo = &buffer_workspace_[bound_buffer_offset_ - 1];
 
   write_workspace_[descriptor_write_offset_++] = write_set;
@@ -641,7 +662,10 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
     barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
-    if (!TextureVK::Cast(*result_texture).SetLayout(barrier)) {
+    // The transition is encoded with the next barriers of this command
+    // buffer, at the latest when it is submitted.
+    if (!command_buffer_->GetEncoder()->SetLayout(
+            TextureVK::Cast(*result_texture), barrier)) {
       return false;
     }
   }
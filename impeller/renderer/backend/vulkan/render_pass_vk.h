@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 
+#include <array>
+#include <utility>
+
 #include "impeller/core/buffer_view.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -44,6 +47,11 @@ class RenderPassVK final : public RenderPass {
   size_t bound_image_offset_ = 0u;
   size_t bound_buffer_offset_ = 0u;
   size_t descriptor_write_offset_ = 0u;
+  // The bindings and offsets of the dynamic uniform buffers.
+  std::array<std::pair<uint32_t, uint32_t>, kMaxBindings>
+      dynamic_offset_workspace_;
+  std::array<uint32_t, kMaxBindings> dynamic_offsets_;
+  size_t dynamic_offset_count_ = 0u;
   size_t instance_count_ = 1u;
   size_t base_vertex_ = 0u;
   size_t vertex_count_ = 0u;
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/core/device_buffer_descriptor.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(RenderPassVKTest, DrawsWithDifferentUniformDataShareADescriptorSet) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  std::shared_ptr<Context> copy = context;
+  auto command_buffer = context->CreateCommandBuffer();
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreen(*copy, {1, 1}, 1);
+  std::shared_ptr<RenderPass> render_pass =
+      command_buffer->CreateRenderPass(target);
+  ASSERT_TRUE(render_pass);
+
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->RegisterDescriptorSetLayouts(
+      std::array<DescriptorSetLayout, 1>{DescriptorSetLayout{
+          .binding = 0u,
+          .descriptor_type = DescriptorType::kUniformBuffer,
+          .shader_stage = ShaderStage::kVertex,
+      }});
+  PipelineDescriptor pipeline_desc;
+  pipeline_desc.SetVertexDescriptor(vertex_descriptor);
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  ASSERT_TRUE(pipeline);
+
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kDevicePrivate,
+          .size = 1024u,
+      });
+  ASSERT_TRUE(buffer);
+
+  const ShaderUniformSlot slot{
+      .name = "FrameInfo", .ext_res_0 = 0u, .set = 0u, .binding = 0u};
+  const ShaderMetadata metadata;
+  for (auto i = 0u; i < 4u; i++) {
+    render_pass->SetPipeline(pipeline);
+    // Each draw has its own uniform data in the same buffer.
+    ASSERT_TRUE(render_pass->BindResource(
+        ShaderStage::kVertex, DescriptorType::kUniformBuffer, slot, metadata,
+        BufferView{buffer, Range{i * 256u, 64u}}));
+    ASSERT_TRUE(render_pass->Draw().ok());
+  }
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateDescriptorSets"),
+      1);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkUpdateDescriptorSets"),
+      1);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkCmdBindDescriptorSets"),
+      4);
+}
+
+TEST(RenderPassVKTest, BindsBuffersAtOffsetsPast32Bits) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  std::shared_ptr<Context> copy = context;
+  auto command_buffer = context->CreateCommandBuffer();
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreen(*copy, {1, 1}, 1);
+  std::shared_ptr<RenderPass> render_pass =
+      command_buffer->CreateRenderPass(target);
+  ASSERT_TRUE(render_pass);
+
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kDevicePrivate,
+          .size = 1024u,
+      });
+  ASSERT_TRUE(buffer);
+
+  const size_t offset = size_t{1u} << 33u;
+  const ShaderUniformSlot slot{
+      .name = "Data", .ext_res_0 = 0u, .set = 0u, .binding = 0u};
+  const ShaderMetadata metadata;
+  // Storage buffers are bound at their offset in the descriptor set.
+  EXPECT_TRUE(render_pass->BindResource(
+      ShaderStage::kFragment, DescriptorType::kStorageBuffer, slot, metadata,
+      BufferView{buffer, Range{offset, 64u}}));
+
+#if !NDEBUG
+  // Uniform buffers use 32 bit dynamic offsets.
+  EXPECT_DEATH_IF_SUPPORTED(
+      render_pass->BindResource(
+          ShaderStage::kFragment, DescriptorType::kUniformBuffer, slot,
+          metadata, BufferView{buffer, Range{offset, 64u}}),
+      "");
+#endif  // NDEBUG
+}
+
+}  // namespace testing
+}  // namespace impeller
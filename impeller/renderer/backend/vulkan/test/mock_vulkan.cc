@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -48,6 +50,8 @@ struct MockFramebuffer {};
 
 static ISize currentImageSize = ISize{1, 1};
 
+static std::atomic<size_t> g_pipeline_cache_data_size = 0u;
+
 class MockDevice final {
  public:
   explicit MockDevice() : called_functions_(new std::vector<std::string>()) {}
@@ -88,6 +92,12 @@ class MockDevice final {
     called_functions_->push_back(function);
   }
 
+  size_t CountCalledFunction(const std::string& function) {
+    Lock lock(called_functions_mutex_);
+    return std::count(called_functions_->begin(), called_functions_->end(),
+                      function);
+  }
+
  private:
   MockDevice(const MockDevice&) = delete;
 
@@ -256,6 +266,22 @@ VkResult vkCreatePipelineCache(VkDevice device,
   return VK_SUCCESS;
 }
 
+VkResult vkGetPipelineCacheData(VkDevice device,
+                                VkPipelineCache pipelineCache,
+                                size_t* pDataSize,
+                                void* pData) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkGetPipelineCacheData");
+  const size_t data_size = g_pipeline_cache_data_size;
+  if (pData) {
+    *pDataSize = std::min(*pDataSize, data_size);
+    std::memset(pData, 0, *pDataSize);
+  } else {
+    *pDataSize = data_size;
+  }
+  return VK_SUCCESS;
+}
+
 VkResult vkCreateCommandPool(VkDevice device,
                              const VkCommandPoolCreateInfo* pCreateInfo,
                              const VkAllocationCallbacks* pAllocator,
@@ -442,6 +468,19 @@ void vkCmdBindPipeline(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdBindPipeline");
 }
 
+void vkCmdBindDescriptorSets(VkCommandBuffer commandBuffer,
+                             VkPipelineBindPoint pipelineBindPoint,
+                             VkPipelineLayout layout,
+                             uint32_t firstSet,
+                             uint32_t descriptorSetCount,
+                             const VkDescriptorSet* pDescriptorSets,
+                             uint32_t dynamicOffsetCount,
+                             const uint32_t* pDynamicOffsets) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdBindDescriptorSets");
+}
+
 void vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
                               VkStencilFaceFlags faceMask,
                               uint32_t reference) {
@@ -468,6 +507,21 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                          VkPipelineStageFlags srcStageMask,
+                          VkPipelineStageFlags dstStageMask,
+                          VkDependencyFlags dependencyFlags,
+                          uint32_t memoryBarrierCount,
+                          const VkMemoryBarrier* pMemoryBarriers,
+                          uint32_t bufferMemoryBarrierCount,
+                          const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                          uint32_t imageMemoryBarrierCount,
+                          const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+}
+
 void vkFreeCommandBuffers(VkDevice device,
                           VkCommandPool commandPool,
                           uint32_t commandBufferCount,
@@ -621,9 +675,23 @@ VkResult vkAllocateDescriptorSets(
     VkDescriptorSet* pDescriptorSets) {
   MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
   mock_device->AddCalledFunction("vkAllocateDescriptorSets");
+  static std::atomic<uint64_t> next_descriptor_set = 1u;
+  for (auto i = 0u; i < pAllocateInfo->descriptorSetCount; i++) {
+    pDescriptorSets[i] =
+        reinterpret_cast<VkDescriptorSet>(next_descriptor_set++);
+  }
   return VK_SUCCESS;
 }
 
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkUpdateDescriptorSets");
+}
+
 VkResult vkGetPhysicalDeviceSurfaceFormatsKHR(
     VkPhysicalDevice physicalDevice,
     VkSurfaceKHR surface,
@@ -774,6 +842,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceMemoryProperties;
   } else if (strcmp("vkCreatePipelineCache", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreatePipelineCache;
+  } else if (strcmp("vkGetPipelineCacheData", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPipelineCacheData;
   } else if (strcmp("vkCreateCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateCommandPool;
   } else if (strcmp("vkResetCommandPool", pName) == 0) {
@@ -824,12 +894,16 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkDestroyPipelineCache;
   } else if (strcmp("vkCmdBindPipeline", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdBindPipeline;
+  } else if (strcmp("vkCmdBindDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdBindDescriptorSets;
   } else if (strcmp("vkCmdSetStencilReference", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetStencilReference;
   } else if (strcmp("vkCmdSetScissor", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyCommandPool;
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
@@ -866,6 +940,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkResetDescriptorPool;
   } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceFormatsKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceSurfaceFormatsKHR;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", pName) == 0) {
@@ -937,9 +1013,19 @@ std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
   return mock_device->GetCalledFunctions();
 }
 
+size_t CountMockVulkanFunctionCalls(VkDevice device,
+                                    const std::string& function) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  return mock_device->CountCalledFunction(function);
+}
+
 void SetSwapchainImageSize(ISize size) {
   currentImageSize = size;
 }
 
+void SetPipelineCacheDataSize(size_t size) {
+  g_pipeline_cache_data_size = size;
+}
+
 }  // namespace testing
 }  // namespace impeller
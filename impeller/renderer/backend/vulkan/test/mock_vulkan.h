@@ -21,6 +21,12 @@ namespace testing {
 std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
     VkDevice device);
 
+// Counts the calls to the given mocked function. Unlike
+// |GetMockVulkanFunctions|, this can be used while other threads are calling
+// mocked functions.
+size_t CountMockVulkanFunctionCalls(VkDevice device,
+                                    const std::string& function);
+
 // A test-controlled version of |vk::Fence|.
 class MockFence final {
  public:
@@ -124,6 +130,10 @@ class MockVulkanContextBuilder {
 /// @brief Override the image size returned by all swapchain images.
 void SetSwapchainImageSize(ISize size);
 
+/// @brief Override the size of the data returned by all pipeline caches. The
+///        data is zeroed.
+void SetPipelineCacheDataSize(size_t size);
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -8,6 +8,7 @@
 #include "flutter/fml/status.h"
 #include "impeller/base/thread.h"
 #include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
@@ -85,6 +86,20 @@ class TextureSourceVK {
   ///
   fml::Status SetLayout(const BarrierVK& barrier) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the layout transition `barrier` for the image to `batch`
+  ///             instead of encoding it. `barrier.cmd_buffer` is ignored.
+  ///
+  ///             The stored layout is updated immediately. So the batch must
+  ///             be encoded before any command that uses the image.
+  ///
+  /// @param[in]  barrier  The barrier.
+  /// @param[in]  batch    The batch to add the barrier to.
+  ///
+  /// @return     If the layout transition was successfully made.
+  ///
+  fml::Status SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Store the layout of the image.
   ///
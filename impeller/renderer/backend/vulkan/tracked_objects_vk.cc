@@ -81,6 +81,10 @@ DescriptorPoolVK& TrackedObjectsVK::GetDescriptorPool() {
   return desc_pool_;
 }
 
+BarrierBatchVK& TrackedObjectsVK::GetBarrierBatch() {
+  return barrier_batch_;
+}
+
 GPUProbe& TrackedObjectsVK::GetGPUProbe() const {
   return *probe_.get();
 }
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 
@@ -38,10 +39,13 @@ class TrackedObjectsVK {
 
   DescriptorPoolVK& GetDescriptorPool();
 
+  BarrierBatchVK& GetBarrierBatch();
+
   GPUProbe& GetGPUProbe() const;
 
  private:
   DescriptorPoolVK desc_pool_;
+  BarrierBatchVK barrier_batch_;
   // `shared_ptr` since command buffers have a link to the command pool.
   std::shared_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
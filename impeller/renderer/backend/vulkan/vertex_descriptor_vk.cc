@@ -101,6 +101,18 @@ vk::Format ToVertexDescriptorFormat(const ShaderStageIOSlot& input) {
       return vk::Format::eUndefined;
     }
     case ShaderType::kUnsignedShort: {
+      if (input.bit_width == 8 * sizeof(uint16_t) && input.normalized) {
+        switch (input.vec_size) {
+          case 1:
+            return vk::Format::eR16Unorm;
+          case 2:
+            return vk::Format::eR16G16Unorm;
+          case 3:
+            return vk::Format::eR16G16B16Unorm;
+          case 4:
+            return vk::Format::eR16G16B16A16Unorm;
+        }
+      }
       if (input.bit_width == 8 * sizeof(uint16_t)) {
         switch (input.vec_size) {
           case 1:
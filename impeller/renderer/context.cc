@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/context.h"
 
+#include "flutter/fml/concurrent_message_loop.h"
+
 namespace impeller {
 
 Context::~Context() = default;
@@ -14,4 +16,9 @@ bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+const std::shared_ptr<fml::ConcurrentTaskRunner>
+Context::GetConcurrentWorkerTaskRunner() const {
+  return nullptr;
+}
+
 }  // namespace impeller
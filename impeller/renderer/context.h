@@ -15,6 +15,10 @@
 #include "impeller/renderer/command_queue.h"
 #include "impeller/renderer/sampler_library.h"
 
+namespace fml {
+class ConcurrentTaskRunner;
+}  // namespace fml
+
 namespace impeller {
 
 class ShaderLibrary;
@@ -165,6 +169,17 @@ class Context {
   /// @brief Return the graphics queue for submitting command buffers.
   virtual std::shared_ptr<CommandQueue> GetCommandQueue() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the task runner of the worker threads owned by the
+  ///             context, which can be used for CPU work that runs
+  ///             concurrently with the raster thread.
+  ///
+  /// @return     The worker task runner, or `nullptr` if the context does not
+  ///             own worker threads.
+  ///
+  virtual const std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -256,6 +256,8 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+void RenderTargetAllocator::DiscardUnused() {}
+
 RenderTarget RenderTargetAllocator::CreateOffscreen(
     const Context& context,
     ISize size,
@@ -181,6 +181,10 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+  /// @brief Discard any textures that are kept for later frames but were not
+  ///        used in the last frame, for instance under memory pressure.
+  virtual void DiscardUnused();
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/vertex_descriptor.h"
 
+#include <algorithm>
+
 namespace impeller {
 
 VertexDescriptor::VertexDescriptor() = default;
@@ -78,4 +80,58 @@ bool VertexDescriptor::UsesInputAttacments() const {
   return uses_input_attachments_;
 }
 
+static bool IsFloat2(const ShaderStageIOSlot& input) {
+  return input.type == ShaderType::kFloat &&
+         input.bit_width == 8 * sizeof(float) && input.vec_size == 2u &&
+         input.columns == 1u;
+}
+
+static constexpr size_t AlignTo(size_t value, size_t alignment) {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+std::shared_ptr<VertexDescriptor> VertexDescriptor::CreatePackedDescriptor()
+    const {
+  auto packed = std::make_shared<VertexDescriptor>();
+  packed->inputs_ = inputs_;
+  packed->layouts_ = layouts_;
+  packed->desc_set_layouts_ = desc_set_layouts_;
+  packed->uses_input_attachments_ = uses_input_attachments_;
+
+  std::vector<ShaderStageIOSlot*> binding_inputs;
+  for (ShaderStageBufferLayout& layout : packed->layouts_) {
+    binding_inputs.clear();
+    bool has_float2 = false;
+    for (ShaderStageIOSlot& input : packed->inputs_) {
+      if (input.binding == layout.binding) {
+        binding_inputs.push_back(&input);
+        has_float2 |= IsFloat2(input);
+      }
+    }
+    if (!has_float2) {
+      continue;
+    }
+    std::sort(binding_inputs.begin(), binding_inputs.end(),
+              [](const ShaderStageIOSlot* a, const ShaderStageIOSlot* b) {
+                return a->offset < b->offset;
+              });
+
+    size_t offset = 0u;
+    for (ShaderStageIOSlot* input : binding_inputs) {
+      if (IsFloat2(*input)) {
+        input->type = ShaderType::kUnsignedShort;
+        input->bit_width = 8 * sizeof(uint16_t);
+        input->normalized = true;
+      }
+      const size_t component_size = input->bit_width / 8;
+      offset = AlignTo(offset, component_size);
+      input->offset = offset;
+      offset += component_size * input->vec_size * input->columns;
+    }
+    // Vertex strides must be a multiple of four bytes on Metal.
+    layout.stride = AlignTo(offset, 4u);
+  }
+  return packed;
+}
+
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_VERTEX_DESCRIPTOR_H_
 #define FLUTTER_IMPELLER_RENDERER_VERTEX_DESCRIPTOR_H_
 
+#include <memory>
 #include <vector>
 
 #include "impeller/base/comparable.h"
@@ -69,6 +70,21 @@ class VertexDescriptor final : public Comparable<VertexDescriptor> {
 
   bool UsesInputAttacments() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a copy of this descriptor in which every two component
+  ///             32-bit float input is read from two 16-bit unsigned
+  ///             normalized components instead. The offsets of the inputs and
+  ///             the strides of the layouts are updated to match a tightly
+  ///             packed interleaved layout.
+  ///
+  ///             The shader still receives floats, but in the range [0, 1].
+  ///             It is up to the caller to map them back, usually by folding
+  ///             the mapping into a transform that is applied to them anyway.
+  ///
+  /// @return     The packed descriptor.
+  ///
+  std::shared_ptr<VertexDescriptor> CreatePackedDescriptor() const;
+
  private:
   std::vector<ShaderStageIOSlot> inputs_;
   std::vector<ShaderStageBufferLayout> layouts_;
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+namespace testing {
+
+// Stage inputs laid out like the reflected inputs of texture_fill.vert.
+static const ShaderStageIOSlot kInputPosition = {
+    "position", 0u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u, 0u, false,
+};
+static const ShaderStageIOSlot kInputTextureCoords = {
+    "texture_coords", 1u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u, 8u, false,
+};
+static const ShaderStageIOSlot kInputColor = {
+    "color", 2u, 0u, 0u, ShaderType::kFloat, 32u, 4u, 1u, 16u, false,
+};
+
+TEST(VertexDescriptorTest, PackedDescriptorReadsFloat2InputsAsUNorm16) {
+  VertexDescriptor desc;
+  desc.SetStageInputs({kInputPosition, kInputTextureCoords},
+                      {ShaderStageBufferLayout{16u, 0u}});
+
+  auto packed = desc.CreatePackedDescriptor();
+
+  ASSERT_EQ(packed->GetStageInputs().size(), 2u);
+  for (const ShaderStageIOSlot& input : packed->GetStageInputs()) {
+    EXPECT_EQ(input.type, ShaderType::kUnsignedShort);
+    EXPECT_EQ(input.bit_width, 16u);
+    EXPECT_EQ(input.vec_size, 2u);
+    EXPECT_TRUE(input.normalized);
+  }
+  EXPECT_EQ(packed->GetStageInputs()[0].offset, 0u);
+  EXPECT_EQ(packed->GetStageInputs()[1].offset, 4u);
+  ASSERT_EQ(packed->GetStageLayouts().size(), 1u);
+  EXPECT_EQ(packed->GetStageLayouts()[0].stride, 8u);
+
+  EXPECT_FALSE(packed->IsEqual(desc));
+  EXPECT_NE(packed->GetHash(), desc.GetHash());
+}
+
+TEST(VertexDescriptorTest, PackedDescriptorRepacksOtherInputs) {
+  VertexDescriptor desc;
+  desc.SetStageInputs({kInputPosition, kInputTextureCoords, kInputColor},
+                      {ShaderStageBufferLayout{32u, 0u}});
+
+  auto packed = desc.CreatePackedDescriptor();
+
+  const ShaderStageIOSlot& color = packed->GetStageInputs()[2];
+  EXPECT_EQ(color.type, ShaderType::kFloat);
+  EXPECT_FALSE(color.normalized);
+  EXPECT_EQ(color.offset, 8u);
+  EXPECT_EQ(packed->GetStageLayouts()[0].stride, 24u);
+}
+
+TEST(VertexDescriptorTest, PackedDescriptorKeepsLayoutsWithoutFloat2Inputs) {
+  VertexDescriptor desc;
+  desc.SetStageInputs({kInputColor}, {ShaderStageBufferLayout{32u, 0u}});
+
+  auto packed = desc.CreatePackedDescriptor();
+
+  EXPECT_TRUE(packed->IsEqual(desc));
+}
+
+}  // namespace testing
+}  // namespace impeller
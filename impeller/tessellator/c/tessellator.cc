@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "impeller/tessellator/tessellator_libtess.h"
+#include "impeller/tessellator/tessellator_monotone.h"
 
 namespace impeller {
 PathBuilder* CreatePathBuilder() {
@@ -39,42 +40,63 @@ void Close(PathBuilder* builder) {
   builder->Close();
 }
 
+template <typename T>
+static bool TessellateTriangles(const Path& path,
+                                Scalar tolerance,
+                                std::vector<float>& points) {
+  return T{}.Tessellate(
+             path, tolerance,
+             [&points](const float* vertices, size_t vertices_count,
+                       const uint16_t* indices, size_t indices_count) {
+               // Results are expected to be re-duplicated.
+               if (!indices) {
+                 points.assign(vertices, vertices + vertices_count * 2);
+                 return true;
+               }
+               for (auto i = 0u; i < indices_count; i++) {
+                 points.push_back(vertices[indices[i] * 2]);
+                 points.push_back(vertices[indices[i] * 2 + 1]);
+               }
+               return true;
+             }) == T::Result::kSuccess;
+}
+
 struct Vertices* Tessellate(PathBuilder* builder,
                             int fill_type,
                             Scalar tolerance) {
+  return TessellateWith(builder, fill_type, tolerance, kTessellatorLibtess);
+}
+
+struct Vertices* TessellateWith(PathBuilder* builder,
+                                int fill_type,
+                                Scalar tolerance,
+                                int tessellator) {
   auto path = builder->CopyPath(static_cast<FillType>(fill_type));
   std::vector<float> points;
-  if (TessellatorLibtess{}.Tessellate(
-          path, tolerance,
-          [&points](const float* vertices, size_t vertices_count,
-                    const uint16_t* indices, size_t indices_count) {
-            // Results are expected to be re-duplicated.
-            std::vector<Point> raw_points;
-            for (auto i = 0u; i < vertices_count * 2; i += 2) {
-              raw_points.emplace_back(Point{vertices[i], vertices[i + 1]});
-            }
-            for (auto i = 0u; i < indices_count; i++) {
-              auto point = raw_points[indices[i]];
-              points.push_back(point.x);
-              points.push_back(point.y);
-            }
-            return true;
-          }) != TessellatorLibtess::Result::kSuccess) {
+  bool success = false;
+  switch (tessellator) {
+    case kTessellatorLibtess:
+      success =
+          TessellateTriangles<TessellatorLibtess>(path, tolerance, points);
+      break;
+    case kTessellatorMonotone:
+      success =
+          TessellateTriangles<TessellatorMonotone>(path, tolerance, points);
+      break;
+  }
+  if (!success) {
     return nullptr;
   }
 
   Vertices* vertices = new Vertices();
   vertices->points = new float[points.size()];
-  if (!vertices->points) {
-    return nullptr;
-  }
   vertices->length = points.size();
   std::copy(points.begin(), points.end(), vertices->points);
   return vertices;
 }
 
 void DestroyVertices(Vertices* vertices) {
-  delete vertices->points;
+  delete[] vertices->points;
   delete vertices;
 }
 
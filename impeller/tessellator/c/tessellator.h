@@ -42,10 +42,21 @@ IMPELLER_API void CubicTo(PathBuilder* builder,
 
 IMPELLER_API void Close(PathBuilder* builder);
 
+/// Values of the |tessellator| argument of |TessellateWith|.
+constexpr int kTessellatorLibtess = 0;
+constexpr int kTessellatorMonotone = 1;
+
 IMPELLER_API struct Vertices* Tessellate(PathBuilder* builder,
                                          int fill_type,
                                          Scalar tolerance);
 
+/// Like |Tessellate|, with the tessellator given by one of the
+/// |kTessellator*| values. Returns nullptr for unknown values.
+IMPELLER_API struct Vertices* TessellateWith(PathBuilder* builder,
+                                             int fill_type,
+                                             Scalar tolerance,
+                                             int tessellator);
+
 IMPELLER_API void DestroyVertices(Vertices* vertices);
 
 }  // namespace impeller
@@ -20,6 +20,19 @@ enum FillType {
   evenOdd,
 }
 
+/// The algorithm that triangulates the interior of a path.
+///
+/// This enum is used by the [VerticesBuilder.tessellate] method.
+// must match the kTessellator values in c/tessellator.h
+enum Tessellator {
+  /// The general purpose libtess2 tessellator.
+  libtess,
+
+  /// Decomposes the path into monotone polygons. This is faster than
+  /// [libtess] for paths with many vertices.
+  monotone,
+}
+
 /// Information about how to approximate points on a curved path segment.
 ///
 /// In particular, the values in this object control how many vertices to
@@ -105,19 +118,24 @@ class VerticesBuilder {
 
   /// Tessellates the path created by the previous method calls into a list of
   /// vertices.
+  ///
+  /// Throws a [StateError] if the path could not be tessellated.
   Float32List tessellate({
     FillType fillType = FillType.nonZero,
     SmoothingApproximation smoothing = const SmoothingApproximation(),
+    Tessellator tessellator = Tessellator.libtess,
   }) {
     assert(_vertices.isEmpty);
     assert(_builder != null);
-    final ffi.Pointer<_Vertices> vertices = _tessellateFn(
+    final ffi.Pointer<_Vertices> vertices = _tessellateWithFn(
       _builder!,
       fillType.index,
       smoothing.scale,
-      smoothing.angleTolerance,
-      smoothing.cuspLimit,
+      tessellator.index,
     );
+    if (vertices == ffi.nullptr) {
+      throw StateError('Failed to tessellate the path.');
+    }
     _vertices.add(vertices);
     return vertices.ref.points.asTypedList(vertices.ref.size);
   }
@@ -214,23 +232,23 @@ typedef _close_type = ffi.Void Function(ffi.Pointer<_PathBuilder>, ffi.Bool);
 final _CloseType _closeFn =
     _dylib.lookupFunction<_close_type, _CloseType>('Close');
 
-typedef _TessellateType = ffi.Pointer<_Vertices> Function(
+typedef _TessellateWithType = ffi.Pointer<_Vertices> Function(
   ffi.Pointer<_PathBuilder>,
   int,
   double,
-  double,
-  double,
+  int,
 );
-typedef _tessellate_type = ffi.Pointer<_Vertices> Function(
+typedef _tessellate_with_type = ffi.Pointer<_Vertices> Function(
   ffi.Pointer<_PathBuilder>,
   ffi.Int,
   ffi.Float,
-  ffi.Float,
-  ffi.Float,
+  ffi.Int,
 );
 
-final _TessellateType _tessellateFn =
-    _dylib.lookupFunction<_tessellate_type, _TessellateType>('Tessellate');
+final _TessellateWithType _tessellateWithFn =
+    _dylib.lookupFunction<_tessellate_with_type, _TessellateWithType>(
+  'TessellateWith',
+);
 
 typedef _DestroyType = void Function(ffi.Pointer<_PathBuilder>);
 typedef _destroy_type = ffi.Void Function(ffi.Pointer<_PathBuilder>);
@@ -0,0 +1,402 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/tessellator/tessellation_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+// The number of scale buckets per doubling of the scale.
+constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+}  // namespace
+
+TessellationCache::Key::Key(Kind kind, Scalar scale) : kind_(kind) {
+  cacheable_ = std::isfinite(scale) && scale > 0.0f;
+  if (!cacheable_) {
+    scale_ = scale;
+    return;
+  }
+  scale_bucket_ = static_cast<int32_t>(
+      std::ceil(std::log2(scale) * kScaleBucketsPerOctave));
+  scale_ = std::max(
+      std::exp2(static_cast<Scalar>(scale_bucket_) / kScaleBucketsPerOctave),
+      scale);
+}
+
+TessellationCache::Key TessellationCache::Key::Fill(Scalar scale) {
+  return Key(Kind::kFill, scale);
+}
+
+TessellationCache::Key TessellationCache::Key::Stroke(Scalar scale,
+                                                      Scalar stroke_width,
+                                                      Scalar miter_limit,
+                                                      Cap cap,
+                                                      Join join) {
+  Key key(Kind::kStroke, scale);
+  key.stroke_width_ = stroke_width;
+  key.miter_limit_ = miter_limit;
+  key.cap_ = cap;
+  key.join_ = join;
+  return key;
+}
+
+bool TessellationCache::Key::operator==(const Key& other) const {
+  return kind_ == other.kind_ && cacheable_ == other.cacheable_ &&
+         scale_bucket_ == other.scale_bucket_ &&
+         stroke_width_ == other.stroke_width_ &&
+         miter_limit_ == other.miter_limit_ && cap_ == other.cap_ &&
+         join_ == other.join_;
+}
+
+size_t TessellationCache::Key::GetHash() const {
+  return fml::HashCombine(kind_, scale_bucket_, stroke_width_, miter_limit_,
+                          cap_, join_);
+}
+
+size_t TessellationCache::EntryKeyHash::operator()(
+    const EntryKey& key) const {
+  return fml::HashCombine(key.path_hash, key.key.GetHash());
+}
+
+double TessellationCache::Stats::GetHitRate() const {
+  const size_t lookup_count = hit_count + miss_count;
+  if (lookup_count == 0u) {
+    return 0.0;
+  }
+  return static_cast<double>(hit_count) / static_cast<double>(lookup_count);
+}
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() {
+  DiscardPrefetches();
+}
+
+const TessellationCache::Tessellation& TessellationCache::GetOrTessellate(
+    const Path& path,
+    const Key& key,
+    TessellateCallback tessellate) {
+  if (!key.IsCacheable()) {
+    scratch_.vertices.clear();
+    scratch_.indices.clear();
+    tessellate(key.GetScale(), scratch_);
+    return scratch_;
+  }
+
+  EntryKey entry_key{path.GetContentHash(), key};
+  if (const Tessellation* tessellation = Find(path, entry_key)) {
+    return *tessellation;
+  }
+
+  TRACE_EVENT0("impeller", "TessellationCache::Miss");
+  miss_count_++;
+  Tessellation tessellation;
+  if (!TakePrefetched(path, entry_key, tessellation)) {
+    tessellate(key.GetScale(), tessellation);
+  }
+  if (!IsRetainable(tessellation.GetByteSize())) {
+    scratch_ = std::move(tessellation);
+    return scratch_;
+  }
+  return Insert(entry_key, path, std::move(tessellation));
+}
+
+VertexBuffer TessellationCache::GetOrTessellate(
+    const Path& path,
+    const Key& key,
+    HostBuffer& host_buffer,
+    TessellateCallback tessellate) {
+  return Upload(GetOrTessellate(path, key, tessellate),
+                key.IsStroke() ? IndexType::kNone : IndexType::k16bit,
+                host_buffer);
+}
+
+VertexBuffer TessellationCache::GetOrWriteVertices(
+    const Path& path,
+    const Key& key,
+    HostBuffer& host_buffer,
+    EstimateCallback estimate,
+    WriteCallback write) {
+  const Scalar scale = key.GetScale();
+  auto write_direct = [&]() {
+    // The host buffer invokes the callback again with room for the vertex
+    // count it returned if the estimate was too low.
+    size_t count = 0u;
+    BufferView vertex_buffer = host_buffer.EmplaceUpTo(
+        sizeof(Point) * estimate(scale), alignof(Point),
+        [&](uint8_t* data, size_t room) {
+          count = write(scale, reinterpret_cast<Point*>(data),
+                        room / sizeof(Point));
+          return sizeof(Point) * count;
+        });
+    if (!vertex_buffer) {
+      count = 0u;
+    }
+    return VertexBuffer{
+        .vertex_buffer = std::move(vertex_buffer),
+        .index_buffer = {},
+        .vertex_count = count,
+        .index_type = IndexType::kNone,
+    };
+  };
+
+  if (!key.IsCacheable()) {
+    return write_direct();
+  }
+
+  EntryKey entry_key{path.GetContentHash(), key};
+  if (const Tessellation* tessellation = Find(path, entry_key)) {
+    return Upload(*tessellation, IndexType::kNone, host_buffer);
+  }
+
+  TRACE_EVENT0("impeller", "TessellationCache::Miss");
+  miss_count_++;
+  const bool seen = MarkSeen(entry_key);
+  Tessellation prefetched;
+  if (TakePrefetched(path, entry_key, prefetched)) {
+    if (!seen || !IsRetainable(prefetched.GetByteSize())) {
+      return Upload(prefetched, IndexType::kNone, host_buffer);
+    }
+    return Upload(Insert(entry_key, path, std::move(prefetched)),
+                  IndexType::kNone, host_buffer);
+  }
+  if (!seen) {
+    return write_direct();
+  }
+
+  const size_t count =
+      WriteVertices(scale, scratch_.vertices, estimate, write);
+  if (!IsRetainable(sizeof(Point) * count)) {
+    BufferView vertex_buffer = host_buffer.Emplace(
+        scratch_.vertices.data(), sizeof(Point) * count, alignof(Point));
+    return VertexBuffer{
+        .vertex_buffer = std::move(vertex_buffer),
+        .index_buffer = {},
+        .vertex_count = count,
+        .index_type = IndexType::kNone,
+    };
+  }
+  Tessellation tessellation;
+  tessellation.vertices.assign(scratch_.vertices.begin(),
+                               scratch_.vertices.begin() + count);
+  return Upload(Insert(entry_key, path, std::move(tessellation)),
+                IndexType::kNone, host_buffer);
+}
+
+void TessellationCache::SetWorkerTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> worker_task_runner) {
+  worker_task_runner_ = std::move(worker_task_runner);
+}
+
+void TessellationCache::Prefetch(const Path& path,
+                                 const Key& key,
+                                 PrefetchCallback tessellate) {
+  if (!worker_task_runner_ || !key.IsCacheable()) {
+    return;
+  }
+  EntryKey entry_key{path.GetContentHash(), key};
+  auto cached = index_.find(entry_key);
+  if (cached != index_.end() && cached->second->path.HasSameContent(path)) {
+    return;
+  }
+  if (prefetched_.find(entry_key) != prefetched_.end()) {
+    return;
+  }
+
+  auto pending = std::make_shared<PendingTessellation>();
+  pending->tessellate = std::move(tessellate);
+  pending->scale = key.GetScale();
+  prefetched_.emplace(entry_key, Prefetched{path, pending});
+  prefetch_count_++;
+  worker_task_runner_->PostTask([pending = std::move(pending)]() {
+    if (pending->claimed.exchange(true)) {
+      // Taken by the raster thread or discarded.
+      return;
+    }
+    TRACE_EVENT0("impeller", "TessellationCache::Prefetch");
+    pending->tessellate(pending->scale, pending->tessellation);
+    pending->done.Signal();
+  });
+}
+
+void TessellationCache::DiscardPrefetches() {
+  for (auto& [entry_key, prefetched] : prefetched_) {
+    prefetched.pending->claimed.store(true);
+  }
+  prefetched_.clear();
+}
+
+TessellationCache::Stats TessellationCache::GetStats() const {
+  return Stats{
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .eviction_count = eviction_count_,
+      .entry_count = entries_.size(),
+      .byte_size = byte_size_,
+      .prefetch_count = prefetch_count_,
+      .prefetch_use_count = prefetch_use_count_,
+  };
+}
+
+void TessellationCache::ResetStats() {
+  hit_count_ = 0u;
+  miss_count_ = 0u;
+  eviction_count_ = 0u;
+  prefetch_count_ = 0u;
+  prefetch_use_count_ = 0u;
+}
+
+void TessellationCache::Clear() {
+  DiscardPrefetches();
+  index_.clear();
+  entries_.clear();
+  recently_seen_.clear();
+  byte_size_ = 0u;
+}
+
+bool TessellationCache::IsRetainable(size_t byte_size) const {
+  // A single large path would evict most of the cache and is unlikely to be
+  // static content.
+  return byte_size <= max_bytes_ / 4u;
+}
+
+const TessellationCache::Tessellation* TessellationCache::Find(
+    const Path& path,
+    const EntryKey& entry_key) {
+  auto found = index_.find(entry_key);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  if (!found->second->path.HasSameContent(path)) {
+    // A different path with the same hash. The most recent one wins.
+    Evict(found->second);
+    return nullptr;
+  }
+  hit_count_++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return &entries_.front().tessellation;
+}
+
+bool TessellationCache::TakePrefetched(const Path& path,
+                                       const EntryKey& entry_key,
+                                       Tessellation& tessellation) {
+  auto found = prefetched_.find(entry_key);
+  if (found == prefetched_.end()) {
+    return false;
+  }
+  Prefetched prefetched = std::move(found->second);
+  prefetched_.erase(found);
+  PendingTessellation& pending = *prefetched.pending;
+  if (!prefetched.path.HasSameContent(path)) {
+    pending.claimed.store(true);
+    return false;
+  }
+
+  if (!pending.claimed.exchange(true)) {
+    // No worker has started on it yet, which would take longer than doing it
+    // right here.
+    pending.tessellate(pending.scale, pending.tessellation);
+  } else {
+    TRACE_EVENT0("impeller", "TessellationCache::WaitForPrefetch");
+    pending.done.Wait();
+  }
+  prefetch_use_count_++;
+  tessellation = std::move(pending.tessellation);
+  return true;
+}
+
+bool TessellationCache::MarkSeen(const EntryKey& entry_key) {
+  if (recently_seen_.size() >= kMaxRecentlySeenCount) {
+    recently_seen_.clear();
+  }
+  return !recently_seen_.insert(EntryKeyHash{}(entry_key)).second;
+}
+
+const TessellationCache::Tessellation& TessellationCache::Insert(
+    const EntryKey& entry_key,
+    const Path& path,
+    Tessellation tessellation) {
+  byte_size_ += tessellation.GetByteSize();
+  entries_.push_front(Entry{entry_key, path, std::move(tessellation)});
+  index_[entry_key] = entries_.begin();
+  TrimToBudget();
+  return entries_.front().tessellation;
+}
+
+size_t TessellationCache::WriteVertices(Scalar scale,
+                                        std::vector<Point>& vertices,
+                                        EstimateCallback estimate,
+                                        WriteCallback write) {
+  // The vertices are only ever grown so that they are not reallocated once
+  // they are large enough for the paths being drawn.
+  vertices.resize(std::max(vertices.size(), estimate(scale)));
+  size_t count = write(scale, vertices.data(), vertices.size());
+  if (count > vertices.size()) {
+    vertices.resize(count);
+    write(scale, vertices.data(), count);
+  }
+  return count;
+}
+
+VertexBuffer TessellationCache::Upload(const Tessellation& tessellation,
+                                       IndexType index_type,
+                                       HostBuffer& host_buffer) {
+  if (tessellation.vertices.empty()) {
+    return VertexBuffer{
+        .vertex_buffer = {},
+        .index_buffer = {},
+        .vertex_count = 0u,
+        .index_type = index_type,
+    };
+  }
+
+  BufferView vertex_buffer =
+      host_buffer.Emplace(tessellation.vertices.data(),
+                          sizeof(Point) * tessellation.vertices.size(),
+                          alignof(Point));
+  if (index_type == IndexType::kNone) {
+    return VertexBuffer{
+        .vertex_buffer = std::move(vertex_buffer),
+        .index_buffer = {},
+        .vertex_count = tessellation.vertices.size(),
+        .index_type = index_type,
+    };
+  }
+
+  BufferView index_buffer =
+      host_buffer.Emplace(tessellation.indices.data(),
+                          sizeof(uint16_t) * tessellation.indices.size(),
+                          alignof(uint16_t));
+  return VertexBuffer{
+      .vertex_buffer = std::move(vertex_buffer),
+      .index_buffer = std::move(index_buffer),
+      .vertex_count = tessellation.indices.size(),
+      .index_type = index_type,
+  };
+}
+
+void TessellationCache::Evict(EntryList::iterator entry) {
+  byte_size_ -= entry->tessellation.GetByteSize();
+  index_.erase(entry->key);
+  entries_.erase(entry);
+  eviction_count_++;
+}
+
+void TessellationCache::TrimToBudget() {
+  while (byte_size_ > max_bytes_ && entries_.size() > 1u) {
+    Evict(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,340 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/function_ref.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A bounded cache of path tessellations that is retained across
+///             frames.
+///
+///             Static vector content (icons, illustrations) is usually drawn
+///             every frame with an identical path and a transform whose scale
+///             does not change. The flattened and tessellated vertices of
+///             such paths only depend on the path content, the scale of the
+///             transform and the stroke parameters, so they can be reused
+///             and only need to be copied into the transients buffer.
+///
+///             Entries are looked up by a hash of the path content and
+///             verified against the cached path so that a hash collision can
+///             never return the wrong geometry. The scale is quantized upwards
+///             to a quarter of an octave so that small changes in scale (and
+///             floating point noise) still hit the cache. Tessellating at the
+///             quantized scale only ever produces a finer tessellation than
+///             the requested one.
+///
+///             The least recently used entries are evicted when the size of
+///             the cached vertex and index data exceeds the budget.
+///
+///             When a worker task runner is set, the paths of upcoming draws
+///             can be prefetched: they are tessellated on the workers while
+///             the raster thread encodes earlier draws, and the result is
+///             picked up when the draw misses the cache.
+///
+///             This class is not thread safe and must only be used from the
+///             raster thread, like the transients buffer it uploads into. Only
+///             the prefetch callbacks run on the workers.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  /// The number of recently seen paths that are remembered to decide which
+  /// written vertices to retain.
+  static constexpr size_t kMaxRecentlySeenCount = 4096u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The parameters other than the path that affect a
+  ///             tessellation.
+  ///
+  class Key {
+   public:
+    static Key Fill(Scalar scale);
+
+    static Key Stroke(Scalar scale,
+                      Scalar stroke_width,
+                      Scalar miter_limit,
+                      Cap cap,
+                      Join join);
+
+    /// The scale the path must be tessellated at for this key. This is
+    /// greater than or equal to the scale the key was created with.
+    Scalar GetScale() const { return scale_; }
+
+    /// Whether tessellations made with this key may be cached. Keys with a
+    /// non-finite or non-positive scale are not cacheable.
+    bool IsCacheable() const { return cacheable_; }
+
+    bool IsStroke() const { return kind_ == Kind::kStroke; }
+
+    bool operator==(const Key& other) const;
+
+    size_t GetHash() const;
+
+   private:
+    enum class Kind : uint8_t {
+      kFill,
+      kStroke,
+    };
+
+    Kind kind_ = Kind::kFill;
+    bool cacheable_ = false;
+    int32_t scale_bucket_ = 0;
+    Scalar scale_ = 0.0f;
+    Scalar stroke_width_ = 0.0f;
+    Scalar miter_limit_ = 0.0f;
+    Cap cap_ = Cap::kButt;
+    Join join_ = Join::kMiter;
+
+    Key(Kind kind, Scalar scale);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The vertices (and for fills, indices) of a tessellated path
+  ///             in the local coordinate space of the path.
+  ///
+  struct Tessellation {
+    std::vector<Point> vertices;
+    std::vector<uint16_t> indices;
+
+    size_t GetByteSize() const {
+      return vertices.size() * sizeof(Point) +
+             indices.size() * sizeof(uint16_t);
+    }
+  };
+
+  /// Fills the tessellation with the geometry of the path at the given scale.
+  /// The tessellation is empty when the callback is invoked.
+  using TessellateCallback =
+      fml::FunctionRef<void(Scalar scale, Tessellation& tessellation)>;
+
+  /// A |TessellateCallback| that owns its state, so that it can be invoked
+  /// after |Prefetch| returns.
+  using PrefetchCallback =
+      std::function<void(Scalar scale, Tessellation& tessellation)>;
+
+  /// Returns an estimate of the number of vertices of the tessellation of the
+  /// path at the given scale. Estimates that are at least the actual number
+  /// avoid tessellating the path twice.
+  using EstimateCallback = fml::FunctionRef<size_t(Scalar scale)>;
+
+  /// Writes up to |max_count| vertices of the tessellation of the path at the
+  /// given scale and returns the number of vertices of the complete
+  /// tessellation. When that is more than |max_count|, the vertices are
+  /// discarded and the callback is invoked again with enough room for all of
+  /// them.
+  using WriteCallback =
+      fml::FunctionRef<size_t(Scalar scale, Point* vertices, size_t max_count)>;
+
+  struct Stats {
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+    size_t eviction_count = 0u;
+    size_t entry_count = 0u;
+    size_t byte_size = 0u;
+    size_t prefetch_count = 0u;
+    size_t prefetch_use_count = 0u;
+
+    /// The fraction of cacheable lookups that were hits, or 0 if there were
+    /// no lookups.
+    double GetHitRate() const;
+  };
+
+  explicit TessellationCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the tessellation of the path for the key, invoking
+  ///             the callback to create it if it is not in the cache.
+  ///
+  ///             The returned reference is only valid until the next call to
+  ///             this cache.
+  ///
+  const Tessellation& GetOrTessellate(const Path& path,
+                                      const Key& key,
+                                      TessellateCallback tessellate);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the tessellation of the path for the key copied into
+  ///             the host buffer.
+  ///
+  ///             Fill tessellations are indexed triangle strips, stroke
+  ///             tessellations are non-indexed triangle strips.
+  ///
+  VertexBuffer GetOrTessellate(const Path& path,
+                               const Key& key,
+                               HostBuffer& host_buffer,
+                               TessellateCallback tessellate);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the non-indexed tessellation of the path for the key
+  ///             in the host buffer.
+  ///
+  ///             The first time a path is seen with a key, its vertices are
+  ///             written directly into the host buffer without any
+  ///             intermediate storage. Only paths that are drawn again are
+  ///             retained, so that paths which change every frame do not
+  ///             churn the cache.
+  ///
+  VertexBuffer GetOrWriteVertices(const Path& path,
+                                  const Key& key,
+                                  HostBuffer& host_buffer,
+                                  EstimateCallback estimate,
+                                  WriteCallback write);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner that prefetched paths are tessellated
+  ///             on. Prefetching is disabled without one.
+  ///
+  void SetWorkerTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> worker_task_runner);
+
+  /// Whether |Prefetch| tessellates paths on a worker task runner.
+  bool IsPrefetching() const { return worker_task_runner_ != nullptr; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts tessellating the path for the key on the worker task
+  ///             runner so that the next |GetOrTessellate| or
+  ///             |GetOrWriteVertices| of the same path and key does not have
+  ///             to.
+  ///
+  ///             The callback is invoked on a worker thread, or on the calling
+  ///             thread if the path is needed before a worker got to it. It
+  ///             must only use state that it owns.
+  ///
+  ///             Nothing is done if prefetching is disabled, the key is not
+  ///             cacheable, or the path is already cached or prefetched.
+  ///
+  void Prefetch(const Path& path,
+                const Key& key,
+                PrefetchCallback tessellate);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the prefetched tessellations that were not used,
+  ///             cancelling the ones that have not started. Call at the end
+  ///             of every frame.
+  ///
+  void DiscardPrefetches();
+
+  Stats GetStats() const;
+
+  void ResetStats();
+
+  void Clear();
+
+ private:
+  struct EntryKey {
+    size_t path_hash;
+    Key key;
+
+    bool operator==(const EntryKey& other) const {
+      return path_hash == other.path_hash && key == other.key;
+    }
+  };
+
+  struct EntryKeyHash {
+    size_t operator()(const EntryKey& key) const;
+  };
+
+  struct Entry {
+    EntryKey key;
+    Path path;
+    Tessellation tessellation;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // A tessellation that is finished by whichever of a worker and the raster
+  // thread claims it first.
+  struct PendingTessellation {
+    PrefetchCallback tessellate;
+    Scalar scale = 0.0f;
+    std::atomic_bool claimed = false;
+    // Signaled when a worker has finished the tessellation.
+    fml::ManualResetWaitableEvent done;
+    Tessellation tessellation;
+  };
+
+  struct Prefetched {
+    Path path;
+    std::shared_ptr<PendingTessellation> pending;
+  };
+
+  const size_t max_bytes_;
+  EntryList entries_;
+  std::unordered_map<EntryKey, EntryList::iterator, EntryKeyHash> index_;
+  size_t byte_size_ = 0u;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t eviction_count_ = 0u;
+  // Holds tessellations that are not cacheable or too large to cache.
+  Tessellation scratch_;
+  // The hashes of the entry keys of the vertices written directly into a host
+  // buffer since the last reset, which are retained when seen again.
+  std::unordered_set<size_t> recently_seen_;
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
+  std::unordered_map<EntryKey, Prefetched, EntryKeyHash> prefetched_;
+  size_t prefetch_count_ = 0u;
+  size_t prefetch_use_count_ = 0u;
+
+  bool IsRetainable(size_t byte_size) const;
+
+  const Tessellation* Find(const Path& path, const EntryKey& entry_key);
+
+  // Moves the prefetched tessellation of the path into |tessellation|, waiting
+  // for it if a worker is still tessellating. Returns false if the path was
+  // not prefetched.
+  bool TakePrefetched(const Path& path,
+                      const EntryKey& entry_key,
+                      Tessellation& tessellation);
+
+  // Remembers the entry key and returns whether it was seen before.
+  bool MarkSeen(const EntryKey& entry_key);
+
+  const Tessellation& Insert(const EntryKey& entry_key,
+                             const Path& path,
+                             Tessellation tessellation);
+
+  size_t WriteVertices(Scalar scale,
+                       std::vector<Point>& vertices,
+                       EstimateCallback estimate,
+                       WriteCallback write);
+
+  static VertexBuffer Upload(const Tessellation& tessellation,
+                             IndexType index_type,
+                             HostBuffer& host_buffer);
+
+  void Evict(EntryList::iterator entry);
+
+  void TrimToBudget();
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
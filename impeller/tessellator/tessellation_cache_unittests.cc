@@ -0,0 +1,329 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellation_cache.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+Path MakeRectPath(Scalar size) {
+  return PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, size, size)).TakePath();
+}
+
+TessellationCache::PrefetchCallback MakeConvexTessellator(
+    size_t& call_count) {
+  return [&call_count](Scalar scale,
+                       TessellationCache::Tessellation& tessellation) {
+    call_count++;
+    EXPECT_TRUE(tessellation.vertices.empty());
+    EXPECT_TRUE(tessellation.indices.empty());
+    // The path is not visible to the callback, use the scale as a marker.
+    tessellation.vertices.push_back({scale, scale});
+    tessellation.indices.push_back(0u);
+  };
+}
+
+// Holds posted tasks until they are run explicitly.
+class DeferredTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(fml::UniqueClosure task) override {
+    tasks_.push_back(std::move(task));
+  }
+
+  void RunTasks() {
+    for (auto& task : tasks_) {
+      task();
+    }
+    tasks_.clear();
+  }
+
+  size_t GetTaskCount() const { return tasks_.size(); }
+
+ private:
+  std::vector<fml::UniqueClosure> tasks_;
+};
+
+}  // namespace
+
+TEST(TessellationCacheTest, ReusesTessellationOfSamePathContent) {
+  TessellationCache cache;
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+
+  auto key = TessellationCache::Key::Fill(1.0f);
+  cache.GetOrTessellate(MakeRectPath(10), key, tessellate);
+  // A path with the same content in different storage is a hit.
+  const auto& tessellation =
+      cache.GetOrTessellate(MakeRectPath(10), key, tessellate);
+  EXPECT_EQ(call_count, 1u);
+  EXPECT_EQ(tessellation.vertices.size(), 1u);
+
+  cache.GetOrTessellate(MakeRectPath(20), key, tessellate);
+  EXPECT_EQ(call_count, 2u);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.hit_count, 1u);
+  EXPECT_EQ(stats.miss_count, 2u);
+  EXPECT_EQ(stats.entry_count, 2u);
+  EXPECT_DOUBLE_EQ(stats.GetHitRate(), 1.0 / 3.0);
+
+  cache.ResetStats();
+  EXPECT_EQ(cache.GetStats().hit_count, 0u);
+  EXPECT_EQ(cache.GetStats().entry_count, 2u);
+}
+
+TEST(TessellationCacheTest, QuantizesScaleUpwards) {
+  for (auto scale : {0.01f, 0.3f, 1.0f, 1.1f, 3.7f, 1000.0f}) {
+    auto key = TessellationCache::Key::Fill(scale);
+    EXPECT_TRUE(key.IsCacheable());
+    EXPECT_GE(key.GetScale(), scale);
+    EXPECT_LE(key.GetScale(), scale * 1.2f);
+  }
+
+  EXPECT_EQ(TessellationCache::Key::Fill(1.05f),
+            TessellationCache::Key::Fill(1.1f));
+  EXPECT_FALSE(TessellationCache::Key::Fill(1.0f) ==
+               TessellationCache::Key::Fill(2.0f));
+
+  EXPECT_FALSE(TessellationCache::Key::Fill(0.0f).IsCacheable());
+  EXPECT_FALSE(TessellationCache::Key::Fill(-1.0f).IsCacheable());
+  EXPECT_FALSE(
+      TessellationCache::Key::Fill(std::numeric_limits<Scalar>::infinity())
+          .IsCacheable());
+}
+
+TEST(TessellationCacheTest, DistinguishesStrokeParameters) {
+  TessellationCache cache;
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto path = MakeRectPath(10);
+
+  auto stroke = [](Scalar width, Cap cap, Join join) {
+    return TessellationCache::Key::Stroke(1.0f, width, 4.0f, cap, join);
+  };
+  cache.GetOrTessellate(path, TessellationCache::Key::Fill(1.0f), tessellate);
+  cache.GetOrTessellate(path, stroke(1, Cap::kButt, Join::kMiter), tessellate);
+  cache.GetOrTessellate(path, stroke(2, Cap::kButt, Join::kMiter), tessellate);
+  cache.GetOrTessellate(path, stroke(1, Cap::kRound, Join::kMiter), tessellate);
+  cache.GetOrTessellate(path, stroke(1, Cap::kButt, Join::kBevel), tessellate);
+  EXPECT_EQ(call_count, 5u);
+
+  cache.GetOrTessellate(path, stroke(1, Cap::kButt, Join::kMiter), tessellate);
+  EXPECT_EQ(call_count, 5u);
+}
+
+TEST(TessellationCacheTest, DoesNotCacheUncacheableScales) {
+  TessellationCache cache;
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto path = MakeRectPath(10);
+
+  cache.GetOrTessellate(path, TessellationCache::Key::Fill(0.0f), tessellate);
+  cache.GetOrTessellate(path, TessellationCache::Key::Fill(0.0f), tessellate);
+  EXPECT_EQ(call_count, 2u);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+  EXPECT_EQ(cache.GetStats().miss_count, 0u);
+}
+
+TEST(TessellationCacheTest, EvictsLeastRecentlyUsedEntries) {
+  // Room for exactly four single vertex, single index tessellations.
+  constexpr size_t kEntrySize = sizeof(Point) + sizeof(uint16_t);
+  TessellationCache cache(kEntrySize * 4);
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto key = TessellationCache::Key::Fill(1.0f);
+
+  for (int i = 1; i <= 4; i++) {
+    cache.GetOrTessellate(MakeRectPath(i), key, tessellate);
+  }
+  // Touch the first path so that the second is the least recently used.
+  cache.GetOrTessellate(MakeRectPath(1), key, tessellate);
+  cache.GetOrTessellate(MakeRectPath(5), key, tessellate);
+  EXPECT_EQ(call_count, 5u);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.entry_count, 4u);
+  EXPECT_EQ(stats.eviction_count, 1u);
+  EXPECT_EQ(stats.byte_size, kEntrySize * 4);
+
+  for (int i : {1, 3, 4, 5}) {
+    cache.GetOrTessellate(MakeRectPath(i), key, tessellate);
+  }
+  EXPECT_EQ(call_count, 5u);
+  cache.GetOrTessellate(MakeRectPath(2), key, tessellate);
+  EXPECT_EQ(call_count, 6u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+  EXPECT_EQ(cache.GetStats().byte_size, 0u);
+}
+
+TEST(TessellationCacheTest, DoesNotCacheLargeTessellations) {
+  constexpr size_t kEntrySize = sizeof(Point) + sizeof(uint16_t);
+  TessellationCache cache(kEntrySize * 2);
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto key = TessellationCache::Key::Fill(1.0f);
+
+  const auto& tessellation =
+      cache.GetOrTessellate(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(tessellation.vertices.size(), 1u);
+  cache.GetOrTessellate(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(call_count, 2u);
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+}
+
+TEST(TessellationCacheTest, CachedTessellationMatchesConvexTessellation) {
+  TessellationCache cache;
+  auto path = PathBuilder{}
+                  .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 50), 10)
+                  .TakePath();
+  auto key = TessellationCache::Key::Fill(1.3f);
+  auto tessellate = [&path](Scalar scale,
+                            TessellationCache::Tessellation& tessellation) {
+    Tessellator::TessellateConvexInternal(path, tessellation.vertices,
+                                          tessellation.indices, scale);
+  };
+
+  std::vector<Point> expected_vertices;
+  std::vector<uint16_t> expected_indices;
+  Tessellator::TessellateConvexInternal(path, expected_vertices,
+                                        expected_indices, key.GetScale());
+
+  for (int i = 0; i < 2; i++) {
+    const auto& tessellation = cache.GetOrTessellate(path, key, tessellate);
+    EXPECT_EQ(tessellation.vertices, expected_vertices);
+    EXPECT_EQ(tessellation.indices, expected_indices);
+  }
+  EXPECT_EQ(cache.GetStats().hit_count, 1u);
+}
+
+TEST(TessellationCacheTest, DoesNotPrefetchWithoutWorkers) {
+  TessellationCache cache;
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto key = TessellationCache::Key::Fill(1.0f);
+
+  EXPECT_FALSE(cache.IsPrefetching());
+  cache.Prefetch(MakeRectPath(10), key, tessellate);
+  EXPECT_EQ(call_count, 0u);
+  EXPECT_EQ(cache.GetStats().prefetch_count, 0u);
+}
+
+TEST(TessellationCacheTest, UsesTessellationsPrefetchedOnWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  TessellationCache cache;
+  cache.SetWorkerTaskRunner(loop->GetTaskRunner());
+  EXPECT_TRUE(cache.IsPrefetching());
+
+  size_t call_count = 0u;
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto key = TessellationCache::Key::Fill(1.0f);
+  auto stroke_key =
+      TessellationCache::Key::Stroke(1.0f, 2.0f, 4.0f, Cap::kButt, Join::kMiter);
+
+  constexpr int kPathCount = 8;
+  fml::CountDownLatch latch(kPathCount + 1);
+  for (int i = 1; i <= kPathCount; i++) {
+    cache.Prefetch(MakeRectPath(i), key,
+                   [&latch, i](Scalar scale,
+                               TessellationCache::Tessellation& tessellation) {
+                     tessellation.vertices.push_back({scale, Scalar(i)});
+                     tessellation.indices.push_back(0u);
+                     latch.CountDown();
+                   });
+  }
+  cache.Prefetch(MakeRectPath(1), stroke_key,
+                 [&latch](Scalar scale,
+                          TessellationCache::Tessellation& tessellation) {
+                   tessellation.vertices.resize(3, {scale, -1.0f});
+                   latch.CountDown();
+                 });
+  // Prefetching the same path and key twice does not tessellate it twice.
+  cache.Prefetch(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(cache.GetStats().prefetch_count, kPathCount + 1u);
+  latch.Wait();
+
+  for (int i = 1; i <= kPathCount; i++) {
+    const auto& tessellation =
+        cache.GetOrTessellate(MakeRectPath(i), key, tessellate);
+    ASSERT_EQ(tessellation.vertices.size(), 1u);
+    EXPECT_EQ(tessellation.vertices[0], Point(1.0f, Scalar(i)));
+  }
+  EXPECT_EQ(call_count, 0u);
+  // Prefetched tessellations are cached like any other.
+  cache.GetOrTessellate(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(cache.GetStats().hit_count, 1u);
+  cache.Prefetch(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(cache.GetStats().prefetch_count, kPathCount + 1u);
+
+  EXPECT_EQ(cache.GetStats().prefetch_use_count, size_t(kPathCount));
+  cache.DiscardPrefetches();
+}
+
+TEST(TessellationCacheTest, TessellatesPrefetchesThatHaveNotStarted) {
+  auto runner = std::make_shared<DeferredTaskRunner>();
+  TessellationCache cache;
+  cache.SetWorkerTaskRunner(runner);
+
+  size_t prefetch_count = 0u;
+  size_t call_count = 0u;
+  auto prefetch = MakeConvexTessellator(prefetch_count);
+  auto tessellate = MakeConvexTessellator(call_count);
+  auto key = TessellationCache::Key::Fill(1.0f);
+
+  cache.Prefetch(MakeRectPath(1), key, prefetch);
+  cache.Prefetch(MakeRectPath(2), key, prefetch);
+  EXPECT_EQ(runner->GetTaskCount(), 2u);
+
+  // The first path is needed before a worker got to it.
+  cache.GetOrTessellate(MakeRectPath(1), key, tessellate);
+  EXPECT_EQ(prefetch_count, 1u);
+  EXPECT_EQ(call_count, 0u);
+
+  // The second path is not drawn, the worker does not tessellate it.
+  cache.DiscardPrefetches();
+  runner->RunTasks();
+  EXPECT_EQ(prefetch_count, 1u);
+  cache.GetOrTessellate(MakeRectPath(2), key, tessellate);
+  EXPECT_EQ(call_count, 1u);
+  EXPECT_EQ(cache.GetStats().prefetch_use_count, 1u);
+}
+
+TEST(TessellationCacheTest, IgnoresPrefetchesOfDifferentPaths) {
+  auto runner = std::make_shared<DeferredTaskRunner>();
+  TessellationCache cache;
+  cache.SetWorkerTaskRunner(runner);
+
+  size_t prefetch_count = 0u;
+  size_t call_count = 0u;
+  auto key = TessellationCache::Key::Fill(1.0f);
+  cache.Prefetch(MakeRectPath(1), key, MakeConvexTessellator(prefetch_count));
+  cache.GetOrTessellate(MakeRectPath(1),
+                        TessellationCache::Key::Fill(3.0f),
+                        MakeConvexTessellator(call_count));
+  cache.GetOrTessellate(MakeRectPath(2), key,
+                        MakeConvexTessellator(call_count));
+  runner->RunTasks();
+  EXPECT_EQ(call_count, 2u);
+  EXPECT_EQ(prefetch_count, 1u);
+  EXPECT_EQ(cache.GetStats().prefetch_use_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
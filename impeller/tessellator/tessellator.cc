@@ -224,12 +224,12 @@ using TessellatedVertexProc = Tessellator::TessellatedVertexProc;
 using EllipticalVertexGenerator = Tessellator::EllipticalVertexGenerator;
 
 EllipticalVertexGenerator::EllipticalVertexGenerator(
-    EllipticalVertexGenerator::GeneratorProc& generator,
+    EllipticalVertexGenerator::Shape shape,
     Trigs&& trigs,
     PrimitiveType triangle_type,
     size_t vertices_per_trig,
     Data&& data)
-    : impl_(generator),
+    : shape_(shape),
       trigs_(std::move(trigs)),
       data_(data),
       vertices_per_trig_(vertices_per_trig) {}
@@ -240,14 +240,14 @@ EllipticalVertexGenerator Tessellator::FilledCircle(
     Scalar radius) {
   size_t divisions =
       ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledCircle,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = {radius, radius},
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      EllipticalVertexGenerator::Shape::kFilledCircle,
+      GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = {radius, radius},
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::StrokedCircle(
@@ -258,14 +258,14 @@ EllipticalVertexGenerator Tessellator::StrokedCircle(
   if (half_width > 0) {
     auto divisions = ComputeQuadrantDivisions(
         view_transform.GetMaxBasisLengthXY() * radius + half_width);
-    return EllipticalVertexGenerator(Tessellator::GenerateStrokedCircle,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 8,
-                                     {
-                                         .reference_centers = {center, center},
-                                         .radii = {radius, radius},
-                                         .half_width = half_width,
-                                     });
+    return EllipticalVertexGenerator(
+        EllipticalVertexGenerator::Shape::kStrokedCircle,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 8,
+        {
+            .reference_centers = {center, center},
+            .radii = {radius, radius},
+            .half_width = half_width,
+        });
   } else {
     return FilledCircle(view_transform, center, radius);
   }
@@ -281,14 +281,14 @@ EllipticalVertexGenerator Tessellator::RoundCapLine(
   if (length > kEhCloseEnough) {
     auto divisions =
         ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-    return EllipticalVertexGenerator(Tessellator::GenerateRoundCapLine,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers = {p0, p1},
-                                         .radii = {radius, radius},
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        EllipticalVertexGenerator::Shape::kRoundCapLine,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers = {p0, p1},
+            .radii = {radius, radius},
+            .half_width = -1.0f,
+        });
   } else {
     return FilledCircle(view_transform, p0, radius);
   }
@@ -305,14 +305,14 @@ EllipticalVertexGenerator Tessellator::FilledEllipse(
   auto divisions = ComputeQuadrantDivisions(
       view_transform.GetMaxBasisLengthXY() * max_radius);
   auto center = bounds.GetCenter();
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledEllipse,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = bounds.GetSize() * 0.5f,
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      EllipticalVertexGenerator::Shape::kFilledEllipse,
+      GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = bounds.GetSize() * 0.5f,
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::FilledRoundRect(
@@ -326,27 +326,28 @@ EllipticalVertexGenerator Tessellator::FilledRoundRect(
         view_transform.GetMaxBasisLengthXY() * max_radius);
     auto upper_left = bounds.GetLeftTop() + radii;
     auto lower_right = bounds.GetRightBottom() - radii;
-    return EllipticalVertexGenerator(Tessellator::GenerateFilledRoundRect,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers =
-                                             {
-                                                 upper_left,
-                                                 lower_right,
-                                             },
-                                         .radii = radii,
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        EllipticalVertexGenerator::Shape::kFilledRoundRect,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers =
+                {
+                    upper_left,
+                    lower_right,
+                },
+            .radii = radii,
+            .half_width = -1.0f,
+        });
   } else {
     return FilledEllipse(view_transform, bounds);
   }
 }
 
+template <typename Sink>
 void Tessellator::GenerateFilledCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    const Sink& sink) {
   auto center = data.reference_centers[0];
   auto radius = data.radii.width;
 
@@ -357,8 +358,8 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    sink({center.x - offset.x, center.y + offset.y});
+    sink({center.x - offset.x, center.y - offset.y});
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -368,15 +369,16 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x + offset.y, center.y + offset.x});
-    proc({center.x + offset.y, center.y - offset.x});
+    sink({center.x + offset.y, center.y + offset.x});
+    sink({center.x + offset.y, center.y - offset.x});
   }
 }
 
+template <typename Sink>
 void Tessellator::GenerateStrokedCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    const Sink& sink) {
   auto center = data.reference_centers[0];
 
   FML_DCHECK(center == data.reference_centers[1]);
@@ -395,8 +397,8 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.x, center.y - outer.y});
-    proc({center.x - inner.x, center.y - inner.y});
+    sink({center.x - outer.x, center.y - outer.y});
+    sink({center.x - inner.x, center.y - inner.y});
   }
 
   // The even quadrants of the circle should be iterated in reverse, but
@@ -407,31 +409,32 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.y, center.y - outer.x});
-    proc({center.x + inner.y, center.y - inner.x});
+    sink({center.x + outer.y, center.y - outer.x});
+    sink({center.x + inner.y, center.y - inner.x});
   }
 
   // Quadrant 3:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.x, center.y + outer.y});
-    proc({center.x + inner.x, center.y + inner.y});
+    sink({center.x + outer.x, center.y + outer.y});
+    sink({center.x + inner.x, center.y + inner.y});
   }
 
   // Quadrant 4:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.y, center.y + outer.x});
-    proc({center.x - inner.y, center.y + inner.x});
+    sink({center.x - outer.y, center.y + outer.x});
+    sink({center.x - inner.y, center.y + inner.x});
   }
 }
 
+template <typename Sink>
 void Tessellator::GenerateRoundCapLine(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    const Sink& sink) {
   auto p0 = data.reference_centers[0];
   auto p1 = data.reference_centers[1];
   auto radius = data.radii.width;
@@ -446,8 +449,8 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.cos;
     auto relative_across = across * trig.sin;
-    proc(p0 - relative_along + relative_across);
-    proc(p0 - relative_along - relative_across);
+    sink(p0 - relative_along + relative_across);
+    sink(p0 - relative_along - relative_across);
   }
 
   // The second half of the round caps should be iterated in reverse, but
@@ -456,15 +459,16 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.sin;
     auto relative_across = across * trig.cos;
-    proc(p1 + relative_along + relative_across);
-    proc(p1 + relative_along - relative_across);
+    sink(p1 + relative_along + relative_across);
+    sink(p1 + relative_along - relative_across);
   }
 }
 
+template <typename Sink>
 void Tessellator::GenerateFilledEllipse(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    const Sink& sink) {
   auto center = data.reference_centers[0];
   auto radii = data.radii;
 
@@ -474,8 +478,8 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    sink({center.x - offset.x, center.y + offset.y});
+    sink({center.x - offset.x, center.y - offset.y});
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -485,15 +489,16 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({center.x + offset.x, center.y + offset.y});
-    proc({center.x + offset.x, center.y - offset.y});
+    sink({center.x + offset.x, center.y + offset.y});
+    sink({center.x + offset.x, center.y - offset.y});
   }
 }
 
+template <typename Sink>
 void Tessellator::GenerateFilledRoundRect(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    const Sink& sink) {
   Scalar left = data.reference_centers[0].x;
   Scalar top = data.reference_centers[0].y;
   Scalar right = data.reference_centers[1].x;
@@ -505,8 +510,8 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({left - offset.x, bottom + offset.y});
-    proc({left - offset.x, top - offset.y});
+    sink({left - offset.x, bottom + offset.y});
+    sink({left - offset.x, top - offset.y});
   }
 
   // The second half of the round rect should be iterated in reverse, but
@@ -516,9 +521,40 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({right + offset.x, bottom + offset.y});
-    proc({right + offset.x, top - offset.y});
+    sink({right + offset.x, bottom + offset.y});
+    sink({right + offset.x, top - offset.y});
   }
 }
 
+template <typename Sink>
+void EllipticalVertexGenerator::Generate(const Sink& sink) const {
+  switch (shape_) {
+    case Shape::kFilledCircle:
+      Tessellator::GenerateFilledCircle(trigs_, data_, sink);
+      break;
+    case Shape::kStrokedCircle:
+      Tessellator::GenerateStrokedCircle(trigs_, data_, sink);
+      break;
+    case Shape::kRoundCapLine:
+      Tessellator::GenerateRoundCapLine(trigs_, data_, sink);
+      break;
+    case Shape::kFilledEllipse:
+      Tessellator::GenerateFilledEllipse(trigs_, data_, sink);
+      break;
+    case Shape::kFilledRoundRect:
+      Tessellator::GenerateFilledRoundRect(trigs_, data_, sink);
+      break;
+  }
+}
+
+void EllipticalVertexGenerator::GenerateVertices(
+    const TessellatedVertexProc& proc) const {
+  Generate(proc);
+}
+
+Point* EllipticalVertexGenerator::WriteVertices(Point* vertices) const {
+  Generate([&vertices](const Point& p) { *vertices++ = p; });
+  return vertices;
+}
+
 }  // namespace impeller
@@ -131,13 +131,49 @@ class Tessellator {
     }
 
     /// |VertexGenerator|
-    void GenerateVertices(const TessellatedVertexProc& proc) const override {
-      impl_(trigs_, data_, proc);
+    void GenerateVertices(const TessellatedVertexProc& proc) const override;
+
+    /// @brief  Write the vertices, in the same order as |GenerateVertices|
+    ///         would deliver them, directly to the given array which must
+    ///         have room for exactly |GetVertexCount| points.
+    ///
+    ///         Unlike |GenerateVertices|, no callback is invoked per vertex
+    ///         which allows the loops of the generator to be inlined and
+    ///         vectorized.
+    ///
+    /// @return A pointer just past the last vertex written.
+    Point* WriteVertices(Point* vertices) const;
+
+    /// @brief  Emplace room for |GetVertexCount| vertices of the given type
+    ///         onto the host buffer and write the vertices directly into it.
+    ///
+    ///         The vertex type must consist of nothing but the position,
+    ///         as is the case for |SolidFillVertexShader::PerVertexData|.
+    template <typename VertexType = Point>
+    BufferView EmplaceVertices(HostBuffer& host_buffer) const {
+      static_assert(sizeof(VertexType) == sizeof(Point));
+      static_assert(alignof(VertexType) == alignof(Point));
+      const size_t count = GetVertexCount();
+      return host_buffer.Emplace(
+          count * sizeof(VertexType), alignof(VertexType),
+          [this, count](uint8_t* buffer) {
+            auto vertices = reinterpret_cast<Point*>(buffer);
+            auto end = WriteVertices(vertices);
+            FML_DCHECK(end == vertices + count);
+          });
     }
 
    private:
     friend class Tessellator;
 
+    enum class Shape {
+      kFilledCircle,
+      kStrokedCircle,
+      kRoundCapLine,
+      kFilledEllipse,
+      kFilledRoundRect,
+    };
+
     struct Data {
       // Circles and Ellipses only use one of these points.
       // RoundCapLines use both as the endpoints of the unexpanded line.
@@ -151,20 +187,21 @@ class Tessellator {
       const Scalar half_width;
     };
 
-    typedef void GeneratorProc(const Trigs& trigs,
-                               const Data& data,
-                               const TessellatedVertexProc& proc);
-
-    GeneratorProc& impl_;
+    const Shape shape_;
     const Trigs trigs_;
     const Data data_;
     const size_t vertices_per_trig_;
 
-    EllipticalVertexGenerator(GeneratorProc& generator,
+    EllipticalVertexGenerator(Shape shape,
                               Trigs&& trigs,
                               PrimitiveType triangle_type,
                               size_t vertices_per_trig,
                               Data&& data);
+
+    // Delivers the vertices of the shape to the |sink|, a callable taking a
+    // |const Point&|, which is inlined into the generator loops.
+    template <typename Sink>
+    void Generate(const Sink& sink) const;
   };
 
   Tessellator();
@@ -296,26 +333,31 @@ class Tessellator {
 
   Trigs GetTrigsForDivisions(size_t divisions);
 
+  template <typename Sink>
   static void GenerateFilledCircle(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   const Sink& sink);
 
+  template <typename Sink>
   static void GenerateStrokedCircle(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    const Sink& sink);
 
+  template <typename Sink>
   static void GenerateRoundCapLine(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   const Sink& sink);
 
+  template <typename Sink>
   static void GenerateFilledEllipse(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    const Sink& sink);
 
+  template <typename Sink>
   static void GenerateFilledRoundRect(
       const Trigs& trigs,
       const EllipticalVertexGenerator::Data& data,
-      const TessellatedVertexProc& proc);
+      const Sink& sink);
 
   Tessellator(const Tessellator&) = delete;
 
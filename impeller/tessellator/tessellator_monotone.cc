@@ -0,0 +1,674 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/tessellator/tessellator_monotone.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <tuple>
+
+namespace impeller {
+
+TessellatorMonotone::TessellatorMonotone()
+    : point_buffer_(std::make_unique<std::vector<Point>>()) {}
+
+TessellatorMonotone::~TessellatorMonotone() = default;
+
+Scalar TessellatorMonotone::Edge::XAt(Scalar y) const {
+  if (y <= top.y) {
+    return top.x;
+  }
+  if (y >= bottom.y) {
+    return bottom.x;
+  }
+  return top.x + (y - top.y) * dxdy;
+}
+
+static constexpr Scalar kNoCrossing = std::numeric_limits<Scalar>::infinity();
+
+uint64_t TessellatorMonotone::VertexKey(Point point) {
+  // Adding zero turns negative zeros into positive ones.
+  Scalar coordinates[2] = {point.x + 0.0f, point.y + 0.0f};
+  uint64_t key;
+  static_assert(sizeof(key) == sizeof(coordinates));
+  std::memcpy(&key, coordinates, sizeof(key));
+  return key;
+}
+
+static bool IsInside(FillType fill_type, int32_t winding) {
+  switch (fill_type) {
+    case FillType::kOdd:
+      return (winding & 1) != 0;
+    case FillType::kNonZero:
+      return winding != 0;
+  }
+  return false;
+}
+
+TessellatorMonotone::Result TessellatorMonotone::Tessellate(
+    const Path& path,
+    Scalar tolerance,
+    const BuilderCallback& callback) {
+  if (!callback) {
+    return TessellatorMonotone::Result::kInputError;
+  }
+
+  if (!point_buffer_) {
+    point_buffer_ = std::make_unique<std::vector<Point>>();
+  }
+  auto polyline = path.CreatePolyline(
+      tolerance, std::move(point_buffer_),
+      [this](Path::Polyline::PointBufferPtr point_buffer) {
+        point_buffer_ = std::move(point_buffer);
+      });
+
+  if (polyline.points->empty()) {
+    return TessellatorMonotone::Result::kInputError;
+  }
+
+  vertices_.clear();
+  indices_.clear();
+  AddEdges(polyline);
+  Sweep(path.GetFillType());
+  MergeDuplicateVertices();
+
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  // As with |TessellatorLibtess|, the vertices are only indexed if a 16bit
+  // index buffer can address all of them.
+  if (vertices_.size() <= USHRT_MAX) {
+    short_indices_.assign(indices_.begin(), indices_.end());
+    if (!callback(reinterpret_cast<const float*>(vertices_.data()),
+                  vertices_.size(), short_indices_.data(),
+                  short_indices_.size())) {
+      return TessellatorMonotone::Result::kInputError;
+    }
+  } else {
+    expanded_vertices_.clear();
+    expanded_vertices_.reserve(indices_.size());
+    for (uint32_t index : indices_) {
+      expanded_vertices_.push_back(vertices_[index]);
+    }
+    if (!callback(reinterpret_cast<const float*>(expanded_vertices_.data()),
+                  expanded_vertices_.size(), nullptr, 0u)) {
+      return TessellatorMonotone::Result::kInputError;
+    }
+  }
+
+  return TessellatorMonotone::Result::kSuccess;
+}
+
+void TessellatorMonotone::AddEdges(const Path::Polyline& polyline) {
+  edges_.clear();
+
+  // Links two edges that follow each other along a contour if they are on the
+  // same side of it, so that a monotone polygon bounded by one of them can be
+  // continued along the other.
+  auto link = [this](uint32_t first, uint32_t second) {
+    Edge& a = edges_[first];
+    Edge& b = edges_[second];
+    if (a.winding != b.winding) {
+      return;
+    }
+    if (a.winding > 0) {
+      b.previous = first;
+    } else {
+      a.previous = second;
+    }
+  };
+
+  const Point* points = polyline.points->data();
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    size_t start, end;
+    std::tie(start, end) = polyline.GetContourPointBounds(contour_i);
+    // Contours are always filled as if they were closed.
+    if (end - start > 1 && points[end - 1] == points[start]) {
+      end--;
+    }
+    if (end - start < 3) {
+      continue;
+    }
+
+    uint32_t first_edge = kNoIndex;
+    uint32_t last_edge = kNoIndex;
+    for (size_t i = start; i < end; i++) {
+      Point a = points[i];
+      Point b = points[i + 1 < end ? i + 1 : start];
+      // Horizontal edges never change the winding along a horizontal line,
+      // the edges on either side of them bound the fill.
+      if (a.y == b.y) {
+        last_edge = kNoIndex;
+        continue;
+      }
+      bool downwards = a.y < b.y;
+      Point top = downwards ? a : b;
+      Point bottom = downwards ? b : a;
+      uint32_t edge = static_cast<uint32_t>(edges_.size());
+      edges_.push_back({
+          .top = top,
+          .bottom = bottom,
+          .dxdy = (bottom.x - top.x) / (bottom.y - top.y),
+          .winding = downwards ? 1 : -1,
+          .previous = kNoIndex,
+      });
+      if (last_edge != kNoIndex) {
+        link(last_edge, edge);
+      }
+      if (i == start) {
+        first_edge = edge;
+      }
+      last_edge = edge;
+    }
+    if (first_edge != kNoIndex && last_edge != kNoIndex &&
+        first_edge != last_edge) {
+      link(last_edge, first_edge);
+    }
+  }
+}
+
+bool TessellatorMonotone::IsBefore(const Edge& a, const Edge& b) {
+  return a.sweep_x < b.sweep_x || (a.sweep_x == b.sweep_x && a.dxdy < b.dxdy);
+}
+
+Scalar TessellatorMonotone::CrossingY(const Edge& left,
+                                      const Edge& right,
+                                      Scalar y) {
+  Scalar bottom_y = std::min(left.bottom.y, right.bottom.y);
+  Scalar bottom_gap = left.XAt(bottom_y) - right.XAt(bottom_y);
+  if (bottom_gap <= 0) {
+    return kNoCrossing;
+  }
+  Scalar top_gap = right.XAt(y) - left.XAt(y);
+  if (top_gap <= 0) {
+    return y;
+  }
+  return y + (bottom_y - y) * top_gap / (top_gap + bottom_gap);
+}
+
+bool TessellatorMonotone::IsLaterCrossing(const Crossing& a,
+                                          const Crossing& b) {
+  return a.y > b.y;
+}
+
+void TessellatorMonotone::Sweep(FillType fill_type) {
+  active_edges_.clear();
+  crossings_.clear();
+  regions_.clear();
+  chain_points_.clear();
+  if (edges_.empty()) {
+    return;
+  }
+
+  edge_starts_.clear();
+  edge_ends_.clear();
+  for (uint32_t edge = 0; edge < edges_.size(); edge++) {
+    edge_starts_.push_back({edges_[edge].top.y, edge});
+    edge_ends_.push_back({edges_[edge].bottom.y, edge});
+  }
+  auto is_earlier = [](const EdgeEvent& a, const EdgeEvent& b) {
+    return a.y < b.y;
+  };
+  std::sort(edge_starts_.begin(), edge_starts_.end(), is_earlier);
+  std::sort(edge_ends_.begin(), edge_ends_.end(), is_earlier);
+
+  // The plane is swept downwards, stopping wherever edges start, end or
+  // cross. Only the active edges around those are revisited, the filled spans
+  // between the others continue unchanged.
+  size_t next_start = 0u;
+  size_t next_end = 0u;
+  while (next_end < edge_ends_.size()) {
+    Scalar y = edge_ends_[next_end].y;
+    if (next_start < edge_starts_.size()) {
+      y = std::min(y, edge_starts_[next_start].y);
+    }
+    if (!crossings_.empty()) {
+      y = std::min(y, crossings_.front().y);
+    }
+
+    changed_positions_.clear();
+    starting_edges_.clear();
+    while (next_start < edge_starts_.size() &&
+           edge_starts_[next_start].y == y) {
+      starting_edges_.push_back(edge_starts_[next_start++].edge);
+    }
+    while (next_end < edge_ends_.size() && edge_ends_[next_end].y == y) {
+      changed_positions_.push_back(
+          edges_[edge_ends_[next_end++].edge].position);
+    }
+    while (!crossings_.empty() && crossings_.front().y == y) {
+      std::pop_heap(crossings_.begin(), crossings_.end(), IsLaterCrossing);
+      const Crossing& crossing = crossings_.back();
+      // Crossings are scheduled again whenever edges become neighbors, so
+      // only the ones between edges that are still neighbors are current.
+      uint32_t left_position = edges_[crossing.left_edge].position;
+      if (left_position + 1 < active_edges_.size() &&
+          active_edges_[left_position] == crossing.left_edge &&
+          active_edges_[left_position + 1] == crossing.right_edge) {
+        changed_positions_.push_back(left_position);
+        changed_positions_.push_back(left_position + 1);
+      }
+      crossings_.pop_back();
+    }
+    if (!changed_positions_.empty() || !starting_edges_.empty()) {
+      UpdateActiveEdges(y, fill_type);
+    }
+  }
+}
+
+void TessellatorMonotone::UpdateActiveEdges(Scalar y, FillType fill_type) {
+  auto is_inside = [this, fill_type](size_t position) {
+    return IsInside(fill_type, edges_[active_edges_[position]].winding_after);
+  };
+
+  changes_.clear();
+  for (uint32_t position : changed_positions_) {
+    const Edge& edge = edges_[active_edges_[position]];
+    changes_.push_back({
+        .lo = position,
+        .hi = position + 1,
+        .winding = edge.bottom.y == y ? -edge.winding : 0,
+    });
+  }
+  for (uint32_t edge : starting_edges_) {
+    Edge& starting = edges_[edge];
+    starting.sweep_x = starting.top.x;
+    starting.position = static_cast<uint32_t>(
+        std::partition_point(active_edges_.begin(), active_edges_.end(),
+                             [this, &starting, y](uint32_t active) {
+                               Edge& edge = edges_[active];
+                               edge.sweep_x = edge.XAt(y);
+                               return IsBefore(edge, starting);
+                             }) -
+        active_edges_.begin());
+    changes_.push_back({
+        .lo = starting.position,
+        .hi = starting.position,
+        .winding = starting.winding,
+    });
+  }
+  std::sort(starting_edges_.begin(), starting_edges_.end(),
+            [this](uint32_t a, uint32_t b) {
+              return edges_[a].position < edges_[b].position;
+            });
+
+  // Each change is widened to whole filled spans so that the spans outside of
+  // it are unaffected. Overlapping changes are merged, as are changes that do
+  // not leave the winding numbers to their right unchanged, which happens
+  // when they are joined by horizontal edges.
+  for (Change& change : changes_) {
+    while (change.lo > 0 && is_inside(change.lo - 1)) {
+      change.lo--;
+    }
+    while (change.hi > 0 && change.hi < active_edges_.size() &&
+           is_inside(change.hi - 1)) {
+      change.hi++;
+    }
+  }
+  std::sort(changes_.begin(), changes_.end(),
+            [](const Change& a, const Change& b) { return a.lo < b.lo; });
+  size_t window_count = 0u;
+  for (const Change& change : changes_) {
+    if (window_count > 0) {
+      Change& window = changes_[window_count - 1];
+      if (change.lo <= window.hi || window.winding != 0) {
+        window.hi = std::max(window.hi, change.hi);
+        window.winding += change.winding;
+        continue;
+      }
+    }
+    changes_[window_count++] = change;
+  }
+
+  // Windows are rebuilt from right to left so that the positions of the ones
+  // still to be rebuilt do not move.
+  size_t starting_end = starting_edges_.size();
+  size_t moved_position = active_edges_.size();
+  for (size_t i = window_count; i > 0; i--) {
+    const Change& window = changes_[i - 1];
+    size_t starting_begin = starting_end;
+    while (starting_begin > 0 &&
+           edges_[starting_edges_[starting_begin - 1]].position >= window.lo) {
+      starting_begin--;
+    }
+    size_t active_count = active_edges_.size();
+    UpdateWindow(window.lo, window.hi, starting_begin, starting_end, y,
+                 fill_type);
+    if (active_edges_.size() != active_count) {
+      moved_position = window.lo;
+    }
+    starting_end = starting_begin;
+  }
+  for (size_t position = moved_position; position < active_edges_.size();
+       position++) {
+    edges_[active_edges_[position]].position = position;
+  }
+}
+
+void TessellatorMonotone::UpdateWindow(size_t lo,
+                                       size_t hi,
+                                       size_t starting_begin,
+                                       size_t starting_end,
+                                       Scalar y,
+                                       FillType fill_type) {
+  auto is_inside = [this, fill_type](size_t position) {
+    return IsInside(fill_type, edges_[active_edges_[position]].winding_after);
+  };
+
+  old_spans_.clear();
+  window_.clear();
+  uint32_t left_edge = kNoIndex;
+  for (size_t position = lo; position < hi; position++) {
+    uint32_t edge = active_edges_[position];
+    bool was_inside = position > lo && is_inside(position - 1);
+    if (!was_inside && is_inside(position)) {
+      left_edge = edge;
+    } else if (was_inside && !is_inside(position)) {
+      old_spans_.push_back({left_edge, edge, edges_[left_edge].region});
+    }
+    if (edges_[edge].bottom.y > y) {
+      window_.push_back(edge);
+    }
+  }
+  window_.insert(window_.end(), starting_edges_.begin() + starting_begin,
+                 starting_edges_.begin() + starting_end);
+  SortWindow(y);
+
+  if (window_.size() == hi - lo) {
+    std::copy(window_.begin(), window_.end(), active_edges_.begin() + lo);
+  } else {
+    active_edges_.erase(active_edges_.begin() + lo, active_edges_.begin() + hi);
+    active_edges_.insert(active_edges_.begin() + lo, window_.begin(),
+                         window_.end());
+  }
+  hi = lo + window_.size();
+  for (size_t position = lo; position < hi; position++) {
+    edges_[active_edges_[position]].position = position;
+  }
+
+  // The winding numbers to the right of the window are unchanged, as every
+  // contour that enters the window also leaves it.
+  new_spans_.clear();
+  int32_t winding = lo > 0 ? edges_[active_edges_[lo - 1]].winding_after : 0;
+  for (size_t position = lo; position < hi; position++) {
+    Edge& edge = edges_[active_edges_[position]];
+    bool was_inside = IsInside(fill_type, winding);
+    winding += edge.winding;
+    edge.winding_after = winding;
+    edge.region = kNoIndex;
+    if (!was_inside && IsInside(fill_type, winding)) {
+      left_edge = active_edges_[position];
+    } else if (was_inside && !IsInside(fill_type, winding)) {
+      new_spans_.push_back({left_edge, active_edges_[position], kNoIndex});
+    }
+  }
+
+  // A span continues the region of a span above it if it is bounded by the
+  // same edges or by the edges that follow them along their contours. A region
+  // is not continued through a point where its sides touch, which would make
+  // it only weakly simple.
+  for (Span& span : new_spans_) {
+    const Edge& left = edges_[span.left_edge];
+    const Edge& right = edges_[span.right_edge];
+    for (Span& old_span : old_spans_) {
+      if (old_span.region == kNoIndex) {
+        continue;
+      }
+      bool same_left = old_span.left_edge == span.left_edge;
+      bool same_right = old_span.right_edge == span.right_edge;
+      if ((same_left || old_span.left_edge == left.previous) &&
+          (same_right || old_span.right_edge == right.previous) &&
+          ((same_left && same_right) || left.XAt(y) < right.XAt(y))) {
+        span.region = old_span.region;
+        old_span.region = kNoIndex;
+        break;
+      }
+    }
+    if (span.region == kNoIndex) {
+      span.region = AddRegion(span, y);
+    } else {
+      ContinueRegion(span.region, span, y);
+    }
+    edges_[span.left_edge].region = span.region;
+  }
+  for (const Span& old_span : old_spans_) {
+    if (old_span.region != kNoIndex) {
+      CloseRegion(old_span.region, y);
+    }
+  }
+
+  size_t first = lo > 0 ? lo - 1 : lo;
+  size_t last = std::min(hi + 1, active_edges_.size());
+  for (size_t position = first; position + 1 < last; position++) {
+    ScheduleCrossing(active_edges_[position], active_edges_[position + 1], y);
+  }
+}
+
+void TessellatorMonotone::SortWindow(Scalar y) {
+  for (uint32_t edge : window_) {
+    edges_[edge].sweep_x = edges_[edge].XAt(y);
+  }
+  // The window keeps the order of the active edges, so it is nearly sorted
+  // already.
+  for (size_t i = 1; i < window_.size(); i++) {
+    uint32_t edge = window_[i];
+    size_t j = i;
+    for (; j > 0 && IsBefore(edges_[edge], edges_[window_[j - 1]]); j--) {
+      window_[j] = window_[j - 1];
+    }
+    window_[j] = edge;
+  }
+
+  // Neighbors that meet on the sweep line and cross below it, including ones
+  // that rounding placed the wrong way around, are swapped right away. All
+  // other crossings are scheduled.
+  bool swapped;
+  do {
+    swapped = false;
+    for (size_t i = 1; i < window_.size(); i++) {
+      if (CrossingY(edges_[window_[i - 1]], edges_[window_[i]], y) <= y) {
+        std::swap(window_[i - 1], window_[i]);
+        swapped = true;
+      }
+    }
+  } while (swapped);
+}
+
+void TessellatorMonotone::ScheduleCrossing(uint32_t left_edge,
+                                           uint32_t right_edge,
+                                           Scalar y) {
+  const Edge& left = edges_[left_edge];
+  const Edge& right = edges_[right_edge];
+  Scalar crossing_y = CrossingY(left, right, y);
+  if (crossing_y == kNoCrossing) {
+    return;
+  }
+  // Neighbors outside of the window that were not sorted together are
+  // swapped as soon as possible after the sweep line.
+  crossing_y = std::max(crossing_y, std::nextafter(y, kNoCrossing));
+  if (crossing_y >= std::min(left.bottom.y, right.bottom.y)) {
+    return;
+  }
+  crossings_.push_back({crossing_y, left_edge, right_edge});
+  std::push_heap(crossings_.begin(), crossings_.end(), IsLaterCrossing);
+}
+
+uint32_t TessellatorMonotone::AddRegion(const Span& span, Scalar y) {
+  uint32_t left_head = AddChainPoint({edges_[span.left_edge].XAt(y), y});
+  uint32_t right_head = AddChainPoint({edges_[span.right_edge].XAt(y), y});
+  regions_.push_back({
+      .left_edge = span.left_edge,
+      .right_edge = span.right_edge,
+      .left_head = left_head,
+      .left_tail = left_head,
+      .right_head = right_head,
+      .right_tail = right_head,
+  });
+  return static_cast<uint32_t>(regions_.size() - 1);
+}
+
+void TessellatorMonotone::ContinueRegion(uint32_t index,
+                                         const Span& span,
+                                         Scalar y) {
+  Region& region = regions_[index];
+  if (region.left_edge != span.left_edge) {
+    AppendChainPoint(region.left_tail, {edges_[span.left_edge].XAt(y), y});
+    region.left_edge = span.left_edge;
+  }
+  if (region.right_edge != span.right_edge) {
+    AppendChainPoint(region.right_tail, {edges_[span.right_edge].XAt(y), y});
+    region.right_edge = span.right_edge;
+  }
+}
+
+uint32_t TessellatorMonotone::AddChainPoint(Point point) {
+  chain_points_.push_back({.point = point, .next = kNoIndex});
+  return static_cast<uint32_t>(chain_points_.size() - 1);
+}
+
+void TessellatorMonotone::AppendChainPoint(uint32_t& tail, Point point) {
+  uint32_t index = AddChainPoint(point);
+  chain_points_[tail].next = index;
+  tail = index;
+}
+
+void TessellatorMonotone::CloseRegion(uint32_t index, Scalar y) {
+  Region& closed = regions_[index];
+  Point left_bottom = {edges_[closed.left_edge].XAt(y), y};
+  Point right_bottom = {edges_[closed.right_edge].XAt(y), y};
+  if (chain_points_[closed.left_tail].point != left_bottom) {
+    AppendChainPoint(closed.left_tail, left_bottom);
+  }
+  if (chain_points_[closed.right_tail].point != right_bottom) {
+    AppendChainPoint(closed.right_tail, right_bottom);
+  }
+
+  // Merge the two chains into sweep order, sharing the top and bottom
+  // vertices if the sides meet there.
+  polygon_.clear();
+  uint32_t left = closed.left_head;
+  uint32_t right = closed.right_head;
+  if (chain_points_[left].point == chain_points_[right].point) {
+    right = chain_points_[right].next;
+  }
+  Point left_end = chain_points_[closed.left_tail].point;
+  while (left != kNoIndex || right != kNoIndex) {
+    if (right != kNoIndex && chain_points_[right].next == kNoIndex &&
+        chain_points_[right].point == left_end) {
+      right = kNoIndex;
+      continue;
+    }
+    bool take_left = right == kNoIndex;
+    if (left != kNoIndex && right != kNoIndex) {
+      Point l = chain_points_[left].point;
+      Point r = chain_points_[right].point;
+      take_left = l.y < r.y || (l.y == r.y && l.x <= r.x);
+    }
+    if (take_left) {
+      polygon_.push_back({chain_points_[left].point, true});
+      left = chain_points_[left].next;
+    } else {
+      polygon_.push_back({chain_points_[right].point, false});
+      right = chain_points_[right].next;
+    }
+  }
+  Triangulate(polygon_);
+}
+
+void TessellatorMonotone::Triangulate(const std::vector<SweepVertex>& polygon) {
+  size_t count = polygon.size();
+  if (count < 3) {
+    return;
+  }
+
+  uint32_t base = static_cast<uint32_t>(vertices_.size());
+  for (const SweepVertex& vertex : polygon) {
+    vertices_.push_back(vertex.point);
+  }
+  auto add_triangle = [this, base](uint32_t a, uint32_t b, uint32_t c) {
+    indices_.push_back(base + a);
+    indices_.push_back(base + b);
+    indices_.push_back(base + c);
+  };
+
+  // Whether the diagonal from |to| up to |from| passes inside the polygon,
+  // which is the case when |middle| is a convex vertex of the chain.
+  auto is_inside = [&polygon](uint32_t from, uint32_t middle, uint32_t to) {
+    Point top = polygon[from].point;
+    Point cross_a = polygon[to].point - top;
+    Point cross_b = polygon[middle].point - top;
+    Scalar cross = cross_a.Cross(cross_b);
+    return polygon[to].left ? cross > 0 : cross < 0;
+  };
+
+  stack_.clear();
+  stack_.push_back(0u);
+  stack_.push_back(1u);
+  for (uint32_t j = 2; j + 1 < count; j++) {
+    if (polygon[j].left != polygon[stack_.back()].left) {
+      for (size_t k = 1; k < stack_.size(); k++) {
+        add_triangle(j, stack_[k - 1], stack_[k]);
+      }
+      stack_.clear();
+      stack_.push_back(j - 1);
+      stack_.push_back(j);
+    } else {
+      uint32_t last = stack_.back();
+      stack_.pop_back();
+      while (!stack_.empty() && is_inside(stack_.back(), last, j)) {
+        add_triangle(j, last, stack_.back());
+        last = stack_.back();
+        stack_.pop_back();
+      }
+      stack_.push_back(last);
+      stack_.push_back(j);
+    }
+  }
+  uint32_t bottom = static_cast<uint32_t>(count - 1);
+  for (size_t k = 1; k < stack_.size(); k++) {
+    add_triangle(bottom, stack_[k - 1], stack_[k]);
+  }
+}
+
+void TessellatorMonotone::MergeDuplicateVertices() {
+  // Neighboring monotone polygons share the vertices where they meet, which
+  // are computed from the same points and edges and so are bitwise identical.
+  // They are found with an open addressing hash table of the unique vertices,
+  // which are moved to the front in their original order.
+  size_t capacity = 16u;
+  while (capacity < vertices_.size() * 2) {
+    capacity *= 2;
+  }
+  vertex_slots_.assign(capacity, kNoIndex);
+  vertex_remap_.resize(vertices_.size());
+  uint32_t unique_count = 0u;
+  for (uint32_t i = 0; i < vertices_.size(); i++) {
+    const Point point = vertices_[i];
+    const uint64_t key = VertexKey(point);
+    size_t slot = (key * 0x9E3779B97F4A7C15u) >> 32;
+    while (true) {
+      slot &= capacity - 1;
+      uint32_t unique = vertex_slots_[slot];
+      if (unique == kNoIndex) {
+        vertex_slots_[slot] = unique_count;
+        vertices_[unique_count] = point;
+        vertex_remap_[i] = unique_count++;
+        break;
+      }
+      if (VertexKey(vertices_[unique]) == key) {
+        vertex_remap_[i] = unique;
+        break;
+      }
+      slot++;
+    }
+  }
+  vertices_.resize(unique_count);
+  for (uint32_t& index : indices_) {
+    index = vertex_remap_[index];
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,231 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TESSELLATOR_TESSELLATOR_MONOTONE_H_
+#define FLUTTER_IMPELLER_TESSELLATOR_TESSELLATOR_MONOTONE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      An extended tessellator that offers arbitrary/concave
+///             tessellation by decomposing the path into y-monotone polygons
+///             with a sweep line and triangulating each of them.
+///
+///             Self-intersecting and overlapping contours are split where
+///             they cross, and both the even-odd and non-zero fill types are
+///             supported. This is a drop in alternative to
+///             |TessellatorLibtess| with the same interface.
+///
+///             All of the working memory is kept by the tessellator and reused
+///             by later calls, so tessellating paths of a similar size
+///             repeatedly does not allocate.
+///
+///             This object is not thread safe, and its methods must not be
+///             called from multiple threads.
+///
+class TessellatorMonotone {
+ public:
+  TessellatorMonotone();
+
+  ~TessellatorMonotone();
+
+  enum class Result {
+    kSuccess,
+    kInputError,
+    kTessellationError,
+  };
+
+  /// @brief A callback that returns the results of the tessellation.
+  ///
+  ///        The index buffer may not be populated, in which case [indices] will
+  ///        be nullptr and indices_count will be 0.
+  using BuilderCallback = std::function<bool(const float* vertices,
+                                             size_t vertices_count,
+                                             const uint16_t* indices,
+                                             size_t indices_count)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Generates filled triangles from the path. A callback is
+  ///             invoked once for the entire tessellation.
+  ///
+  /// @param[in]  path  The path to tessellate.
+  /// @param[in]  tolerance  The tolerance value for conversion of the path to
+  ///                        a polyline. This value is often derived from the
+  ///                        Matrix::GetMaxBasisLength of the CTM applied to the
+  ///                        path for rendering.
+  /// @param[in]  callback  The callback, return false to indicate failure.
+  ///
+  /// @return The result status of the tessellation.
+  ///
+  TessellatorMonotone::Result Tessellate(const Path& path,
+                                         Scalar tolerance,
+                                         const BuilderCallback& callback);
+
+ private:
+  /// A non-horizontal line segment of the polyline, oriented downwards.
+  struct Edge {
+    Point top;
+    Point bottom;
+    Scalar dxdy;
+    /// +1 if the contour runs downwards along this edge, -1 otherwise.
+    int32_t winding;
+    /// The edge that ends at |top| and continues the same side of the contour
+    /// into this one, or |kNoIndex|.
+    uint32_t previous;
+    /// While the edge is active, its index in the active edges, the winding
+    /// number just to its right and the region whose left side it is.
+    uint32_t position;
+    int32_t winding_after;
+    uint32_t region;
+    /// The position of the edge on the sweep line while the active edges are
+    /// being sorted.
+    Scalar sweep_x;
+
+    Scalar XAt(Scalar y) const;
+  };
+
+  /// The height at which an edge starts or ends.
+  struct EdgeEvent {
+    Scalar y;
+    uint32_t edge;
+  };
+
+  /// A point below the sweep line at which two neighboring active edges
+  /// cross.
+  struct Crossing {
+    Scalar y;
+    uint32_t left_edge;
+    uint32_t right_edge;
+  };
+
+  /// A range of active edges that changes at the sweep line, and the winding
+  /// added to the right of it by the change.
+  struct Change {
+    uint32_t lo;
+    uint32_t hi;
+    int32_t winding;
+  };
+
+  /// A maximal filled span between two active edges.
+  struct Span {
+    uint32_t left_edge;
+    uint32_t right_edge;
+    uint32_t region;
+  };
+
+  /// A point on the left or right chain of a monotone polygon, linked to the
+  /// next point below it on the same chain.
+  struct ChainPoint {
+    Point point;
+    uint32_t next;
+  };
+
+  /// A y-monotone polygon that is still being built by the sweep.
+  struct Region {
+    uint32_t left_edge;
+    uint32_t right_edge;
+    uint32_t left_head;
+    uint32_t left_tail;
+    uint32_t right_head;
+    uint32_t right_tail;
+  };
+
+  /// A vertex of a monotone polygon in sweep order.
+  struct SweepVertex {
+    Point point;
+    bool left;
+  };
+
+  static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+  /// The bits of the coordinates of |point|, which identify its vertex.
+  static uint64_t VertexKey(Point point);
+
+  /// Whether |a| is to the left of |b| just below the sweep line.
+  static bool IsBefore(const Edge& a, const Edge& b);
+
+  /// The height below |y| at which |left| and |right| cross, or infinity if
+  /// they do not cross before either of them ends.
+  static Scalar CrossingY(const Edge& left, const Edge& right, Scalar y);
+
+  /// Orders |crossings_| as a min-heap.
+  static bool IsLaterCrossing(const Crossing& a, const Crossing& b);
+
+  void AddEdges(const Path::Polyline& polyline);
+
+  void Sweep(FillType fill_type);
+
+  /// Removes the ending edges, swaps the crossing edges and inserts the
+  /// starting edges at |y|.
+  void UpdateActiveEdges(Scalar y, FillType fill_type);
+
+  /// Replaces the active edges from |lo| to |hi| with the ones among them
+  /// that continue below |y| and the given starting edges, then continues,
+  /// closes and opens the regions between them.
+  void UpdateWindow(size_t lo,
+                    size_t hi,
+                    size_t starting_begin,
+                    size_t starting_end,
+                    Scalar y,
+                    FillType fill_type);
+
+  /// Sorts |window_| by position just below |y|.
+  void SortWindow(Scalar y);
+
+  void ScheduleCrossing(uint32_t left_edge, uint32_t right_edge, Scalar y);
+
+  uint32_t AddRegion(const Span& span, Scalar y);
+
+  void ContinueRegion(uint32_t region, const Span& span, Scalar y);
+
+  uint32_t AddChainPoint(Point point);
+
+  void AppendChainPoint(uint32_t& tail, Point point);
+
+  void CloseRegion(uint32_t region, Scalar y);
+
+  void Triangulate(const std::vector<SweepVertex>& polygon);
+
+  /// Replaces the vertices that have the same position by a single one.
+  void MergeDuplicateVertices();
+
+  // Working memory, cleared but not released by each call to |Tessellate|.
+  std::unique_ptr<std::vector<Point>> point_buffer_;
+  std::vector<Edge> edges_;
+  std::vector<EdgeEvent> edge_starts_;
+  std::vector<EdgeEvent> edge_ends_;
+  std::vector<uint32_t> active_edges_;
+  std::vector<Crossing> crossings_;
+  std::vector<uint32_t> changed_positions_;
+  std::vector<uint32_t> starting_edges_;
+  std::vector<Change> changes_;
+  std::vector<uint32_t> window_;
+  std::vector<Span> old_spans_;
+  std::vector<Span> new_spans_;
+  std::vector<Region> regions_;
+  std::vector<ChainPoint> chain_points_;
+  std::vector<SweepVertex> polygon_;
+  std::vector<uint32_t> stack_;
+  std::vector<Point> vertices_;
+  std::vector<uint32_t> indices_;
+  std::vector<uint32_t> vertex_slots_;
+  std::vector<uint32_t> vertex_remap_;
+  std::vector<uint16_t> short_indices_;
+  std::vector<Point> expanded_vertices_;
+
+  TessellatorMonotone(const TessellatorMonotone&) = delete;
+
+  TessellatorMonotone& operator=(const TessellatorMonotone&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TESSELLATOR_TESSELLATOR_MONOTONE_H_
@@ -2,14 +2,19 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/c/tessellator.h"
 #include "impeller/tessellator/tessellator.h"
 #include "impeller/tessellator/tessellator_libtess.h"
+#include "impeller/tessellator/tessellator_monotone.h"
 
 namespace impeller {
 namespace testing {
@@ -496,6 +501,41 @@ TEST(TessellatorTest, FilledRoundRectTessellationVertices) {
        Rect::MakeXYWH(5000, 10000, 2000, 3000), {50, 70});
 }
 
+TEST(TessellatorTest, WriteVerticesMatchesGenerateVertices) {
+  auto tessellator = std::make_shared<Tessellator>();
+  auto transform = Matrix::MakeScale({2.0, 2.0, 1.0});
+
+  auto test = [](const Tessellator::EllipticalVertexGenerator& generator) {
+    std::vector<Point> generated;
+    generator.GenerateVertices([&generated](const Point& p) {  //
+      generated.push_back(p);
+    });
+
+    // Surround the vertices with guard values to detect out of bounds
+    // writes.
+    const Point guard = {-12345, 12345};
+    std::vector<Point> written(generator.GetVertexCount() + 2, guard);
+    auto end = generator.WriteVertices(written.data() + 1);
+    EXPECT_EQ(end, written.data() + 1 + generator.GetVertexCount());
+    EXPECT_EQ(written.front(), guard);
+    EXPECT_EQ(written.back(), guard);
+
+    ASSERT_EQ(generated.size(), generator.GetVertexCount());
+    for (size_t i = 0; i < generated.size(); i++) {
+      EXPECT_EQ(written[i + 1], generated[i]) << "vertex " << i;
+    }
+  };
+
+  test(tessellator->FilledCircle(transform, {10, 10}, 20));
+  test(tessellator->StrokedCircle(transform, {10, 10}, 20, 4));
+  test(tessellator->RoundCapLine(transform, {10, 10}, {30, 40}, 5));
+  test(tessellator->FilledEllipse(transform, Rect::MakeLTRB(0, 0, 40, 20)));
+  test(tessellator->FilledRoundRect(transform, Rect::MakeLTRB(0, 0, 40, 20),
+                                    {5, 8}));
+  // Large enough that the trigs are not cached.
+  test(tessellator->FilledCircle(transform, {}, 100000));
+}
+
 TEST(TessellatorTest, EarlyReturnEmptyConvexShape) {
   // This path is not technically empty (it has a size in one dimension),
   // but is otherwise completely flat.
@@ -511,6 +551,338 @@ TEST(TessellatorTest, EarlyReturnEmptyConvexShape) {
   EXPECT_TRUE(points.empty());
 }
 
+TEST(TessellatorTest, TessellatorMonotoneReturnsCorrectResultStatus) {
+  auto ignore = [](const float* vertices, size_t vertices_count,
+                   const uint16_t* indices, size_t indices_count) {
+    return true;
+  };
+
+  // Zero points.
+  {
+    TessellatorMonotone t;
+    auto path = PathBuilder{}.TakePath(FillType::kOdd);
+    EXPECT_EQ(t.Tessellate(path, 1.0f, ignore),
+              TessellatorMonotone::Result::kInputError);
+  }
+
+  // One point.
+  {
+    TessellatorMonotone t;
+    auto path = PathBuilder{}.LineTo({0, 0}).TakePath(FillType::kOdd);
+    EXPECT_EQ(t.Tessellate(path, 1.0f, ignore),
+              TessellatorMonotone::Result::kSuccess);
+  }
+
+  // Two points.
+  {
+    TessellatorMonotone t;
+    auto path = PathBuilder{}.AddLine({0, 0}, {0, 1}).TakePath(FillType::kOdd);
+    EXPECT_EQ(t.Tessellate(path, 1.0f, ignore),
+              TessellatorMonotone::Result::kSuccess);
+  }
+
+  // Many points.
+  {
+    TessellatorMonotone t;
+    PathBuilder builder;
+    for (int i = 0; i < 1000; i++) {
+      auto coord = i * 1.0f;
+      builder.AddLine({coord, coord}, {coord + 1, coord + 1});
+    }
+    auto path = builder.TakePath(FillType::kOdd);
+    EXPECT_EQ(t.Tessellate(path, 1.0f, ignore),
+              TessellatorMonotone::Result::kSuccess);
+  }
+
+  // Closure fails.
+  {
+    TessellatorMonotone t;
+    auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 1, 1)).TakePath();
+    EXPECT_EQ(t.Tessellate(path, 1.0f,
+                           [](const float* vertices, size_t vertices_count,
+                              const uint16_t* indices,
+                              size_t indices_count) { return false; }),
+              TessellatorMonotone::Result::kInputError);
+  }
+}
+
+// The winding number of the closed contours of the polyline around the point.
+static int WindingNumber(const Path::Polyline& polyline, Point point) {
+  int winding = 0;
+  for (size_t i = 0; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    for (size_t j = start; j < end; j++) {
+      Point a = polyline.GetPoint(j);
+      Point b = polyline.GetPoint(j + 1 < end ? j + 1 : start);
+      if ((a.y <= point.y) == (b.y <= point.y)) {
+        continue;
+      }
+      Scalar x = a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y);
+      if (x < point.x) {
+        winding += a.y < b.y ? 1 : -1;
+      }
+    }
+  }
+  return winding;
+}
+
+// Checks that every point of a grid over the path that is filled according to
+// the fill type of the path is covered by exactly one of the triangles, and
+// that no other points are covered.
+static void ExpectTrianglesCoverFill(const Path& path) {
+  std::vector<Point> triangles;
+  TessellatorMonotone tessellator;
+  auto result = tessellator.Tessellate(
+      path, 1.0f,
+      [&triangles](const float* vertices, size_t vertices_count,
+                   const uint16_t* indices, size_t indices_count) {
+        auto points = reinterpret_cast<const Point*>(vertices);
+        for (size_t i = 0; i < indices_count; i++) {
+          triangles.push_back(points[indices[i]]);
+        }
+        return true;
+      });
+  ASSERT_EQ(result, TessellatorMonotone::Result::kSuccess);
+  ASSERT_EQ(triangles.size() % 3, 0u);
+
+  auto polyline = path.CreatePolyline(1.0f);
+  auto bounds = path.GetBoundingBox().value_or(Rect());
+  // Offset the grid so that it does not line up with the vertices.
+  for (Scalar y = bounds.GetTop() + 0.371f; y < bounds.GetBottom(); y += 1.7f) {
+    for (Scalar x = bounds.GetLeft() + 0.193f; x < bounds.GetRight();
+         x += 1.3f) {
+      Point point(x, y);
+      int winding = WindingNumber(polyline, point);
+      bool filled = path.GetFillType() == FillType::kOdd ? (winding & 1) != 0
+                                                          : winding != 0;
+      int covered = 0;
+      for (size_t i = 0; i < triangles.size(); i += 3) {
+        Scalar d0 =
+            (triangles[i + 1] - triangles[i]).Cross(point - triangles[i]);
+        Scalar d1 = (triangles[i + 2] - triangles[i + 1])
+                        .Cross(point - triangles[i + 1]);
+        Scalar d2 = (triangles[i] - triangles[i + 2])
+                        .Cross(point - triangles[i + 2]);
+        if ((d0 > 0 && d1 > 0 && d2 > 0) || (d0 < 0 && d1 < 0 && d2 < 0)) {
+          covered++;
+        }
+      }
+      ASSERT_EQ(covered, filled ? 1 : 0) << point << " winding " << winding;
+    }
+  }
+}
+
+TEST(TessellatorTest, TessellatorMonotoneFillsConcavePaths) {
+  for (auto fill_type : {FillType::kOdd, FillType::kNonZero}) {
+    // A star with a self-intersecting outline, which is only filled in the
+    // middle with the non-zero fill type.
+    ExpectTrianglesCoverFill(PathBuilder{}
+                                 .MoveTo({50, 0})
+                                 .LineTo({79, 90})
+                                 .LineTo({2, 35})
+                                 .LineTo({98, 35})
+                                 .LineTo({21, 90})
+                                 .Close()
+                                 .TakePath(fill_type));
+
+    // Overlapping rectangles in the same direction and a hole in the opposite
+    // direction.
+    ExpectTrianglesCoverFill(PathBuilder{}
+                                 .AddRect(Rect::MakeLTRB(0, 0, 60, 60))
+                                 .AddRect(Rect::MakeLTRB(30, 30, 90, 90))
+                                 .MoveTo({10, 10})
+                                 .LineTo({10, 20})
+                                 .LineTo({20, 20})
+                                 .LineTo({20, 10})
+                                 .Close()
+                                 .TakePath(fill_type));
+
+    // A glyph-like outline with curves, a counter and a spike.
+    ExpectTrianglesCoverFill(PathBuilder{}
+                                 .MoveTo({10, 100})
+                                 .CubicCurveTo({10, 0}, {90, 0}, {90, 100})
+                                 .LineTo({70, 100})
+                                 .QuadraticCurveTo({50, 20}, {30, 100})
+                                 .LineTo({50, 60})
+                                 .Close()
+                                 .AddCircle({50, 50}, 12)
+                                 .TakePath(fill_type));
+
+    // A comb whose teeth are all separate monotone polygons.
+    PathBuilder comb;
+    comb.MoveTo({0, 0}).LineTo({100, 0});
+    for (int i = 0; i < 10; i++) {
+      comb.LineTo({95.0f - i * 10, 80 + (i % 3) * 7})
+          .LineTo({90.0f - i * 10, 10});
+    }
+    ExpectTrianglesCoverFill(comb.Close().TakePath(fill_type));
+  }
+}
+
+TEST(TessellatorTest, TessellatorMonotoneReusesWorkingMemory) {
+  TessellatorMonotone t;
+  auto path = PathBuilder{}
+                  .AddCircle({50, 50}, 40)
+                  .AddCircle({60, 50}, 40)
+                  .TakePath(FillType::kOdd);
+  std::vector<float> first;
+  std::vector<float> second;
+  for (auto* output : {&first, &second}) {
+    auto result = t.Tessellate(
+        path, 1.0f,
+        [output](const float* vertices, size_t vertices_count,
+                 const uint16_t* indices, size_t indices_count) {
+          for (size_t i = 0; i < indices_count; i++) {
+            output->push_back(vertices[indices[i] * 2]);
+            output->push_back(vertices[indices[i] * 2 + 1]);
+          }
+          return true;
+        });
+    ASSERT_EQ(result, TessellatorMonotone::Result::kSuccess);
+  }
+  EXPECT_FALSE(first.empty());
+  EXPECT_EQ(first, second);
+}
+
+TEST(TessellatorTest, TessellatorMonotoneSharesVerticesBetweenPolygons) {
+  // A comb whose teeth are all separate monotone polygons that meet the
+  // polygon of the spine at the vertices of the path.
+  PathBuilder comb;
+  comb.MoveTo({0, 0}).LineTo({100, 0});
+  for (int i = 0; i < 10; i++) {
+    comb.LineTo({95.0f - i * 10, 80}).LineTo({90.0f - i * 10, 10});
+  }
+  auto path = comb.Close().TakePath();
+  auto polyline = path.CreatePolyline(1.0f);
+
+  TessellatorMonotone t;
+  std::vector<Point> points;
+  auto result = t.Tessellate(
+      path, 1.0f,
+      [&points](const float* vertices, size_t vertices_count,
+                const uint16_t* indices, size_t indices_count) {
+        auto begin = reinterpret_cast<const Point*>(vertices);
+        points.assign(begin, begin + vertices_count);
+        EXPECT_GT(indices_count, vertices_count);
+        return true;
+      });
+  ASSERT_EQ(result, TessellatorMonotone::Result::kSuccess);
+  EXPECT_LE(points.size(), polyline.points->size());
+  for (size_t i = 0; i < points.size(); i++) {
+    for (size_t j = i + 1; j < points.size(); j++) {
+      EXPECT_NE(points[i], points[j]);
+    }
+  }
+}
+
+// The total area of the triangles the tessellator generates for the path.
+template <typename T>
+static Scalar TessellatedArea(const Path& path) {
+  Scalar area = 0.0f;
+  T tessellator;
+  auto result = tessellator.Tessellate(
+      path, 1.0f,
+      [&area](const float* vertices, size_t vertices_count,
+              const uint16_t* indices, size_t indices_count) {
+        auto points = reinterpret_cast<const Point*>(vertices);
+        size_t count = indices ? indices_count : vertices_count;
+        auto get = [&](size_t i) {
+          return indices ? points[indices[i]] : points[i];
+        };
+        for (size_t i = 0; i + 2 < count; i += 3) {
+          area += std::abs((get(i + 1) - get(i)).Cross(get(i + 2) - get(i)));
+        }
+        return true;
+      });
+  EXPECT_EQ(result, T::Result::kSuccess);
+  return area / 2.0f;
+}
+
+TEST(TessellatorTest, TessellatorMonotoneCoversSameAreaAsLibtess) {
+  for (auto fill_type : {FillType::kOdd, FillType::kNonZero}) {
+    std::vector<Path> paths = {
+        PathBuilder{}
+            .MoveTo({50, 0})
+            .LineTo({79, 90})
+            .LineTo({2, 35})
+            .LineTo({98, 35})
+            .LineTo({21, 90})
+            .Close()
+            .TakePath(fill_type),
+        PathBuilder{}
+            .AddRect(Rect::MakeLTRB(0, 0, 60, 60))
+            .AddRect(Rect::MakeLTRB(30, 30, 90, 90))
+            .MoveTo({10, 10})
+            .LineTo({10, 20})
+            .LineTo({20, 20})
+            .LineTo({20, 10})
+            .Close()
+            .TakePath(fill_type),
+        PathBuilder{}
+            .AddCircle({50, 50}, 40)
+            .AddCircle({60, 50}, 40)
+            .AddCircle({55, 60}, 20)
+            .TakePath(fill_type),
+    };
+    for (const Path& path : paths) {
+      Scalar libtess_area = TessellatedArea<TessellatorLibtess>(path);
+      ASSERT_GT(libtess_area, 0.0f);
+      EXPECT_NEAR(TessellatedArea<TessellatorMonotone>(path), libtess_area,
+                  libtess_area * 1e-4f);
+    }
+  }
+}
+
+TEST(TessellatorTest, CApiTessellatesWithEitherTessellator) {
+  PathBuilder* builder = CreatePathBuilder();
+  // An L shape with an area of 3 squares of 10x10.
+  MoveTo(builder, 0, 0);
+  LineTo(builder, 20, 0);
+  LineTo(builder, 20, 10);
+  LineTo(builder, 10, 10);
+  LineTo(builder, 10, 20);
+  LineTo(builder, 0, 20);
+  Close(builder);
+
+  for (int tessellator : {kTessellatorLibtess, kTessellatorMonotone}) {
+    Vertices* vertices =
+        TessellateWith(builder, static_cast<int>(FillType::kOdd), 1.0f,
+                       tessellator);
+    ASSERT_NE(vertices, nullptr);
+    // Triangles with two coordinates per point.
+    ASSERT_GT(vertices->length, 0u);
+    ASSERT_EQ(vertices->length % 6, 0u);
+    Scalar area = 0.0f;
+    for (uint32_t i = 0; i < vertices->length; i += 6) {
+      const float* p = vertices->points + i;
+      area += std::abs((p[2] - p[0]) * (p[5] - p[1]) -
+                       (p[4] - p[0]) * (p[3] - p[1]));
+    }
+    EXPECT_NEAR(area / 2.0f, 300.0f, 1e-3f) << "tessellator " << tessellator;
+    DestroyVertices(vertices);
+  }
+
+  // The default is libtess.
+  Vertices* vertices =
+      Tessellate(builder, static_cast<int>(FillType::kOdd), 1.0f);
+  Vertices* libtess_vertices = TessellateWith(
+      builder, static_cast<int>(FillType::kOdd), 1.0f, kTessellatorLibtess);
+  ASSERT_NE(vertices, nullptr);
+  ASSERT_NE(libtess_vertices, nullptr);
+  EXPECT_EQ(std::vector<float>(vertices->points,
+                               vertices->points + vertices->length),
+            std::vector<float>(libtess_vertices->points,
+                               libtess_vertices->points +
+                                   libtess_vertices->length));
+  DestroyVertices(vertices);
+  DestroyVertices(libtess_vertices);
+
+  EXPECT_EQ(TessellateWith(builder, static_cast<int>(FillType::kOdd), 1.0f,
+                           kTessellatorMonotone + 1),
+            nullptr);
+  DestroyPathBuilder(builder);
+}
+
 #if !NDEBUG
 TEST(TessellatorTest, ChecksConcurrentPolylineUsage) {
   auto tessellator = std::make_shared<Tessellator>();
@@ -307,6 +307,16 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   // this call is thread-safe.
   SkExecutor::SetDefault(&skia_concurrent_executor_);
 
+#if FML_OS_LINUX
+  // Embedders that set thread priorities themselves also decide where the
+  // threads run. Otherwise, prefer to keep the workers off the fastest cores,
+  // which the UI and raster threads prefer.
+  if (settings_.use_engine_thread_policy) {
+    concurrent_message_loop_->PostTaskToAllWorkers(
+        []() { fml::RequestAffinity(fml::CpuAffinity::kNotPerformance); });
+  }
+#endif  // FML_OS_LINUX
+
   FML_DCHECK(vm_data_);
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
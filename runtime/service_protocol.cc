@@ -39,6 +39,10 @@ const std::string_view
         "_flutter.estimateRasterCacheMemory";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetTaskQueueStatsExtensionName =
+    "_flutter.getTaskQueueStats";
+const std::string_view ServiceProtocol::kDumpTraceRingBufferExtensionName =
+    "_flutter.dumpTraceRingBuffer";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -59,6 +63,8 @@ ServiceProtocol::ServiceProtocol()
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kReloadAssetFonts,
+          kGetTaskQueueStatsExtensionName,
+          kDumpTraceRingBufferExtensionName,
       }) {}
 
 ServiceProtocol::~ServiceProtocol() {
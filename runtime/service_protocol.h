@@ -29,6 +29,8 @@ class ServiceProtocol {
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetTaskQueueStatsExtensionName;
+  static const std::string_view kDumpTraceRingBufferExtensionName;
 
   class Handler {
    public:
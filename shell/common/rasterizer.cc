@@ -168,6 +168,17 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
 }
 
 void Rasterizer::NotifyLowMemoryWarning() const {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (surface_) {
+    if (auto aiks_context = surface_->GetAiksContext()) {
+      // Drop the offscreen textures that are only kept for later frames.
+      aiks_context->GetContentContext()
+          .GetRenderTargetCache()
+          ->DiscardUnused();
+      return;
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 #if !SLIMPELLER
   if (!surface_) {
     FML_DLOG(INFO)
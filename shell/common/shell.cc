@@ -20,8 +20,10 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
@@ -122,6 +124,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_to_ring_buffer) {
+      fml::tracing::TraceRecorder::GetInstance().Start();
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -510,6 +516,16 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTaskQueueStatsExtensionName] = {
+          task_runners_.GetUITaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTaskQueueStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kDumpTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolDumpTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -1591,6 +1607,11 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.trace_to_ring_buffer &&
+      !settings_.trace_ring_buffer_dump_path.empty()) {
+    DumpTraceRingBufferIfJanky(timing);
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1649,6 +1670,47 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+void Shell::DumpTraceRingBufferIfJanky(const FrameTiming& timing) {
+  const fml::TimeDelta frame_time =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  if (frame_time.ToMillisecondsF() <= 2 * GetFrameBudget().count()) {
+    return;
+  }
+
+  // Janky frames tend to come in bursts. Each dump already holds the last few
+  // seconds of events so there is no point in writing one per frame.
+  constexpr fml::TimeDelta kMinimumDumpInterval =
+      fml::TimeDelta::FromSeconds(5);
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (last_trace_ring_buffer_dump_.has_value() &&
+      now - last_trace_ring_buffer_dump_.value() < kMinimumDumpInterval) {
+    return;
+  }
+  last_trace_ring_buffer_dump_ = now;
+
+  // Snapshotting and serializing the buffers is done on the IO thread to keep
+  // it off the critical path of the next frame.
+  const std::string file_name =
+      "flutter_jank_frame_" + std::to_string(timing.GetFrameNumber()) +
+      ".pftrace";
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetIOTaskRunner(),
+      [directory_path = settings_.trace_ring_buffer_dump_path, file_name]() {
+        TRACE_EVENT0("flutter", "DumpTraceRingBuffer");
+        auto directory =
+            fml::OpenDirectory(directory_path.c_str(), true,
+                               fml::FilePermission::kReadWrite);
+        if (!directory.is_valid() ||
+            !fml::tracing::TraceRecorder::GetInstance().WriteToFile(
+                directory, file_name.c_str(),
+                fml::tracing::TraceRecorder::Format::kPerfettoProto)) {
+          FML_LOG(ERROR) << "Could not dump the trace ring buffer to "
+                         << directory_path << "/" << file_name;
+        }
+      });
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -2052,6 +2114,130 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+static void AddHistogramToResponse(const fml::Log2Histogram& histogram,
+                                   const char* name,
+                                   rapidjson::Value& object,
+                                   rapidjson::Document::AllocatorType& alloc) {
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember<uint64_t>("count", histogram.GetCount(), alloc);
+  value.AddMember<uint64_t>("sum", histogram.GetSum(), alloc);
+  value.AddMember<uint64_t>("p50", histogram.GetPercentile(50), alloc);
+  value.AddMember<uint64_t>("p90", histogram.GetPercentile(90), alloc);
+  value.AddMember<uint64_t>("p99", histogram.GetPercentile(99), alloc);
+  value.AddMember<uint64_t>("max", histogram.GetMax(), alloc);
+  rapidjson::Value buckets(rapidjson::kArrayType);
+  for (auto bucket : histogram.GetBuckets()) {
+    buckets.PushBack<uint64_t>(bucket, alloc);
+  }
+  value.AddMember("log2Buckets", buckets, alloc);
+  object.AddMember(rapidjson::StringRef(name), value, alloc);
+}
+
+bool Shell::OnServiceProtocolGetTaskQueueStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  auto enable = params.find("enable");
+  if (enable != params.end()) {
+    task_queues->SetStatsEnabled(enable->second == "true");
+  }
+
+  const std::pair<const char*, fml::RefPtr<fml::TaskRunner>> runners[] = {
+      {"platform", task_runners_.GetPlatformTaskRunner()},
+      {"ui", task_runners_.GetUITaskRunner()},
+      {"raster", task_runners_.GetRasterTaskRunner()},
+      {"io", task_runners_.GetIOTaskRunner()},
+  };
+
+  const auto stats = task_queues->GetStats();
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TaskQueueStats", allocator);
+  response->AddMember("enabled", task_queues->IsStatsEnabled(), allocator);
+  rapidjson::Value queues(rapidjson::kArrayType);
+  for (const auto& [name, runner] : runners) {
+    auto found = stats.find(runner->GetTaskQueueId());
+    if (found == stats.end()) {
+      continue;
+    }
+    rapidjson::Value queue(rapidjson::kObjectType);
+    queue.AddMember("name", rapidjson::StringRef(name), allocator);
+    queue.AddMember<uint64_t>("id", found->first, allocator);
+    for (auto grade : {fml::TaskSourceGrade::kUserInteraction,
+                       fml::TaskSourceGrade::kDartEventLoop,
+                       fml::TaskSourceGrade::kUnspecified}) {
+      const auto& grade_stats = found->second.GetGradeStats(grade);
+      rapidjson::Value grade_value(rapidjson::kObjectType);
+      AddHistogramToResponse(grade_stats.latency_us, "latencyMicros",
+                             grade_value, allocator);
+      AddHistogramToResponse(grade_stats.duration_us, "durationMicros",
+                             grade_value, allocator);
+      AddHistogramToResponse(grade_stats.queue_depth, "queueDepth",
+                             grade_value, allocator);
+      queue.AddMember(
+          rapidjson::StringRef(fml::TaskQueueStats::GetGradeName(grade)),
+          grade_value, allocator);
+    }
+    queues.PushBack(queue, allocator);
+  }
+  response->AddMember("queues", queues, allocator);
+
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    task_queues->ResetStats();
+  }
+
+  return true;
+}
+
+bool Shell::OnServiceProtocolDumpTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& recorder = fml::tracing::TraceRecorder::GetInstance();
+
+  auto format = fml::tracing::TraceRecorder::Format::kPerfettoProto;
+  auto format_param = params.find("format");
+  if (format_param != params.end()) {
+    if (format_param->second == "json") {
+      format = fml::tracing::TraceRecorder::Format::kChromeJSON;
+    } else if (format_param->second != "perfetto") {
+      ServiceProtocolParameterError(
+          response, "'format' must be either 'json' or 'perfetto'.");
+      return false;
+    }
+  }
+
+  std::unique_ptr<fml::Mapping> trace =
+      fml::tracing::TraceRecorder::Serialize(recorder.Snapshot(), format);
+  if (!trace) {
+    ServiceProtocolFailureError(response,
+                                "Could not serialize the trace ring buffer.");
+    return false;
+  }
+  std::string encoded(Base64::EncodedSize(trace->GetSize()), '\0');
+  Base64::Encode(trace->GetMapping(), trace->GetSize(), encoded.data());
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("recording", recorder.IsRecording(), allocator);
+  response->AddMember(
+      "format",
+      rapidjson::StringRef(
+          format == fml::tracing::TraceRecorder::Format::kChromeJSON
+              ? "json"
+              : "perfetto"),
+      allocator);
+  response->AddMember(
+      "trace", rapidjson::Value(encoded.c_str(), encoded.size(), allocator),
+      allocator);
+  return true;
+}
+
 void Shell::OnPlatformViewAddView(int64_t view_id,
                                   const ViewportMetrics& viewport_metrics,
                                   AddViewCallback callback) {
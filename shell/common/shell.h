@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 
@@ -486,6 +487,10 @@ class Shell final : public PlatformView::Delegate,
   // stored here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The last time the trace ring buffer was dumped because of a janky frame.
+  // Only accessed on the raster thread.
+  std::optional<fml::TimePoint> last_trace_ring_buffer_dump_;
+
   /// Manages the displays. This class is thread safe, can be accessed from
   /// any of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -549,6 +554,10 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Dumps the trace ring buffer to |Settings::trace_ring_buffer_dump_path| if
+  // the frame was janky.
+  void DumpTraceRingBufferIfJanky(const FrameTiming& timing);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -759,6 +768,25 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the task queueing latency, run duration and queue depth
+  // histograms of the shell's task runners. Collection is toggled by passing
+  // `enable` ("true" or "false") and the histograms are cleared by passing
+  // `reset` ("true").
+  bool OnServiceProtocolGetTaskQueueStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the events held by the trace ring buffer as a base64 encoded
+  // trace. The trace is in the Perfetto protobuf format unless `format` is
+  // "json", which selects the Chrome JSON format.
+  bool OnServiceProtocolDumpTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
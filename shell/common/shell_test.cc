@@ -319,6 +319,12 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetTaskQueueStats:
+            shell->OnServiceProtocolGetTaskQueueStats(params, response);
+            break;
+          case ServiceProtocolEnum::kDumpTraceRingBuffer:
+            shell->OnServiceProtocolDumpTraceRingBuffer(params, response);
+            break;
         }
         finished.set_value(true);
       });
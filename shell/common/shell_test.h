@@ -135,6 +135,8 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetTaskQueueStats,
+    kDumpTraceRingBuffer,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
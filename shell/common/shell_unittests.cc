@@ -31,9 +31,12 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_test.h"
@@ -2923,6 +2926,91 @@ TEST_F(ShellTest, OnServiceProtocolSetAssetBundlePathWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetTaskQueueStatsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const auto ui_task_runner = shell->GetTaskRunners().GetUITaskRunner();
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["enable"] = "true";
+  rapidjson::Document enable_document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTaskQueueStats,
+                    ui_task_runner, params, &enable_document);
+  ASSERT_TRUE(task_queues->IsStatsEnabled());
+
+  fml::AutoResetWaitableEvent latch;
+  ui_task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTaskQueueStats,
+                    ui_task_runner, {}, &document);
+  task_queues->SetStatsEnabled(false);
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_STREQ(document["type"].GetString(), "TaskQueueStats");
+  ASSERT_TRUE(document["enabled"].GetBool());
+  bool found_ui_queue = false;
+  for (const auto& queue : document["queues"].GetArray()) {
+    if (std::string(queue["name"].GetString()) != "ui") {
+      continue;
+    }
+    found_ui_queue = true;
+    const auto& unspecified = queue["unspecified"];
+    EXPECT_GE(unspecified["durationMicros"]["count"].GetUint64(), 1u);
+    EXPECT_GE(unspecified["latencyMicros"]["count"].GetUint64(), 1u);
+    EXPECT_EQ(unspecified["queueDepth"]["log2Buckets"].GetArray().Size(),
+              fml::Log2Histogram::kBucketCount);
+  }
+  ASSERT_TRUE(found_ui_queue);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolDumpTraceRingBufferWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  const auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
+  auto& recorder = fml::tracing::TraceRecorder::GetInstance();
+  recorder.Clear();
+  recorder.Start();
+  recorder.Record("DumpedOnDemand", 100, 0, 0, nullptr,
+                  Dart_Timeline_Event_Instant, 0, nullptr, nullptr);
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["format"] = "json";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kDumpTraceRingBuffer,
+                    io_task_runner, params, &document);
+  recorder.Stop();
+  recorder.Clear();
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_STREQ(document["type"].GetString(), "TraceRingBuffer");
+  ASSERT_STREQ(document["format"].GetString(), "json");
+  ASSERT_TRUE(document["recording"].GetBool());
+  const std::string encoded = document["trace"].GetString();
+  size_t decoded_size = 0;
+  ASSERT_EQ(Base64::Decode(encoded.data(), encoded.size(), nullptr,
+                           &decoded_size),
+            Base64::Error::kNone);
+  std::string trace(decoded_size, '\0');
+  ASSERT_EQ(Base64::Decode(encoded.data(), encoded.size(), trace.data(),
+                           &decoded_size),
+            Base64::Error::kNone);
+  EXPECT_NE(trace.find("DumpedOnDemand"), std::string::npos);
+
+  params["format"] = "svg";
+  rapidjson::Document error_document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kDumpTraceRingBuffer,
+                    io_task_runner, params, &error_document);
+  ASSERT_TRUE(error_document.IsObject());
+  EXPECT_STREQ(error_document["message"].GetString(), "Invalid params");
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, EngineRootIsolateLaunchesDontTakeVMDataSettings) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   // Make sure the shell launch does not kick off the creation of the VM
@@ -354,6 +354,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  settings.trace_to_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceToRingBuffer));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceRingBufferDumpPath),
+                              &settings.trace_ring_buffer_dump_path);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -202,6 +202,18 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(TraceToRingBuffer,
+           "trace-to-ring-buffer",
+           "Record engine trace events into a bounded in-process ring buffer "
+           "per thread. This works without the Dart timeline and the "
+           "recorded events can be dumped in the Chrome JSON or Perfetto "
+           "formats with the _flutter.dumpTraceRingBuffer service "
+           "extension.")
+DEF_SWITCH(TraceRingBufferDumpPath,
+           "trace-ring-buffer-dump-path",
+           "When tracing to the ring buffer, dump its contents to a Perfetto "
+           "trace in the specified directory whenever a frame takes more than "
+           "twice the frame budget to build and rasterize.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
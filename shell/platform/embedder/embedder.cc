@@ -24,6 +24,10 @@
 #include "third_party/skia/include/gpu/ganesh/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
+#if FML_OS_LINUX
+#include "flutter/fml/platform/linux/cpu_affinity.h"
+#endif  // FML_OS_LINUX
+
 #if !defined(FLUTTER_NO_EXPORT)
 #if FML_OS_WIN
 #define FLUTTER_EXPORT __declspec(dllexport)
@@ -2235,12 +2239,21 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   }
 #endif
   auto custom_task_runners = SAFE_ACCESS(args, custom_task_runners, nullptr);
+  settings.use_engine_thread_policy =
+      !custom_task_runners || !custom_task_runners->thread_priority_setter;
   auto thread_config_callback = [&custom_task_runners](
                                     const fml::Thread::ThreadConfig& config) {
-    fml::Thread::SetCurrentThreadName(config);
     if (!custom_task_runners || !custom_task_runners->thread_priority_setter) {
+#if FML_OS_LINUX
+      // Without a priority setter from the embedder, apply the engine's own
+      // placement and policy for the engine managed threads.
+      fml::LinuxThreadConfigSetter(config);
+#else
+      fml::Thread::SetCurrentThreadName(config);
+#endif  // FML_OS_LINUX
       return;
     }
+    fml::Thread::SetCurrentThreadName(config);
     FlutterThreadPriority priority = FlutterThreadPriority::kNormal;
     switch (config.priority) {
       case fml::Thread::ThreadPriority::kBackground:
@@ -584,6 +584,10 @@ def run_engine_benchmarks(build_dir, executable_filter):
 
   run_engine_executable(build_dir, 'fml_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(
+      build_dir, 'fml_task_capture_benchmarks', executable_filter, icu_flags
+  )
+
   run_engine_executable(build_dir, 'ui_benchmarks', executable_filter, icu_flags)
 
   run_engine_executable(build_dir, 'display_list_builder_benchmarks', executable_filter, icu_flags)